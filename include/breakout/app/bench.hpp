@@ -0,0 +1,15 @@
+#pragma once
+
+#include <span>
+#include <string_view>
+
+namespace bk::bench
+{
+	/**
+	 * \brief Run a micro benchmark from the command line: `breakout --bench <name> [args...]`.
+	 * Results are written to the log. Running without a name lists the available benchmarks.
+	 * \param args Benchmark name followed by its arguments.
+	 * \returns Process exit code.
+	 */
+	int run(std::span<std::string_view const> args);
+} // namespace bk::bench
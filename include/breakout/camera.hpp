@@ -2,6 +2,8 @@
 
 #include <glm/glm.hpp>
 
+#include "breakout/frustum.hpp"
+
 namespace bk
 {
     enum class CameraMovement
@@ -27,6 +29,14 @@ namespace bk
 
         [[nodiscard]] glm::mat4 GetViewMatrix() const;
 
+        /// Perspective with m_Zoom as the vertical field of view, for Vulkan: depth 0 to 1, y down.
+        [[nodiscard]] glm::mat4 GetProjectionMatrix() const;
+
+        [[nodiscard]] glm::mat4 GetViewProjectionMatrix() const;
+
+        /// World space planes of GetViewProjectionMatrix(), for cullSpheres() and friends.
+        [[nodiscard]] const Frustum& GetFrustum() const;
+
         void ProcessKeyboard(CameraMovement direction, float deltaTime);
 
         void ProcessMouseMovement(float xOffset, float yOffset, bool constrainPitch = true);
@@ -58,35 +68,48 @@ namespace bk
 
         [[nodiscard]] float GetZoom() const { return m_Zoom; }
 
+        [[nodiscard]] float GetAspectRatio() const { return m_AspectRatio; }
+
+        [[nodiscard]] float GetNearPlane() const { return m_NearPlane; }
+
+        [[nodiscard]] float GetFarPlane() const { return m_FarPlane; }
+
 
         /// Setters
 
-        void SetPosition(const glm::vec3& position) { m_Position = position; }
+        void SetPosition(const glm::vec3& position) { m_Position = position; m_Dirty = true; }
 
-        void SetFront(const glm::vec3& front) { m_Front = front; }
+        void SetFront(const glm::vec3& front) { m_Front = front; m_Dirty = true; }
 
-        void SetUp(const glm::vec3& up) { m_Up = up; }
+        void SetUp(const glm::vec3& up) { m_Up = up; m_Dirty = true; }
 
-        void SetRight(const glm::vec3& right) { m_Right = right; }
+        void SetRight(const glm::vec3& right) { m_Right = right; m_Dirty = true; }
 
-        void SetWorldUp(const glm::vec3& worldUp) { m_WorldUp = worldUp; }
+        void SetWorldUp(const glm::vec3& worldUp) { m_WorldUp = worldUp; m_Dirty = true; }
 
-        void SetYaw(float yaw) { m_Yaw = yaw; }
+        void SetYaw(float yaw) { m_Yaw = yaw; m_Dirty = true; }
 
-        void SetPitch(float pitch) { m_Pitch = pitch; }
+        void SetPitch(float pitch) { m_Pitch = pitch; m_Dirty = true; }
 
-        void SetRoll(float roll) { m_Roll = roll; }
+        void SetRoll(float roll) { m_Roll = roll; m_Dirty = true; }
 
         void SetMovementSpeed(float speed) { m_MovementSpeed = speed; }
 
         void SetMouseSensitivity(float sensitivity) { m_MouseSensitivity = sensitivity; }
 
-        void SetZoom(float zoom) { m_Zoom = zoom; }
+        void SetZoom(float zoom) { m_Zoom = zoom; m_Dirty = true; }
+
+        void SetAspectRatio(float aspectRatio) { m_AspectRatio = aspectRatio; m_Dirty = true; }
+
+        void SetClipPlanes(float nearPlane, float farPlane) { m_NearPlane = nearPlane; m_FarPlane = farPlane; m_Dirty = true; }
 
     private:
 
         void UpdateCameraVectors();
 
+        /// Recompute the cached matrices and frustum if a setter or Process* call changed anything they depend on.
+        void UpdateMatrices() const;
+
         glm::vec3 m_Position { 0 };
         glm::vec3 m_Front { 0 };
         glm::vec3 m_Up { 0 };
@@ -102,6 +125,16 @@ namespace bk
         float m_MovementSpeed { m_SPEED };
         float m_MouseSensitivity { m_SENSITIVITY };
         float m_Zoom { m_ZOOM };
+        float m_AspectRatio { m_ASPECT_RATIO };
+        float m_NearPlane { m_NEAR_PLANE };
+        float m_FarPlane { m_FAR_PLANE };
+
+        // Cached, rebuilt on first use after m_Dirty is set. Getters are const, hence mutable.
+        mutable glm::mat4 m_View { 1.0f };
+        mutable glm::mat4 m_Projection { 1.0f };
+        mutable glm::mat4 m_ViewProjection { 1.0f };
+        mutable Frustum m_Frustum {};
+        mutable bool m_Dirty { true };
 
         // Default camera values
         constexpr static float m_YAW { -90.0f };
@@ -110,6 +143,9 @@ namespace bk
         constexpr static float m_SPEED { 2.5f };
         constexpr static float m_SENSITIVITY { 0.1f };
         constexpr static float m_ZOOM { 45.0f };
+        constexpr static float m_ASPECT_RATIO { 16.0f / 9.0f };
+        constexpr static float m_NEAR_PLANE { 0.1f };
+        constexpr static float m_FAR_PLANE { 100.0f };
 
     };
 
@@ -0,0 +1,85 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+namespace bk::alloc
+{
+	/**
+	 * \brief Whether this build replaces the global operator new (CMake option BK_TRACK_ALLOCATIONS). Without it every
+	 * count stays zero and Scope costs a thread local store.
+	 */
+#if defined(BK_TRACK_ALLOCATIONS)
+	inline constexpr bool tracking_v{true};
+#else
+	inline constexpr bool tracking_v{false};
+#endif
+
+	/**
+	 * \brief Subsystem heap allocations are charged to: whatever Scope is innermost on the allocating thread.
+	 */
+	enum class Tag : std::uint8_t
+	{
+		eUntagged,
+		eGame,
+		eRenderer,
+		eResources,
+		eLogger,
+		eJobs, // Pool workers outside any more specific scope
+		eCOUNT_
+	};
+
+	inline constexpr auto tag_count_v = static_cast<std::size_t>(Tag::eCOUNT_);
+
+	[[nodiscard]] std::string_view tagName(Tag tag);
+
+	struct Counts
+	{
+		std::uint64_t allocations{};
+		std::uint64_t bytes{}; // Requested, not including allocator overhead
+	};
+
+	using TagCounts = std::array<Counts, tag_count_v>;
+
+	/**
+	 * \brief Charge allocations on this thread to tag until destroyed, then restore the previous tag.
+	 */
+	class Scope
+	{
+	public:
+		explicit Scope(Tag tag);
+
+		Scope(Scope &&) = delete;
+
+		Scope & operator=(Scope &&) = delete;
+
+		Scope(Scope const &) = delete;
+
+		Scope & operator=(Scope const &) = delete;
+
+		~Scope();
+
+	private:
+		Tag m_previous;
+	};
+
+	/**
+	 * \returns Allocations per tag since startup.
+	 */
+	[[nodiscard]] TagCounts totals();
+
+	/**
+	 * \brief Close the current frame: returns its allocations per tag and starts counting the next one.
+	 * Allocations racing with the call on other threads land in one frame or the other.
+	 */
+	TagCounts endFrame();
+
+	[[nodiscard]] Counts sum(TagCounts const & counts);
+
+	/**
+	 * \brief Log totals per tag and per frame statistics (frames closed, how many allocated nothing, the worst one).
+	 */
+	void report();
+} // namespace bk::alloc
@@ -0,0 +1,20 @@
+#pragma once
+
+#include <cstddef>
+#include <filesystem>
+#include <span>
+
+namespace bk
+{
+	/**
+	 * \brief Write bytes to path through a temporary file renamed over it, so readers never see a partial file and a crash
+	 * never leaves one behind. Creates parent directories.
+	 * \returns false (after logging) on failure.
+	 */
+	bool writeFileAtomic(std::filesystem::path const & path, std::span<std::byte const> bytes);
+
+	/**
+	 * \brief As writeFileAtomic above, for a file made of several parts written back to back.
+	 */
+	bool writeFileAtomic(std::filesystem::path const & path, std::span<std::span<std::byte const> const> parts);
+} // namespace bk
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <chrono>
+#include <filesystem>
+#include <memory>
+#include <vector>
+
+namespace bk
+{
+	/**
+	 * \brief Non-blocking watcher reporting files that were written or moved into watched directories.
+	 * Backed by inotify on Linux; on other platforms isSupported() is false and poll() never reports anything.
+	 */
+	class FileWatcher
+	{
+	public:
+		using Clock = std::chrono::steady_clock;
+
+		struct Event
+		{
+			std::filesystem::path path{};
+
+			/**
+			 * \brief Time at which the change was picked up, used as the start of reload latency measurements.
+			 */
+			Clock::time_point detected{};
+		};
+
+		FileWatcher();
+
+		FileWatcher(FileWatcher &&) = delete;
+
+		FileWatcher & operator=(FileWatcher &&) = delete;
+
+		FileWatcher(FileWatcher const &) = delete;
+
+		FileWatcher & operator=(FileWatcher const &) = delete;
+
+		~FileWatcher();
+
+		[[nodiscard]] bool isSupported() const;
+
+		/**
+		 * \brief Start watching a directory (non recursive). Watching the same directory twice is a no-op.
+		 * \returns false if the directory could not be watched.
+		 */
+		bool watch(std::filesystem::path const & directory);
+
+		/**
+		 * \brief Drain pending notifications without blocking.
+		 * Repeated changes to the same file within one call are reported once.
+		 */
+		[[nodiscard]] std::vector<Event> poll();
+
+	private:
+		struct Impl;
+
+		std::unique_ptr<Impl> m_impl;
+	};
+} // namespace bk
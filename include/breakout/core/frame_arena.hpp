@@ -0,0 +1,66 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <memory_resource>
+#include <vector>
+
+namespace bk
+{
+	/**
+	 * \brief Linear allocator for memory that lives until the end of the frame, as a std::pmr::memory_resource so standard
+	 * containers can use it: std::pmr::vector<T>{arena.allocator<T>()}.
+	 * Allocation bumps an offset; deallocation does nothing; reset() frees everything at once. A frame needing more than
+	 * the block gets overflow blocks from the heap, and the next reset() replaces the block with one big enough for that
+	 * frame, so steady state frames allocate nothing. Not thread safe: meant for the frame thread.
+	 */
+	class FrameArena final : public std::pmr::memory_resource
+	{
+	public:
+		struct Stats
+		{
+			std::size_t used{};        // This frame, overflow included
+			std::size_t capacity{};    // Of the block
+			std::size_t highWater{};   // Most used by any frame
+			std::uint32_t overflows{}; // Overflow blocks allocated since startup
+		};
+
+		explicit FrameArena(std::size_t capacity);
+
+		FrameArena(FrameArena &&) = delete;
+
+		FrameArena & operator=(FrameArena &&) = delete;
+
+		FrameArena(FrameArena const &) = delete;
+
+		FrameArena & operator=(FrameArena const &) = delete;
+
+		~FrameArena() override = default;
+
+		/**
+		 * \brief End of frame: everything allocated since the last reset() is freed. Containers using the arena must be gone.
+		 */
+		void reset();
+
+		template <typename Type>
+		[[nodiscard]] std::pmr::polymorphic_allocator<Type> allocator()
+		{
+			return std::pmr::polymorphic_allocator<Type>{this};
+		}
+
+		[[nodiscard]] Stats const & getStats() const { return m_stats; }
+
+	private:
+		void * do_allocate(std::size_t bytes, std::size_t alignment) override;
+
+		void do_deallocate(void * /*ptr*/, std::size_t /*bytes*/, std::size_t /*alignment*/) override {}
+
+		[[nodiscard]] bool do_is_equal(std::pmr::memory_resource const & other) const noexcept override { return this == &other; }
+
+		std::unique_ptr<std::byte[]> m_block{};
+		std::size_t m_offset{};
+		std::vector<std::unique_ptr<std::byte[]>> m_overflow{};
+		Stats m_stats{};
+	};
+} // namespace bk
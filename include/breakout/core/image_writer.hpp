@@ -0,0 +1,22 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace bk::image
+{
+	/**
+	 * \brief Encode RGBA8 pixels (R in the lowest byte, rows top to bottom, tightly packed) as a PNG.
+	 * Deflate runs in stored mode: no compression, so encoding costs little more than a copy and a checksum, at the price of
+	 * files as big as the pixels. Good enough for golden images and captures; recompress them offline if size matters.
+	 */
+	[[nodiscard]] std::vector<std::byte> encodePng(std::uint32_t width, std::uint32_t height, std::span<std::uint32_t const> pixels);
+
+	/**
+	 * \brief Encode pixels (as for encodePng) as a QOI image: lossless and actually compressed (runs, a colour cache and
+	 * small deltas), in one pass that costs little more than encodePng. Files are usually a fraction of the PNG's size.
+	 */
+	[[nodiscard]] std::vector<std::byte> encodeQoi(std::uint32_t width, std::uint32_t height, std::span<std::uint32_t const> pixels);
+} // namespace bk::image
@@ -0,0 +1,96 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <initializer_list>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace bk
+{
+	class ThreadPool;
+
+	/**
+	 * \brief Startup as a dependency graph: each task starts as soon as the tasks it depends on are done, on a pool worker
+	 * or, for tasks that must stay on it (SDL, anything frame-thread-only), on the thread calling run().
+	 * Every task is timed; the timings and the critical path (the chain of tasks startup actually waited on) are logged.
+	 */
+	class InitGraph
+	{
+	public:
+		using TaskId = std::uint32_t;
+		using Task   = std::function<bool()>; // Returns false on failure, after logging why
+
+		enum class Thread : std::uint8_t
+		{
+			eAny,  // A pool worker
+			eMain, // The thread calling run()
+		};
+
+		struct Timing
+		{
+			std::int64_t beginNs{}; // Profiler::now() clock
+			std::int64_t endNs{};
+			bool ran{false}; // False if skipped because a task failed first
+			bool ok{false};
+			bool onMain{false};
+		};
+
+		InitGraph() = default;
+
+		InitGraph(InitGraph &&) = delete;
+
+		InitGraph & operator=(InitGraph &&) = delete;
+
+		InitGraph(InitGraph const &) = delete;
+
+		InitGraph & operator=(InitGraph const &) = delete;
+
+		~InitGraph() = default;
+
+		/**
+		 * \param name Must outlive the graph (a literal).
+		 * \param dependencies Tasks added before this one that must finish first.
+		 */
+		TaskId add(std::string_view name, Task task, std::initializer_list<TaskId> dependencies = {}, Thread thread = Thread::eAny);
+
+		/**
+		 * \brief Run every task and log how long each took. Once a task fails nothing new starts; tasks already running
+		 * are waited for, the rest are skipped.
+		 * \returns True if every task succeeded.
+		 */
+		bool run(ThreadPool & pool);
+
+		/**
+		 * \brief After run(): from the task that finished last back to a root, following at each step the dependency that
+		 * finished last (the one the task was waiting on). Speeding up anything off this path does not shorten startup.
+		 */
+		[[nodiscard]] std::vector<TaskId> criticalPath() const;
+
+		/**
+		 * \brief After run(): the critical path with each task's duration and wait, then the total against the summed task time.
+		 */
+		[[nodiscard]] std::string report() const;
+
+		[[nodiscard]] std::string_view name(TaskId const id) const { return m_nodes[id].name; }
+
+		[[nodiscard]] Timing const & timing(TaskId const id) const { return m_nodes[id].timing; }
+
+	private:
+		struct Node
+		{
+			std::string_view name{};
+			Task task{};
+			std::vector<TaskId> dependencies{};
+			Thread thread{Thread::eAny};
+			Timing timing{};
+		};
+
+		bool execute(Node & node, bool onMain);
+
+		std::vector<Node> m_nodes{};
+		std::int64_t m_beginNs{};
+		std::int64_t m_endNs{};
+	};
+} // namespace bk
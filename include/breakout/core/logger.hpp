@@ -8,6 +8,7 @@
 #include <optional>
 
 #include "breakout/stl/fixed_string.hpp"
+#include "breakout/stl/string_id.hpp"
 
 namespace bk::logger {
     /**
@@ -68,6 +69,19 @@ namespace bk::logger {
         eUtc
     };
 
+    /**
+     * \brief Log category: its name, and the StringId that per category config is looked up by.
+     */
+    struct Category {
+        std::string_view name{};
+        StringId id{};
+
+        Category() = default;
+
+        // NOLINTNEXTLINE(google-explicit-constructor)
+        constexpr Category(std::string_view const name) : name(name), id(name) {}
+    };
+
     struct Config {
         /**
          * \brief Default format specification for log entries.
@@ -100,9 +114,9 @@ namespace bk::logger {
         Level maxLevel{Level::eDebug};
 
         /**
-         * \brief Max log Level overrides per category.
+         * \brief Max log Level overrides per category, e.g. {StringId{"gpu"}, Level::eWarn}.
          */
-        std::unordered_map<std::string_view, Level> categoryMaxLevels{};
+        std::unordered_map<StringId, Level> categoryMaxLevels{};
 
         /**
          * \brief Log Target overrides per Level.
@@ -129,6 +143,7 @@ namespace bk::logger {
      */
     struct Context {
         std::string_view category{};
+        StringId categoryId{};
         Clock::time_point timestamp{};
         ThreadId thread{};
         Level level{};
@@ -142,9 +157,9 @@ namespace bk::logger {
          */
         static ThreadId getThreadId();
 
-        static Context make(std::string_view category, Level level);
+        static Context make(Category category, Level level);
 
-        static Context make(std::string_view category, Level level, std::string_view function,
+        static Context make(Category category, Level level, std::string_view function,
                             std::string_view filePath, int currentLine);
     };
 
@@ -162,6 +177,16 @@ namespace bk::logger {
         virtual void handle(std::string_view formatted, Context const &context) = 0;
     };
 
+    /**
+     * \brief Counters for monitoring the logger itself.
+     */
+    struct Stats {
+        std::uint64_t messages{};       // Passed the level filters
+        std::uint64_t filtered{};       // Rejected by the level filters
+        std::uint64_t dropped{};        // Logged while no Instance existed
+        std::size_t pendingFileBytes{}; // Formatted but not yet written out by the file sink's thread
+    };
+
     /**
      * \brief Logger Instance: a single instance must be created within main's scope.
      */
@@ -211,6 +236,11 @@ namespace bk::logger {
          */
         static void print(std::string_view message, Context const &context);
 
+        /**
+         * \brief Thread-safe; all zero but dropped while no Instance exists.
+         */
+        [[nodiscard]] static Stats getStats();
+
     private:
         struct Impl;
 
@@ -223,9 +253,9 @@ namespace bk::logger {
         std::unique_ptr<Impl, Deleter> m_impl{};
     };
 
-    void print(Level level, std::string_view category, std::string_view message);
+    void print(Level level, Category category, std::string_view message);
 
-    void print(Level level, std::string_view category, std::string_view function, std::string_view filePath,
+    void print(Level level, Category category, std::string_view function, std::string_view filePath,
                int curLine, std::string_view message);
 } // namespace breakout::logger
 
@@ -296,7 +326,7 @@ namespace bk {
         }
 
     private:
-        std::string_view m_category{};
+        logger::Category m_category{};
     };
 
     namespace logger
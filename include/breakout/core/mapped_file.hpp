@@ -0,0 +1,45 @@
+#pragma once
+
+#include <cstddef>
+#include <filesystem>
+#include <optional>
+#include <span>
+
+namespace bk
+{
+	/**
+	 * \brief Read-only memory mapping of a whole file.
+	 */
+	class MappedFile
+	{
+	public:
+		/**
+		 * \brief Map a file.
+		 * \returns nullopt if the file does not exist, is empty, or could not be mapped.
+		 */
+		static std::optional<MappedFile> open(std::filesystem::path const & path);
+
+		MappedFile(MappedFile && other) noexcept;
+
+		MappedFile & operator=(MappedFile && other) noexcept;
+
+		MappedFile(MappedFile const &) = delete;
+
+		MappedFile & operator=(MappedFile const &) = delete;
+
+		~MappedFile();
+
+		[[nodiscard]] std::span<std::byte const> bytes() const { return {m_data, m_size}; }
+
+	private:
+		MappedFile() = default;
+
+		void release();
+
+		std::byte const * m_data{};
+		std::size_t m_size{};
+#if defined(_WIN32)
+		void * m_mapping{};
+#endif
+	};
+} // namespace bk
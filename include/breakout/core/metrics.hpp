@@ -0,0 +1,199 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <string_view>
+#include <thread>
+
+namespace bk::metrics
+{
+	inline constexpr std::size_t shard_count_v{8};
+
+	namespace detail
+	{
+		std::uint32_t nextShard();
+
+		/**
+		 * \brief The calling thread's shard: threads are spread round robin over shard_count_v, on first use.
+		 */
+		inline std::size_t shard()
+		{
+			thread_local std::uint32_t s_shard{~0u};
+			if (s_shard == ~0u) [[unlikely]] { s_shard = nextShard(); }
+			return s_shard;
+		}
+
+		// One cache line each, so threads on different shards never contend.
+		template <typename Type>
+		struct alignas(64) Shard
+		{
+			std::atomic<Type> value{};
+		};
+	} // namespace detail
+
+	/**
+	 * \brief Monotonic count. add() is a relaxed atomic add on the calling thread's shard; value() sums the shards.
+	 */
+	class Counter
+	{
+	public:
+		void add(std::uint64_t const amount = 1) { m_shards[detail::shard()].value.fetch_add(amount, std::memory_order_relaxed); }
+
+		[[nodiscard]] std::uint64_t value() const;
+
+	private:
+		std::array<detail::Shard<std::uint64_t>, shard_count_v> m_shards{};
+	};
+
+	/**
+	 * \brief Value that goes up and down, e.g. queue depth or bytes in use. add() is sharded as for Counter.
+	 */
+	class Gauge
+	{
+	public:
+		void add(std::int64_t const amount) { m_shards[detail::shard()].value.fetch_add(amount, std::memory_order_relaxed); }
+
+		/**
+		 * \brief Replace the value. Not sharded (and not atomic with respect to concurrent add()s): meant for gauges that
+		 * only one thread sets, e.g. per frame values.
+		 */
+		void set(std::int64_t value);
+
+		[[nodiscard]] std::int64_t value() const;
+
+	private:
+		std::array<detail::Shard<std::int64_t>, shard_count_v> m_shards{};
+	};
+
+	/**
+	 * \brief Distribution of non-negative integers (typically nanoseconds) in log-linear buckets, as HdrHistogram does:
+	 * exact below 64, then 32 buckets per power of two, so any value is off by at most 1/32 (3%). Values from 2^40 (about
+	 * 18 minutes in ns) up share the last bucket. record() is two relaxed atomic adds on the calling thread's shard.
+	 */
+	class Histogram
+	{
+	public:
+		static constexpr std::uint32_t sub_bucket_bits_v{5};
+		static constexpr std::uint32_t max_exponent_v{40};
+		static constexpr std::size_t bucket_count_v{(max_exponent_v - sub_bucket_bits_v + 2) << sub_bucket_bits_v};
+
+		struct Summary
+		{
+			std::uint64_t count{};
+			std::uint64_t sum{};
+			// Upper bounds of the buckets holding each quantile, so within 3% above the true value.
+			std::uint64_t p50{};
+			std::uint64_t p90{};
+			std::uint64_t p99{};
+			std::uint64_t max{};
+		};
+
+		static constexpr std::size_t bucketIndex(std::uint64_t const value)
+		{
+			constexpr auto sub_buckets_v = std::uint64_t{1} << sub_bucket_bits_v;
+			if (value < 2 * sub_buckets_v) { return static_cast<std::size_t>(value); }
+			auto const exponent = std::min<std::uint32_t>(static_cast<std::uint32_t>(std::bit_width(value)) - 1, max_exponent_v);
+			auto const shift    = exponent - sub_bucket_bits_v;
+			auto const mantissa = std::min(value >> shift, 2 * sub_buckets_v - 1); // Leading one and sub_bucket_bits_v bits
+			return ((shift + 1) << sub_bucket_bits_v) + static_cast<std::size_t>(mantissa - sub_buckets_v);
+		}
+
+		/**
+		 * \returns The largest value that lands in bucket index.
+		 */
+		static constexpr std::uint64_t bucketUpperBound(std::size_t const index)
+		{
+			constexpr auto sub_buckets_v = std::size_t{1} << sub_bucket_bits_v;
+			if (index < 2 * sub_buckets_v) { return index; }
+			auto const shift = index / sub_buckets_v - 1;
+			return ((std::uint64_t{sub_buckets_v + index % sub_buckets_v} + 1) << shift) - 1;
+		}
+
+		void record(std::uint64_t const value)
+		{
+			auto & shard = m_shards[detail::shard()];
+			shard.buckets[bucketIndex(value)].fetch_add(1, std::memory_order_relaxed);
+			shard.sum.fetch_add(value, std::memory_order_relaxed);
+		}
+
+		void record(std::chrono::nanoseconds const duration) { record(static_cast<std::uint64_t>(std::max<std::int64_t>(duration.count(), 0))); }
+
+		/**
+		 * \brief Merge the shards: everything recorded since startup.
+		 */
+		[[nodiscard]] Summary summarize() const;
+
+	private:
+		struct alignas(64) Shard
+		{
+			std::array<std::atomic<std::uint64_t>, bucket_count_v> buckets{};
+			std::atomic<std::uint64_t> sum{};
+		};
+
+		std::array<Shard, shard_count_v> m_shards{};
+	};
+
+	static_assert(Histogram::bucketIndex(63) == 63 && Histogram::bucketIndex(64) == 64 && Histogram::bucketIndex(65) == 64);
+	static_assert(Histogram::bucketUpperBound(Histogram::bucketIndex(1000)) >= 1000);
+	static_assert(Histogram::bucketUpperBound(Histogram::bucketIndex(~std::uint64_t{})) == Histogram::bucketUpperBound(Histogram::bucket_count_v - 1));
+
+	/**
+	 * \brief Find or register the metric called name in the global registry. The reference stays valid for the program's
+	 * lifetime: look it up once (e.g. into a static) and update it from any thread. Names follow Prometheus rules
+	 * ([a-zA-Z_:][a-zA-Z0-9_:]*); asking for an existing name as another kind logs an error and returns an unregistered metric.
+	 */
+	Counter & counter(std::string_view name);
+
+	Gauge & gauge(std::string_view name);
+
+	Histogram & histogram(std::string_view name);
+
+	/**
+	 * \brief Every registered metric in the Prometheus text exposition format: counters and gauges as such, histograms as
+	 * summaries with 0.5, 0.9 and 0.99 quantiles.
+	 */
+	[[nodiscard]] std::string format();
+
+	/**
+	 * \brief Collects the registry on a background thread every interval, writing it to a file for a collector to scrape
+	 * and/or to the log (category "metrics", so every logger::Sink sees it).
+	 */
+	class Publisher
+	{
+	public:
+		struct Config
+		{
+			std::chrono::milliseconds interval{std::chrono::seconds{10}};
+			std::filesystem::path file{}; // Replaced atomically every interval; empty to not write one
+			bool log{false};
+		};
+
+		explicit Publisher(Config config);
+
+		Publisher(Publisher &&) = delete;
+
+		Publisher & operator=(Publisher &&) = delete;
+
+		Publisher(Publisher const &) = delete;
+
+		Publisher & operator=(Publisher const &) = delete;
+
+		/**
+		 * \brief Publishes one last time, then stops the thread.
+		 */
+		~Publisher();
+
+		void publish() const;
+
+	private:
+		Config m_config{};
+		std::jthread m_thread{};
+	};
+} // namespace bk::metrics
@@ -0,0 +1,143 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <string_view>
+#include <vector>
+
+#include "breakout/core/alloc_tracker.hpp"
+
+namespace bk
+{
+	/**
+	 * \brief Per-frame timeline of named CPU and GPU zones.
+	 * CPU zones are timed with std::chrono::steady_clock; GPU zones arrive later, already converted to that time base (see
+	 * gpu::GpuProfiler), so both end up in one report per frame. A frame is published once it is latency frames old, by
+	 * which point its GPU results have been read back. Input-to-present latencies are kept alongside, over a sliding window.
+	 */
+	class Profiler
+	{
+	public:
+		static constexpr int gpu_track_v{-1};
+		static constexpr std::size_t latency_window_v{1024}; // Input latency samples kept for percentiles
+
+		struct Zone
+		{
+			std::string_view name{}; // Must outlive the profiler; string literals in practice
+			std::int64_t beginNs{};  // steady_clock
+			std::int64_t endNs{};
+			int track{};             // Logger thread ID for CPU zones, gpu_track_v for GPU zones
+			std::uint16_t depth{};   // Nesting level within the track
+		};
+
+		struct Frame
+		{
+			std::uint64_t number{};
+			std::int64_t beginNs{};
+			std::int64_t endNs{};
+			std::vector<Zone> zones{};
+			bool gpuCalibrated{true};    // False when GPU zones were aligned to the CPU timeline by estimate
+			alloc::Counts allocations{}; // Heap allocations during the frame, when the build tracks them
+		};
+
+		struct Percentiles
+		{
+			std::size_t samples{};
+			double p50Ms{};
+			double p90Ms{};
+			double p99Ms{};
+			double maxMs{};
+		};
+
+		/**
+		 * \brief RAII CPU zone.
+		 */
+		class Scope
+		{
+		public:
+			Scope(Profiler & profiler, std::string_view name);
+
+			Scope(Scope &&) = delete;
+
+			Scope & operator=(Scope &&) = delete;
+
+			Scope(Scope const &) = delete;
+
+			Scope & operator=(Scope const &) = delete;
+
+			~Scope();
+
+		private:
+			Profiler & m_profiler;
+			std::string_view m_name;
+			std::int64_t m_beginNs;
+		};
+
+		/**
+		 * \param latency Frames to hold a frame open for late (GPU) zones; at least the number of frames in flight.
+		 * \param reportInterval Log every reportInterval-th published frame; 0 never logs.
+		 */
+		explicit Profiler(std::uint32_t latency, std::uint32_t reportInterval = 0);
+
+		static std::int64_t now();
+
+		/**
+		 * \brief Open a CPU zone on the calling thread; prefer Scope.
+		 */
+		[[nodiscard]] Scope zone(std::string_view name) { return Scope{*this, name}; }
+
+		void beginFrame(std::uint64_t number);
+
+		/**
+		 * \brief Close the current frame and publish the frames that are now latency frames old.
+		 */
+		void endFrame();
+
+		/**
+		 * \brief Add a zone to a frame still held open. Thread-safe; zones for frames already published are dropped.
+		 */
+		void addZone(std::uint64_t frame, Zone const & zone);
+
+		void setGpuCalibrated(std::uint64_t frame, bool calibrated);
+
+		/**
+		 * \brief Record the heap allocations of the current frame, e.g. from alloc::endFrame().
+		 */
+		void setAllocations(alloc::Counts const & counts);
+
+		/**
+		 * \brief Record the time from an input event to the present call of the frame that first reflected it. Thread-safe.
+		 */
+		void addInputLatency(std::int64_t ns);
+
+		/**
+		 * \returns Percentiles over the last latency_window_v input latencies.
+		 */
+		[[nodiscard]] Percentiles inputLatency() const;
+
+		/**
+		 * \returns A copy of the most recently published frame.
+		 */
+		[[nodiscard]] Frame lastFrame() const;
+
+		/**
+		 * \brief Log a frame's zones in time order, offsets relative to the frame start.
+		 */
+		static void report(Frame const & frame);
+
+	private:
+		Frame * find(std::uint64_t number);
+
+		std::uint32_t m_latency{};
+		std::uint32_t m_reportInterval{};
+
+		mutable std::mutex m_mutex{};
+		std::deque<Frame> m_open{};
+		Frame m_published{};
+		std::uint64_t m_current{};
+		std::vector<std::int64_t> m_inputLatencies{}; // Ring of latency_window_v
+		std::size_t m_inputLatencyCount{};
+	};
+} // namespace bk
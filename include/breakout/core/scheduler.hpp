@@ -0,0 +1,199 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <coroutine>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "breakout/core/task.hpp"
+
+namespace bk
+{
+	class ThreadPool;
+
+	/**
+	 * \brief Runs coroutine Tasks from the frame loop: tick() resumes whatever became ready since the last frame, in order,
+	 * until the frame's time budget is spent; the rest waits for the next tick. Long operations are sliced across frames by
+	 * awaiting yield() (or nextFrame()) between steps, or moved off the frame thread with worker().
+	 * Create, spawn and tick on the frame thread; awaiters may be used from tasks on any thread.
+	 */
+	class Scheduler
+	{
+	public:
+		using Clock = std::chrono::steady_clock;
+
+		struct Config
+		{
+			Clock::duration budget{std::chrono::milliseconds{2}}; // Per tick; at least one task is resumed regardless
+		};
+
+		/**
+		 * \brief Resumes on the frame thread in the next tick.
+		 */
+		struct NextFrame
+		{
+			Scheduler & scheduler;
+
+			[[nodiscard]] bool await_ready() const noexcept { return false; }
+
+			void await_suspend(std::coroutine_handle<> handle) const;
+
+			void await_resume() const noexcept {}
+		};
+
+		/**
+		 * \brief Resumes on the frame thread in the first tick at or after the deadline.
+		 */
+		struct After
+		{
+			Scheduler & scheduler;
+			Clock::time_point deadline;
+
+			[[nodiscard]] bool await_ready() const noexcept { return false; }
+
+			void await_suspend(std::coroutine_handle<> handle) const;
+
+			void await_resume() const noexcept {}
+		};
+
+		/**
+		 * \brief Resumes on a pool worker; the task keeps running there until it awaits something that brings it back.
+		 */
+		struct Worker
+		{
+			Scheduler & scheduler;
+
+			[[nodiscard]] bool await_ready() const noexcept { return false; }
+
+			void await_suspend(std::coroutine_handle<> handle) const;
+
+			void await_resume() const noexcept {}
+		};
+
+		/**
+		 * \brief Resumes on the frame thread: immediately if already there, otherwise in the current or next tick.
+		 */
+		struct FrameThread
+		{
+			Scheduler & scheduler;
+
+			[[nodiscard]] bool await_ready() const noexcept { return std::this_thread::get_id() == scheduler.m_frameThread; }
+
+			void await_suspend(std::coroutine_handle<> handle) const { scheduler.schedule(handle); }
+
+			void await_resume() const noexcept {}
+		};
+
+		/**
+		 * \brief Resumes on the frame thread once the predicate, evaluated there once per tick, returns true.
+		 */
+		struct Until
+		{
+			Scheduler & scheduler;
+			std::function<bool()> predicate;
+
+			[[nodiscard]] bool await_ready() const { return std::this_thread::get_id() == scheduler.m_frameThread && predicate(); }
+
+			void await_suspend(std::coroutine_handle<> handle);
+
+			void await_resume() const noexcept {}
+		};
+
+		/**
+		 * \brief Resumes on the frame thread later in this tick if the budget allows, otherwise in the next one.
+		 */
+		struct Yield
+		{
+			Scheduler & scheduler;
+
+			[[nodiscard]] bool await_ready() const noexcept { return false; }
+
+			void await_suspend(std::coroutine_handle<> handle) const { scheduler.schedule(handle); }
+
+			void await_resume() const noexcept {}
+		};
+
+		/**
+		 * \brief The calling thread becomes the frame thread; the pool must outlive the scheduler.
+		 */
+		Scheduler(ThreadPool & pool, Config config);
+
+		Scheduler(Scheduler &&) = delete;
+
+		Scheduler & operator=(Scheduler &&) = delete;
+
+		Scheduler(Scheduler const &) = delete;
+
+		Scheduler & operator=(Scheduler const &) = delete;
+
+		/**
+		 * \brief Waits for tasks running on workers to suspend, then destroys every unfinished task.
+		 */
+		~Scheduler();
+
+		/**
+		 * \brief Take ownership of a task and start it in the next tick. Exceptions escaping it are logged.
+		 */
+		void spawn(Task<void> task);
+
+		/**
+		 * \brief Frame thread, once per frame: wake due timers and satisfied predicates, then resume ready tasks until the
+		 * budget is spent.
+		 */
+		void tick();
+
+		[[nodiscard]] NextFrame nextFrame() { return {*this}; }
+
+		[[nodiscard]] After after(Clock::duration const delay) { return {*this, Clock::now() + delay}; }
+
+		[[nodiscard]] Worker worker() { return {*this}; }
+
+		[[nodiscard]] FrameThread frameThread() { return {*this}; }
+
+		[[nodiscard]] Until until(std::function<bool()> predicate) { return {*this, std::move(predicate)}; }
+
+		[[nodiscard]] Yield yield() { return {*this}; }
+
+		/**
+		 * \brief Spawned tasks not yet finished.
+		 */
+		[[nodiscard]] std::size_t taskCount() const { return m_tasks.size(); }
+
+	private:
+		struct Timer
+		{
+			Clock::time_point deadline{};
+			std::coroutine_handle<> handle{};
+		};
+
+		struct Waiter
+		{
+			std::function<bool()> predicate{};
+			std::coroutine_handle<> handle{};
+		};
+
+		Task<void> run(Task<void> task);
+
+		void schedule(std::coroutine_handle<> handle);
+
+		ThreadPool & m_pool;
+		Config m_config;
+		std::thread::id m_frameThread{};
+		std::vector<Task<void>> m_tasks{}; // Spawned, wrapped by run(); frame thread only
+
+		// Everything a task can be waiting in; awaiters may run on workers, so all of it is guarded.
+		std::mutex m_mutex{};
+		std::deque<std::coroutine_handle<>> m_ready{};
+		std::vector<std::coroutine_handle<>> m_nextFrame{};
+		std::vector<Timer> m_timers{}; // Min-heap on deadline
+		std::vector<Waiter> m_waiters{};
+		// Tasks handed to the pool and not yet suspended again; the destructor waits for these.
+		std::uint32_t m_onWorkers{};
+		std::condition_variable m_workersDone{};
+	};
+} // namespace bk
@@ -0,0 +1,201 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <optional>
+#include <ranges>
+#include <span>
+#include <type_traits>
+#include <vector>
+
+namespace bk::snapshot
+{
+	/**
+	 * \brief Hash of a serialized state, for desync checks: equal states hash equal on every platform of the same
+	 * endianness. Not cryptographic. Ring::capture returns the same value for the state it records.
+	 */
+	[[nodiscard]] std::uint64_t hash(std::span<std::byte const> state);
+
+	/**
+	 * \brief Serializes simulation state into a reusable byte buffer, with every value padded to 8 bytes. Fields then stay
+	 * word aligned, so an unchanged field XORs to zero words against the previous frame whatever changed before it (as
+	 * long as no array before it changed length).
+	 */
+	class Writer
+	{
+	public:
+		/**
+		 * \brief Clears out; its capacity is kept, so rewriting a state of the same size does not allocate.
+		 */
+		explicit Writer(std::vector<std::byte> & out) : m_out(out) { m_out.clear(); }
+
+		template <typename Type>
+			requires std::is_trivially_copyable_v<Type> && (!std::ranges::range<Type>)
+		void write(Type const & value)
+		{
+			append(std::as_bytes(std::span{&value, 1}));
+		}
+
+		/**
+		 * \brief Element count, then the elements.
+		 */
+		template <std::ranges::contiguous_range Range>
+			requires std::is_trivially_copyable_v<std::ranges::range_value_t<Range>>
+		void write(Range const & values)
+		{
+			write(static_cast<std::uint64_t>(std::ranges::size(values)));
+			append(std::as_bytes(std::span{std::ranges::data(values), std::ranges::size(values)}));
+		}
+
+	private:
+		void append(std::span<std::byte const> bytes);
+
+		std::vector<std::byte> & m_out;
+	};
+
+	/**
+	 * \brief Reads back what a Writer wrote, in the same order. Reads past the end fail and leave the target untouched.
+	 */
+	class Reader
+	{
+	public:
+		explicit Reader(std::span<std::byte const> const state) : m_state(state) {}
+
+		template <typename Type>
+			requires std::is_trivially_copyable_v<Type> && (!std::ranges::range<Type>)
+		bool read(Type & value)
+		{
+			auto const bytes = take(sizeof(Type));
+			if (bytes.empty()) { return false; }
+			std::memcpy(&value, bytes.data(), sizeof(Type));
+			return true;
+		}
+
+		template <typename Type>
+			requires std::is_trivially_copyable_v<Type>
+		bool read(std::vector<Type> & values)
+		{
+			auto count = std::uint64_t{};
+			if (!read(count) || count > (m_state.size() - m_offset) / sizeof(Type)) { return false; }
+			auto const bytes = take(count * sizeof(Type));
+			if (bytes.size() != count * sizeof(Type)) { return false; }
+			values.resize(count);
+			if (count != 0) { std::memcpy(values.data(), bytes.data(), bytes.size()); }
+			return true;
+		}
+
+		/**
+		 * \brief Ranges that cannot be resized (std::array, C arrays, spans): fails unless the count written matches their size.
+		 */
+		template <std::ranges::contiguous_range Range>
+			requires std::ranges::sized_range<Range> && std::is_trivially_copyable_v<std::ranges::range_value_t<Range>>
+		bool read(Range & values)
+		{
+			using Value = std::ranges::range_value_t<Range>;
+			auto count  = std::uint64_t{};
+			if (!read(count) || count != std::ranges::size(values)) { return false; }
+			auto const bytes = take(count * sizeof(Value));
+			if (bytes.size() != count * sizeof(Value)) { return false; }
+			if (count != 0) { std::memcpy(std::ranges::data(values), bytes.data(), bytes.size()); }
+			return true;
+		}
+
+		[[nodiscard]] bool atEnd() const { return m_offset == m_state.size(); }
+
+	private:
+		[[nodiscard]] std::span<std::byte const> take(std::size_t size);
+
+		std::span<std::byte const> m_state;
+		std::size_t m_offset{};
+	};
+
+	/**
+	 * \brief The last few frames of simulation state, for restarts, rewinding and rollback.
+	 * The newest state is kept whole; every snapshot is stored as its XOR with the state before it, with runs of zero
+	 * words (everything that did not change) left out. That is written into one preallocated byte ring and evicts the
+	 * oldest snapshots when the ring is full. Going back n frames decodes n deltas onto a copy of the newest state.
+	 */
+	class Ring
+	{
+	public:
+		struct Config
+		{
+			std::uint32_t capacity{120};         // Snapshots kept at most (two seconds at 60Hz)
+			std::size_t bytes{32ull << 20u};     // Ring for deltas; a capture needs up to 1.5x the state size free at once
+			std::size_t stateBytes{1ull << 20u}; // Expected state size, preallocated for the newest state
+		};
+
+		struct Stats
+		{
+			std::size_t stateBytes{};  // Newest state
+			std::size_t deltaBytes{};  // Its encoded delta
+			std::size_t storedBytes{}; // All deltas in the ring
+			std::uint32_t evictions{}; // Snapshots dropped to make room, since startup
+		};
+
+		explicit Ring(Config config);
+
+		/**
+		 * \brief Record frame's state (normally Writer output), newer than everything recorded so far.
+		 * \returns hash(state), computed in the same pass.
+		 */
+		std::uint64_t capture(std::uint64_t frame, std::span<std::byte const> state);
+
+		/**
+		 * \brief Reconstruct the state recorded for frame into out. Reuse out between calls: it grows to the largest state.
+		 * \returns False if frame is not in the ring (never recorded, or evicted).
+		 */
+		[[nodiscard]] bool restore(std::uint64_t frame, std::vector<std::byte> & out);
+
+		/**
+		 * \brief restore(), then forget every snapshot newer than frame: the next capture continues from it.
+		 */
+		[[nodiscard]] bool rollback(std::uint64_t frame, std::vector<std::byte> & out);
+
+		/**
+		 * \brief The hash capture() returned for frame, if it is still in the ring.
+		 */
+		[[nodiscard]] std::optional<std::uint64_t> hash(std::uint64_t frame) const;
+
+		[[nodiscard]] std::uint32_t size() const { return m_count; }
+
+		/**
+		 * \brief Oldest and newest frames in the ring; nothing if empty.
+		 */
+		[[nodiscard]] std::optional<std::uint64_t> oldest() const;
+
+		[[nodiscard]] std::optional<std::uint64_t> newest() const;
+
+		[[nodiscard]] Stats const & getStats() const { return m_stats; }
+
+	private:
+		struct Slot
+		{
+			std::uint64_t frame{};
+			std::uint64_t hash{};
+			std::size_t offset{};        // Words into m_buffer
+			std::size_t words{};         // Encoded size
+			std::size_t bytes{};         // Size of this frame's state
+			std::size_t previousBytes{}; // Size of the state the delta is against
+		};
+
+		[[nodiscard]] Slot const & slot(std::uint32_t age) const { return m_slots[(m_first + m_count - 1 - age) % m_slots.size()]; }
+
+		[[nodiscard]] std::optional<std::uint32_t> find(std::uint64_t frame) const;
+
+		[[nodiscard]] std::size_t allocate(std::size_t words);
+
+		void evictOldest();
+
+		std::vector<std::uint64_t> m_buffer;
+		std::size_t m_head{}; // Next free word
+		std::vector<Slot> m_slots;
+		std::uint32_t m_first{}; // Oldest slot
+		std::uint32_t m_count{};
+
+		std::vector<std::uint64_t> m_latest{}; // Newest state, zero padded to whole words
+		std::size_t m_latestBytes{};
+		Stats m_stats{};
+	};
+} // namespace bk::snapshot
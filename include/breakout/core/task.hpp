@@ -0,0 +1,158 @@
+#pragma once
+
+#include <cassert>
+#include <concepts>
+#include <coroutine>
+#include <exception>
+#include <optional>
+#include <utility>
+
+namespace bk
+{
+	template <typename Type = void>
+	class Task;
+
+	namespace detail
+	{
+		struct TaskPromiseBase
+		{
+			// Finishing hands control straight back to whoever awaited the task (symmetric transfer, so chains of nested
+			// tasks do not grow the stack), or to the resumer if nobody did.
+			struct FinalAwaiter
+			{
+				[[nodiscard]] bool await_ready() const noexcept { return false; }
+
+				template <typename Promise>
+				std::coroutine_handle<> await_suspend(std::coroutine_handle<Promise> const handle) const noexcept
+				{
+					if (auto const continuation = handle.promise().continuation) { return continuation; }
+					return std::noop_coroutine();
+				}
+
+				void await_resume() const noexcept {}
+			};
+
+			[[nodiscard]] std::suspend_always initial_suspend() const noexcept { return {}; }
+
+			[[nodiscard]] FinalAwaiter final_suspend() const noexcept { return {}; }
+
+			void unhandled_exception() noexcept { exception = std::current_exception(); }
+
+			void rethrow() const
+			{
+				if (exception) { std::rethrow_exception(exception); }
+			}
+
+			std::coroutine_handle<> continuation{};
+			std::exception_ptr exception{};
+		};
+
+		template <typename Type>
+		struct TaskPromise : TaskPromiseBase
+		{
+			Task<Type> get_return_object() noexcept;
+
+			template <typename Value>
+				requires std::convertible_to<Value &&, Type>
+			void return_value(Value && value)
+			{
+				result.emplace(std::forward<Value>(value));
+			}
+
+			Type take()
+			{
+				rethrow();
+				return std::move(*result);
+			}
+
+			std::optional<Type> result{};
+		};
+
+		template <>
+		struct TaskPromise<void> : TaskPromiseBase
+		{
+			Task<void> get_return_object() noexcept;
+
+			void return_void() const noexcept {}
+
+			void take() const { rethrow(); }
+		};
+	} // namespace detail
+
+	/**
+	 * \brief Lazily started coroutine producing a Type. Nothing runs until the task is awaited (by another task) or handed
+	 * to Scheduler::spawn; awaiting it yields its result or rethrows what it threw.
+	 * Where a task resumes after suspending depends on what it awaited: see the Scheduler awaiters.
+	 */
+	template <typename Type>
+	class [[nodiscard]] Task
+	{
+	public:
+		using promise_type = detail::TaskPromise<Type>;
+		using Handle       = std::coroutine_handle<promise_type>;
+
+		Task() = default;
+
+		explicit Task(Handle const handle) : m_handle(handle) {}
+
+		Task(Task && other) noexcept : m_handle(std::exchange(other.m_handle, {})) {}
+
+		Task & operator=(Task && other) noexcept
+		{
+			if (this != &other)
+			{
+				if (m_handle) { m_handle.destroy(); }
+				m_handle = std::exchange(other.m_handle, {});
+			}
+			return *this;
+		}
+
+		Task(Task const &) = delete;
+
+		Task & operator=(Task const &) = delete;
+
+		/**
+		 * \brief Destroys the coroutine, finished or not; an unfinished one must not be queued anywhere to be resumed.
+		 */
+		~Task()
+		{
+			if (m_handle) { m_handle.destroy(); }
+		}
+
+		[[nodiscard]] bool isDone() const { return !m_handle || m_handle.done(); }
+
+		[[nodiscard]] Handle handle() const { return m_handle; }
+
+		auto operator co_await() const noexcept
+		{
+			struct Awaiter
+			{
+				Handle handle;
+
+				[[nodiscard]] bool await_ready() const noexcept { return handle.done(); }
+
+				std::coroutine_handle<> await_suspend(std::coroutine_handle<> const awaiting) const noexcept
+				{
+					handle.promise().continuation = awaiting;
+					return handle;
+				}
+
+				Type await_resume() const { return handle.promise().take(); }
+			};
+
+			assert(m_handle);
+			return Awaiter{m_handle};
+		}
+
+	private:
+		Handle m_handle{};
+	};
+
+	template <typename Type>
+	Task<Type> detail::TaskPromise<Type>::get_return_object() noexcept
+	{
+		return Task<Type>{Task<Type>::Handle::from_promise(*this)};
+	}
+
+	inline Task<void> detail::TaskPromise<void>::get_return_object() noexcept { return Task<void>{Task<void>::Handle::from_promise(*this)}; }
+} // namespace bk
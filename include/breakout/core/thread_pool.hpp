@@ -0,0 +1,77 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace bk
+{
+	/**
+	 * \brief Fixed size pool of worker threads consuming a shared FIFO job queue.
+	 * Jobs still queued when the pool is destroyed are dropped.
+	 */
+	class ThreadPool
+	{
+	public:
+		using Job = std::function<void()>;
+
+		struct Stats
+		{
+			std::uint64_t jobs{};  // Finished since startup
+			std::int64_t busyNs{}; // Summed over workers; divide a delta by elapsed time and workerCount() for utilisation
+			std::size_t queued{};  // Waiting for a worker right now
+		};
+
+		/**
+		 * \brief Number of workers used when none is requested: one per hardware thread, minus the main thread.
+		 */
+		static std::uint32_t defaultWorkerCount();
+
+		explicit ThreadPool(std::uint32_t workerCount = defaultWorkerCount());
+
+		ThreadPool(ThreadPool &&) = delete;
+
+		ThreadPool & operator=(ThreadPool &&) = delete;
+
+		ThreadPool(ThreadPool const &) = delete;
+
+		ThreadPool & operator=(ThreadPool const &) = delete;
+
+		~ThreadPool() = default;
+
+		/**
+		 * \brief Queue a job to be run on any worker.
+		 */
+		void enqueue(Job job);
+
+		/**
+		 * \brief Run fn(i) for every i in [0, count) across the workers and the calling thread, returning once all calls are done.
+		 * The calling thread keeps claiming indices itself, so this is safe to call from inside a job.
+		 */
+		void parallelFor(std::uint32_t count, std::function<void(std::uint32_t)> const & fn);
+
+		[[nodiscard]] std::uint32_t workerCount() const { return static_cast<std::uint32_t>(m_workers.size()); }
+
+		/**
+		 * \brief Thread-safe. Job time only counts jobs run by workers, not parallelFor indices claimed by the caller.
+		 */
+		[[nodiscard]] Stats getStats() const;
+
+	private:
+		void run(std::stop_token const & stop);
+
+		mutable std::mutex m_mutex{};
+		std::condition_variable_any m_cv{};
+		std::deque<Job> m_jobs{};
+		std::atomic<std::uint64_t> m_finished{};
+		std::atomic<std::int64_t> m_busyNs{};
+
+		// Declared last so the workers are joined before the queue they read from is destroyed.
+		std::vector<std::jthread> m_workers{};
+	};
+} // namespace bk
@@ -0,0 +1,106 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+#include <glm/mat4x4.hpp>
+#include <glm/vec3.hpp>
+#include <glm/vec4.hpp>
+
+namespace bk
+{
+	/**
+	 * \brief Six planes (normal in xyz, distance in w), normalised and facing inwards: p is on the inner side of a plane
+	 * when dot(plane.xyz, p) + plane.w >= 0.
+	 */
+	struct Frustum
+	{
+		enum Plane : std::uint8_t
+		{
+			eLeft,
+			eRight,
+			eBottom,
+			eTop,
+			eNear,
+			eFar,
+			eCOUNT_
+		};
+
+		/**
+		 * \brief Extract the planes of a view-projection matrix with Vulkan clip space depth (0 <= z <= w).
+		 * Planes are in the space the matrix transforms from: world space for a view-projection.
+		 */
+		[[nodiscard]] static Frustum fromMatrix(glm::mat4 const & viewProj);
+
+		[[nodiscard]] bool intersectsSphere(glm::vec3 const & center, float radius) const;
+
+		/**
+		 * \brief Conservative: boxes near a corner of the frustum, outside it but not wholly behind a single plane, pass.
+		 */
+		[[nodiscard]] bool intersectsBox(glm::vec3 const & center, glm::vec3 const & extent) const;
+
+		std::array<glm::vec4, eCOUNT_> planes{};
+	};
+
+	/**
+	 * \brief Bounding spheres in structure-of-arrays layout; all spans the same size.
+	 */
+	struct SphereBounds
+	{
+		std::span<float const> x{};
+		std::span<float const> y{};
+		std::span<float const> z{};
+		std::span<float const> radius{};
+	};
+
+	/**
+	 * \brief Axis aligned bounding boxes as centre and half extent, in structure-of-arrays layout; all spans the same size.
+	 */
+	struct BoxBounds
+	{
+		std::span<float const> centerX{};
+		std::span<float const> centerY{};
+		std::span<float const> centerZ{};
+		std::span<float const> extentX{};
+		std::span<float const> extentY{};
+		std::span<float const> extentZ{};
+	};
+
+	/**
+	 * \brief 2D rectangles as min and max corners, in structure-of-arrays layout; all spans the same size.
+	 */
+	struct RectBounds
+	{
+		std::span<float const> minX{};
+		std::span<float const> minY{};
+		std::span<float const> maxX{};
+		std::span<float const> maxY{};
+	};
+
+	/**
+	 * \brief Batched culling: test every bound, writing the indices of those that may be visible to visible, in ascending
+	 * order. The result feeds SpriteBatch::submit() (or any other batcher) directly.
+	 * Bounds are tested 8 at a time with AVX2 where the build targets it (x86-64-v3), with a scalar fallback elsewhere; the
+	 * indices are compacted with a permute rather than a branch per element, so cost does not depend on how many pass.
+	 *
+	 * \param visible At least as many elements as there are bounds.
+	 * \returns The number of indices written.
+	 */
+	std::size_t cullSpheres(Frustum const & frustum, SphereBounds const & bounds, std::span<std::uint32_t> visible);
+
+	std::size_t cullBoxes(Frustum const & frustum, BoxBounds const & bounds, std::span<std::uint32_t> visible);
+
+	/**
+	 * \brief As cullSpheres(), for 2D content against a visible rectangle, e.g. sprites against the area an orthographic
+	 * camera sees. Rectangles touching its edge count as visible.
+	 * \param view min x, min y, max x, max y.
+	 */
+	std::size_t cullRects(glm::vec4 const & view, RectBounds const & bounds, std::span<std::uint32_t> visible);
+
+	/**
+	 * \returns Whether the cull functions use the AVX2 kernels in this build.
+	 */
+	bool isCullingSimd();
+} // namespace bk
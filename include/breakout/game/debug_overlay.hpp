@@ -0,0 +1,123 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string_view>
+
+#include <vulkan/vulkan.h>
+
+#include "breakout/gpu/imgui_renderer.hpp"
+
+union SDL_Event;
+struct ImGuiContext;
+
+namespace bk
+{
+	class Profiler;
+	class ThreadPool;
+} // namespace bk
+
+namespace bk::gpu
+{
+	struct Device;
+	class FrameRingAllocator;
+	class TextureTable;
+	class UploadQueue;
+} // namespace bk::gpu
+
+namespace game
+{
+	/**
+	 * \brief In-game performance overlay, toggled with F3: frame time graph and percentiles, the last profiled frame's CPU and
+	 * GPU zones, heap allocations, logger counters, VMA heap budgets and job system utilisation.
+	 * Hidden, it costs a store per frame (the frame time history) and nothing else: no ImGui frame, no render pass. Visible,
+	 * its own cost shows up as "overlay" zones (zone_name_v), CPU and GPU, which it reports on its first line.
+	 */
+	class DebugOverlay
+	{
+	public:
+		static constexpr std::string_view zone_name_v{"overlay"};
+		static constexpr std::size_t history_v{240}; // Frame times kept for the graph and percentiles
+
+		/**
+		 * \brief What the overlay reports on; all must outlive build().
+		 */
+		struct Sources
+		{
+			bk::Profiler const & profiler;
+			bk::ThreadPool const & jobs;
+			bk::gpu::Device const & device;
+		};
+
+		/**
+		 * \brief Creates the ImGui context and renderer (whose font atlas goes out with the next upload batch).
+		 */
+		DebugOverlay(bk::gpu::Device const & device, bk::gpu::UploadQueue & uploads, bk::gpu::TextureTable & textures);
+
+		DebugOverlay(DebugOverlay &&) = delete;
+
+		DebugOverlay & operator=(DebugOverlay &&) = delete;
+
+		DebugOverlay(DebugOverlay const &) = delete;
+
+		DebugOverlay & operator=(DebugOverlay const &) = delete;
+
+		/**
+		 * \brief The device must be idle.
+		 */
+		~DebugOverlay();
+
+		/**
+		 * \brief F3 toggles visibility; while visible, mouse events are fed to ImGui.
+		 * \returns True if the overlay wants the event for itself (the mouse is over one of its windows).
+		 */
+		bool handleEvent(SDL_Event const & event);
+
+		void setVisible(bool visible);
+
+		[[nodiscard]] bool isVisible() const { return m_visible; }
+
+		/**
+		 * \brief Frame thread, every frame, visible or not.
+		 */
+		void addFrameTime(std::chrono::nanoseconds const time)
+		{
+			m_frameTimesMs[m_frameCount++ % history_v] = std::chrono::duration<float, std::milli>{time}.count();
+		}
+
+		/**
+		 * \brief Lay out this frame's UI and copy its geometry to ring memory. Does nothing while hidden.
+		 * \param display Window size, which mouse coordinates are in.
+		 * \param framebuffer Size of the image record() draws into.
+		 */
+		void build(Sources const & sources, VkExtent2D display, VkExtent2D framebuffer, bk::gpu::FrameRingAllocator & ring);
+
+		/**
+		 * \brief Draw what build() produced. Inside dynamic rendering to the framebuffer; pipeline uses pipelineLayout().
+		 */
+		void record(VkCommandBuffer cmd, VkPipeline pipeline) const;
+
+		[[nodiscard]] VkPipelineLayout pipelineLayout() const { return m_renderer->layout(); }
+
+	private:
+		void drawFrameTimes() const;
+
+		void drawSystems(Sources const & sources);
+
+		ImGuiContext * m_context{};
+		std::unique_ptr<bk::gpu::ImGuiRenderer> m_renderer{};
+		bool m_visible{false};
+		bool m_prepared{false};
+
+		std::array<float, history_v> m_frameTimesMs{};
+		std::uint64_t m_frameCount{};
+
+		std::chrono::steady_clock::time_point m_lastBuild{};
+		// Job utilisation is averaged over a quarter second, sampled from the pool's busy time
+		std::chrono::steady_clock::time_point m_jobSampleTime{};
+		std::int64_t m_jobSampleBusyNs{};
+		float m_jobUtilisation{};
+	};
+} // namespace game
@@ -0,0 +1,130 @@
+#pragma once
+
+#include <breakout/gpu/vk_types.hpp>
+
+#include <glm/vec2.hpp>
+#include <glm/vec4.hpp>
+
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <span>
+#include <vector>
+
+namespace bk::gpu {
+    struct Device;
+}
+
+namespace game {
+    class LoadContext;
+
+    /**
+     * \brief Signed distance field glyphs for printable ASCII, baked from a TrueType font, and the metrics to lay them out.
+     * Sizes are in ems (multiples of the requested text size), so one atlas serves every size: the distance field keeps
+     * edges sharp when scaled up to a few times the bake size, and antialiased when scaled down.
+     */
+    class GlyphAtlas {
+    public:
+        static constexpr char first_v{' '};
+        static constexpr char last_v{'~'};
+        static constexpr std::size_t count_v{last_v - first_v + 1};
+
+        struct Config {
+            float pixelHeight{48.0f}; // Bake size; the atlas grows with its square
+            int padding{6}; // Pixels of distance around each glyph: the furthest an outline or glow can reach
+            std::uint32_t width{512}; // Atlas width; the height is what the glyphs need, rounded up to a power of two
+        };
+
+        struct Glyph {
+            glm::vec2 offset{}; // Top left of the quad from the pen position on the baseline
+            glm::vec2 size{}; // Zero for glyphs with nothing to draw (space)
+            glm::vec4 uvRect{};
+            float advance{};
+        };
+
+        /**
+         * \brief Rasterize the distance field of every glyph and pack them into one R8 image.
+         * \returns Nothing (after logging why) if ttf is not a font stb_truetype can read, or the glyphs do not fit.
+         */
+        static std::optional<GlyphAtlas> bake(std::span<std::byte const> ttf, Config const & config);
+
+        /**
+         * \brief Characters outside the atlas map to '?'.
+         */
+        [[nodiscard]] Glyph const & glyph(char c) const {
+            return m_glyphs[c >= first_v && c <= last_v ? static_cast<std::size_t>(c - first_v) : static_cast<std::size_t>('?' - first_v)];
+        }
+
+        /**
+         * \brief Pen adjustment between two characters, added to the first one's advance.
+         */
+        [[nodiscard]] float kerning(char left, char right) const;
+
+        [[nodiscard]] float ascent() const { return m_ascent; }
+
+        [[nodiscard]] float lineHeight() const { return m_lineHeight; }
+
+        /**
+         * \brief Unique per bake, including rebakes of the same file: TextCache layouts are only valid for the id they used.
+         */
+        [[nodiscard]] std::uint64_t id() const { return m_id; }
+
+        [[nodiscard]] VkExtent3D extent() const { return {m_width, m_height, 1}; }
+
+        /**
+         * \brief R8 distance values, 128 on the outline; empty once released.
+         */
+        [[nodiscard]] std::span<std::uint8_t const> pixels() const { return m_pixels; }
+
+        void releasePixels() { m_pixels = {}; }
+
+    private:
+        std::array<Glyph, count_v> m_glyphs{};
+        std::vector<float> m_kerning{}; // count_v x count_v, in ems; empty if the font has none
+        float m_ascent{};
+        float m_lineHeight{};
+        std::uint64_t m_id{};
+        std::uint32_t m_width{};
+        std::uint32_t m_height{};
+        std::vector<std::uint8_t> m_pixels{};
+    };
+
+    /**
+     * \brief A GlyphAtlas on the GPU, addressed by shaders through its slot in the bindless texture table. Drawn with
+     * shaders/text.frag, which turns the distance into coverage.
+     */
+    class Font {
+    public:
+        /**
+         * \brief ResourceManager loader: bake a .ttf or .otf file, queue the atlas upload and allocate its slot.
+         * \returns null (after logging why) if the font cannot be read or the texture table is full.
+         */
+        static std::shared_ptr<Font const> load(LoadContext const & context, bk::gpu::Device const & device, GlyphAtlas::Config const & config);
+
+        Font(bk::gpu::Device const & device, GlyphAtlas atlas, bk::gpu::AllocatedImage image, std::uint32_t slot);
+
+        Font(Font &&) = delete;
+
+        Font & operator=(Font &&) = delete;
+
+        Font(Font const &) = delete;
+
+        Font & operator=(Font const &) = delete;
+
+        ~Font();
+
+        /**
+         * \brief Metrics only: the pixels are released once uploaded.
+         */
+        [[nodiscard]] GlyphAtlas const & atlas() const { return m_atlas; }
+
+        [[nodiscard]] std::uint32_t slot() const { return m_slot; }
+
+    private:
+        bk::gpu::Device const * m_device{};
+        GlyphAtlas m_atlas;
+        bk::gpu::AllocatedImage m_image{};
+        std::uint32_t m_slot{};
+    };
+}
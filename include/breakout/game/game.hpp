@@ -2,18 +2,80 @@
 
 
 #include <breakout/gpu/vk_types.hpp>
+#include <breakout/gpu/vk_device.hpp>
+#include <breakout/gpu/command_recorder.hpp>
+#include <breakout/gpu/frame_capture.hpp>
+#include <breakout/gpu/frame_ring_allocator.hpp>
+#include <breakout/gpu/gpu_profiler.hpp>
+#include <breakout/gpu/pipeline_cache.hpp>
+#include <breakout/gpu/render_graph.hpp>
+#include <breakout/gpu/upload_queue.hpp>
+#include <breakout/gpu/sprite_batch.hpp>
+#include <breakout/gpu/texture_table.hpp>
+#include <breakout/core/frame_arena.hpp>
+#include <breakout/core/metrics.hpp>
+#include <breakout/core/profiler.hpp>
+#include <breakout/core/scheduler.hpp>
+#include <breakout/core/thread_pool.hpp>
+#include <breakout/game/debug_overlay.hpp>
+#include <breakout/game/resource_manager.hpp>
+#include <breakout/game/text_cache.hpp>
+#include <breakout/soft/rasterizer.hpp>
+
+#include <array>
+#include <chrono>
+#include <filesystem>
+#include <optional>
+#include <vector>
 
 struct SDL_Window;
+union SDL_Event;
 
 namespace brk {
     constexpr VkExtent2D default_window_size{ 1700 , 900 };
+    constexpr VkFormat draw_image_format_v{ VK_FORMAT_R8G8B8A8_UNORM };
+    constexpr std::uint32_t max_frames_in_flight_v{ 4 };
+
+    // Everything one frame in flight records into; reused once its fence has signalled.
+    struct FrameData {
+        VkCommandPool commandPool{};
+        VkCommandBuffer commandBuffer{};
+        VkFence renderFence{};
+        VkSemaphore swapchainSemaphore{}; // Signalled when the acquired swapchain image may be written
+    };
 
     struct  Game {
         struct Config {
             VkExtent2D startupWindowSize{ default_window_size };
             std::string_view startupWindowTitle{ "Breakout" };
-            bool enableResizableWindow{ false }; // Keep this false until window resizing works
+            bool enableResizableWindow{ true }; // The swapchain follows the window size without waiting for the device
             bool enableValidationLayers{ false };
+            bool enableHotReload{ true }; // Reload assets when their files change on disk (Linux only for now)
+            bool headless{ false }; // No window or swapchain: run headlessFrameCount frames and exit (works on lavapipe)
+            std::uint32_t headlessFrameCount{ 300 };
+            std::filesystem::path cacheDirectory{ "cache" }; // Pipeline cache and other derived data
+            VkDeviceSize frameRingCapacity{ 4ull << 20u }; // Per-frame uniform/vertex bytes; size it from the high-water mark logged at exit
+            VkDeviceSize uploadStagingCapacity{ 64ull << 20u }; // Staging ring for texture and mesh uploads
+            std::size_t frameArenaCapacity{ 256ull << 10u }; // CPU scratch memory per frame; grows to the largest frame if exceeded
+            VkPresentModeKHR presentMode{ VK_PRESENT_MODE_FIFO_KHR }; // MAILBOX: low latency without tearing; IMMEDIATE: lowest, tears. Falls back to FIFO
+            std::uint32_t framesInFlight{ 2 }; // Frames the CPU may run ahead of the GPU (1..max_frames_in_flight_v): fewer is less latency, less overlap
+            bool justInTimeInput{ false }; // Sleep off the time a frame would spend blocked on its fence before sampling input, not after
+            double inputWaitMarginMs{ 1.0 }; // Sample input this much earlier than predicted, so a slow frame does not miss its present
+            std::uint32_t textureTableCapacity{ 4096 }; // Bindless texture slots; clamped to what the device supports
+            std::uint32_t recordThreadCount{ 4 }; // Sprite draws are split into this many secondary command buffers, recorded in parallel
+            std::uint32_t profileReportInterval{ 0 }; // Log the CPU/GPU zones of every n-th frame; 0 disables the report
+            bool dumpRenderGraph{ false }; // Log the first frame's compiled render graph: passes, barriers, transient placement
+            bool softwareRenderer{ false }; // No window or Vulkan device: sprites are rasterized on the CPU for headlessFrameCount frames
+            std::filesystem::path softwareOutput{}; // Software renderer only: write the last frame here as a PNG, e.g. for golden images
+            std::filesystem::path captureDirectory{ "captures" }; // Frames captured with F12 or captureInterval are written here
+            bk::gpu::FrameCapture::Format captureFormat{ bk::gpu::FrameCapture::Format::ePng };
+            std::uint32_t captureInterval{ 0 }; // Capture every n-th frame; 0 only captures on F12
+            std::chrono::milliseconds metricsInterval{ 0 }; // Publish frame counters and latency histograms this often; 0 disables
+            std::filesystem::path metricsFile{}; // Where to publish them, in Prometheus text format; empty logs them instead
+            bool showOverlay{ false }; // Start with the performance overlay open; F3 toggles it
+            std::chrono::microseconds taskBudget{ 2000 }; // Time per frame for resuming coroutine tasks; what does not fit carries over
+            bool startupReport{ false }; // Log the critical path through the startup tasks once init is done
+            std::filesystem::path font{}; // TrueType or OpenType font for HUD text, baked into a distance field atlas at startup; empty draws no text
         } config{};
 
 
@@ -26,20 +88,163 @@ namespace brk {
         //initializes everything in the engine
         bool init();
 
+        //initializes SDL and creates the window (windowed only)
+        bool initWindow();
+
+        //loads the shaders the built-in pipelines are made of
+        bool initShaders();
+
+        //creates the sprite pipeline layout and the fallback pipeline; needs the pipeline cache, shaders and texture table
+        bool initPipelines();
+
+        //creates the swapchain and its images (windowed only); oldSwapchain is retired by the driver, not destroyed
+        bool initSwapchain(VkSwapchainKHR oldSwapchain = VK_NULL_HANDLE);
+
+        //replaces the swapchain with one the window's current size, keeping the old one until no frame in flight uses it
+        bool recreateSwapchain();
+
+        //destroys retired swapchains whose frames are done (all of them when all is set, with the device idle)
+        void destroyRetiredSwapchains(bool all);
+
+        void destroySwapchain();
+
+        //creates the bindless texture table and its default texture
+        void initTextures();
+
+        //creates the per-frame command buffers, fences, the frame ring allocator, the command recorder, the render graph and the GPU profiler
+        void initFrames();
+
+        FrameData& getCurrentFrame() { return m_frames[static_cast<std::uint32_t>(m_frameNumber) % m_framesInFlight]; }
+
         //shuts down the engine
         void cleanup();
 
         //draw loop
         void draw();
 
+        //draws the frame with m_rasterizer instead of the GPU
+        void drawSoftware();
+
+        //submits this frame's sprites to m_sprites
+        void drawScene();
+
+        //per frame bookkeeping before draw: retire uploads, swap in reloaded resources, apply input
+        void update();
+
+        //records an SDL input event in m_input for the next update
+        void handleInput(SDL_Event const & event);
+
         //run the main loop
         void run();
 
+        //one iteration of the main loop: update and draw, timed for the resize report
+        void frame();
+
+        //SDL event watch: sees events as they arrive, including from inside modal resize loops where run() is stuck
+        static bool onEvent(void * userdata, SDL_Event * event);
+
         struct Deleter
         {
             void operator()(SDL_Window * ptr) const;
         };
 
         std::unique_ptr<SDL_Window, Deleter> m_window;
+
+        std::unique_ptr<bk::Profiler> m_profiler;
+        // Must outlive m_resources, which may still have reload jobs queued on it.
+        std::unique_ptr<bk::ThreadPool> m_jobs;
+        // Scratch memory for the frame thread, reset at the end of every frame
+        std::unique_ptr<bk::FrameArena> m_frameArena;
+        std::unique_ptr<bk::metrics::Publisher> m_metrics;
+        std::unique_ptr<bk::gpu::Device> m_device;
+        // Must outlive m_resources, whose loaders upload through it.
+        std::unique_ptr<bk::gpu::UploadQueue> m_uploads;
+        // Must outlive m_resources, whose textures own slots in it.
+        std::unique_ptr<bk::gpu::TextureTable> m_textures;
+        // 1x1 white: what unused slots and untextured sprites (slot 0) sample
+        bk::gpu::AllocatedImage m_defaultTexture{};
+        game::ResourceManager m_resources;
+        // Coroutine tasks (loading, transitions, scripted sequences), resumed from update(); declared after what they use
+        std::unique_ptr<bk::Scheduler> m_scheduler;
+        std::unique_ptr<bk::gpu::PipelineCache> m_pipelines;
+
+        std::uint32_t m_framesInFlight{ 2 };
+        std::vector<FrameData> m_frames;
+        std::unique_ptr<bk::gpu::FrameRingAllocator> m_frameRing;
+        std::unique_ptr<bk::gpu::CommandRecorder> m_recorder;
+        std::unique_ptr<bk::gpu::RenderGraph> m_graph;
+        std::unique_ptr<bk::gpu::GpuProfiler> m_gpuProfiler;
+        std::unique_ptr<bk::gpu::FrameCapture> m_capture;
+        // Performance overlay (F3); drawn over the frame after the capture copy, so captures never contain it
+        std::unique_ptr<game::DebugOverlay> m_overlay;
+
+        // Frames are drawn into a render graph transient this size, then blitted to the swapchain image when there is a window
+        VkExtent2D m_drawExtent{};
+
+        VkSwapchainKHR m_swapchain{};
+        VkFormat m_swapchainImageFormat{};
+        VkExtent2D m_swapchainExtent{};
+        std::vector<VkImage> m_swapchainImages;
+        std::vector<VkImageView> m_swapchainImageViews;
+        // One per swapchain image rather than per frame: presentation may still wait on it when the frame slot comes around again
+        std::vector<VkSemaphore> m_renderSemaphores;
+        // Out of date, suboptimal or resized: recreate before the next acquire
+        bool m_swapchainDirty{ false };
+        bool m_inFrame{ false };
+
+        // Replaced swapchains, destroyed once the frames submitted before the replacement are done
+        struct RetiredSwapchain {
+            VkSwapchainKHR swapchain{};
+            std::vector<VkImageView> imageViews;
+            std::vector<VkSemaphore> renderSemaphores;
+            std::uint64_t frame{}; // First frame that used the replacement
+        };
+        std::vector<RetiredSwapchain> m_retiredSwapchains;
+
+        // Frame times while the window is being resized, logged once it has settled
+        struct ResizeStats {
+            std::uint32_t recreations{};
+            std::uint32_t frames{};
+            double worstFrameMs{};
+            double worstRecreateMs{};
+            std::chrono::steady_clock::time_point lastRecreate{};
+        };
+        ResizeStats m_resize{};
+
+        // Input gathered since the last update
+        struct InputState {
+            float paddleX{ 0.5f }; // Fraction of the draw width
+            int paddleDirection{}; // Arrow keys held: -1, 0 or 1
+            std::uint64_t oldestEventNs{}; // SDL timestamp of the oldest event not yet applied; 0 if there is none
+        };
+        InputState m_input{};
+        std::chrono::steady_clock::time_point m_lastUpdate{};
+        // SDL timestamp of the oldest input the current frame applied; its latency to the present call goes to the profiler
+        std::uint64_t m_frameInputNs{};
+
+        // Just-in-time input: recent slack (the sleep before input plus the time still spent blocked on fences and
+        // acquisition), the sleep derived from it, and the sleep the current frame actually took
+        std::array<double, 16> m_recentWaitsMs{};
+        double m_inputWaitMs{};
+        double m_inputSleptMs{};
+
+        bk::gpu::SpriteBatch m_sprites;
+        // Software renderer only; no device exists alongside it
+        std::unique_ptr<bk::soft::Rasterizer> m_rasterizer;
+        std::vector<bk::gpu::SpriteInstance> m_softwareInstances;
+        game::ResourceId m_spriteVertex{};
+        game::ResourceId m_spriteFragment{};
+        game::ResourceId m_fallbackFragment{};
+        game::ResourceId m_imguiVertex{};
+        game::ResourceId m_textFragment{};
+        // game::Font for HUD text; unset without Config::font
+        std::optional<game::ResourceId> m_font;
+        // Layouts of the HUD strings, so only the ones that changed are laid out again
+        game::TextCache m_text;
+
+        // Shared by all sprite pipelines: the texture table in set 0, bk::gpu::SpritePushConstants
+        VkPipelineLayout m_spriteLayout{};
+        // Bound while a sprite pipeline is still compiling in the background
+        VkPipeline m_fallbackPipeline{};
     };
 }
@@ -0,0 +1,141 @@
+#pragma once
+
+#include <glm/vec2.hpp>
+#include <glm/vec3.hpp>
+
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <optional>
+#include <span>
+#include <string_view>
+#include <vector>
+
+#include "breakout/core/mapped_file.hpp"
+#include "breakout/gpu/vk_types.hpp"
+
+namespace bk
+{
+	class ThreadPool;
+} // namespace bk
+
+namespace bk::gpu
+{
+	struct Device;
+} // namespace bk::gpu
+
+namespace game
+{
+	class LoadContext;
+
+	/**
+	 * \brief Vertex layout shared by every imported mesh, the .bkmesh cache and the vertex shaders.
+	 */
+	struct Vertex
+	{
+		glm::vec3 position{};
+		glm::vec3 normal{};
+		glm::vec2 uv{};
+	};
+
+	static_assert(sizeof(Vertex) == 32);
+
+	/**
+	 * \brief Indexed triangle list.
+	 */
+	struct MeshData
+	{
+		std::vector<Vertex> vertices{};
+		std::vector<std::uint32_t> indices{};
+	};
+
+	/**
+	 * \brief Immutable mesh, backed either by a mapped .bkmesh cache file or by freshly imported data.
+	 * For cached meshes the spans point straight into the mapping, so they can be copied into a staging buffer as is.
+	 */
+	class Mesh
+	{
+	public:
+		/**
+		 * \brief Appended to a source path to get the path of its cache file.
+		 */
+		static constexpr std::string_view cache_extension_v{".bkmesh"};
+
+		/**
+		 * \brief Bumped whenever Vertex or the import pipeline changes, invalidating existing cache files.
+		 */
+		static constexpr std::uint32_t cache_version_v{1};
+
+		/**
+		 * \brief Load an .obj, .gltf or .glb file through its cache.
+		 * A missing or stale cache is rebuilt by importing the source on the given pool; otherwise the cache is mapped.
+		 * \returns null if the source could not be imported.
+		 */
+		static std::shared_ptr<Mesh const> load(std::filesystem::path const & source, bk::ThreadPool & pool);
+
+		[[nodiscard]] static std::filesystem::path cachePath(std::filesystem::path const & source);
+
+		explicit Mesh(MeshData data);
+
+		explicit Mesh(bk::MappedFile file, std::span<Vertex const> vertices, std::span<std::uint32_t const> indices);
+
+		[[nodiscard]] std::span<Vertex const> vertices() const { return m_vertices; }
+
+		[[nodiscard]] std::span<std::uint32_t const> indices() const { return m_indices; }
+
+		[[nodiscard]] bool isMapped() const { return m_file.has_value(); }
+
+	private:
+		std::optional<bk::MappedFile> m_file{};
+		MeshData m_data{};
+		std::span<Vertex const> m_vertices{};
+		std::span<std::uint32_t const> m_indices{};
+	};
+
+	/**
+	 * \brief A Mesh in device local memory: vertices in a storage buffer that shaders pull through its device address,
+	 * as the sprite shaders do, and indices in an index buffer.
+	 */
+	class GpuMesh
+	{
+	public:
+		struct Buffer
+		{
+			VkBuffer buffer{};
+			VmaAllocation allocation{};
+		};
+
+		/**
+		 * \brief ResourceManager loader: load the source through its .bkmesh cache (importing it on pool if needed) and
+		 * queue the upload of both arrays. A cached mesh is copied from the mapping into staging memory, without reading
+		 * it into vectors first; the mapping is released once the upload is queued.
+		 * \returns null (after logging why) if the mesh cannot be loaded or is empty.
+		 */
+		static std::shared_ptr<GpuMesh const> load(LoadContext const & context, bk::gpu::Device const & device, bk::ThreadPool & pool);
+
+		GpuMesh(bk::gpu::Device const & device, Buffer vertices, Buffer indices, std::uint32_t indexCount);
+
+		GpuMesh(GpuMesh &&) = delete;
+
+		GpuMesh & operator=(GpuMesh &&) = delete;
+
+		GpuMesh(GpuMesh const &) = delete;
+
+		GpuMesh & operator=(GpuMesh const &) = delete;
+
+		~GpuMesh();
+
+		[[nodiscard]] VkDeviceAddress vertexAddress() const { return m_vertexAddress; }
+
+		[[nodiscard]] VkBuffer indexBuffer() const { return m_indices.buffer; }
+
+		[[nodiscard]] std::uint32_t indexCount() const { return m_indexCount; }
+
+	private:
+		bk::gpu::Device const * m_device{};
+		Buffer m_vertices{};
+		Buffer m_indices{};
+		VkDeviceAddress m_vertexAddress{};
+		std::uint32_t m_indexCount{};
+	};
+} // namespace game
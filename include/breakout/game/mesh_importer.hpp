@@ -0,0 +1,27 @@
+#pragma once
+
+#include <filesystem>
+#include <optional>
+#include <span>
+
+#include "breakout/game/mesh.hpp"
+
+namespace game::mesh_import
+{
+	/**
+	 * \brief Parse an .obj (tinyobjloader) or .gltf/.glb (fastgltf) file, then weld and optimize it.
+	 * All triangle primitives are merged into one mesh; glTF node transforms are not applied.
+	 */
+	std::optional<MeshData> importFile(std::filesystem::path const & path, bk::ThreadPool & pool);
+
+	/**
+	 * \brief Turn a triangle soup (three vertices per triangle) into an indexed mesh with bitwise identical vertices merged.
+	 * Vertices are split into hash shards that are deduplicated in parallel.
+	 */
+	MeshData weld(std::span<Vertex const> corners, bk::ThreadPool & pool);
+
+	/**
+	 * \brief Reorder triangles for post-transform vertex cache hits (Forsyth), then vertices in order of first use.
+	 */
+	void optimize(MeshData & mesh);
+} // namespace game::mesh_import
@@ -1 +1,270 @@
-﻿#pragma once
+#pragma once
+
+#include <cassert>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <string>
+#include <typeinfo>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include <vulkan/vulkan.h>
+
+#include "breakout/core/file_watcher.hpp"
+#include "breakout/core/scheduler.hpp"
+#include "breakout/stl/string_id.hpp"
+
+namespace bk
+{
+	class ThreadPool;
+} // namespace bk
+
+namespace bk::gpu
+{
+	class TextureTable;
+	class UploadQueue;
+	enum struct UploadTicket : std::uint64_t;
+} // namespace bk::gpu
+
+namespace game
+{
+	namespace detail
+	{
+		struct ReloadBatch;
+	} // namespace detail
+
+	/**
+	 * \brief Strongly typed handle to a resource registered with the ResourceManager.
+	 */
+	enum struct ResourceId : std::uint32_t
+	{
+	};
+
+	class ResourceManager;
+
+	/**
+	 * \brief Passed to loaders.
+	 * Dependencies resolve to the version that will be swapped in together with the resource being loaded.
+	 */
+	class LoadContext
+	{
+	public:
+		[[nodiscard]] std::filesystem::path const & path() const { return m_path; }
+
+		template <typename Type>
+		[[nodiscard]] std::shared_ptr<Type const> dependency(ResourceId id) const
+		{
+			return std::static_pointer_cast<Type const>(resolve(id, typeid(Type)));
+		}
+
+		/**
+		 * \brief Queue for GPU data; requires ResourceManager::setUploadQueue.
+		 */
+		[[nodiscard]] bk::gpu::UploadQueue & uploads() const;
+
+		/**
+		 * \brief Hold the resource back until an upload it made has completed: reloads are swapped in only then, and
+		 * ResourceManager::isReady reports false for the initial load until then.
+		 */
+		void waitFor(bk::gpu::UploadTicket ticket) const;
+
+		/**
+		 * \brief Put view (in SHADER_READ_ONLY_OPTIMAL) in the bindless texture table; requires ResourceManager::setTextureTable.
+		 * The slot belongs to the version being loaded: it is freed once that version has been replaced and the frames in
+		 * flight are done with it, or right away if the load fails.
+		 * \param nearest Nearest instead of linear filtering.
+		 * \returns Nothing (after logging) if the table is full.
+		 */
+		[[nodiscard]] std::optional<std::uint32_t> allocateTextureSlot(VkImageView view, bool nearest = false) const;
+
+	private:
+		friend class ResourceManager;
+
+		LoadContext(ResourceManager const & manager, std::filesystem::path const & path, detail::ReloadBatch * batch)
+		: m_manager(manager), m_path(path), m_batch(batch) {}
+
+		[[nodiscard]] std::shared_ptr<void const> resolve(ResourceId id, std::type_info const & type) const;
+
+		ResourceManager const & m_manager;
+		std::filesystem::path const & m_path;
+		detail::ReloadBatch * m_batch{};
+		mutable std::uint64_t m_upload{};
+		mutable std::vector<std::uint32_t> m_textureSlots{};
+	};
+
+	/**
+	 * \brief Owns loaded assets and keeps them up to date with their source files.
+	 * Resources are loaded synchronously when added. With hot reload enabled, changed files are reloaded on worker threads
+	 * together with everything that depends on them, and the new versions are swapped in as one unit by update().
+	 * All member functions except the loaders themselves must be called from the frame thread.
+	 */
+	class ResourceManager
+	{
+	public:
+		template <typename Type>
+		using Loader = std::function<std::shared_ptr<Type const>(LoadContext const &)>;
+
+		using Clock = bk::FileWatcher::Clock;
+
+		struct ReloadStats
+		{
+			std::uint32_t reloads{};
+			std::uint32_t failures{};
+			Clock::duration lastLatency{};
+			Clock::duration maxLatency{};
+		};
+
+		ResourceManager() = default;
+
+		ResourceManager(ResourceManager &&) = delete;
+
+		ResourceManager & operator=(ResourceManager &&) = delete;
+
+		ResourceManager(ResourceManager const &) = delete;
+
+		ResourceManager & operator=(ResourceManager const &) = delete;
+
+		~ResourceManager();
+
+		/**
+		 * \brief Register and load a resource.
+		 * \param path Source file; changes to it trigger a reload when hot reload is enabled.
+		 * \param loader Invoked now, and again on a worker thread on every reload. Returning null or throwing keeps the old version.
+		 * \param dependencies Resources this one is built from; it is reloaded whenever one of them is.
+		 */
+		template <typename Type>
+		ResourceId add(std::filesystem::path path, Loader<Type> loader, std::span<ResourceId const> dependencies = {})
+		{
+			auto erased = [loader = std::move(loader)](LoadContext const & context) -> std::shared_ptr<void const> { return loader(context); };
+			return add(std::move(path), typeid(Type), std::move(erased), dependencies);
+		}
+
+		/**
+		 * \brief Obtain the current version of a resource.
+		 * The returned pointer stays valid across reloads; call again after update() to observe a new version.
+		 */
+		template <typename Type>
+		[[nodiscard]] std::shared_ptr<Type const> get(ResourceId id) const
+		{
+			auto const & entry = at(id);
+			assert(*entry.type == typeid(Type));
+			return std::static_pointer_cast<Type const>(entry.value);
+		}
+
+		/**
+		 * \brief Number of times a resource has been swapped in, starting at 1 for the initial load.
+		 */
+		[[nodiscard]] std::uint32_t version(ResourceId id) const { return at(id).version; }
+
+		/**
+		 * \brief Whether the GPU uploads of the current version (see LoadContext::waitFor) have completed.
+		 */
+		[[nodiscard]] bool isReady(ResourceId id) const;
+
+		/**
+		 * \brief For tasks: co_await resumes on the frame thread once isReady(id), checked every tick.
+		 */
+		[[nodiscard]] bk::Scheduler::Until whenReady(bk::Scheduler & scheduler, ResourceId const id) const
+		{
+			return scheduler.until([this, id] { return isReady(id); });
+		}
+
+		/**
+		 * \brief Let loaders upload GPU data. Completion is polled by the queue's owner; update() only reads the result.
+		 * The queue must outlive the manager's resources.
+		 */
+		void setUploadQueue(bk::gpu::UploadQueue * uploads) { m_uploads = uploads; }
+
+		/**
+		 * \brief Let loaders allocate bindless texture slots. Replaced versions are handed to the table to be kept alive
+		 * until their slots are recycled. The table must outlive the manager's resources.
+		 */
+		void setTextureTable(bk::gpu::TextureTable * textures) { m_textures = textures; }
+
+		/**
+		 * \brief Start watching the directories of all registered (and future) resources, reloading on the given pool.
+		 * The pool must outlive the manager.
+		 */
+		void enableHotReload(bk::ThreadPool & pool);
+
+		/**
+		 * \brief Frame boundary hook: picks up file changes, schedules reloads, and swaps in finished ones.
+		 * Never waits for a reload to finish.
+		 */
+		void update();
+
+		/**
+		 * \brief Wait for reloads in flight, then release every resource.
+		 * For resources whose destruction depends on objects owned elsewhere (e.g. the Vulkan device).
+		 */
+		void clear();
+
+		[[nodiscard]] ReloadStats const & getReloadStats() const { return m_stats; }
+
+	private:
+		using Erased = std::function<std::shared_ptr<void const>(LoadContext const &)>;
+
+		struct Entry
+		{
+			std::filesystem::path path{};
+			std::type_info const * type{};
+			Erased loader{};
+			std::vector<ResourceId> dependencies{};
+			std::vector<ResourceId> dependents{};
+			std::shared_ptr<void const> value{};
+			std::uint32_t version{};
+			std::uint64_t upload{}; // UploadTicket the current value waits for
+			std::vector<std::uint32_t> textureSlots{}; // Owned by the current value
+		};
+
+		friend class LoadContext;
+
+		ResourceId add(std::filesystem::path path, std::type_info const & type, Erased loader, std::span<ResourceId const> dependencies);
+
+		[[nodiscard]] Entry const & at(ResourceId id) const;
+
+		void watchDirectory(std::filesystem::path const & path);
+
+		bool schedule(bk::FileWatcher::Event const & event);
+
+		void launch(std::shared_ptr<detail::ReloadBatch> const & batch, ResourceId id);
+
+		void commit(detail::ReloadBatch & batch);
+
+		[[nodiscard]] bool isUploaded(std::uint64_t ticket) const;
+
+		void waitForReloads();
+
+		// Guards entries against reads from loader threads while the frame thread adds or swaps in resources.
+		mutable std::mutex m_entriesMutex{};
+		std::vector<std::unique_ptr<Entry>> m_entries{};
+		// Keyed by the interned generic path: file change events are matched with an integer compare.
+		std::unordered_map<bk::StringId, std::vector<ResourceId>> m_byPath{};
+
+		bk::ThreadPool * m_pool{};
+		bk::gpu::UploadQueue * m_uploads{};
+		bk::gpu::TextureTable * m_textures{};
+		std::unique_ptr<bk::FileWatcher> m_watcher{};
+		std::unordered_set<ResourceId> m_inFlight{};
+		std::vector<bk::FileWatcher::Event> m_deferred{};
+		// Reloaded, but still waiting on their GPU uploads before they can be swapped in.
+		std::vector<std::shared_ptr<detail::ReloadBatch>> m_uploading{};
+
+		// Guards everything reload jobs hand back to the frame thread.
+		std::mutex m_completedMutex{};
+		std::condition_variable m_completedCv{};
+		std::vector<std::shared_ptr<detail::ReloadBatch>> m_completed{};
+		// Queued or running reload jobs; the destructor waits for them since they reference this manager.
+		std::uint32_t m_running{};
+
+		ReloadStats m_stats{};
+	};
+} // namespace game
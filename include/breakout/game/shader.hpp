@@ -1,8 +1,51 @@
 
 #pragma once
 
+#include <breakout/gpu/vk_types.hpp>
+
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+
 namespace game {
+    /**
+     * \brief Shader module created from a precompiled SPIR-V file.
+     */
     class Shader {
+    public:
+        /**
+         * \brief Load a .spv file produced by the build (see shaders/CMakeLists.txt).
+         * \returns null (after logging why) if the file is missing or is not SPIR-V.
+         */
+        static std::shared_ptr<Shader const> load(VkDevice device, std::filesystem::path const & path);
+
+        /**
+         * \brief Directory the build writes compiled shaders to.
+         */
+        static std::filesystem::path directory();
+
+        Shader(VkDevice device, VkShaderModule module, std::uint64_t hash);
+
+        Shader(Shader &&) = delete;
+
+        Shader & operator=(Shader &&) = delete;
+
+        Shader(Shader const &) = delete;
+
+        Shader & operator=(Shader const &) = delete;
+
+        ~Shader();
+
+        [[nodiscard]] VkShaderModule module() const { return m_module; }
+
+        /**
+         * \brief Hash of the SPIR-V code; stable across runs and module re-creation, so usable in pipeline keys.
+         */
+        [[nodiscard]] std::uint64_t hash() const { return m_hash; }
 
+    private:
+        VkDevice m_device{};
+        VkShaderModule m_module{};
+        std::uint64_t m_hash{};
     };
-}
\ No newline at end of file
+}
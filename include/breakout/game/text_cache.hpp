@@ -0,0 +1,117 @@
+#pragma once
+
+#include <breakout/gpu/sprite_batch.hpp>
+
+#include <glm/vec2.hpp>
+#include <glm/vec4.hpp>
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace game {
+    class GlyphAtlas;
+
+    /**
+     * \brief Laid out strings, keyed by their text, turned into glyph sprites each frame.
+     * Layout (glyph lookup, kerning, line breaks) runs only the first time a string is seen or when the atlas is rebaked;
+     * after that a label costs a hash lookup and one SpriteBatch::submit per glyph, so its quads go through the same
+     * instanced draws as every other sprite. Strings not drawn for a while are dropped.
+     */
+    class TextCache {
+    public:
+        struct Config {
+            std::uint32_t evictAfter{30}; // Frames a string may go undrawn before its layout is dropped
+        };
+
+        /**
+         * \brief Where and how a string is drawn.
+         */
+        struct Label {
+            glm::vec2 position{}; // Of the anchor, in pixels
+            float size{16.0f}; // Pixels per em
+            glm::vec2 anchor{}; // Point of the text box at position: (0, 0) top left, (0.5, 0.5) centre, (1, 1) bottom right
+            std::uint32_t color{0xffffffff};
+            std::uint16_t texture{}; // The font's TextureTable slot
+            std::uint8_t pipeline{}; // The text pipeline, as for Sprite::pipeline
+            std::uint8_t layer{};
+        };
+
+        /**
+         * \brief A glyph quad relative to the top left of the text box, in ems.
+         */
+        struct Quad {
+            glm::vec2 position{}; // Centre
+            glm::vec2 size{};
+            glm::vec4 uvRect{};
+        };
+
+        struct Layout {
+            std::vector<Quad> quads{};
+            glm::vec2 extent{}; // Text box in ems: widest line by line count times the line height
+        };
+
+        struct Stats {
+            // Of the last frame ended with endFrame()
+            std::uint32_t hits{};
+            std::uint32_t rebuilds{};
+            std::uint32_t glyphs{};
+            std::size_t entries{};
+            std::uint32_t evictions{}; // Since construction
+        };
+
+        TextCache() = default;
+
+        explicit TextCache(Config config) : m_config(config) {}
+
+        /**
+         * \brief Lay out text on its own, replacing out's quads (and reusing their memory). '\n' starts a new line.
+         */
+        static void layout(GlyphAtlas const & atlas, std::string_view text, Layout & out);
+
+        /**
+         * \brief Submit the quads of a layout as sprites.
+         */
+        static void submit(bk::gpu::SpriteBatch & batch, Layout const & layout, Label const & label);
+
+        /**
+         * \brief Submit text, laid out with atlas unless the same string was laid out with it before.
+         */
+        void submit(bk::gpu::SpriteBatch & batch, GlyphAtlas const & atlas, std::string_view text, Label const & label);
+
+        /**
+         * \brief Once per frame, after the last submit: drops strings unused for Config::evictAfter frames (checked every
+         * that many frames, so this is normally just a counter) and publishes the frame's stats.
+         */
+        void endFrame();
+
+        void clear();
+
+        [[nodiscard]] Stats const & getStats() const { return m_stats; }
+
+    private:
+        struct Entry {
+            Layout layout{};
+            std::uint64_t atlas{}; // GlyphAtlas::id() it was laid out with
+            std::uint64_t lastUsed{};
+        };
+
+        // Lets find() take a string_view, so hits do not build a std::string.
+        struct Hash {
+            using is_transparent = void;
+
+            std::size_t operator()(std::string_view text) const { return std::hash<std::string_view>{}(text); }
+        };
+
+        Config m_config{};
+        std::unordered_map<std::string, Entry, Hash, std::equal_to<>> m_entries{};
+        // Quad storage of evicted entries, handed to new ones so steadily changing strings stop allocating for it
+        std::vector<std::vector<Quad>> m_spare{};
+        std::uint64_t m_frame{};
+        Stats m_current{}; // Frame in progress
+        Stats m_stats{};
+    };
+}
@@ -1,8 +1,52 @@
-
 #pragma once
 
+#include <breakout/gpu/vk_types.hpp>
+
+#include <cstdint>
+#include <memory>
+
+namespace bk::gpu {
+    struct Device;
+}
+
 namespace game {
+    class LoadContext;
+
+    /**
+     * \brief Sampled RGBA8 image, addressed by shaders through its slot in the bindless texture table.
+     */
     class Texture2D {
+    public:
+        /**
+         * \brief ResourceManager loader: decode a PNG, JPEG, TGA or BMP file, queue its upload and allocate its slot.
+         * \returns null (after logging why) if the file cannot be decoded or the texture table is full.
+         */
+        static std::shared_ptr<Texture2D const> load(LoadContext const & context, bk::gpu::Device const & device);
+
+        Texture2D(bk::gpu::Device const & device, bk::gpu::AllocatedImage image, std::uint32_t slot);
+
+        Texture2D(Texture2D &&) = delete;
+
+        Texture2D & operator=(Texture2D &&) = delete;
+
+        Texture2D(Texture2D const &) = delete;
+
+        Texture2D & operator=(Texture2D const &) = delete;
+
+        ~Texture2D();
+
+        /**
+         * \brief Index into the texture table, as stored in sprite instances.
+         */
+        [[nodiscard]] std::uint32_t slot() const { return m_slot; }
+
+        [[nodiscard]] VkExtent3D extent() const { return m_image.extent; }
+
+        [[nodiscard]] VkImageView view() const { return m_image.view; }
 
+    private:
+        bk::gpu::Device const * m_device{};
+        bk::gpu::AllocatedImage m_image{};
+        std::uint32_t m_slot{};
     };
-}
\ No newline at end of file
+}
@@ -0,0 +1,108 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <span>
+#include <vector>
+
+#include "breakout/gpu/vk_types.hpp"
+
+namespace bk
+{
+	class ThreadPool;
+} // namespace bk
+
+namespace bk::gpu
+{
+	struct Device;
+
+	/**
+	 * \brief What the secondary command buffers of a dynamic rendering pass inherit from it.
+	 */
+	struct RenderTarget
+	{
+		VkFormat colorFormat{VK_FORMAT_UNDEFINED};
+		VkFormat depthFormat{VK_FORMAT_UNDEFINED};
+		VkExtent2D extent{}; // Viewport and scissor of every secondary, as dynamic state is not inherited
+	};
+
+	/**
+	 * \brief Records the passes of a frame into secondary command buffers on worker threads.
+	 * Every recording context owns one command pool per frame in flight. Pools are transient and reset as a whole when
+	 * their frame comes around again, never per buffer, and a context only ever runs on one thread at a time, so no
+	 * pool is shared between threads. The primary command buffer then executes the secondaries in pass order.
+	 */
+	class CommandRecorder
+	{
+	public:
+		using Pass = std::function<void(VkCommandBuffer)>;
+
+		struct Config
+		{
+			std::uint32_t frameCount{2};
+			std::uint32_t contextCount{4}; // Passes recorded in parallel at most; there is no point exceeding the pool's workers + 1
+		};
+
+		struct Stats
+		{
+			std::uint32_t passes{};
+			std::uint32_t contexts{};        // Contexts that recorded something last frame
+			std::uint32_t commandBuffers{};  // Allocated over all pools; grows to the most passes any frame had
+			double recordMs{};               // Wall time of the last record()
+		};
+
+		CommandRecorder(Device const & device, ThreadPool & pool, Config const & config);
+
+		CommandRecorder(CommandRecorder &&) = delete;
+
+		CommandRecorder & operator=(CommandRecorder &&) = delete;
+
+		CommandRecorder(CommandRecorder const &) = delete;
+
+		CommandRecorder & operator=(CommandRecorder const &) = delete;
+
+		/**
+		 * \brief The device must be idle.
+		 */
+		~CommandRecorder();
+
+		/**
+		 * \brief Reset the pools of frame, recycling all its command buffers.
+		 * Call once the fence of the frame that last used this slot has signalled.
+		 */
+		void beginFrame(std::uint32_t frame);
+
+		/**
+		 * \brief Record every pass into its own secondary command buffer, spread over the contexts, and wait for all of them.
+		 * \returns The secondaries in pass order, valid until the next record() or beginFrame().
+		 */
+		std::span<VkCommandBuffer const> record(std::span<Pass const> passes, RenderTarget const & target);
+
+		/**
+		 * \brief Execute the secondaries of the last record() inside a rendering pass begun with
+		 * VK_RENDERING_CONTENTS_SECONDARY_COMMAND_BUFFERS_BIT.
+		 */
+		void execute(VkCommandBuffer primary) const;
+
+		[[nodiscard]] Stats const & getStats() const { return m_stats; }
+
+	private:
+		struct Context
+		{
+			VkCommandPool pool{};
+			std::vector<VkCommandBuffer> buffers{};
+			std::uint32_t used{};
+		};
+
+		VkCommandBuffer acquire(Context & context) const;
+
+		VkDevice m_device{};
+		ThreadPool & m_pool;
+		std::uint32_t m_contextCount{};
+		// [frame * m_contextCount + context]
+		std::vector<Context> m_contexts{};
+		std::uint32_t m_frame{};
+		std::vector<VkCommandBuffer> m_recorded{};
+		Stats m_stats{};
+	};
+} // namespace bk::gpu
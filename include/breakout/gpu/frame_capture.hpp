@@ -0,0 +1,133 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <filesystem>
+#include <mutex>
+#include <vector>
+
+#include "breakout/gpu/render_graph.hpp"
+#include "breakout/gpu/vk_types.hpp"
+
+namespace bk
+{
+	class ThreadPool;
+} // namespace bk
+
+namespace bk::gpu
+{
+	struct Device;
+
+	/**
+	 * \brief Writes rendered frames to image files without stalling the frame loop.
+	 * A captured frame gets a render graph pass copying the image into a host-visible readback buffer. Nothing waits for
+	 * that copy: the buffer is picked up frameCount frames later, once the frame's fence is known to have signalled, and
+	 * encoded and written on a ThreadPool worker straight from mapped memory.
+	 *
+	 * Readback buffers form a ring of frameCount + maxPending entries, each free, recorded (GPU copy in flight) or encoding.
+	 * When none is free the capture is dropped and counted rather than waited for, so a slow disk costs frames in the
+	 * capture, never in the game.
+	 */
+	class FrameCapture
+	{
+	public:
+		enum class Format : std::uint8_t
+		{
+			ePng, // Uncompressed deflate: cheapest to encode, largest files
+			eQoi
+		};
+
+		struct Config
+		{
+			std::filesystem::path directory{"captures"};
+			Format format{Format::ePng};
+			std::uint32_t frameCount{2}; // Frames in flight: a copy is complete once as many frames have started after it
+			std::uint32_t maxPending{4}; // Captures waiting for or being encoded on top of those in flight
+		};
+
+		struct Stats
+		{
+			std::uint64_t captured{}; // Copies recorded
+			std::uint64_t written{};
+			std::uint64_t dropped{}; // No free readback buffer when requested
+			std::uint64_t failed{};  // Unsupported formats and write errors
+			double lastEncodeMs{};   // Encode and write of the last written frame, on the worker
+		};
+
+		FrameCapture(Device const & device, ThreadPool & pool, Config const & config);
+
+		FrameCapture(FrameCapture &&) = delete;
+
+		FrameCapture & operator=(FrameCapture &&) = delete;
+
+		FrameCapture(FrameCapture const &) = delete;
+
+		FrameCapture & operator=(FrameCapture const &) = delete;
+
+		/**
+		 * \brief Waits for encodes in progress; captures still in flight are lost. The device must be idle, and the pool
+		 * still running.
+		 */
+		~FrameCapture();
+
+		/**
+		 * \brief Capture the next frame passed to addPass(). Thread safe.
+		 */
+		void captureNext();
+
+		/**
+		 * \brief Capture every interval-th frame continuously; 0 stops. Thread safe.
+		 */
+		void setInterval(std::uint32_t interval);
+
+		/**
+		 * \brief Hand the readbacks of frames the GPU is done with to the encoder. Call once per frame, after its fence wait.
+		 */
+		void beginFrame(std::uint64_t frame);
+
+		/**
+		 * \brief If this frame is to be captured, add a pass copying image (of extent and format, R8G8B8A8 or B8G8R8A8) to
+		 * a readback buffer. Add it after the passes that write the image.
+		 */
+		void addPass(RenderGraph & graph, RenderGraph::Image image, VkExtent2D extent, VkFormat format);
+
+		[[nodiscard]] Stats getStats() const;
+
+	private:
+		enum class State : std::uint8_t
+		{
+			eFree,
+			eRecorded,
+			eEncoding
+		};
+
+		struct Readback
+		{
+			VkBuffer buffer{};
+			VmaAllocation allocation{};
+			void const * data{};
+			VkDeviceSize capacity{};
+			State state{State::eFree};
+			std::uint64_t frame{};
+			VkExtent2D extent{};
+			bool bgra{};
+			bool single{}; // From captureNext(): logged once written
+		};
+
+		void encode(Readback & readback);
+
+		VkDevice m_device{};
+		VmaAllocator m_allocator{};
+		ThreadPool & m_pool;
+		Config m_config{};
+		std::uint64_t m_frame{};
+
+		mutable std::mutex m_mutex{};
+		std::condition_variable m_idle{}; // Signalled whenever an encode finishes
+		std::vector<Readback> m_readbacks{};
+		bool m_captureNext{};
+		std::uint32_t m_interval{};
+		std::uint32_t m_encoding{};
+		Stats m_stats{};
+	};
+} // namespace bk::gpu
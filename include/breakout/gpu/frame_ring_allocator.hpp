@@ -0,0 +1,130 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <optional>
+#include <span>
+#include <vector>
+
+#include "breakout/gpu/vk_types.hpp"
+
+namespace bk::gpu
+{
+	struct Device;
+
+	/**
+	 * \brief Linear allocator for data that only lives for one frame: uniforms, dynamic vertices, instance data.
+	 * Owns one persistently mapped host-visible buffer per frame in flight; allocating is an aligned pointer bump into the
+	 * current slot's buffer and a slot is rewound as a whole once the fence of the frame that last used it has signalled.
+	 * Allocation is lock-free so command recording threads can share the ring.
+	 */
+	class FrameRingAllocator
+	{
+	public:
+		struct Config
+		{
+			std::uint32_t slotCount{2};
+			VkDeviceSize capacity{4ull << 20u}; // Bytes per slot
+			VkBufferUsageFlags usage{VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT | VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_VERTEX_BUFFER_BIT |
+									 VK_BUFFER_USAGE_INDEX_BUFFER_BIT | VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT | VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT};
+		};
+
+		/**
+		 * \brief A range of the current slot's buffer, valid until the slot is reclaimed.
+		 */
+		struct Allocation
+		{
+			VkBuffer buffer{};
+			VkDeviceSize offset{};
+			VkDeviceSize size{};
+			VkDeviceAddress address{}; // Device address of the range (buffer address + offset)
+			void * data{};             // Persistently mapped, write-only from the CPU's point of view
+
+			template <typename T>
+			[[nodiscard]] std::span<T> as() const
+			{
+				return {static_cast<T *>(data), static_cast<std::size_t>(size / sizeof(T))};
+			}
+		};
+
+		struct Stats
+		{
+			VkDeviceSize capacity{};
+			VkDeviceSize lastFrameBytes{};     // Used by the most recently reclaimed frame
+			VkDeviceSize highWaterBytes{};     // Largest single frame so far
+			std::uint32_t lastFrameAllocations{};
+			std::uint32_t highWaterAllocations{};
+			std::uint64_t failedAllocations{}; // Requests that did not fit; sizing the ring from highWaterBytes avoids these
+		};
+
+		FrameRingAllocator(Device const & device, Config const & config);
+
+		FrameRingAllocator(FrameRingAllocator &&) = delete;
+
+		FrameRingAllocator & operator=(FrameRingAllocator &&) = delete;
+
+		FrameRingAllocator(FrameRingAllocator const &) = delete;
+
+		FrameRingAllocator & operator=(FrameRingAllocator const &) = delete;
+
+		/**
+		 * \brief Logs the high-water marks. The device must be idle.
+		 */
+		~FrameRingAllocator();
+
+		/**
+		 * \brief Make slot current and rewind it, recording its usage in the stats.
+		 * Call once the fence of the frame that last used this slot has signalled.
+		 */
+		void reclaim(std::uint32_t slot);
+
+		/**
+		 * \brief Sub-allocate size bytes from the current slot. Thread safe.
+		 * \param alignment Required in addition to the device's uniform/storage offset alignment.
+		 * \returns nullopt if the slot is full.
+		 */
+		[[nodiscard]] std::optional<Allocation> allocate(VkDeviceSize size, VkDeviceSize alignment = 1);
+
+		/**
+		 * \brief Copy data into a fresh allocation.
+		 */
+		template <typename T>
+		[[nodiscard]] std::optional<Allocation> push(std::span<T const> data, VkDeviceSize alignment = alignof(T))
+		{
+			auto ret = allocate(data.size_bytes(), alignment);
+			if (ret) { std::memcpy(ret->data, data.data(), data.size_bytes()); }
+			return ret;
+		}
+
+		/**
+		 * \brief Make the current slot's writes visible to the device. Call before submitting the frame; a no-op on coherent memory.
+		 */
+		void flush() const;
+
+		[[nodiscard]] std::uint32_t currentSlot() const { return m_current; }
+
+		[[nodiscard]] Stats getStats() const;
+
+	private:
+		struct Slot
+		{
+			VkBuffer buffer{};
+			VmaAllocation allocation{};
+			std::byte * mapped{};
+			VkDeviceAddress address{};
+			std::atomic<VkDeviceSize> head{};
+			std::atomic<std::uint32_t> allocations{};
+		};
+
+		VmaAllocator m_allocator{};
+		std::vector<Slot> m_slots{};
+		std::uint32_t m_current{};
+		VkDeviceSize m_capacity{};
+		VkDeviceSize m_minAlignment{1};
+		bool m_coherent{true};
+
+		Stats m_stats{};
+		std::atomic<std::uint64_t> m_failed{};
+	};
+} // namespace bk::gpu
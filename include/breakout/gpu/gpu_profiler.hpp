@@ -0,0 +1,135 @@
+#pragma once
+
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+#include "breakout/core/profiler.hpp"
+#include "breakout/gpu/vk_types.hpp"
+
+namespace bk::gpu
+{
+	struct Device;
+
+	/**
+	 * \brief Times regions of the primary command buffer with timestamp queries and feeds them to a bk::Profiler.
+	 * Each frame in flight has its own query pool, read back (without waiting) when the frame slot comes around again, so
+	 * results are frameCount frames late but never stall. Timestamps are mapped to steady_clock with
+	 * VK_EXT_calibrated_timestamps where available; otherwise the first timestamp of a frame is pinned to the CPU time its
+	 * recording began, which keeps durations exact but offsets approximate.
+	 */
+	class GpuProfiler
+	{
+	public:
+		struct Config
+		{
+			std::uint32_t frameCount{2};
+			std::uint32_t maxZones{64};             // Per frame; zones past this are not timed
+			std::uint32_t recalibrateInterval{240}; // Frames between re-sampling the CPU/GPU clock pair, to follow drift
+		};
+
+		/**
+		 * \brief RAII GPU zone: timestamps at construction and destruction.
+		 */
+		class Scope
+		{
+		public:
+			Scope(GpuProfiler & profiler, VkCommandBuffer cmd, std::string_view name);
+
+			Scope(Scope &&) = delete;
+
+			Scope & operator=(Scope &&) = delete;
+
+			Scope(Scope const &) = delete;
+
+			Scope & operator=(Scope const &) = delete;
+
+			~Scope();
+
+		private:
+			GpuProfiler & m_profiler;
+			VkCommandBuffer m_cmd;
+			std::uint32_t m_zone;
+		};
+
+		GpuProfiler(Device const & device, Profiler & profiler, Config const & config);
+
+		GpuProfiler(GpuProfiler &&) = delete;
+
+		GpuProfiler & operator=(GpuProfiler &&) = delete;
+
+		GpuProfiler(GpuProfiler const &) = delete;
+
+		GpuProfiler & operator=(GpuProfiler const &) = delete;
+
+		/**
+		 * \brief The device must be idle.
+		 */
+		~GpuProfiler();
+
+		/**
+		 * \returns False if the graphics queue cannot write timestamps; zones are then no-ops.
+		 */
+		[[nodiscard]] bool isSupported() const { return m_mask != 0; }
+
+		[[nodiscard]] bool isCalibrated() const { return m_getCalibratedTimestamps != nullptr; }
+
+		/**
+		 * \brief Hand the results of slot's previous frame to the profiler and reset its queries.
+		 * Call right after beginning the primary command buffer, once the slot's fence has signalled.
+		 */
+		void beginFrame(VkCommandBuffer cmd, std::uint32_t slot, std::uint64_t frame);
+
+		/**
+		 * \brief Time a region of the primary command buffer passed to beginFrame(). Not for secondaries.
+		 */
+		[[nodiscard]] Scope zone(VkCommandBuffer cmd, std::string_view name) { return Scope{*this, cmd, name}; }
+
+	private:
+		struct PendingZone
+		{
+			std::string_view name{};
+			std::uint32_t beginQuery{};
+			std::uint32_t endQuery{};
+			std::uint16_t depth{};
+		};
+
+		struct Slot
+		{
+			VkQueryPool pool{};
+			std::vector<PendingZone> zones{};
+			std::uint32_t queries{};
+			std::uint64_t frame{};
+			std::int64_t recordNs{}; // When the frame's recording began; anchors uncalibrated timestamps
+		};
+
+		static constexpr std::uint32_t no_zone_v{~0u};
+
+		std::uint32_t begin(VkCommandBuffer cmd, std::string_view name);
+
+		void end(VkCommandBuffer cmd, std::uint32_t zone);
+
+		void collect(Slot & slot);
+
+		void calibrate();
+
+		[[nodiscard]] std::int64_t toCpuNs(std::uint64_t ticks) const;
+
+		VkDevice m_device{};
+		Profiler & m_profiler;
+		Config m_config{};
+		double m_period{}; // Nanoseconds per tick
+		std::uint64_t m_mask{};
+		PFN_vkGetCalibratedTimestampsEXT m_getCalibratedTimestamps{};
+
+		// A matching pair of clock readings; timestamps are converted relative to them.
+		std::uint64_t m_gpuBase{};
+		std::int64_t m_cpuBase{};
+		std::uint32_t m_sinceCalibration{};
+
+		std::vector<Slot> m_slots{};
+		Slot * m_current{};
+		std::uint16_t m_depth{};
+		std::vector<std::uint64_t> m_results{};
+	};
+} // namespace bk::gpu
@@ -0,0 +1,108 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include <glm/vec2.hpp>
+
+#include "breakout/gpu/vk_types.hpp"
+
+struct ImDrawData;
+
+namespace bk::gpu
+{
+	struct Device;
+	class FrameRingAllocator;
+	class TextureTable;
+	class UploadQueue;
+	enum struct UploadTicket : std::uint64_t;
+
+	struct ImGuiPushConstants
+	{
+		// Display coordinates to NDC
+		glm::vec2 scale{};
+		glm::vec2 translate{};
+		VkDeviceAddress vertices{}; // ImDrawVert array
+		VkDeviceAddress indices{};  // ImDrawIdx (16 bit) array
+		std::uint32_t texture{};    // TextureTable slot
+		std::uint32_t padding{};
+	};
+	static_assert(sizeof(ImGuiPushConstants) == 40);
+
+	/**
+	 * \brief Draws Dear ImGui output with the renderer's own machinery instead of an imgui backend: the font atlas is a
+	 * TextureTable slot (so texture IDs are slots), vertices and indices go to FrameRingAllocator memory and the vertex
+	 * shader (imgui.vert) pulls both through buffer device addresses, so nothing is bound but the table.
+	 * The ImGui context must exist before construction and outlive the renderer.
+	 */
+	class ImGuiRenderer
+	{
+	public:
+		struct Stats
+		{
+			std::uint32_t vertices{};
+			std::uint32_t indices{};
+			std::uint32_t draws{};
+		};
+
+		/**
+		 * \brief Builds the font atlas and queues its upload; nothing is drawn until the upload has completed.
+		 */
+		ImGuiRenderer(Device const & device, UploadQueue & uploads, TextureTable & textures);
+
+		ImGuiRenderer(ImGuiRenderer &&) = delete;
+
+		ImGuiRenderer & operator=(ImGuiRenderer &&) = delete;
+
+		ImGuiRenderer(ImGuiRenderer const &) = delete;
+
+		ImGuiRenderer & operator=(ImGuiRenderer const &) = delete;
+
+		/**
+		 * \brief The device must be idle.
+		 */
+		~ImGuiRenderer();
+
+		/**
+		 * \brief Pipeline layout for pipelines drawing with imgui.vert: the texture table and ImGuiPushConstants.
+		 */
+		[[nodiscard]] VkPipelineLayout layout() const { return m_layout; }
+
+		/**
+		 * \brief Copy this frame's draw data (after ImGui::Render()) to ring memory and turn its commands into draws.
+		 * \param framebuffer Size of the image record() draws into; clip rects are scaled from display to its pixels.
+		 * \returns False if the ring is full; record() then draws nothing, as it does while the font atlas is uploading.
+		 */
+		bool prepare(ImDrawData const & data, FrameRingAllocator & ring, VkExtent2D framebuffer);
+
+		/**
+		 * \brief Draw what prepare() collected. Inside dynamic rendering to a color attachment of the framebuffer size.
+		 */
+		void record(VkCommandBuffer cmd, VkPipeline pipeline) const;
+
+		[[nodiscard]] Stats const & getStats() const { return m_stats; }
+
+	private:
+		struct Draw
+		{
+			VkRect2D scissor{};
+			std::uint32_t indexCount{};
+			std::uint32_t firstIndex{};
+			std::uint32_t vertexOffset{};
+			std::uint32_t texture{};
+		};
+
+		Device const & m_device;
+		TextureTable & m_textures;
+		UploadQueue const & m_uploads;
+		AllocatedImage m_font{};
+		UploadTicket m_fontUpload{};
+		std::uint32_t m_fontSlot{};
+		VkPipelineLayout m_layout{};
+
+		VkExtent2D m_framebuffer{};
+		ImGuiPushConstants m_constants{};
+		std::vector<Draw> m_draws{};
+		Stats m_stats{};
+	};
+} // namespace bk::gpu
@@ -0,0 +1,163 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+
+#include "breakout/gpu/vk_types.hpp"
+
+namespace bk
+{
+	class ThreadPool;
+} // namespace bk
+
+namespace game
+{
+	class Shader;
+} // namespace game
+
+namespace bk::gpu
+{
+	struct Device;
+
+	/**
+	 * \brief Everything that determines a graphics pipeline.
+	 * Pipelines pull their vertex data from buffers (no vertex input state) and render with dynamic rendering,
+	 * with viewport and scissor left dynamic.
+	 */
+	struct GraphicsPipelineDesc
+	{
+		// Held by the compilation, so a reload cannot destroy a module while the driver still reads it.
+		std::shared_ptr<game::Shader const> vertex{};
+		std::shared_ptr<game::Shader const> fragment{};
+
+		// Content hashes (game::Shader::hash) rather than module handles, so the key survives shader reloads.
+		std::uint64_t vertexHash{};
+		std::uint64_t fragmentHash{};
+
+		VkPipelineLayout layout{};
+		VkFormat colorFormat{VK_FORMAT_UNDEFINED};
+		VkFormat depthFormat{VK_FORMAT_UNDEFINED};
+		VkPrimitiveTopology topology{VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST};
+		VkCullModeFlags cullMode{VK_CULL_MODE_NONE};
+		bool alphaBlend{false};
+		bool depthTest{false};
+
+		[[nodiscard]] std::uint64_t hash() const;
+
+		/**
+		 * \brief Compares what hash() covers: a reloaded shader with the same code is a new module but the same pipeline.
+		 */
+		bool operator==(GraphicsPipelineDesc const & other) const;
+	};
+
+	/**
+	 * \brief Compiles graphics pipelines on worker threads and keeps them keyed by their hashed state.
+	 * Backed by a VkPipelineCache that is restored from and saved to disk, in a file keyed by the device's vendor, device,
+	 * driver version and pipeline cache UUID, so a driver update never gets fed a foreign blob.
+	 * A pipeline with a shader replaced by a reload is destroyed once no frame in flight can still use it.
+	 */
+	class PipelineCache
+	{
+	public:
+		struct Stats
+		{
+			std::uint32_t compiled{};
+			std::uint32_t failed{};
+			std::uint32_t fallbacks{};
+			std::uint32_t destroyed{}; // Superseded by shader reloads
+			std::size_t loadedBytes{};
+		};
+
+		/**
+		 * \param directory Where the cache blob lives; created on save if missing.
+		 * \param frameCount Frames in flight, for which a pipeline may still be used after its last get().
+		 */
+		PipelineCache(Device const & device, ThreadPool & pool, std::filesystem::path directory, std::uint32_t frameCount);
+
+		PipelineCache(PipelineCache &&) = delete;
+
+		PipelineCache & operator=(PipelineCache &&) = delete;
+
+		PipelineCache(PipelineCache const &) = delete;
+
+		PipelineCache & operator=(PipelineCache const &) = delete;
+
+		/**
+		 * \brief Waits for pending compilations, saves the cache and destroys all pipelines.
+		 */
+		~PipelineCache();
+
+		/**
+		 * \brief Obtain a pipeline without waiting.
+		 * \returns The pipeline once compiled; until then (or if compilation failed) the fallback, after queueing the compilation on first request.
+		 */
+		VkPipeline get(GraphicsPipelineDesc const & desc, VkPipeline fallback);
+
+		/**
+		 * \brief Obtain a pipeline, compiling it on the calling thread if needed. Meant for fallbacks and startup: the
+		 * pipeline lives as long as the cache, even once its shaders are reloaded.
+		 */
+		VkPipeline getNow(GraphicsPipelineDesc const & desc);
+
+		/**
+		 * \brief Destroy pipelines with a shader that was released (replaced by a reload) and that were last requested
+		 * with get() frameCount or more frames ago. Frame thread; once per frame, after the frame's fence wait.
+		 */
+		void beginFrame(std::uint64_t frame);
+
+		/**
+		 * \brief Write the VkPipelineCache blob to disk.
+		 */
+		bool save() const;
+
+		[[nodiscard]] std::filesystem::path const & path() const { return m_path; }
+
+		[[nodiscard]] Stats getStats() const;
+
+	private:
+		enum class State : std::uint8_t
+		{
+			ePending,
+			eReady,
+			eFailed,
+		};
+
+		struct Entry
+		{
+			GraphicsPipelineDesc desc{}; // Without its shaders, which the entry must not keep alive
+			std::weak_ptr<game::Shader const> vertex{};
+			std::weak_ptr<game::Shader const> fragment{};
+			VkPipeline pipeline{};
+			State state{State::ePending};
+			std::uint64_t lastUsed{}; // Frame of the last get()
+			bool pinned{false};       // Requested with getNow(): callers keep those handles, so they are never destroyed early
+		};
+
+		/**
+		 * \brief Look up or insert the entry of desc, marked as used this frame.
+		 */
+		std::pair<Entry &, bool> use(std::uint64_t key, GraphicsPipelineDesc const & desc);
+
+		VkPipeline compile(GraphicsPipelineDesc const & desc) const;
+
+		void store(std::uint64_t key, VkPipeline pipeline);
+
+		VkDevice m_device{};
+		VkPipelineCache m_cache{};
+		std::filesystem::path m_path{};
+		ThreadPool & m_pool;
+		std::uint32_t m_frameCount{};
+
+		mutable std::mutex m_mutex{};
+		std::condition_variable m_cv{};
+		std::unordered_map<std::uint64_t, Entry> m_pipelines{};
+		std::uint32_t m_pending{};
+		std::uint64_t m_frame{};
+		Stats m_stats{};
+	};
+} // namespace bk::gpu
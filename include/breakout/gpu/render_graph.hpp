@@ -0,0 +1,315 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "breakout/gpu/vk_types.hpp"
+
+namespace bk::gpu
+{
+	struct Device;
+
+	/**
+	 * \brief Frame graph: passes declare which images and buffers they read and write, the graph derives the rest.
+	 * Rebuilt every frame (reset(), declare, compile(), execute()), which is cheap: the Vulkan objects behind transient
+	 * resources are cached per frame slot and only recreated when their descriptions or lifetimes change.
+	 *
+	 * - Passes whose results nothing uses are culled: only writers of imported or kept resources, passes marked keep()
+	 *   and whatever they depend on run.
+	 * - Barriers are derived from the declared accesses and issued as one vkCmdPipelineBarrier2 per pass (at most),
+	 *   with every access a pass makes to a resource merged into a single barrier. Reads after reads need none.
+	 * - Transient resources live in one VMA allocation per frame slot; resources whose lifetimes do not overlap share
+	 *   memory.
+	 */
+	class RenderGraph
+	{
+	public:
+		enum struct Image : std::uint32_t
+		{
+		};
+
+		enum struct Buffer : std::uint32_t
+		{
+		};
+
+		/**
+		 * \brief How a pass uses a resource; implies the pipeline stage, access mask and (for images) layout and usage.
+		 */
+		enum class Access : std::uint8_t
+		{
+			eColorAttachment, // Read and written: load ops may read it
+			eDepthAttachment,
+			eSampled,         // Fragment shaders
+			eStorageRead,     // Compute shaders
+			eStorageWrite,
+			eTransferSrc,
+			eTransferDst,
+			eVertexBuffer,
+			eIndexBuffer,
+			eIndirectBuffer,
+			eUniformBuffer, // Vertex and fragment shaders
+			eCOUNT_
+		};
+
+		struct ImageDesc
+		{
+			VkExtent2D extent{};
+			VkFormat format{VK_FORMAT_R8G8B8A8_UNORM};
+			VkImageUsageFlags usage{}; // Added to what the accesses imply
+		};
+
+		struct ImportedImage
+		{
+			VkImage image{};
+			VkImageView view{};
+			VkExtent2D extent{};
+			VkFormat format{VK_FORMAT_UNDEFINED};
+			VkImageLayout initialLayout{VK_IMAGE_LAYOUT_UNDEFINED};
+			// Left in this layout after the last pass; UNDEFINED leaves it in whatever the last access needed.
+			VkImageLayout finalLayout{VK_IMAGE_LAYOUT_UNDEFINED};
+			// Work before the graph that the first access has to wait for; to chain after a semaphore wait (e.g. swapchain
+			// acquisition), its wait stage.
+			VkPipelineStageFlags2 initialStage{VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT};
+		};
+
+		struct ImportedBuffer
+		{
+			VkBuffer buffer{};
+			VkDeviceSize size{};
+			VkPipelineStageFlags2 initialStage{VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT};
+			VkAccessFlags2 initialAccess{VK_ACCESS_2_MEMORY_WRITE_BIT}; // Writes before the graph to make visible
+		};
+
+		/**
+		 * \brief What a pass sees of an image while executing.
+		 */
+		struct ImageView
+		{
+			VkImage image{};
+			VkImageView view{};
+			VkExtent2D extent{};
+			VkFormat format{};
+		};
+
+		class PassBuilder
+		{
+		public:
+			void read(Image image, Access access);
+
+			void write(Image image, Access access);
+
+			void read(Buffer buffer, Access access);
+
+			void write(Buffer buffer, Access access);
+
+			/**
+			 * \brief Never cull this pass, e.g. for readbacks or timing work that writes nothing the graph knows about.
+			 */
+			void keep();
+
+		private:
+			friend class RenderGraph;
+
+			explicit PassBuilder(RenderGraph & graph, std::uint32_t pass) : m_graph(graph), m_pass(pass) {}
+
+			RenderGraph & m_graph;
+			std::uint32_t m_pass;
+		};
+
+		using Setup   = std::function<void(PassBuilder &)>;
+		using Execute = std::function<void(VkCommandBuffer, RenderGraph const &)>;
+
+		struct Config
+		{
+			std::uint32_t frameCount{2}; // Transients are kept per frame slot, so the previous frame may still use its own
+		};
+
+		struct Stats
+		{
+			std::uint32_t passes{};
+			std::uint32_t culled{};
+			std::uint32_t barrierBatches{}; // vkCmdPipelineBarrier2 calls
+			std::uint32_t imageBarriers{};
+			std::uint32_t bufferBarriers{};
+			std::uint32_t transients{};
+			VkDeviceSize transientBytes{}; // Size of the shared allocation
+			VkDeviceSize unaliasedBytes{}; // What the transients would need without aliasing
+			std::uint32_t rebuilds{};      // Times the transient objects of a slot were recreated, since construction
+		};
+
+		RenderGraph(Device const & device, Config const & config);
+
+		RenderGraph(RenderGraph &&) = delete;
+
+		RenderGraph & operator=(RenderGraph &&) = delete;
+
+		RenderGraph(RenderGraph const &) = delete;
+
+		RenderGraph & operator=(RenderGraph const &) = delete;
+
+		/**
+		 * \brief The device must be idle.
+		 */
+		~RenderGraph();
+
+		/**
+		 * \brief Forget the previous frame's passes and resources, keeping the cached transients.
+		 */
+		void reset();
+
+		[[nodiscard]] Image importImage(std::string_view name, ImportedImage const & image);
+
+		[[nodiscard]] Buffer importBuffer(std::string_view name, ImportedBuffer const & buffer);
+
+		/**
+		 * \brief Image that only exists within the frame; its contents are undefined before its first write.
+		 */
+		[[nodiscard]] Image createImage(std::string_view name, ImageDesc const & desc);
+
+		[[nodiscard]] Buffer createBuffer(std::string_view name, VkDeviceSize size, VkBufferUsageFlags usage = 0);
+
+		/**
+		 * \brief Treat image as read after the last pass, so the passes writing it survive culling.
+		 */
+		void keep(Image image);
+
+		/**
+		 * \brief Declare a pass. setup runs immediately; execute runs in execute(), in declaration order, unless culled.
+		 */
+		void addPass(std::string_view name, Setup const & setup, Execute execute);
+
+		/**
+		 * \brief Cull passes, derive barriers and place transients for frame slot. The slot's previous frame must be done
+		 * on the GPU: its transients may be recreated.
+		 */
+		void compile(std::uint32_t slot);
+
+		/**
+		 * \brief Record the live passes and their barriers into cmd, then the final layout transitions.
+		 */
+		void execute(VkCommandBuffer cmd) const;
+
+		/**
+		 * \brief While executing: the physical image behind a handle.
+		 */
+		[[nodiscard]] ImageView image(Image image) const;
+
+		[[nodiscard]] VkBuffer buffer(Buffer buffer) const;
+
+		/**
+		 * \brief Human readable description of the compiled graph: resources, placement, passes and their barriers.
+		 */
+		[[nodiscard]] std::string dump() const;
+
+		[[nodiscard]] Stats const & getStats() const { return m_stats; }
+
+	private:
+		enum class Kind : std::uint8_t
+		{
+			eImage,
+			eBuffer
+		};
+
+		struct Use
+		{
+			std::uint32_t resource{};
+			Access access{};
+			bool write{};
+		};
+
+		struct Pass
+		{
+			std::string name{};
+			Execute execute{};
+			std::vector<Use> uses{};
+			bool keep{};
+			bool live{};
+			std::uint32_t firstBarrier{}; // Into m_imageBarriers / m_bufferBarriers
+			std::uint32_t imageBarrierCount{};
+			std::uint32_t firstBufferBarrier{};
+			std::uint32_t bufferBarrierCount{};
+		};
+
+		struct Resource
+		{
+			std::string name{};
+			Kind kind{};
+			bool imported{};
+			bool kept{};
+			ImportedImage image{};   // Imports, and extent / format / usage of transient images
+			ImportedBuffer buffer{}; // Imports, and size / usage of transient buffers
+			VkImageUsageFlags usage{};
+			std::uint32_t firstPass{~0u};
+			std::uint32_t lastPass{};
+			std::uint32_t physical{~0u}; // Index into the slot's transients
+		};
+
+		/**
+		 * \brief Tracked state of a resource while barriers are derived.
+		 */
+		struct State
+		{
+			VkImageLayout layout{};
+			VkPipelineStageFlags2 writeStage{};
+			VkAccessFlags2 writeAccess{};
+			VkPipelineStageFlags2 readStages{};   // Reads since the last write
+			VkPipelineStageFlags2 visibleStages{}; // Stages the last write has been made visible to
+			VkAccessFlags2 visibleAccess{};
+		};
+
+		/**
+		 * \brief A transient as created: what it was created from decides whether it can be reused next frame.
+		 */
+		struct Transient
+		{
+			Kind kind{};
+			VkExtent2D extent{};
+			VkFormat format{};
+			VkFlags usage{};
+			VkDeviceSize size{};
+			std::uint32_t firstPass{};
+			std::uint32_t lastPass{};
+			VkDeviceSize offset{};
+			VkDeviceSize bytes{};
+			VkImage image{};
+			VkImageView view{};
+			VkBuffer vkBuffer{};
+
+			[[nodiscard]] bool matches(Transient const & other) const;
+		};
+
+		struct Slot
+		{
+			std::vector<Transient> transients{};
+			VmaAllocation allocation{};
+			VkDeviceSize bytes{};
+		};
+
+		std::uint32_t add(std::string_view name, Resource resource);
+
+		void use(std::uint32_t pass, std::uint32_t resource, Access access, bool write);
+
+		void cull();
+
+		void place(std::uint32_t slot);
+
+		void destroy(Slot & slot);
+
+		void buildBarriers();
+
+		Device const & m_device;
+		Config m_config{};
+		std::vector<Resource> m_resources{};
+		std::vector<Pass> m_passes{};
+		std::vector<VkImageMemoryBarrier2> m_imageBarriers{};
+		std::vector<VkBufferMemoryBarrier2> m_bufferBarriers{};
+		std::vector<VkImageMemoryBarrier2> m_finalBarriers{};
+		std::vector<Slot> m_slots{};
+		Slot * m_current{};
+		Stats m_stats{};
+	};
+} // namespace bk::gpu
@@ -0,0 +1,138 @@
+#pragma once
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include <glm/mat4x4.hpp>
+#include <glm/vec2.hpp>
+#include <glm/vec4.hpp>
+
+#include "breakout/gpu/vk_types.hpp"
+
+namespace bk::gpu
+{
+	/**
+	 * \brief A textured, tinted, optionally rotated quad.
+	 */
+	struct Sprite
+	{
+		glm::vec2 position{};                     // Centre
+		glm::vec2 size{1.0f};
+		glm::vec4 uvRect{0.0f, 0.0f, 1.0f, 1.0f}; // min u, min v, max u, max v
+		std::uint32_t color{0xffffffff};          // RGBA8, R in the lowest byte
+		float rotation{};                         // Radians, about the centre
+		std::uint16_t texture{};                  // TextureTable slot
+		std::uint8_t pipeline{};                  // Index into the pipelines passed to SpriteBatch::record
+		std::uint8_t layer{};                     // Higher layers are drawn on top
+	};
+
+	/**
+	 * \brief Per-instance data as read by shaders/sprite.vert (std430).
+	 */
+	struct SpriteInstance
+	{
+		glm::vec2 position{};
+		glm::vec2 size{};
+		glm::vec4 uvRect{};
+		std::uint32_t color{};
+		float rotation{};
+		std::uint32_t texture{};
+		std::uint32_t padding{};
+	};
+	static_assert(sizeof(SpriteInstance) == 48);
+
+	/**
+	 * \brief Push constants shared by every sprite pipeline.
+	 */
+	struct SpritePushConstants
+	{
+		glm::mat4 viewProj{};
+		VkDeviceAddress instances{};
+	};
+	static_assert(sizeof(SpritePushConstants) == 72);
+
+	/**
+	 * \brief Collects sprites for a frame and turns them into a few instanced draws.
+	 * Sprites are radix sorted by (layer, pipeline, texture), stable so submission order still decides overlap within a
+	 * key, then written out in that order to instance memory (normally a FrameRingAllocator range, persistently mapped).
+	 * Textures are bindless (TextureTable slots read from the instance), so a draw is emitted per run of equal pipeline;
+	 * texture stays in the key only to keep sprites sampling the same image together.
+	 */
+	class SpriteBatch
+	{
+	public:
+		struct Draw
+		{
+			std::uint8_t pipeline{};
+			std::uint32_t firstInstance{};
+			std::uint32_t instanceCount{};
+		};
+
+		struct Stats
+		{
+			std::uint32_t sprites{};
+			std::uint32_t draws{};
+			std::uint32_t pipelineBinds{};
+			std::uint32_t sortPasses{}; // Radix passes actually run; passes over a digit all keys share are skipped
+		};
+
+		void reserve(std::size_t count);
+
+		/**
+		 * \brief Forget the sprites of the previous frame, keeping the memory.
+		 */
+		void clear();
+
+		void submit(Sprite const & sprite);
+
+		/**
+		 * \brief Submit sprites[i] for every i in visible, in that order: the index list cullRects() and friends produce.
+		 */
+		void submit(std::span<Sprite const> sprites, std::span<std::uint32_t const> visible);
+
+		[[nodiscard]] std::size_t size() const { return m_instances.size(); }
+
+		[[nodiscard]] VkDeviceSize bytes() const { return m_instances.size() * sizeof(SpriteInstance); }
+
+		/**
+		 * \brief Sort the submitted sprites and write their instances to out.
+		 * \param out At least size() instances; written sequentially, so write-combined memory is fine.
+		 * \returns The draws, valid until the next build() or clear().
+		 */
+		std::span<Draw const> build(std::span<SpriteInstance> out);
+
+		/**
+		 * \brief Record the draws of the last build(), inside a dynamic rendering pass with viewport and scissor set and the
+		 * TextureTable bound.
+		 * \param pipelines Indexed by Sprite::pipeline; created with layout.
+		 * \param instances Device address of the memory passed to build().
+		 */
+		void record(VkCommandBuffer cmd, VkPipelineLayout layout, std::span<VkPipeline const> pipelines, glm::mat4 const & viewProj,
+					VkDeviceAddress instances);
+
+		/**
+		 * \brief Record a subset of the draws of the last build(). Const, so disjoint ranges can be recorded on different threads.
+		 * \returns The number of pipeline binds recorded.
+		 */
+		static std::uint32_t record(VkCommandBuffer cmd, VkPipelineLayout layout, std::span<VkPipeline const> pipelines, glm::mat4 const & viewProj,
+									VkDeviceAddress instances, std::span<Draw const> draws);
+
+		/**
+		 * \returns The draws of the last build().
+		 */
+		[[nodiscard]] std::span<Draw const> draws() const { return m_draws; }
+
+		[[nodiscard]] Stats const & getStats() const { return m_stats; }
+
+	private:
+		void sort();
+
+		std::vector<SpriteInstance> m_instances{};
+		// Sort key in the high half, index into m_instances in the low half.
+		std::vector<std::uint64_t> m_keys{};
+		std::vector<std::uint64_t> m_scratch{};
+		std::vector<Draw> m_draws{};
+		Stats m_stats{};
+	};
+} // namespace bk::gpu
@@ -0,0 +1,128 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <vector>
+
+#include "breakout/gpu/vk_types.hpp"
+
+namespace bk::gpu
+{
+	struct Device;
+
+	/**
+	 * \brief One global array of combined image samplers that shaders index by slot ("bindless" textures).
+	 * The set is bound once per command buffer and never changes; textures come and go by writing slots, which the
+	 * UPDATE_AFTER_BIND + PARTIALLY_BOUND binding allows while the set is bound, as long as the slot itself is not in use
+	 * by a frame in flight. Freed slots are therefore retired for frameCount frames before they are reused.
+	 */
+	class TextureTable
+	{
+	public:
+		enum class Sampler : std::uint8_t
+		{
+			eLinear,
+			eNearest,
+			eCOUNT_
+		};
+
+		struct Config
+		{
+			std::uint32_t capacity{4096}; // Clamped to the device's update-after-bind limits
+			std::uint32_t frameCount{2};
+		};
+
+		struct Stats
+		{
+			std::uint32_t capacity{};
+			std::uint32_t used{};
+			std::uint32_t highWater{};
+			std::uint32_t retiring{};
+		};
+
+		// Points at the default texture; unused and retired slots are reset to it too, so a stale index never faults.
+		static constexpr std::uint32_t default_slot_v{0};
+
+		TextureTable(Device const & device, Config const & config);
+
+		TextureTable(TextureTable &&) = delete;
+
+		TextureTable & operator=(TextureTable &&) = delete;
+
+		TextureTable(TextureTable const &) = delete;
+
+		TextureTable & operator=(TextureTable const &) = delete;
+
+		/**
+		 * \brief The device must be idle.
+		 */
+		~TextureTable();
+
+		/**
+		 * \brief Point the default slot at view (in SHADER_READ_ONLY_OPTIMAL), which must outlive the table.
+		 */
+		void setDefault(VkImageView view);
+
+		/**
+		 * \brief Allocate a slot for view (in SHADER_READ_ONLY_OPTIMAL). Thread safe.
+		 * \returns Nothing (after logging) if the table is full.
+		 */
+		std::optional<std::uint32_t> allocate(VkImageView view, Sampler sampler = Sampler::eLinear);
+
+		/**
+		 * \brief Free slots no submitted frame has used, e.g. of a reload that failed. Thread safe.
+		 */
+		void release(std::span<std::uint32_t const> slots);
+
+		/**
+		 * \brief Free slots once the frames in flight are done with them, keeping keepAlive (the owner of the views) until then.
+		 */
+		void retire(std::span<std::uint32_t const> slots, std::shared_ptr<void const> keepAlive);
+
+		/**
+		 * \brief Recycle slots retired frameCount frames ago. Frame thread; once per frame.
+		 */
+		void beginFrame(std::uint64_t frame);
+
+		void bind(VkCommandBuffer cmd, VkPipelineLayout layout, std::uint32_t set = 0) const;
+
+		/**
+		 * \brief Descriptor set layout to put in pipeline layouts that sample from the table.
+		 */
+		[[nodiscard]] VkDescriptorSetLayout layout() const { return m_layout; }
+
+		[[nodiscard]] Stats getStats() const;
+
+	private:
+		struct Retired
+		{
+			std::uint64_t frame{};
+			std::vector<std::uint32_t> slots{};
+			std::shared_ptr<void const> keepAlive{};
+		};
+
+		void write(std::uint32_t slot, VkImageView view, Sampler sampler) const;
+
+		void free(std::uint32_t slot);
+
+		VkDevice m_device{};
+		std::uint32_t m_frameCount{};
+		std::uint32_t m_capacity{};
+		VkDescriptorSetLayout m_layout{};
+		VkDescriptorPool m_pool{};
+		VkDescriptorSet m_set{};
+		std::array<VkSampler, static_cast<std::size_t>(Sampler::eCOUNT_)> m_samplers{};
+		VkImageView m_default{};
+
+		mutable std::mutex m_mutex{};
+		std::vector<std::uint32_t> m_free{};
+		std::uint32_t m_used{};
+		std::uint32_t m_highWater{};
+		std::vector<Retired> m_retired{};
+		std::uint64_t m_frame{};
+	};
+} // namespace bk::gpu
@@ -0,0 +1,203 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <span>
+#include <vector>
+
+#include "breakout/gpu/vk_types.hpp"
+
+namespace bk::gpu
+{
+	struct Device;
+
+	/**
+	 * \brief Identifies the batch an upload was put in: the value the upload timeline semaphore reaches once it is done.
+	 */
+	enum struct UploadTicket : std::uint64_t
+	{
+	};
+
+	/**
+	 * \brief Streams buffer and image contents to the GPU without blocking the frame.
+	 * Uploads from any thread are copied into a shared staging ring and recorded together into one command buffer per
+	 * submit(), on the device's transfer queue when it has one. Each batch signals a timeline semaphore; completion is
+	 * polled once per frame, never waited on. Uploads that do not fit the ring get a staging buffer of their own.
+	 *
+	 * With a separate transfer queue family, destinations are released to the graphics family after the copy and
+	 * recordAcquires() has to be recorded at the start of the graphics frame that first uses them.
+	 */
+	class UploadQueue
+	{
+	public:
+		using Clock = std::chrono::steady_clock;
+
+		struct Config
+		{
+			VkDeviceSize stagingCapacity{64ull << 20u};
+		};
+
+		struct Stats
+		{
+			std::uint64_t uploads{};
+			std::uint64_t batches{};
+			std::uint64_t bytes{};         // Submitted so far
+			std::uint64_t overflowBytes{}; // Staged outside the ring because it was full
+			double throughputMBps{};       // Bytes over time from submit until completion was observed, so a lower bound
+			Clock::duration lastStall{};   // Time the frame thread spent in the most recent submit()
+			Clock::duration maxStall{};
+			Clock::duration totalStall{};
+		};
+
+		UploadQueue(Device const & device, Config const & config);
+
+		UploadQueue(UploadQueue &&) = delete;
+
+		UploadQueue & operator=(UploadQueue &&) = delete;
+
+		UploadQueue(UploadQueue const &) = delete;
+
+		UploadQueue & operator=(UploadQueue const &) = delete;
+
+		/**
+		 * \brief Waits for submitted batches and drops unsubmitted ones.
+		 */
+		~UploadQueue();
+
+		/**
+		 * \brief Copy data into dst at dstOffset. Thread safe; data may be released on return.
+		 * dst must stay alive until the returned ticket is complete.
+		 */
+		UploadTicket upload(std::span<std::byte const> data, VkBuffer dst, VkDeviceSize dstOffset = 0);
+
+		/**
+		 * \brief Fill mip 0 of a 2D image, which ends up in finalLayout. Thread safe.
+		 * \param data Tightly packed texels covering extent.
+		 */
+		UploadTicket upload(std::span<std::byte const> data, VkImage dst, VkExtent3D extent, VkImageLayout finalLayout,
+							VkImageAspectFlags aspect = VK_IMAGE_ASPECT_COLOR_BIT);
+
+		/**
+		 * \brief Record and submit everything uploaded since the last call. Frame thread only.
+		 * \returns The ticket of the submitted batch, or of the previous one if nothing was pending.
+		 */
+		UploadTicket submit();
+
+		/**
+		 * \brief Retire completed batches and recycle their staging memory. Frame thread only; call once per frame.
+		 */
+		void poll();
+
+		/**
+		 * \brief Whether the batch had completed as of the last poll().
+		 */
+		[[nodiscard]] bool isComplete(UploadTicket ticket) const { return static_cast<std::uint64_t>(ticket) <= m_completed; }
+
+		/**
+		 * \brief Block until ticket is complete. For startup and tools; the frame loop should poll instead.
+		 */
+		void wait(UploadTicket ticket);
+
+		/**
+		 * \brief Record the queue family acquires for batches completed as of the last poll(), on the graphics queue.
+		 * \returns The semaphore value the submission containing cmd must wait for (already reached, so the wait is free),
+		 * or 0 if there is nothing to wait for.
+		 */
+		std::uint64_t recordAcquires(VkCommandBuffer cmd);
+
+		[[nodiscard]] VkSemaphore semaphore() const { return m_semaphore; }
+
+		[[nodiscard]] Stats getStats() const;
+
+	private:
+		struct Copy
+		{
+			VkBuffer staging{};
+			VkDeviceSize stagingOffset{};
+			VkDeviceSize size{};
+
+			VkBuffer dstBuffer{};
+			VkDeviceSize dstOffset{};
+
+			VkImage dstImage{};
+			VkExtent3D extent{};
+			VkImageLayout finalLayout{};
+			VkImageAspectFlags aspect{};
+		};
+
+		struct Dedicated
+		{
+			VkBuffer buffer{};
+			VmaAllocation allocation{};
+		};
+
+		struct Batch
+		{
+			VkCommandPool pool{};
+			VkCommandBuffer cmd{};
+			std::uint64_t value{};
+			VkDeviceSize ringEnd{};
+			VkDeviceSize bytes{};
+			Clock::time_point submitted{};
+			std::vector<Dedicated> dedicated{};
+			std::vector<VkBufferMemoryBarrier2> bufferAcquires{};
+			std::vector<VkImageMemoryBarrier2> imageAcquires{};
+		};
+
+		struct Staging
+		{
+			VkBuffer buffer{};
+			VkDeviceSize offset{};
+			std::byte * data{};
+			Dedicated dedicated{};
+		};
+
+		Staging reserve(VkDeviceSize size, VkDeviceSize alignment);
+
+		UploadTicket push(Copy const & copy, Dedicated dedicated);
+
+		void record(Batch & batch, std::span<Copy> copies) const;
+
+		void retire(Batch & batch);
+
+		Batch acquireBatch();
+
+		VkDevice m_device{};
+		VmaAllocator m_allocator{};
+		VkQueue m_queue{};
+		std::uint32_t m_family{};
+		std::uint32_t m_graphicsFamily{};
+		VkDeviceSize m_copyAlignment{};
+
+		VkBuffer m_ring{};
+		VmaAllocation m_ringAllocation{};
+		std::byte * m_ringData{};
+		VkDeviceSize m_capacity{};
+
+		VkSemaphore m_semaphore{};
+		std::uint64_t m_completed{};
+
+		// Shared with uploading threads. Ring offsets grow monotonically; the physical offset is modulo capacity.
+		mutable std::mutex m_mutex{};
+		std::condition_variable m_writersDone{};
+		VkDeviceSize m_head{};
+		VkDeviceSize m_tail{};
+		std::uint32_t m_writers{};
+		std::uint64_t m_nextValue{1};
+		std::vector<Copy> m_pending{};
+		std::vector<Dedicated> m_pendingDedicated{};
+		Stats m_stats{};
+
+		// Frame thread only.
+		std::deque<Batch> m_inFlight{};
+		std::vector<Batch> m_free{};
+		std::vector<VkBufferMemoryBarrier2> m_bufferAcquires{};
+		std::vector<VkImageMemoryBarrier2> m_imageAcquires{};
+		std::uint64_t m_busyBytes{};
+		Clock::duration m_busyTime{};
+	};
+} // namespace bk::gpu
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <memory>
+#include <string_view>
+
+#include "breakout/gpu/vk_types.hpp"
+
+struct SDL_Window;
+
+namespace bk::gpu
+{
+	struct DeviceConfig
+	{
+		std::string_view appName{"Breakout"};
+		bool enableValidationLayers{false};
+
+		/**
+		 * \brief Window to present to. Null creates a headless device without a surface, e.g. to run on lavapipe
+		 * (VK_ICD_FILENAMES=.../lvp_icd.x86_64.json) on machines without a GPU.
+		 */
+		SDL_Window * window{};
+	};
+
+	/**
+	 * \brief Vulkan instance, device, queues and memory allocator shared by the renderer.
+	 * Requires Vulkan 1.3 with dynamic rendering, synchronization2, timeline semaphores and buffer device address.
+	 */
+	struct Device
+	{
+		/**
+		 * \returns null (after logging why) if no suitable device was found.
+		 */
+		static std::unique_ptr<Device> create(DeviceConfig const & config);
+
+		Device() = default;
+
+		Device(Device &&) = delete;
+
+		Device & operator=(Device &&) = delete;
+
+		Device(Device const &) = delete;
+
+		Device & operator=(Device const &) = delete;
+
+		~Device();
+
+		[[nodiscard]] bool isHeadless() const { return surface == VK_NULL_HANDLE; }
+
+		[[nodiscard]] bool hasTransferQueue() const { return transferQueueFamily != graphicsQueueFamily; }
+
+		VkInstance instance{};
+		VkDebugUtilsMessengerEXT debugMessenger{};
+		VkSurfaceKHR surface{};
+		VkPhysicalDevice physicalDevice{};
+		VkPhysicalDeviceProperties properties{};
+		VkDevice device{};
+
+		VkQueue graphicsQueue{};
+		std::uint32_t graphicsQueueFamily{};
+
+		// A queue family without graphics for uploads when the device has one (DMA engine); the graphics queue otherwise.
+		VkQueue transferQueue{};
+		std::uint32_t transferQueueFamily{};
+
+		VmaAllocator allocator{};
+
+		// VK_EXT_calibrated_timestamps is enabled (GPU profiler zones line up with CPU zones)
+		bool calibratedTimestamps{};
+	};
+} // namespace bk::gpu
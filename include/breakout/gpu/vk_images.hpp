@@ -0,0 +1,26 @@
+#pragma once
+
+#include "breakout/gpu/vk_types.hpp"
+
+namespace bk::gpu
+{
+	struct Device;
+
+	/**
+	 * \brief Create a device local 2D image with a view covering it.
+	 */
+	AllocatedImage createImage(Device const & device, VkExtent3D extent, VkFormat format, VkImageUsageFlags usage);
+
+	void destroyImage(Device const & device, AllocatedImage & image);
+
+	/**
+	 * \brief Full pipeline barrier moving every subresource of image to newLayout. Simple rather than fast; fine for a
+	 * handful of images per frame.
+	 */
+	void transitionImage(VkCommandBuffer cmd, VkImage image, VkImageLayout currentLayout, VkImageLayout newLayout);
+
+	/**
+	 * \brief Blit (scaling with linear filtering) src, in TRANSFER_SRC_OPTIMAL, onto dst, in TRANSFER_DST_OPTIMAL.
+	 */
+	void copyImageToImage(VkCommandBuffer cmd, VkImage src, VkImage dst, VkExtent2D srcSize, VkExtent2D dstSize);
+} // namespace bk::gpu
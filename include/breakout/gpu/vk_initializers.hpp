@@ -1,3 +1,36 @@
-
 #pragma once
 
+#include <span>
+
+#include "breakout/gpu/vk_types.hpp"
+
+/**
+ * \brief Builders for the Vulkan structs filled the same way all over the renderer.
+ */
+namespace bk::gpu::init
+{
+	VkCommandBufferBeginInfo commandBufferBeginInfo(VkCommandBufferUsageFlags flags = 0);
+
+	VkCommandBufferSubmitInfo commandBufferSubmitInfo(VkCommandBuffer cmd);
+
+	VkSemaphoreSubmitInfo semaphoreSubmitInfo(VkPipelineStageFlags2 stageMask, VkSemaphore semaphore, std::uint64_t value = 0);
+
+	VkSubmitInfo2 submitInfo(VkCommandBufferSubmitInfo const * cmd, std::span<VkSemaphoreSubmitInfo const> wait = {},
+							 std::span<VkSemaphoreSubmitInfo const> signal = {});
+
+	VkImageSubresourceRange imageSubresourceRange(VkImageAspectFlags aspectMask);
+
+	VkImageCreateInfo imageCreateInfo(VkFormat format, VkImageUsageFlags usage, VkExtent3D extent);
+
+	VkImageViewCreateInfo imageViewCreateInfo(VkFormat format, VkImage image, VkImageAspectFlags aspectMask);
+
+	/**
+	 * \param clear Clears the attachment when set, loads it otherwise.
+	 */
+	VkRenderingAttachmentInfo attachmentInfo(VkImageView view, VkClearValue const * clear, VkImageLayout layout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL);
+
+	/**
+	 * \param depth May be null.
+	 */
+	VkRenderingInfo renderingInfo(VkExtent2D extent, VkRenderingAttachmentInfo const * color, VkRenderingAttachmentInfo const * depth);
+} // namespace bk::gpu::init
@@ -26,3 +26,18 @@ fmt::print("Detected Vulkan error: {}", string_VkResult(err)); \
 abort();                                                    \
 }                                                               \
 } while (0)
+
+namespace bk::gpu
+{
+	/**
+	 * \brief Image with its default view and the memory backing it.
+	 */
+	struct AllocatedImage
+	{
+		VkImage image{};
+		VkImageView view{};
+		VmaAllocation allocation{};
+		VkExtent3D extent{};
+		VkFormat format{VK_FORMAT_UNDEFINED};
+	};
+} // namespace bk::gpu
@@ -0,0 +1,147 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <span>
+#include <vector>
+
+#include <glm/mat4x4.hpp>
+#include <glm/vec2.hpp>
+
+#include "breakout/gpu/sprite_batch.hpp"
+
+namespace bk
+{
+	class ThreadPool;
+} // namespace bk
+
+namespace bk::soft
+{
+	/**
+	 * \brief CPU side texture: RGBA8 texels, R in the lowest byte, rows top to bottom. Not owned.
+	 */
+	struct Texture
+	{
+		std::uint32_t width{};
+		std::uint32_t height{};
+		std::span<std::uint32_t const> texels{};
+	};
+
+	/**
+	 * \brief Draws the 2D sprite path on the CPU, for machines without a GPU (build agents, golden image tests, CPU benchmarks).
+	 * Takes the instances SpriteBatch::build() writes for the GPU, in the same order, and matches shaders/sprite.* and the
+	 * sprite pipeline's blend state: texel * tint, then src-alpha/one-minus-src-alpha (alpha: one/one-minus-src-alpha).
+	 * Sampling is nearest with clamp to edge; there is no filtering.
+	 *
+	 * The framebuffer is split into tile_size_v square tiles. Sprites are binned to the tiles they overlap, in instance
+	 * order, then the tiles are cleared and shaded in parallel: each tile belongs to one thread, so no two threads touch a
+	 * pixel and blending stays in order. Rows are shaded 8 pixels at a time with AVX2 where the build targets it (x86-64-v3),
+	 * with a scalar fallback elsewhere.
+	 */
+	class Rasterizer
+	{
+	public:
+		static constexpr std::uint32_t tile_size_v{64};
+
+		struct Config
+		{
+			std::uint32_t width{};
+			std::uint32_t height{};
+		};
+
+		struct Stats
+		{
+			std::uint32_t sprites{}; // Drawn last frame, after dropping degenerate and off-screen ones
+			std::uint32_t tiles{};
+			std::uint64_t binned{};  // (tile, sprite) pairs shaded
+			std::uint64_t covered{}; // Pixels inside a sprite, counted over all sprites
+		};
+
+		/**
+		 * \returns Whether rows are shaded with the AVX2 kernels in this build.
+		 */
+		static bool isSimd();
+
+		Rasterizer(ThreadPool & pool, Config const & config);
+
+		Rasterizer(Rasterizer &&) = delete;
+
+		Rasterizer & operator=(Rasterizer &&) = delete;
+
+		Rasterizer(Rasterizer const &) = delete;
+
+		Rasterizer & operator=(Rasterizer const &) = delete;
+
+		~Rasterizer() = default;
+
+		void resize(std::uint32_t width, std::uint32_t height);
+
+		/**
+		 * \brief What sprites with SpriteInstance::texture == slot sample. Unset slots (and slot 0, by default) are white.
+		 */
+		void setTexture(std::uint32_t slot, Texture const & texture);
+
+		/**
+		 * \brief Clear to clearColor and draw instances, in order, blocking until the frame is done.
+		 * \param viewProj As pushed to the GPU pipelines; Vulkan NDC, y down.
+		 */
+		void draw(std::span<gpu::SpriteInstance const> instances, glm::mat4 const & viewProj, std::uint32_t clearColor = 0xff000000);
+
+		/**
+		 * \brief The last frame: RGBA8, R in the lowest byte, width() * height() pixels, rows top to bottom.
+		 */
+		[[nodiscard]] std::span<std::uint32_t const> pixels() const { return m_pixels; }
+
+		[[nodiscard]] std::uint32_t width() const { return m_width; }
+
+		[[nodiscard]] std::uint32_t height() const { return m_height; }
+
+		/**
+		 * \brief Write the last frame as a PNG.
+		 * \returns false (after logging) on failure.
+		 */
+		bool write(std::filesystem::path const & path) const;
+
+		[[nodiscard]] Stats const & getStats() const { return m_stats; }
+
+	private:
+		/**
+		 * \brief A sprite set up for shading: its screen space bounds and the plane equations of everything interpolated.
+		 * (s, t) are the quad coordinates in [0, 1), which decide coverage; (u, v) are texel coordinates.
+		 */
+		struct Setup
+		{
+			glm::vec2 min{};
+			glm::vec2 max{};
+			// Value at the screen origin, then per pixel step in x and y.
+			float s{};
+			float sx{};
+			float sy{};
+			float t{};
+			float tx{};
+			float ty{};
+			float u{};
+			float ux{};
+			float uy{};
+			float v{};
+			float vx{};
+			float vy{};
+			std::uint32_t color{};
+			Texture texture{}; // Empty for untextured sprites, which take the solid color path
+		};
+
+		void shadeTile(std::uint32_t tile, std::uint32_t clearColor);
+
+		ThreadPool & m_pool;
+		std::uint32_t m_width{};
+		std::uint32_t m_height{};
+		std::uint32_t m_tilesX{};
+		std::uint32_t m_tilesY{};
+		std::vector<std::uint32_t> m_pixels{};
+		std::vector<Texture> m_textures{};
+		std::vector<Setup> m_setups{};
+		std::vector<std::vector<std::uint32_t>> m_bins{}; // Indices into m_setups per tile, in draw order
+		std::vector<std::uint64_t> m_covered{};           // Per tile, summed into m_stats
+		Stats m_stats{};
+	};
+} // namespace bk::soft
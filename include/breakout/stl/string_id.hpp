@@ -0,0 +1,84 @@
+#pragma once
+
+#include <compare>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string_view>
+
+#include "breakout/stl/fixed_string.hpp"
+
+namespace bk
+{
+    ///
+    /// \brief 64 bit FNV-1a: a byte at a time, but simple enough to run at compile time.
+    ///
+    constexpr std::uint64_t fnv1a(std::string_view const text)
+    {
+        auto ret = std::uint64_t{0xcbf29ce484222325};
+        for (auto const c : text)
+        {
+            ret ^= static_cast<std::uint8_t>(c);
+            ret *= std::uint64_t{0x100000001b3};
+        }
+        return ret;
+    }
+
+    ///
+    /// \brief Longest name the intern table keeps; longer ones are truncated there (the ID still covers the whole text).
+    ///
+    inline constexpr std::size_t string_id_capacity_v{256};
+
+    ///
+    /// \brief Hashed string: compared, ordered and hashed as an integer.
+    /// Constructing one only hashes (at compile time for literals, see _sid). intern() also records the text in a global
+    /// table, so name() can map IDs back for logs and debuggers; debug builds abort when two different strings interned
+    /// there hash to the same ID.
+    ///
+    class StringId
+    {
+    public:
+        StringId() = default;
+
+        constexpr explicit StringId(std::string_view const text) : m_value(fnv1a(text)) {}
+
+        ///
+        /// \brief Hash text and record it in the intern table. Thread safe.
+        ///
+        static StringId intern(std::string_view text);
+
+        ///
+        /// \returns The text this ID was interned with, or an empty view if it never was. Stays valid for the program's lifetime.
+        ///
+        [[nodiscard]] std::string_view name() const;
+
+        [[nodiscard]] constexpr std::uint64_t value() const { return m_value; }
+
+        constexpr explicit operator bool() const { return m_value != 0; }
+
+        constexpr bool operator==(StringId const &) const = default;
+
+        constexpr auto operator<=>(StringId const &) const = default;
+
+    private:
+        std::uint64_t m_value{};
+    };
+
+    namespace literals
+    {
+        consteval StringId operator""_sid(char const * text, std::size_t const size) { return StringId{std::string_view{text, size}}; }
+    } // namespace literals
+
+    // unit tests
+
+    static_assert(fnv1a("") == 0xcbf29ce484222325);
+    static_assert(fnv1a("a") == 0xaf63dc4c8601ec8c);
+    static_assert(StringId{FixedString{"general"}.view()} == StringId{"general"});
+} // namespace bk
+
+template <>
+struct std::hash<bk::StringId>
+{
+    // Already a well mixed 64 bit hash.
+    std::size_t operator()(bk::StringId const id) const noexcept { return static_cast<std::size_t>(id.value()); }
+};
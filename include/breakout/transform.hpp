@@ -0,0 +1,137 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include <glm/gtc/quaternion.hpp>
+#include <glm/mat4x4.hpp>
+#include <glm/vec3.hpp>
+
+namespace bk
+{
+	struct SinCos
+	{
+		float sin{};
+		float cos{};
+	};
+
+	/**
+	 * \brief sin and cos of one angle in single precision, sharing the range reduction: within 1e-7 of the exact values
+	 * for |radians| up to about 1e4, losing accuracy gradually beyond that.
+	 */
+	[[nodiscard]] SinCos fastSinCos(float radians);
+
+	/**
+	 * \brief Position, rotation and scale of many objects, and the matrices made of them.
+	 * Components are stored as structure-of-arrays and processed in groups of 8, with AVX2 where the build targets it
+	 * (x86-64-v3) and a scalar fallback elsewhere. Setters mark a transform's group dirty; update() rebuilds the world
+	 * matrices of dirty groups only, and world-view-projection matrices of dirty groups, or of all of them when the
+	 * view-projection changed. Keep objects that move every frame next to each other, so they dirty as few groups as
+	 * possible.
+	 */
+	class Transforms
+	{
+	public:
+		static constexpr std::size_t group_size_v{8};
+
+		struct Trs
+		{
+			glm::vec3 position{0.0f};
+			glm::quat rotation{1.0f, 0.0f, 0.0f, 0.0f}; // Unit quaternion; w first
+			glm::vec3 scale{1.0f};
+		};
+
+		struct Stats
+		{
+			std::uint32_t worldUpdates{};    // Transforms whose world matrix the last update() rebuilt, in whole groups
+			std::uint32_t viewProjUpdates{}; // The same for world-view-projection matrices
+		};
+
+		void reserve(std::size_t count);
+
+		void clear();
+
+		/**
+		 * \returns The index of the new transform, valid until remove() moves another one into it.
+		 */
+		std::uint32_t add(Trs const & trs);
+
+		/**
+		 * \brief Remove a transform by moving the last one into its index.
+		 */
+		void remove(std::uint32_t index);
+
+		[[nodiscard]] std::size_t size() const { return m_count; }
+
+		void set(std::uint32_t index, Trs const & trs);
+
+		void setPosition(std::uint32_t index, glm::vec3 const & position);
+
+		void setRotation(std::uint32_t index, glm::quat const & rotation);
+
+		/**
+		 * \brief Rotation about the z axis, for objects in the xy plane (sprites).
+		 */
+		void setRotationZ(std::uint32_t index, float radians);
+
+		void setScale(std::uint32_t index, glm::vec3 const & scale);
+
+		[[nodiscard]] Trs get(std::uint32_t index) const;
+
+		/**
+		 * \brief Rebuild the matrices that are out of date; without dirty transforms and with the same viewProj, a scan over
+		 * one flag per group.
+		 */
+		void update(glm::mat4 const & viewProj);
+
+		/**
+		 * \brief translate(position) * rotate(rotation) * scale(scale) per transform, as of the last update().
+		 */
+		[[nodiscard]] std::span<glm::mat4 const> world() const { return std::span{m_world}.first(m_count); }
+
+		/**
+		 * \brief viewProj * world per transform, as of the last update().
+		 */
+		[[nodiscard]] std::span<glm::mat4 const> worldViewProj() const { return std::span{m_worldViewProj}.first(m_count); }
+
+		[[nodiscard]] Stats const & getStats() const { return m_stats; }
+
+		/**
+		 * \returns Whether update() uses the AVX2 kernels in this build.
+		 */
+		static bool isSimd();
+
+	private:
+		void markDirty(std::uint32_t const index) { m_dirty[index / group_size_v] = 1; }
+
+		void updateGroup(std::size_t group, glm::mat4 const & viewProj, bool world);
+
+		[[nodiscard]] std::array<std::vector<float> *, 10> componentArrays()
+		{
+			return {&m_positionX, &m_positionY, &m_positionZ, &m_rotationX, &m_rotationY, &m_rotationZ, &m_rotationW, &m_scaleX, &m_scaleY, &m_scaleZ};
+		}
+
+		// Components, padded with identity transforms to a whole number of groups.
+		std::vector<float> m_positionX{};
+		std::vector<float> m_positionY{};
+		std::vector<float> m_positionZ{};
+		std::vector<float> m_rotationX{};
+		std::vector<float> m_rotationY{};
+		std::vector<float> m_rotationZ{};
+		std::vector<float> m_rotationW{};
+		std::vector<float> m_scaleX{};
+		std::vector<float> m_scaleY{};
+		std::vector<float> m_scaleZ{};
+		std::size_t m_count{};
+
+		std::vector<std::uint8_t> m_dirty{}; // Per group
+		std::vector<glm::mat4> m_world{};
+		std::vector<glm::mat4> m_worldViewProj{};
+		glm::mat4 m_viewProj{1.0f};
+		bool m_hasViewProj{false};
+		Stats m_stats{};
+	};
+} // namespace bk
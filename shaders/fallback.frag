@@ -0,0 +1,10 @@
+#version 450
+
+// Drawn while the real pipeline is still compiling (or failed to): an unmistakable magenta checkerboard.
+layout(location = 0) out vec4 outColor;
+
+void main()
+{
+	ivec2 cell = ivec2(gl_FragCoord.xy) / 16;
+	outColor = ((cell.x + cell.y) & 1) == 0 ? vec4(1.0, 0.0, 1.0, 1.0) : vec4(0.0, 0.0, 0.0, 1.0);
+}
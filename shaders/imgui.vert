@@ -0,0 +1,36 @@
+#version 450
+#extension GL_EXT_buffer_reference : require
+
+// Dear ImGui geometry (bk::gpu::ImGuiRenderer), pulled from the frame's ring buffer with no vertex buffers bound.
+// ImDrawVert (vec2 position, vec2 uv, packed RGBA8 color: 20 bytes) and 16 bit indices fit no std430 array stride,
+// so both are read as raw words. gl_VertexIndex walks the indices; gl_InstanceIndex carries the draw's vertex offset.
+layout(buffer_reference, std430, buffer_reference_align = 4) readonly buffer Words
+{
+	uint words[];
+};
+
+layout(push_constant) uniform Constants
+{
+	vec2 scale;
+	vec2 translate;
+	Words vertices;
+	Words indices;
+	uint texture;
+} constants;
+
+layout(location = 0) out vec2 outUV;
+layout(location = 1) out vec4 outColor;
+layout(location = 2) flat out uint outTexture;
+
+void main()
+{
+	uint word = constants.indices.words[gl_VertexIndex >> 1];
+	uint index = (gl_VertexIndex & 1) == 0 ? word & 0xffffu : word >> 16;
+	uint base = (uint(gl_InstanceIndex) + index) * 5u;
+
+	vec2 position = uintBitsToFloat(uvec2(constants.vertices.words[base], constants.vertices.words[base + 1u]));
+	gl_Position = vec4(position * constants.scale + constants.translate, 0.0, 1.0);
+	outUV = uintBitsToFloat(uvec2(constants.vertices.words[base + 2u], constants.vertices.words[base + 3u]));
+	outColor = unpackUnorm4x8(constants.vertices.words[base + 4u]);
+	outTexture = constants.texture;
+}
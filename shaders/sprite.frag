@@ -0,0 +1,17 @@
+#version 450
+#extension GL_EXT_nonuniform_qualifier : require
+
+layout(location = 0) in vec2 inUV;
+layout(location = 1) in vec4 inColor;
+layout(location = 2) flat in uint inTexture;
+
+// bk::gpu::TextureTable: every texture in one array, indexed by the sprite's slot.
+layout(set = 0, binding = 0) uniform sampler2D textures[];
+
+layout(location = 0) out vec4 outColor;
+
+void main()
+{
+	// Instances of one draw may use different slots, so the index is not dynamically uniform.
+	outColor = texture(textures[nonuniformEXT(inTexture)], inUV) * inColor;
+}
@@ -0,0 +1,48 @@
+#version 450
+#extension GL_EXT_buffer_reference : require
+
+// Instanced quads: instance data is pulled from the frame's instance buffer (bk::gpu::SpriteInstance), the corner from
+// gl_VertexIndex, so no vertex buffers are bound.
+struct SpriteInstance
+{
+	vec2 position;
+	vec2 size;
+	vec4 uvRect;
+	uint color;
+	float rotation;
+	uint texture;
+	uint padding;
+};
+
+layout(buffer_reference, std430, buffer_reference_align = 16) readonly buffer InstanceBuffer
+{
+	SpriteInstance instances[];
+};
+
+layout(push_constant) uniform Constants
+{
+	mat4 viewProj;
+	InstanceBuffer instanceBuffer;
+} constants;
+
+layout(location = 0) out vec2 outUV;
+layout(location = 1) out vec4 outColor;
+layout(location = 2) flat out uint outTexture;
+
+const vec2 corners[6] = vec2[](vec2(0.0, 0.0), vec2(1.0, 0.0), vec2(1.0, 1.0), vec2(1.0, 1.0), vec2(0.0, 1.0), vec2(0.0, 0.0));
+
+void main()
+{
+	SpriteInstance sprite = constants.instanceBuffer.instances[gl_InstanceIndex];
+	vec2 corner = corners[gl_VertexIndex];
+
+	float s = sin(sprite.rotation);
+	float c = cos(sprite.rotation);
+	vec2 local = (corner - 0.5) * sprite.size;
+	vec2 world = sprite.position + vec2(local.x * c - local.y * s, local.x * s + local.y * c);
+
+	gl_Position = constants.viewProj * vec4(world, 0.0, 1.0);
+	outUV = mix(sprite.uvRect.xy, sprite.uvRect.zw, corner);
+	outColor = unpackUnorm4x8(sprite.color);
+	outTexture = sprite.texture;
+}
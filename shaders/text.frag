@@ -0,0 +1,21 @@
+#version 450
+#extension GL_EXT_nonuniform_qualifier : require
+
+// Text drawn with sprite.vert: each glyph is a sprite sampling a game::GlyphAtlas, whose texels are the distance to the
+// glyph's outline (0.5 on it, more inside) rather than coverage.
+layout(location = 0) in vec2 inUV;
+layout(location = 1) in vec4 inColor;
+layout(location = 2) flat in uint inTexture;
+
+layout(set = 0, binding = 0) uniform sampler2D textures[];
+
+layout(location = 0) out vec4 outColor;
+
+void main()
+{
+	float distance = texture(textures[nonuniformEXT(inTexture)], inUV).r;
+	// How much the distance changes across one pixel on screen: the edge is antialiased over about a pixel at any size.
+	float width = max(fwidth(distance), 1e-4) * 0.5;
+	float coverage = smoothstep(0.5 - width, 0.5 + width, distance);
+	outColor = vec4(inColor.rgb, inColor.a * coverage);
+}
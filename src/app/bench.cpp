@@ -0,0 +1,706 @@
+#include "breakout/app/bench.hpp"
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <filesystem>
+#include <format>
+#include <limits>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <glm/gtc/matrix_transform.hpp>
+
+#include "breakout/camera.hpp"
+#include "breakout/core/logger.hpp"
+#include "breakout/core/mapped_file.hpp"
+#include "breakout/core/snapshot.hpp"
+#include "breakout/core/thread_pool.hpp"
+#include "breakout/game/font.hpp"
+#include "breakout/game/mesh.hpp"
+#include "breakout/game/shader.hpp"
+#include "breakout/game/text_cache.hpp"
+#include "breakout/gpu/command_recorder.hpp"
+#include "breakout/gpu/pipeline_cache.hpp"
+#include "breakout/gpu/sprite_batch.hpp"
+#include "breakout/gpu/vk_device.hpp"
+#include "breakout/soft/rasterizer.hpp"
+#include "breakout/transform.hpp"
+
+namespace bk::bench
+{
+	namespace
+	{
+		auto const s_log = Logger{"bench"};
+
+		using Clock = std::chrono::steady_clock;
+
+		double elapsedMs(Clock::time_point const start)
+		{
+			return std::chrono::duration<double, std::milli>{Clock::now() - start}.count();
+		}
+
+		std::uint32_t parseCount(std::span<std::string_view const> args, std::size_t const index, std::uint32_t const fallback)
+		{
+			if (args.size() <= index) { return fallback; }
+			return static_cast<std::uint32_t>(std::strtoul(std::string{args[index]}.c_str(), nullptr, 10));
+		}
+
+		// args: <mesh file> [cached iterations]
+		int meshCache(std::span<std::string_view const> args)
+		{
+			if (args.empty())
+			{
+				s_log.error("usage: --bench mesh <file.obj|file.gltf|file.glb> [iterations]");
+				return EXIT_FAILURE;
+			}
+
+			auto const source     = std::filesystem::path{args[0]};
+			auto const iterations = std::max(parseCount(args, 1, 10), 1U);
+			auto pool             = ThreadPool{};
+
+			auto error = std::error_code{};
+			std::filesystem::remove(game::Mesh::cachePath(source), error);
+
+			auto start          = Clock::now();
+			auto const imported = game::Mesh::load(source, pool);
+			auto const firstRun = elapsedMs(start);
+			if (!imported) { return EXIT_FAILURE; }
+
+			auto best  = firstRun;
+			auto total = 0.0;
+			for (std::uint32_t i = 0; i < iterations; ++i)
+			{
+				start             = Clock::now();
+				auto const cached = game::Mesh::load(source, pool);
+				auto const ms     = elapsedMs(start);
+				if (!cached || !cached->isMapped())
+				{
+					s_log.error("cached load of '{}' did not hit the cache", source.string());
+					return EXIT_FAILURE;
+				}
+				best   = std::min(best, ms);
+				total += ms;
+			}
+
+			s_log.info("mesh '{}': {} vertices, {} indices", source.string(), imported->vertices().size(), imported->indices().size());
+			s_log.info("first run (parse + weld + optimize + write): {:.3f}ms", firstRun);
+			s_log.info(
+				"cached run (mmap), {} iterations: best {:.3f}ms, avg {:.3f}ms ({:.1f}x faster)", iterations, best, total / iterations, firstRun / best);
+			return EXIT_SUCCESS;
+		}
+
+		// args: [iterations]
+		// CPU side only: submit + sort + instance write per frame; no device needed.
+		int spriteBatch(std::span<std::string_view const> args)
+		{
+			constexpr auto counts_v          = std::array<std::uint32_t, 3>{10'000, 100'000, 1'000'000};
+			constexpr std::uint16_t textures = 32;
+			constexpr std::uint8_t layers    = 4;
+
+			auto const iterations = std::max(parseCount(args, 0, 20), 1U);
+			auto random           = std::mt19937{42};
+
+			for (auto const count : counts_v)
+			{
+				// Generated once so the timing only covers what a frame would do with them.
+				auto sprites = std::vector<gpu::Sprite>(count);
+				for (auto & sprite : sprites)
+				{
+					sprite.position = {static_cast<float>(random() % 1920), static_cast<float>(random() % 1080)};
+					sprite.size     = {16.0f, 16.0f};
+					sprite.texture  = static_cast<std::uint16_t>(random() % textures);
+					sprite.layer    = static_cast<std::uint8_t>(random() % layers);
+				}
+
+				auto batch = gpu::SpriteBatch{};
+				batch.reserve(count);
+				auto instances = std::vector<gpu::SpriteInstance>(count);
+
+				auto best  = std::numeric_limits<double>::max();
+				auto total = 0.0;
+				for (std::uint32_t i = 0; i < iterations; ++i)
+				{
+					auto const start = Clock::now();
+					batch.clear();
+					for (auto const & sprite : sprites) { batch.submit(sprite); }
+					batch.build(instances);
+					auto const ms = elapsedMs(start);
+					best          = std::min(best, ms);
+					total        += ms;
+				}
+
+				auto const & stats = batch.getStats();
+				s_log.info("{:>8} sprites: best {:.3f}ms, avg {:.3f}ms ({:.1f}ns/sprite), {} draws, {} sort passes", count, best, total / iterations,
+						   best * 1e6 / count, stats.draws, stats.sortPasses);
+			}
+			return EXIT_SUCCESS;
+		}
+
+		// args: [objects] [iterations]
+		int frustumCull(std::span<std::string_view const> args)
+		{
+			auto const count      = std::max(parseCount(args, 0, 100'000), 1U);
+			auto const iterations = std::max(parseCount(args, 1, 100), 1U);
+			auto random           = std::mt19937{42};
+
+			// Objects scattered around a camera at the origin, which sees about one in twenty.
+			auto position = std::uniform_real_distribution<float>{-100.0f, 100.0f};
+			auto size     = std::uniform_real_distribution<float>{0.1f, 2.0f};
+			auto x        = std::vector<float>(count);
+			auto y        = std::vector<float>(count);
+			auto z        = std::vector<float>(count);
+			auto radius   = std::vector<float>(count);
+			for (std::uint32_t i = 0; i < count; ++i)
+			{
+				x[i]      = position(random);
+				y[i]      = position(random);
+				z[i]      = position(random);
+				radius[i] = size(random);
+			}
+			auto camera = Camera{};
+			camera.SetClipPlanes(0.1f, 150.0f);
+			auto const & frustum = camera.GetFrustum();
+
+			// Rects reuse the same arrays: (x, y) min corners, grown by the radius.
+			auto maxX = std::vector<float>(count);
+			auto maxY = std::vector<float>(count);
+			for (std::uint32_t i = 0; i < count; ++i)
+			{
+				maxX[i] = x[i] + radius[i];
+				maxY[i] = y[i] + radius[i];
+			}
+
+			auto visible    = std::vector<std::uint32_t>(count);
+			auto const time = [&](std::string_view const name, auto const & cull)
+			{
+				auto best    = std::numeric_limits<double>::max();
+				auto written = std::size_t{};
+				for (std::uint32_t i = 0; i < iterations; ++i)
+				{
+					auto const start = Clock::now();
+					written          = cull();
+					best             = std::min(best, elapsedMs(start));
+				}
+				s_log.info("{:>8}: best {:.3f}ms ({:.2f}ns/object), {} of {} visible", name, best, best * 1e6 / count, written, count);
+			};
+
+			s_log.info("{} objects, {} kernels, {} iterations", count, isCullingSimd() ? "AVX2" : "scalar", iterations);
+			time("spheres", [&] { return cullSpheres(frustum, {x, y, z, radius}, visible); });
+			time("boxes", [&] { return cullBoxes(frustum, {x, y, z, radius, radius, radius}, visible); });
+			time("rects", [&] { return cullRects({-50.0f, -50.0f, 50.0f, 50.0f}, {x, y, maxX, maxY}, visible); });
+			return EXIT_SUCCESS;
+		}
+
+		// args: [sprites] [max threads] [iterations]
+		// Needs a device but no window; run against lavapipe on machines without a GPU. Nothing is submitted.
+		int recordScaling(std::span<std::string_view const> args)
+		{
+			constexpr std::uint32_t passes_v = 64;
+			constexpr std::uint16_t textures = 512;
+			constexpr auto color_format_v    = VK_FORMAT_R8G8B8A8_UNORM;
+
+			auto const spriteCount = std::max(parseCount(args, 0, 100'000), 1U);
+			auto const maxThreads  = std::max(parseCount(args, 1, ThreadPool::defaultWorkerCount() + 1), 1U);
+			auto const iterations  = std::max(parseCount(args, 2, 50), 1U);
+
+			auto const device = gpu::Device::create({.appName = "Breakout bench"});
+			if (!device) { return EXIT_FAILURE; }
+			s_log.info("recording on '{}'", device->properties.deviceName);
+
+			// The calling thread records too.
+			auto pool      = ThreadPool{maxThreads - 1};
+			auto pipelines = gpu::PipelineCache{*device, pool, std::filesystem::temp_directory_path() / "breakout-bench", 1};
+
+			auto const vertex   = game::Shader::load(device->device, game::Shader::directory() / "sprite.vert.spv");
+			auto const fragment = game::Shader::load(device->device, game::Shader::directory() / "sprite.frag.spv");
+			if (!vertex || !fragment) { return EXIT_FAILURE; }
+
+			auto pushConstants       = VkPushConstantRange{};
+			pushConstants.stageFlags = VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT;
+			pushConstants.size       = sizeof(gpu::SpritePushConstants);
+
+			auto layoutInfo                   = VkPipelineLayoutCreateInfo{};
+			layoutInfo.sType                  = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+			layoutInfo.pushConstantRangeCount = 1;
+			layoutInfo.pPushConstantRanges    = &pushConstants;
+			auto layout                       = VkPipelineLayout{};
+			VK_CHECK(vkCreatePipelineLayout(device->device, &layoutInfo, nullptr, &layout));
+
+			auto const pipeline = std::array{pipelines.getNow({
+				.vertex       = vertex,
+				.fragment     = fragment,
+				.vertexHash   = vertex->hash(),
+				.fragmentHash = fragment->hash(),
+				.layout       = layout,
+				.colorFormat  = color_format_v,
+				.alphaBlend   = true,
+			})};
+
+			auto random = std::mt19937{42};
+			auto batch  = gpu::SpriteBatch{};
+			batch.reserve(spriteCount);
+			for (std::uint32_t i = 0; i < spriteCount; ++i)
+			{
+				batch.submit({
+					.position = {static_cast<float>(random() % 1920), static_cast<float>(random() % 1080)},
+					.size     = {16.0f, 16.0f},
+					.texture  = static_cast<std::uint16_t>(random() % textures),
+				});
+			}
+			auto instances   = std::vector<gpu::SpriteInstance>(spriteCount);
+			auto const draws = batch.build(instances);
+
+			// The same passes whatever the thread count, so only the parallelism changes.
+			auto const viewProj = glm::mat4{1.0f};
+			auto passList       = std::vector<gpu::CommandRecorder::Pass>{};
+			for (std::uint32_t i = 0; i < passes_v; ++i)
+			{
+				auto const first = draws.size() * i / passes_v;
+				auto const range = draws.subspan(first, draws.size() * (i + 1) / passes_v - first);
+				passList.emplace_back([&, range](VkCommandBuffer const cmd) { gpu::SpriteBatch::record(cmd, layout, pipeline, viewProj, 0, range); });
+			}
+
+			auto const target = gpu::RenderTarget{.colorFormat = color_format_v, .extent = {1920, 1080}};
+			auto threadCounts = std::vector<std::uint32_t>{};
+			for (std::uint32_t threads = 1; threads < maxThreads; threads *= 2) { threadCounts.push_back(threads); }
+			threadCounts.push_back(maxThreads);
+
+			auto singleThread = 0.0;
+			for (auto const threads : threadCounts)
+			{
+				auto recorder = gpu::CommandRecorder{*device, pool, {.frameCount = 1, .contextCount = threads}};
+				// Untimed first frame: allocates the command buffers.
+				recorder.beginFrame(0);
+				recorder.record(passList, target);
+
+				auto best  = std::numeric_limits<double>::max();
+				auto total = 0.0;
+				for (std::uint32_t i = 0; i < iterations; ++i)
+				{
+					auto const start = Clock::now();
+					recorder.beginFrame(0);
+					recorder.record(passList, target);
+					auto const ms = elapsedMs(start);
+					best          = std::min(best, ms);
+					total        += ms;
+				}
+
+				if (threads == 1) { singleThread = best; }
+				s_log.info("{:>3} threads: best {:.3f}ms, avg {:.3f}ms ({:.2f}x)", threads, best, total / iterations, singleThread / best);
+			}
+			s_log.info("{} sprites, {} draws in {} secondary command buffers, {} iterations", spriteCount, draws.size(), passes_v, iterations);
+
+			vkDestroyPipelineLayout(device->device, layout, nullptr);
+			return EXIT_SUCCESS;
+		}
+
+		// args: [sprites] [max threads] [iterations]
+		// CPU only: the software rasterizer drawing 1080p frames of rotated, alpha blended sprites, half of them textured.
+		int softwareRaster(std::span<std::string_view const> args)
+		{
+			constexpr std::uint32_t width     = 1920;
+			constexpr std::uint32_t height    = 1080;
+			constexpr std::uint32_t texture_v = 64;
+			constexpr std::uint16_t textures  = 4;
+
+			auto const spriteCount = std::max(parseCount(args, 0, 100'000), 1U);
+			auto const maxThreads  = std::max(parseCount(args, 1, ThreadPool::defaultWorkerCount() + 1), 1U);
+			auto const iterations  = std::max(parseCount(args, 2, 20), 1U);
+
+			// Checkerboards with translucent squares, so both the gather and the blend paths are exercised.
+			auto texels = std::vector<std::uint32_t>(static_cast<std::size_t>(texture_v) * texture_v * textures);
+			for (std::size_t i = 0; i < texels.size(); ++i)
+			{
+				auto const x = i % texture_v;
+				auto const y = i / texture_v % texture_v;
+				texels[i]    = ((x / 8 + y / 8) % 2 == 0) ? 0xffffffff : 0x80404040;
+			}
+
+			auto random = std::mt19937{42};
+			auto batch  = gpu::SpriteBatch{};
+			batch.reserve(spriteCount);
+			for (std::uint32_t i = 0; i < spriteCount; ++i)
+			{
+				batch.submit({
+					.position = {static_cast<float>(random() % width), static_cast<float>(random() % height)},
+					.size     = {static_cast<float>(8 + random() % 24), static_cast<float>(8 + random() % 24)},
+					.color    = static_cast<std::uint32_t>(0x60000000u | (random() & 0xffffffu) | ((random() % 2) * 0xff000000u)),
+					.rotation = static_cast<float>(random() % 628) * 0.01f,
+					.texture  = static_cast<std::uint16_t>(random() % (textures * 2)), // Slots past the textures are untextured
+				});
+			}
+			auto instances = std::vector<gpu::SpriteInstance>(spriteCount);
+			batch.build(instances);
+
+			auto const viewProj = glm::ortho(0.0f, static_cast<float>(width), 0.0f, static_cast<float>(height), -1.0f, 1.0f);
+			auto threadCounts   = std::vector<std::uint32_t>{};
+			for (std::uint32_t threads = 1; threads < maxThreads; threads *= 2) { threadCounts.push_back(threads); }
+			threadCounts.push_back(maxThreads);
+
+			auto singleThread = 0.0;
+			for (auto const threads : threadCounts)
+			{
+				// The calling thread shades tiles too.
+				auto pool       = ThreadPool{threads - 1};
+				auto rasterizer = soft::Rasterizer{pool, {.width = width, .height = height}};
+				for (std::uint16_t slot = 0; slot < textures; ++slot)
+				{
+					auto const size = static_cast<std::size_t>(texture_v) * texture_v;
+					rasterizer.setTexture(slot, {.width = texture_v, .height = texture_v, .texels = std::span{texels}.subspan(slot * size, size)});
+				}
+
+				auto best  = std::numeric_limits<double>::max();
+				auto total = 0.0;
+				for (std::uint32_t i = 0; i < iterations; ++i)
+				{
+					auto const start = Clock::now();
+					rasterizer.draw(instances, viewProj);
+					auto const ms = elapsedMs(start);
+					best          = std::min(best, ms);
+					total        += ms;
+				}
+
+				if (threads == 1) { singleThread = best; }
+				auto const & stats = rasterizer.getStats();
+				s_log.info("{:>3} threads: best {:.3f}ms, avg {:.3f}ms ({:.2f}x), {:.1f} Mpixels/s", threads, best, total / iterations, singleThread / best,
+						   static_cast<double>(stats.covered) / best / 1e3);
+				if (threads == maxThreads)
+				{
+					auto const path = std::filesystem::temp_directory_path() / "breakout-bench-software.png";
+					if (rasterizer.write(path)) { s_log.info("last frame written to '{}'", path.string()); }
+				}
+			}
+			s_log.info("{} sprites, {} kernels, {} tiles of {}px, {} iterations", spriteCount, soft::Rasterizer::isSimd() ? "AVX2" : "scalar",
+					   (width + soft::Rasterizer::tile_size_v - 1) / soft::Rasterizer::tile_size_v *
+						   ((height + soft::Rasterizer::tile_size_v - 1) / soft::Rasterizer::tile_size_v),
+					   soft::Rasterizer::tile_size_v, iterations);
+			return EXIT_SUCCESS;
+		}
+
+		// args: [bricks] [frames]
+		// A wall of bricks of which a few are hit every frame, plus a ball and paddle: serialize, capture, then restore from
+		// one frame, half the ring and the whole ring back.
+		int snapshotRing(std::span<std::string_view const> args)
+		{
+			struct Brick
+			{
+				glm::vec2 position{};
+				std::uint32_t color{};
+				std::uint16_t hits{};
+				std::uint16_t flags{};
+			};
+
+			constexpr std::uint32_t hits_per_frame_v = 64;
+
+			auto const count  = std::max(parseCount(args, 0, 100'000), 1U);
+			auto const frames = std::max(parseCount(args, 1, 600), 2U);
+			auto random       = std::mt19937{42};
+
+			auto bricks = std::vector<Brick>(count);
+			for (std::uint32_t i = 0; i < count; ++i)
+			{
+				bricks[i] = {
+					.position = {static_cast<float>(i % 320) * 6.0f, static_cast<float>(i / 320) * 3.0f},
+					.color    = static_cast<std::uint32_t>(random()),
+					.hits     = static_cast<std::uint16_t>(1 + random() % 3),
+				};
+			}
+			auto ball   = glm::vec4{960.0f, 540.0f, 3.0f, -4.0f}; // Position, velocity
+			auto paddle = 0.5f;
+
+			auto ring  = snapshot::Ring{{.stateBytes = count * sizeof(Brick) + 64}};
+			auto state = std::vector<std::byte>{};
+			state.reserve(count * sizeof(Brick) + 64);
+			auto const serialize = [&]
+			{
+				auto writer = snapshot::Writer{state};
+				writer.write(ball);
+				writer.write(paddle);
+				writer.write(bricks);
+			};
+
+			auto serializeMs = 0.0;
+			auto captureMs   = 0.0;
+			auto worstMs     = 0.0;
+			auto deltaBytes  = std::size_t{};
+			for (std::uint32_t frame = 1; frame <= frames; ++frame)
+			{
+				for (std::uint32_t i = 0; i < hits_per_frame_v; ++i)
+				{
+					auto & brick = bricks[random() % count];
+					brick.hits   = brick.hits == 0 ? 0 : static_cast<std::uint16_t>(brick.hits - 1);
+					brick.flags |= 1;
+				}
+				ball   += glm::vec4{ball.z, ball.w, 0.0f, 0.0f};
+				paddle  = static_cast<float>(frame % 100) / 100.0f;
+
+				auto start = Clock::now();
+				serialize();
+				auto const serialized = elapsedMs(start);
+				start                 = Clock::now();
+				ring.capture(frame, state);
+				auto const captured  = elapsedMs(start);
+				serializeMs         += serialized;
+				captureMs           += captured;
+				worstMs              = std::max(worstMs, serialized + captured);
+				deltaBytes          += ring.getStats().deltaBytes;
+			}
+			s_log.info("{} bricks, {} byte state, {} snapshots in {:.1f} MiB", count, state.size(), ring.size(),
+					   static_cast<double>(ring.getStats().storedBytes) / (1024.0 * 1024.0));
+			s_log.info("per frame: serialize {:.3f}ms, hash + capture {:.3f}ms, worst {:.3f}ms together; {:.0f} byte deltas on average", serializeMs / frames,
+					   captureMs / frames, worstMs, static_cast<double>(deltaBytes) / frames);
+
+			auto start = Clock::now();
+			auto const stateHash = snapshot::hash(state);
+			s_log.info("hash alone: {:.3f}ms ({:016x})", elapsedMs(start), stateHash);
+
+			auto const newest = *ring.newest();
+			auto restored     = std::vector<std::byte>{};
+			restored.reserve(state.capacity()); // As a game would keep it around: the first restore should not allocate
+			for (auto const age : {std::uint64_t{1}, (newest - *ring.oldest()) / 2, newest - *ring.oldest()})
+			{
+				start           = Clock::now();
+				auto const ok   = ring.restore(newest - age, restored);
+				auto const ms   = elapsedMs(start);
+				auto const same = ok && snapshot::hash(restored) == ring.hash(newest - age);
+				s_log.info("restore {:>3} frames back: {:.3f}ms{}", age, ms, same ? "" : " (MISMATCH)");
+				if (!same) { return EXIT_FAILURE; }
+			}
+
+			start = Clock::now();
+			if (!ring.rollback(newest - 1, restored)) { return EXIT_FAILURE; }
+			auto reader = snapshot::Reader{restored};
+			if (!reader.read(ball) || !reader.read(paddle) || !reader.read(bricks)) { return EXIT_FAILURE; }
+			s_log.info("rollback one frame and deserialize: {:.3f}ms", elapsedMs(start));
+			return EXIT_SUCCESS;
+		}
+
+		// args: <font file> [labels] [frames]
+		// A HUD-like set of labels, a tenth of them counters that change every frame, laid out and submitted as glyph
+		// sprites each frame: through a TextCache, and laid out from scratch every time for comparison.
+		int textLayout(std::span<std::string_view const> args)
+		{
+			if (args.empty())
+			{
+				s_log.error("usage: --bench text <file.ttf> [labels] [frames]");
+				return EXIT_FAILURE;
+			}
+
+			auto const source = std::filesystem::path{args[0]};
+			auto const labels = std::max(parseCount(args, 1, 500), 1U);
+			auto const frames = std::max(parseCount(args, 2, 600), 1U);
+			auto const file   = MappedFile::open(source);
+			if (!file)
+			{
+				s_log.error("failed to open '{}'", source.string());
+				return EXIT_FAILURE;
+			}
+
+			auto start       = Clock::now();
+			auto const atlas = game::GlyphAtlas::bake(file->bytes(), {});
+			if (!atlas) { return EXIT_FAILURE; }
+			s_log.info("baked '{}' into a {}x{} atlas in {:.3f}ms", source.string(), atlas->extent().width, atlas->extent().height, elapsedMs(start));
+
+			auto batch = gpu::SpriteBatch{};
+			batch.reserve(labels * 32);
+			auto instances = std::vector<gpu::SpriteInstance>(labels * 32);
+			auto buffer    = std::array<char, 64>{};
+			// Label i of frame: counters (every tenth label) show the frame number, the rest a value that never changes.
+			auto const text = [&](std::uint32_t const i, std::uint32_t const frame)
+			{
+				auto const value = i % 10 == 0 ? frame * 7 + i : i * 13;
+				auto const end   = std::format_to_n(buffer.data(), buffer.size(), "label {}: {:06}", i, value).out;
+				return std::string_view{buffer.data(), end};
+			};
+			auto const label = [](std::uint32_t const i)
+			{
+				return game::TextCache::Label{
+					.position = {static_cast<float>(i % 8) * 240.0f, static_cast<float>(i / 8) * 16.0f},
+					.size     = 14.0f,
+					.pipeline = 1,
+				};
+			};
+
+			auto cache  = game::TextCache{};
+			auto layout = game::TextCache::Layout{};
+			for (auto const cached : {true, false})
+			{
+				auto best     = std::numeric_limits<double>::max();
+				auto total    = 0.0;
+				auto rebuilds = std::size_t{};
+				for (std::uint32_t frame = 0; frame < frames; ++frame)
+				{
+					batch.clear();
+					start = Clock::now();
+					for (std::uint32_t i = 0; i < labels; ++i)
+					{
+						if (cached) { cache.submit(batch, *atlas, text(i, frame), label(i)); }
+						else
+						{
+							game::TextCache::layout(*atlas, text(i, frame), layout);
+							game::TextCache::submit(batch, layout, label(i));
+						}
+					}
+					cache.endFrame();
+					auto const ms  = elapsedMs(start);
+					best           = std::min(best, ms);
+					total         += ms;
+					rebuilds      += cache.getStats().rebuilds;
+				}
+
+				instances.resize(batch.size());
+				batch.build(instances);
+				s_log.info("{}: best {:.3f}ms, avg {:.3f}ms per frame ({:.0f}ns/label), {} glyphs in {} draws, {:.1f} layouts per frame",
+						   cached ? "cached" : "uncached", best, total / frames, total * 1e6 / frames / labels, batch.size(), batch.getStats().draws,
+						   cached ? static_cast<double>(rebuilds) / frames : static_cast<double>(labels));
+			}
+			s_log.info("cache: {} strings, {} evicted", cache.getStats().entries, cache.getStats().evictions);
+			return EXIT_SUCCESS;
+		}
+
+		// args: [transforms] [frames]
+		// Transforms::update() when everything moves, when a contiguous tenth moves under a still camera, when only the
+		// camera moves and when nothing does; against building every matrix with glm from an array of structs, and
+		// fastSinCos against double std::sin and std::cos.
+		int transformUpdate(std::span<std::string_view const> args)
+		{
+			auto const count  = std::max(parseCount(args, 0, 100'000), 1U);
+			auto const frames = std::max(parseCount(args, 1, 300), 1U);
+			auto random       = std::mt19937{42};
+			auto unit         = std::uniform_real_distribution<float>{-1.0f, 1.0f};
+
+			auto objects = std::vector<Transforms::Trs>(count);
+			for (auto & object : objects)
+			{
+				object.position = {unit(random) * 100.0f, unit(random) * 100.0f, unit(random) * 100.0f};
+				object.rotation = glm::normalize(glm::quat{unit(random), unit(random), unit(random), unit(random)});
+				object.scale    = glm::vec3{1.0f + unit(random) * 0.5f};
+			}
+
+			auto transforms = Transforms{};
+			transforms.reserve(count);
+			for (auto const & object : objects) { transforms.add(object); }
+
+			auto const projection = glm::perspective(glm::radians(60.0f), 16.0f / 9.0f, 0.1f, 1000.0f);
+			auto const viewProj   = [&projection](std::uint32_t const frame)
+			{
+				auto const eye = glm::vec3{std::cos(static_cast<float>(frame) * 0.01f) * 200.0f, 50.0f, std::sin(static_cast<float>(frame) * 0.01f) * 200.0f};
+				return projection * glm::lookAt(eye, glm::vec3{0.0f}, glm::vec3{0.0f, 1.0f, 0.0f});
+			};
+
+			s_log.info("{} transforms, {} frames, {}", count, frames, Transforms::isSimd() ? "AVX2" : "scalar");
+			struct Scenario
+			{
+				std::string_view name;
+				std::uint32_t moving;
+				bool camera;
+			};
+			for (auto const & scenario : {Scenario{"everything moves", count, true}, Scenario{"a tenth moves", std::max(count / 10, 1U), false},
+										  Scenario{"camera moves", 0, true}, Scenario{"nothing moves", 0, false}})
+			{
+				transforms.update(viewProj(0));
+				auto best    = std::numeric_limits<double>::max();
+				auto total   = 0.0;
+				auto updates = std::size_t{};
+				for (std::uint32_t frame = 1; frame <= frames; ++frame)
+				{
+					auto const start = Clock::now();
+					for (std::uint32_t i = 0; i < scenario.moving; ++i)
+					{
+						transforms.setPosition(i, objects[i].position + glm::vec3{static_cast<float>(frame) * 0.01f});
+					}
+					transforms.update(viewProj(scenario.camera ? frame : 0));
+					auto const ms  = elapsedMs(start);
+					best           = std::min(best, ms);
+					total         += ms;
+					updates       += transforms.getStats().worldUpdates;
+				}
+				s_log.info("{}: best {:.3f}ms, avg {:.3f}ms per frame, {:.0f} world matrices rebuilt per frame", scenario.name, best, total / frames,
+						   static_cast<double>(updates) / frames);
+			}
+
+			// What the update replaces: both matrices of every object rebuilt with glm each frame.
+			auto world         = std::vector<glm::mat4>(count);
+			auto worldViewProj = std::vector<glm::mat4>(count);
+			auto best          = std::numeric_limits<double>::max();
+			auto total         = 0.0;
+			for (std::uint32_t frame = 1; frame <= frames; ++frame)
+			{
+				auto const start = Clock::now();
+				auto const vp    = viewProj(frame);
+				for (std::uint32_t i = 0; i < count; ++i)
+				{
+					auto const & object = objects[i];
+					world[i]            = glm::scale(glm::translate(glm::mat4{1.0f}, object.position) * glm::mat4_cast(object.rotation), object.scale);
+					worldViewProj[i]    = vp * world[i];
+				}
+				auto const ms  = elapsedMs(start);
+				best           = std::min(best, ms);
+				total         += ms;
+			}
+			s_log.info("glm, array of structs: best {:.3f}ms, avg {:.3f}ms per frame", best, total / frames);
+
+			constexpr std::uint32_t angles_v = 1'000'000;
+			auto sum      = 0.0;
+			auto maxError = 0.0;
+			auto start    = Clock::now();
+			for (std::uint32_t i = 0; i < angles_v; ++i)
+			{
+				auto const radians = static_cast<double>(i) * 1e-4 - 50.0;
+				sum               += std::sin(radians) + std::cos(radians);
+			}
+			auto const libmMs = elapsedMs(start);
+			start             = Clock::now();
+			for (std::uint32_t i = 0; i < angles_v; ++i)
+			{
+				auto const result = fastSinCos(static_cast<float>(i) * 1e-4f - 50.0f);
+				sum              += static_cast<double>(result.sin + result.cos);
+			}
+			auto const fastMs = elapsedMs(start);
+			for (std::uint32_t i = 0; i < angles_v; ++i)
+			{
+				auto const radians = static_cast<float>(i) * 1e-4f - 50.0f;
+				auto const result  = fastSinCos(radians);
+				auto const exact   = static_cast<double>(radians);
+				maxError           = std::max({maxError, std::abs(result.sin - std::sin(exact)), std::abs(result.cos - std::cos(exact))});
+			}
+			s_log.info("{} angles: double sin + cos {:.3f}ms, fastSinCos {:.3f}ms, max error {:.2g} ({:.1f})", angles_v, libmMs, fastMs, maxError, sum);
+			return EXIT_SUCCESS;
+		}
+
+		struct Benchmark
+		{
+			std::string_view name;
+			std::string_view description;
+			int (*run)(std::span<std::string_view const>);
+		};
+
+		constexpr auto benchmarks_v = std::array{
+			Benchmark{"cull", "frustum culling of 100k bounding spheres, boxes and rects", &frustumCull},
+			Benchmark{"mesh", "first-run import vs cached (.bkmesh) mesh load times", &meshCache},
+			Benchmark{"record", "secondary command buffer recording time from 1 to N threads (headless device)", &recordScaling},
+			Benchmark{"snapshot", "snapshot ring capture, hash and restore of a 100k brick world", &snapshotRing},
+			Benchmark{"software", "software rasterizer frame time for 1080p sprite scenes from 1 to N threads (no device)", &softwareRaster},
+			Benchmark{"sprites", "CPU cost of batching 10k/100k/1M sprites into instanced draws", &spriteBatch},
+			Benchmark{"text", "per-frame cost of hundreds of HUD labels through the text layout cache vs laid out every frame", &textLayout},
+			Benchmark{"transforms", "batched world and view-projection matrix updates of 100k transforms, and fastSinCos vs libm", &transformUpdate},
+		};
+	} // namespace
+
+	int run(std::span<std::string_view const> args)
+	{
+		if (!args.empty())
+		{
+			auto const itr = std::ranges::find(benchmarks_v, args.front(), &Benchmark::name);
+			if (itr != benchmarks_v.end()) { return itr->run(args.subspan(1)); }
+			s_log.error("unknown benchmark '{}'", args.front());
+		}
+
+		for (auto const & benchmark : benchmarks_v) { s_log.info("{}: {}", benchmark.name, benchmark.description); }
+		return args.empty() ? EXIT_SUCCESS : EXIT_FAILURE;
+	}
+} // namespace bk::bench
@@ -3,6 +3,8 @@
 
 #include <glm/gtc/matrix_transform.hpp>
 
+#include "breakout/transform.hpp"
+
 namespace bk
 {
 
@@ -20,7 +22,26 @@ namespace bk
 
     glm::mat4 Camera::GetViewMatrix() const
     {
-        return glm::lookAt(m_Position, m_Position + m_Front, m_Up);
+        UpdateMatrices();
+        return m_View;
+    }
+
+    glm::mat4 Camera::GetProjectionMatrix() const
+    {
+        UpdateMatrices();
+        return m_Projection;
+    }
+
+    glm::mat4 Camera::GetViewProjectionMatrix() const
+    {
+        UpdateMatrices();
+        return m_ViewProjection;
+    }
+
+    const Frustum& Camera::GetFrustum() const
+    {
+        UpdateMatrices();
+        return m_Frustum;
     }
 
     void Camera::ProcessKeyboard(CameraMovement direction, float deltaTime)
@@ -38,6 +59,7 @@ namespace bk
             m_Position += m_Up * velocity;
         if (direction == CameraMovement::eDown)
             m_Position -= m_Up * velocity;
+        m_Dirty = true;
 
     }
 
@@ -70,20 +92,37 @@ namespace bk
             m_Zoom = 1.0f;
         if (m_Zoom >= 45.0f)
             m_Zoom = 45.0f;
+        m_Dirty = true;
     }
 
     void Camera::UpdateCameraVectors()
     {
-        // Calculate the new Front vector
+        // Calculate the new Front vector; one float sincos per angle instead of four double calls
+        const SinCos yaw = fastSinCos(glm::radians(m_Yaw));
+        const SinCos pitch = fastSinCos(glm::radians(m_Pitch));
         glm::vec3 front;
-        front.x = static_cast<float>(cos(glm::radians(m_Yaw)) * cos(glm::radians(m_Pitch)));
-        front.y = static_cast<float>(sin(glm::radians(m_Pitch)));
-        front.z = static_cast<float>(sin(glm::radians(m_Yaw)) * cos(glm::radians(m_Pitch)));
+        front.x = yaw.cos * pitch.cos;
+        front.y = pitch.sin;
+        front.z = yaw.sin * pitch.cos;
 
         m_Front = glm::normalize(front);
 
         // Also re-calculate the Right and Up vector
         m_Right = glm::normalize(glm::cross(m_Front, m_WorldUp));  // Normalize the vectors, because their length gets closer to 0 the more you look up or down which results in slower movement.
         m_Up    = glm::normalize(glm::cross(m_Right, m_Front));
+        m_Dirty = true;
+    }
+
+    void Camera::UpdateMatrices() const
+    {
+        if (!m_Dirty)
+            return;
+
+        m_View = glm::lookAt(m_Position, m_Position + m_Front, m_Up);
+        m_Projection = glm::perspectiveRH_ZO(glm::radians(m_Zoom), m_AspectRatio, m_NearPlane, m_FarPlane);
+        m_Projection[1][1] *= -1.0f; // Vulkan clip space y points down
+        m_ViewProjection = m_Projection * m_View;
+        m_Frustum = Frustum::fromMatrix(m_ViewProjection);
+        m_Dirty = false;
     }
 } // namespace breakout
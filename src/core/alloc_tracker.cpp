@@ -0,0 +1,191 @@
+#include "breakout/core/alloc_tracker.hpp"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+#include "breakout/core/logger.hpp"
+
+namespace bk::alloc
+{
+	namespace
+	{
+		auto const s_log = Logger{"alloc"};
+
+		struct Counter
+		{
+			std::atomic<std::uint64_t> allocations{};
+			std::atomic<std::uint64_t> bytes{};
+		};
+
+		// Constant initialised: operator new may run before any dynamic initialiser.
+		constinit std::array<Counter, tag_count_v> s_totals{};
+		constinit std::array<Counter, tag_count_v> s_frame{};
+		constinit thread_local Tag s_tag{Tag::eUntagged};
+
+		// Frame thread only.
+		constinit std::uint64_t s_frames{};
+		constinit std::uint64_t s_emptyFrames{};
+		constinit Counts s_worstFrame{};
+
+		[[maybe_unused]] void record(std::size_t const size)
+		{
+			auto const tag = static_cast<std::size_t>(s_tag);
+			s_totals[tag].allocations.fetch_add(1, std::memory_order_relaxed);
+			s_totals[tag].bytes.fetch_add(size, std::memory_order_relaxed);
+			s_frame[tag].allocations.fetch_add(1, std::memory_order_relaxed);
+			s_frame[tag].bytes.fetch_add(size, std::memory_order_relaxed);
+		}
+	} // namespace
+
+	std::string_view tagName(Tag const tag)
+	{
+		switch (tag)
+		{
+		case Tag::eUntagged: return "untagged";
+		case Tag::eGame: return "game";
+		case Tag::eRenderer: return "renderer";
+		case Tag::eResources: return "resources";
+		case Tag::eLogger: return "logger";
+		case Tag::eJobs: return "jobs";
+		default: return "?";
+		}
+	}
+
+	Scope::Scope(Tag const tag) : m_previous(s_tag) { s_tag = tag; }
+
+	Scope::~Scope() { s_tag = m_previous; }
+
+	TagCounts totals()
+	{
+		auto ret = TagCounts{};
+		for (std::size_t i = 0; i < tag_count_v; ++i)
+		{
+			ret[i] = {s_totals[i].allocations.load(std::memory_order_relaxed), s_totals[i].bytes.load(std::memory_order_relaxed)};
+		}
+		return ret;
+	}
+
+	TagCounts endFrame()
+	{
+		auto ret = TagCounts{};
+		for (std::size_t i = 0; i < tag_count_v; ++i)
+		{
+			ret[i] = {s_frame[i].allocations.exchange(0, std::memory_order_relaxed), s_frame[i].bytes.exchange(0, std::memory_order_relaxed)};
+		}
+
+		auto const frame = sum(ret);
+		++s_frames;
+		if (frame.allocations == 0) { ++s_emptyFrames; }
+		if (frame.allocations > s_worstFrame.allocations) { s_worstFrame = frame; }
+		return ret;
+	}
+
+	Counts sum(TagCounts const & counts)
+	{
+		auto ret = Counts{};
+		for (auto const & count : counts)
+		{
+			ret.allocations += count.allocations;
+			ret.bytes       += count.bytes;
+		}
+		return ret;
+	}
+
+	void report()
+	{
+		if constexpr (!tracking_v)
+		{
+			s_log.info("allocation tracking is off in this build (configure with -DBK_TRACK_ALLOCATIONS=ON)");
+			return;
+		}
+
+		auto const counts = totals();
+		for (std::size_t i = 0; i < tag_count_v; ++i)
+		{
+			if (counts[i].allocations == 0) { continue; }
+			s_log.info("{:>10}: {} allocations, {:.1f} KiB", tagName(static_cast<Tag>(i)), counts[i].allocations, static_cast<double>(counts[i].bytes) / 1024.0);
+		}
+		if (s_frames > 0)
+		{
+			s_log.info("{} frames, {} without allocations; worst frame {} allocations, {:.1f} KiB", s_frames, s_emptyFrames, s_worstFrame.allocations,
+					   static_cast<double>(s_worstFrame.bytes) / 1024.0);
+		}
+	}
+} // namespace bk::alloc
+
+#if defined(BK_TRACK_ALLOCATIONS)
+// Replacements for every global allocation function, all funnelled through allocate() and release(). Aligned variants
+// only see alignments above __STDCPP_DEFAULT_NEW_ALIGNMENT__, which malloc does not guarantee.
+namespace
+{
+	void * allocate(std::size_t size, std::size_t const alignment) noexcept
+	{
+		bk::alloc::record(size);
+		size = size == 0 ? 1 : size;
+		if (alignment <= __STDCPP_DEFAULT_NEW_ALIGNMENT__) { return std::malloc(size); }
+#if defined(_WIN32)
+		return _aligned_malloc(size, alignment);
+#else
+		return std::aligned_alloc(alignment, (size + alignment - 1) / alignment * alignment);
+#endif
+	}
+
+	void * allocateOrThrow(std::size_t const size, std::size_t const alignment)
+	{
+		while (true)
+		{
+			if (auto * ret = allocate(size, alignment)) { return ret; }
+			auto const handler = std::get_new_handler();
+			if (handler == nullptr) { throw std::bad_alloc{}; }
+			handler();
+		}
+	}
+
+	void release(void * ptr, std::size_t const alignment) noexcept
+	{
+#if defined(_WIN32)
+		if (alignment > __STDCPP_DEFAULT_NEW_ALIGNMENT__)
+		{
+			_aligned_free(ptr);
+			return;
+		}
+#else
+		static_cast<void>(alignment);
+#endif
+		std::free(ptr);
+	}
+
+	constexpr auto default_v = std::size_t{__STDCPP_DEFAULT_NEW_ALIGNMENT__};
+} // namespace
+
+// NOLINTBEGIN(*-new-delete-operators)
+void * operator new(std::size_t const size) { return allocateOrThrow(size, default_v); }
+void * operator new[](std::size_t const size) { return allocateOrThrow(size, default_v); }
+void * operator new(std::size_t const size, std::nothrow_t const &) noexcept { return allocate(size, default_v); }
+void * operator new[](std::size_t const size, std::nothrow_t const &) noexcept { return allocate(size, default_v); }
+void * operator new(std::size_t const size, std::align_val_t const alignment) { return allocateOrThrow(size, static_cast<std::size_t>(alignment)); }
+void * operator new[](std::size_t const size, std::align_val_t const alignment) { return allocateOrThrow(size, static_cast<std::size_t>(alignment)); }
+void * operator new(std::size_t const size, std::align_val_t const alignment, std::nothrow_t const &) noexcept
+{
+	return allocate(size, static_cast<std::size_t>(alignment));
+}
+void * operator new[](std::size_t const size, std::align_val_t const alignment, std::nothrow_t const &) noexcept
+{
+	return allocate(size, static_cast<std::size_t>(alignment));
+}
+
+void operator delete(void * ptr) noexcept { release(ptr, default_v); }
+void operator delete[](void * ptr) noexcept { release(ptr, default_v); }
+void operator delete(void * ptr, std::size_t) noexcept { release(ptr, default_v); }
+void operator delete[](void * ptr, std::size_t) noexcept { release(ptr, default_v); }
+void operator delete(void * ptr, std::nothrow_t const &) noexcept { release(ptr, default_v); }
+void operator delete[](void * ptr, std::nothrow_t const &) noexcept { release(ptr, default_v); }
+void operator delete(void * ptr, std::align_val_t const alignment) noexcept { release(ptr, static_cast<std::size_t>(alignment)); }
+void operator delete[](void * ptr, std::align_val_t const alignment) noexcept { release(ptr, static_cast<std::size_t>(alignment)); }
+void operator delete(void * ptr, std::size_t, std::align_val_t const alignment) noexcept { release(ptr, static_cast<std::size_t>(alignment)); }
+void operator delete[](void * ptr, std::size_t, std::align_val_t const alignment) noexcept { release(ptr, static_cast<std::size_t>(alignment)); }
+void operator delete(void * ptr, std::align_val_t const alignment, std::nothrow_t const &) noexcept { release(ptr, static_cast<std::size_t>(alignment)); }
+void operator delete[](void * ptr, std::align_val_t const alignment, std::nothrow_t const &) noexcept { release(ptr, static_cast<std::size_t>(alignment)); }
+// NOLINTEND(*-new-delete-operators)
+#endif
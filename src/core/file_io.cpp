@@ -0,0 +1,47 @@
+#include "breakout/core/file_io.hpp"
+
+#include <fstream>
+
+#include "breakout/core/logger.hpp"
+
+namespace bk
+{
+	namespace
+	{
+		auto const s_log = Logger{"files"};
+	} // namespace
+
+	bool writeFileAtomic(std::filesystem::path const & path, std::span<std::byte const> const bytes)
+	{
+		return writeFileAtomic(path, std::span{&bytes, 1});
+	}
+
+	bool writeFileAtomic(std::filesystem::path const & path, std::span<std::span<std::byte const> const> const parts)
+	{
+		auto error = std::error_code{};
+		if (path.has_parent_path()) { std::filesystem::create_directories(path.parent_path(), error); }
+
+		auto temporary = path;
+		temporary += ".tmp";
+		{
+			auto file = std::ofstream{temporary, std::ios::binary | std::ios::trunc};
+			for (auto const part : parts)
+			{
+				file.write(reinterpret_cast<char const *>(part.data()), static_cast<std::streamsize>(part.size())); // NOLINT(*-reinterpret-cast)
+			}
+			if (!file)
+			{
+				s_log.error("failed to write '{}'", path.string());
+				return false;
+			}
+		}
+
+		std::filesystem::rename(temporary, path, error);
+		if (error)
+		{
+			s_log.error("failed to write '{}': {}", path.string(), error.message());
+			return false;
+		}
+		return true;
+	}
+} // namespace bk
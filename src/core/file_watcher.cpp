@@ -0,0 +1,126 @@
+#include "breakout/core/file_watcher.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <unordered_map>
+
+#if defined(__linux__)
+	#include <sys/inotify.h>
+	#include <unistd.h>
+
+	#include <cerrno>
+#endif
+
+#include "breakout/core/logger.hpp"
+
+namespace bk
+{
+	namespace
+	{
+		auto const s_log = Logger{"file-watcher"};
+	} // namespace
+
+#if defined(__linux__)
+	struct FileWatcher::Impl
+	{
+		static constexpr std::uint32_t mask_v{IN_CLOSE_WRITE | IN_MOVED_TO};
+
+		int fd{inotify_init1(IN_NONBLOCK | IN_CLOEXEC)};
+		std::unordered_map<int, std::filesystem::path> directories{};
+
+		Impl(Impl const &) = delete;
+
+		Impl & operator=(Impl const &) = delete;
+
+		Impl()
+		{
+			if (fd < 0) { s_log.warn("inotify unavailable: {}", std::strerror(errno)); }
+		}
+
+		~Impl()
+		{
+			if (fd >= 0) { close(fd); }
+		}
+
+		bool watch(std::filesystem::path const & directory)
+		{
+			if (fd < 0) { return false; }
+			auto const wd = inotify_add_watch(fd, directory.c_str(), mask_v);
+			if (wd < 0)
+			{
+				s_log.warn("failed to watch '{}': {}", directory.string(), std::strerror(errno));
+				return false;
+			}
+			directories.insert_or_assign(wd, directory);
+			return true;
+		}
+
+		void poll(std::vector<Event> & out)
+		{
+			if (fd < 0) { return; }
+
+			static constexpr std::size_t buffer_size_v{4096};
+			alignas(inotify_event) auto buffer = std::array<char, buffer_size_v>{};
+			auto const now = Clock::now();
+
+			while (true)
+			{
+				auto const length = read(fd, buffer.data(), buffer.size());
+				if (length <= 0) { break; }
+
+				for (std::size_t offset = 0; offset < static_cast<std::size_t>(length);)
+				{
+					auto event = inotify_event{};
+					std::memcpy(&event, buffer.data() + offset, sizeof(inotify_event));
+					auto const * name = buffer.data() + offset + sizeof(inotify_event);
+					offset += sizeof(inotify_event) + event.len;
+
+					if (event.len == 0 || (event.mask & mask_v) == 0) { continue; }
+					auto const itr = directories.find(event.wd);
+					if (itr == directories.end()) { continue; }
+
+					auto path = itr->second / name;
+					if (std::ranges::find(out, path, &Event::path) != out.end()) { continue; }
+					out.push_back(Event{.path = std::move(path), .detected = now});
+				}
+			}
+		}
+	};
+#else
+	struct FileWatcher::Impl
+	{
+		static bool watch(std::filesystem::path const & /*directory*/) { return false; }
+
+		static void poll(std::vector<Event> & /*out*/) {}
+	};
+#endif
+
+	FileWatcher::FileWatcher() : m_impl(std::make_unique<Impl>()) {}
+
+	FileWatcher::~FileWatcher() = default;
+
+	bool FileWatcher::isSupported() const
+	{
+#if defined(__linux__)
+		return m_impl->fd >= 0;
+#else
+		return false;
+#endif
+	}
+
+	bool FileWatcher::watch(std::filesystem::path const & directory)
+	{
+		auto canonical = std::error_code{};
+		auto const path = std::filesystem::weakly_canonical(directory, canonical);
+		if (canonical) { return false; }
+		return m_impl->watch(path);
+	}
+
+	std::vector<FileWatcher::Event> FileWatcher::poll()
+	{
+		auto ret = std::vector<Event>{};
+		m_impl->poll(ret);
+		return ret;
+	}
+} // namespace bk
@@ -0,0 +1,53 @@
+#include "breakout/core/frame_arena.hpp"
+
+#include <algorithm>
+
+namespace bk
+{
+	namespace
+	{
+		// Offset of the first address at or after base + offset with the given (power of two) alignment.
+		std::size_t alignUp(std::byte const * base, std::size_t const offset, std::size_t const alignment)
+		{
+			auto const address = reinterpret_cast<std::uintptr_t>(base) + offset;
+			return offset + ((alignment - address % alignment) % alignment);
+		}
+	} // namespace
+
+	FrameArena::FrameArena(std::size_t const capacity)
+	: m_block(std::make_unique_for_overwrite<std::byte[]>(std::max(capacity, std::size_t{1}))), m_stats{.capacity = std::max(capacity, std::size_t{1})}
+	{
+	}
+
+	void FrameArena::reset()
+	{
+		if (!m_overflow.empty())
+		{
+			// Grow to what this frame needed, with headroom, so the next ones fit in a single block.
+			m_overflow.clear();
+			m_stats.capacity = std::max(m_stats.used + m_stats.used / 2, m_stats.capacity * 2);
+			m_block          = std::make_unique_for_overwrite<std::byte[]>(m_stats.capacity);
+		}
+		m_offset     = 0;
+		m_stats.used = 0;
+	}
+
+	void * FrameArena::do_allocate(std::size_t const bytes, std::size_t const alignment)
+	{
+		auto const offset = alignUp(m_block.get(), m_offset, alignment);
+		if (offset + bytes <= m_stats.capacity)
+		{
+			m_stats.used      += offset + bytes - m_offset;
+			m_offset           = offset + bytes;
+			m_stats.highWater  = std::max(m_stats.highWater, m_stats.used);
+			return m_block.get() + offset;
+		}
+
+		// Does not fit: a heap block just for this allocation, released on reset().
+		auto & overflow = m_overflow.emplace_back(std::make_unique_for_overwrite<std::byte[]>(bytes + alignment));
+		++m_stats.overflows;
+		m_stats.used      += bytes + alignment;
+		m_stats.highWater  = std::max(m_stats.highWater, m_stats.used);
+		return overflow.get() + alignUp(overflow.get(), 0, alignment);
+	}
+} // namespace bk
@@ -0,0 +1,258 @@
+#include "breakout/core/image_writer.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstring>
+#include <string_view>
+
+namespace bk::image
+{
+	namespace
+	{
+		constexpr std::size_t max_stored_block_v{65535};
+
+		constexpr auto crc_table_v = []
+		{
+			auto table = std::array<std::uint32_t, 256>{};
+			for (std::uint32_t i = 0; i < table.size(); ++i)
+			{
+				auto crc = i;
+				for (auto bit = 0; bit < 8; ++bit) { crc = (crc & 1u) != 0 ? 0xedb88320u ^ (crc >> 1u) : crc >> 1u; }
+				table[i] = crc;
+			}
+			return table;
+		}();
+
+		std::uint32_t crc32(std::span<std::byte const> const bytes, std::uint32_t crc = 0)
+		{
+			crc = ~crc;
+			for (auto const byte : bytes) { crc = crc_table_v[(crc ^ static_cast<std::uint32_t>(byte)) & 0xffu] ^ (crc >> 8u); }
+			return ~crc;
+		}
+
+		class Writer
+		{
+		public:
+			explicit Writer(std::vector<std::byte> & out) : m_out(out) {}
+
+			void u8(std::uint32_t const value) { m_out.push_back(static_cast<std::byte>(value & 0xffu)); }
+
+			void u16le(std::uint32_t const value)
+			{
+				u8(value);
+				u8(value >> 8u);
+			}
+
+			void u32be(std::uint32_t const value)
+			{
+				u8(value >> 24u);
+				u8(value >> 16u);
+				u8(value >> 8u);
+				u8(value);
+			}
+
+			void bytes(void const * data, std::size_t const size)
+			{
+				auto const offset = m_out.size();
+				m_out.resize(offset + size);
+				std::memcpy(m_out.data() + offset, data, size);
+			}
+
+			/**
+			 * \brief Start a chunk; its length is patched and its CRC appended by endChunk().
+			 */
+			void beginChunk(std::string_view const type)
+			{
+				assert(type.size() == 4);
+				m_chunk = m_out.size();
+				u32be(0);
+				bytes(type.data(), type.size());
+			}
+
+			void endChunk()
+			{
+				auto const length = static_cast<std::uint32_t>(m_out.size() - m_chunk - 8);
+				for (auto i = 0u; i < 4; ++i) { m_out[m_chunk + i] = static_cast<std::byte>((length >> (24u - i * 8u)) & 0xffu); }
+				u32be(crc32(std::span{m_out}.subspan(m_chunk + 4)));
+			}
+
+		private:
+			std::vector<std::byte> & m_out;
+			std::size_t m_chunk{};
+		};
+	} // namespace
+
+	std::vector<std::byte> encodePng(std::uint32_t const width, std::uint32_t const height, std::span<std::uint32_t const> const pixels)
+	{
+		assert(width > 0 && height > 0 && pixels.size() == static_cast<std::size_t>(width) * height);
+
+		// Filter type 0 (none) in front of every row, then the row itself.
+		auto const rowBytes = static_cast<std::size_t>(width) * 4;
+		auto const rawBytes = (rowBytes + 1) * height;
+		auto const blocks   = std::max<std::size_t>((rawBytes + max_stored_block_v - 1) / max_stored_block_v, 1);
+
+		auto out = std::vector<std::byte>{};
+		out.reserve(8 + 25 + 12 + 2 + rawBytes + blocks * 5 + 4 + 12);
+		auto writer = Writer{out};
+
+		constexpr auto signature_v = std::array<std::uint8_t, 8>{0x89, 'P', 'N', 'G', '\r', '\n', 0x1a, '\n'};
+		writer.bytes(signature_v.data(), signature_v.size());
+
+		writer.beginChunk("IHDR");
+		writer.u32be(width);
+		writer.u32be(height);
+		writer.u8(8); // Bit depth
+		writer.u8(6); // RGBA
+		writer.u8(0); // Deflate
+		writer.u8(0); // Adaptive filtering
+		writer.u8(0); // Not interlaced
+		writer.endChunk();
+
+		writer.beginChunk("IDAT");
+		writer.u8(0x78); // zlib header: deflate, 32K window, no dictionary
+		writer.u8(0x01);
+
+		// The raw stream (filter bytes and rows) is cut into stored blocks wherever 64K runs out, rows included.
+		auto a         = std::uint32_t{1};
+		auto b         = std::uint32_t{0};
+		auto remaining = rawBytes;
+		auto blockLeft = std::size_t{};
+		auto const put = [&](std::uint8_t const * data, std::size_t size)
+		{
+			while (size > 0)
+			{
+				if (blockLeft == 0)
+				{
+					blockLeft = std::min(remaining, max_stored_block_v);
+					remaining -= blockLeft;
+					writer.u8(remaining == 0 ? 1 : 0); // BFINAL, BTYPE 00 (stored)
+					writer.u16le(static_cast<std::uint32_t>(blockLeft));
+					writer.u16le(static_cast<std::uint32_t>(~blockLeft & 0xffffu));
+				}
+				auto const count = std::min(size, blockLeft);
+				writer.bytes(data, count);
+
+				// Adler-32, reduced every 5552 bytes: the largest run that cannot overflow b.
+				for (std::size_t done = 0; done < count;)
+				{
+					auto const end = std::min(count, done + 5552);
+					for (; done < end; ++done)
+					{
+						a += data[done];
+						b += a;
+					}
+					a %= 65521;
+					b %= 65521;
+				}
+
+				data      += count;
+				size      -= count;
+				blockLeft -= count;
+			}
+		};
+
+		constexpr std::uint8_t filter_none_v{0};
+		for (std::uint32_t y = 0; y < height; ++y)
+		{
+			put(&filter_none_v, 1);
+			put(reinterpret_cast<std::uint8_t const *>(pixels.data() + static_cast<std::size_t>(y) * width), rowBytes); // NOLINT(*-reinterpret-cast)
+		}
+		writer.u32be((b << 16u) | a);
+		writer.endChunk();
+
+		writer.beginChunk("IEND");
+		writer.endChunk();
+		return out;
+	}
+
+	std::vector<std::byte> encodeQoi(std::uint32_t const width, std::uint32_t const height, std::span<std::uint32_t const> const pixels)
+	{
+		assert(width > 0 && height > 0 && pixels.size() == static_cast<std::size_t>(width) * height);
+
+		constexpr std::uint32_t op_index_v{0x00};
+		constexpr std::uint32_t op_diff_v{0x40};
+		constexpr std::uint32_t op_luma_v{0x80};
+		constexpr std::uint32_t op_run_v{0xc0};
+		constexpr std::uint32_t op_rgb_v{0xfe};
+		constexpr std::uint32_t op_rgba_v{0xff};
+		constexpr std::uint32_t max_run_v{62};
+
+		auto out = std::vector<std::byte>{};
+		out.reserve(14 + pixels.size() * 5 + 8); // Worst case: every pixel as QOI_OP_RGBA
+		auto writer = Writer{out};
+
+		writer.bytes("qoif", 4);
+		writer.u32be(width);
+		writer.u32be(height);
+		writer.u8(4); // RGBA
+		writer.u8(0); // sRGB with linear alpha
+
+		auto const byte  = [](std::uint32_t const pixel, std::uint32_t const index) { return (pixel >> (index * 8u)) & 0xffu; };
+		auto const delta = [](std::uint32_t const a, std::uint32_t const b) { return static_cast<std::int32_t>(static_cast<std::int8_t>(a - b)); };
+
+		auto seen     = std::array<std::uint32_t, 64>{};
+		auto previous = std::uint32_t{0xff000000};
+		auto run      = std::uint32_t{};
+		for (std::size_t i = 0; i < pixels.size(); ++i)
+		{
+			auto const pixel = pixels[i];
+			if (pixel == previous)
+			{
+				if (++run == max_run_v || i + 1 == pixels.size())
+				{
+					writer.u8(op_run_v | (run - 1));
+					run = 0;
+				}
+				continue;
+			}
+			if (run > 0)
+			{
+				writer.u8(op_run_v | (run - 1));
+				run = 0;
+			}
+
+			auto const r    = byte(pixel, 0);
+			auto const g    = byte(pixel, 1);
+			auto const b    = byte(pixel, 2);
+			auto const a    = byte(pixel, 3);
+			auto const hash = (r * 3 + g * 5 + b * 7 + a * 11) % 64;
+			if (seen[hash] == pixel)
+			{
+				writer.u8(op_index_v | hash);
+			}
+			else if (seen[hash] = pixel; a != byte(previous, 3))
+			{
+				writer.u8(op_rgba_v);
+				writer.bytes(&pixel, 4);
+			}
+			else
+			{
+				auto const dr = delta(r, byte(previous, 0));
+				auto const dg = delta(g, byte(previous, 1));
+				auto const db = delta(b, byte(previous, 2));
+				if (dr >= -2 && dr <= 1 && dg >= -2 && dg <= 1 && db >= -2 && db <= 1)
+				{
+					writer.u8(op_diff_v | static_cast<std::uint32_t>((dr + 2) << 4 | (dg + 2) << 2 | (db + 2)));
+				}
+				else if (auto const rg = dr - dg, bg = db - dg; dg >= -32 && dg <= 31 && rg >= -8 && rg <= 7 && bg >= -8 && bg <= 7)
+				{
+					writer.u8(op_luma_v | static_cast<std::uint32_t>(dg + 32));
+					writer.u8(static_cast<std::uint32_t>((rg + 8) << 4 | (bg + 8)));
+				}
+				else
+				{
+					writer.u8(op_rgb_v);
+					writer.u8(r);
+					writer.u8(g);
+					writer.u8(b);
+				}
+			}
+			previous = pixel;
+		}
+
+		constexpr auto end_marker_v = std::array<std::uint8_t, 8>{0, 0, 0, 0, 0, 0, 0, 1};
+		writer.bytes(end_marker_v.data(), end_marker_v.size());
+		return out;
+	}
+} // namespace bk::image
@@ -0,0 +1,185 @@
+#include "breakout/core/init_graph.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <condition_variable>
+#include <exception>
+#include <format>
+#include <iterator>
+#include <mutex>
+#include <utility>
+
+#include "breakout/core/logger.hpp"
+#include "breakout/core/profiler.hpp"
+#include "breakout/core/thread_pool.hpp"
+
+namespace bk
+{
+	namespace
+	{
+		auto const s_log = Logger{"startup"};
+
+		double toMs(std::int64_t const ns) { return static_cast<double>(ns) / 1e6; }
+	} // namespace
+
+	InitGraph::TaskId InitGraph::add(std::string_view const name, Task task, std::initializer_list<TaskId> const dependencies, Thread const thread)
+	{
+		auto const id = static_cast<TaskId>(m_nodes.size());
+		// Dependencies can only point backwards, so the graph cannot have cycles.
+		assert(std::ranges::all_of(dependencies, [id](TaskId const dependency) { return dependency < id; }));
+		m_nodes.push_back({
+			.name         = name,
+			.task         = std::move(task),
+			.dependencies = dependencies,
+			.thread       = thread,
+		});
+		return id;
+	}
+
+	bool InitGraph::execute(Node & node, bool const onMain)
+	{
+		node.timing.onMain  = onMain;
+		node.timing.beginNs = Profiler::now();
+		try
+		{
+			node.timing.ok = node.task();
+		} catch (std::exception const & e)
+		{
+			s_log.error("{}: {}", node.name, e.what());
+		} catch (...)
+		{
+			s_log.error("{}: unknown exception", node.name);
+		}
+		node.timing.endNs = Profiler::now();
+		node.timing.ran   = true;
+		s_log.info("{} {} in {:.2f}ms on {}", node.name, node.timing.ok ? "done" : "failed", toMs(node.timing.endNs - node.timing.beginNs),
+				   onMain ? "the main thread" : "a worker");
+		return node.timing.ok;
+	}
+
+	bool InitGraph::run(ThreadPool & pool)
+	{
+		auto dependents = std::vector<std::vector<TaskId>>(m_nodes.size());
+		auto waitingOn  = std::vector<std::uint32_t>(m_nodes.size());
+		for (TaskId id = 0; id < m_nodes.size(); ++id)
+		{
+			for (auto const dependency : m_nodes[id].dependencies) { dependents[dependency].push_back(id); }
+			waitingOn[id] = static_cast<std::uint32_t>(m_nodes[id].dependencies.size());
+		}
+
+		auto mutex     = std::mutex{};
+		auto done      = std::condition_variable{};
+		auto mainReady = std::vector<TaskId>{};
+		auto remaining = m_nodes.size();
+		auto failed    = false;
+
+		// Both called with the mutex held; start() once a task's last dependency has finished. A task whose turn comes after
+		// a failure is finished without running, which in turn releases its dependents, so remaining always reaches zero.
+		std::function<void(TaskId)> finish;
+		auto const start = [&](TaskId const id)
+		{
+			if (failed)
+			{
+				finish(id);
+				return;
+			}
+			if (m_nodes[id].thread == Thread::eMain)
+			{
+				mainReady.push_back(id);
+				done.notify_one();
+				return;
+			}
+			pool.enqueue(
+				[&, id]
+				{
+					auto const ok = execute(m_nodes[id], false);
+					auto lock     = std::scoped_lock{mutex};
+					failed        = failed || !ok;
+					finish(id);
+				});
+		};
+		finish = [&](TaskId const id)
+		{
+			--remaining;
+			for (auto const dependent : dependents[id])
+			{
+				if (--waitingOn[dependent] == 0) { start(dependent); }
+			}
+			if (remaining == 0) { done.notify_one(); }
+		};
+
+		m_beginNs = Profiler::now();
+		auto lock = std::unique_lock{mutex};
+		for (TaskId id = 0; id < m_nodes.size(); ++id)
+		{
+			if (waitingOn[id] == 0) { start(id); }
+		}
+
+		// The calling thread runs main-thread tasks as they become ready, until everything is finished.
+		while (true)
+		{
+			done.wait(lock, [&] { return remaining == 0 || !mainReady.empty(); });
+			if (mainReady.empty()) { break; }
+
+			auto const id = mainReady.front();
+			mainReady.erase(mainReady.begin());
+			if (failed)
+			{
+				finish(id);
+				continue;
+			}
+			lock.unlock();
+			auto const ok = execute(m_nodes[id], true);
+			lock.lock();
+			failed = failed || !ok;
+			finish(id);
+		}
+		m_endNs = Profiler::now();
+
+		s_log.info("startup {} in {:.2f}ms", failed ? "failed" : "done", toMs(m_endNs - m_beginNs));
+		return !failed;
+	}
+
+	std::vector<InitGraph::TaskId> InitGraph::criticalPath() const
+	{
+		auto const finishedLast = [this](auto const & ids)
+		{
+			return std::ranges::max(ids, {}, [this](TaskId const id) { return m_nodes[id].timing.ran ? m_nodes[id].timing.endNs : 0; });
+		};
+
+		auto path = std::vector<TaskId>{};
+		if (m_nodes.empty()) { return path; }
+
+		auto all = std::vector<TaskId>(m_nodes.size());
+		for (TaskId id = 0; id < m_nodes.size(); ++id) { all[id] = id; }
+		path.push_back(finishedLast(all));
+		while (!m_nodes[path.back()].dependencies.empty()) { path.push_back(finishedLast(m_nodes[path.back()].dependencies)); }
+		std::ranges::reverse(path);
+		return path;
+	}
+
+	std::string InitGraph::report() const
+	{
+		auto out     = std::string{"startup critical path:\n"};
+		auto readyNs = m_beginNs;
+		for (auto const id : criticalPath())
+		{
+			auto const & timing = m_nodes[id].timing;
+			if (!timing.ran)
+			{
+				std::format_to(std::back_inserter(out), "  {:<16} skipped\n", m_nodes[id].name);
+				continue;
+			}
+			// Waiting is time between the dependency finishing and this task starting: a busy pool, or the main thread
+			// still running something else.
+			std::format_to(std::back_inserter(out), "  {:<16} {:8.2f}ms  (+{:.2f}ms waiting, {})\n", m_nodes[id].name, toMs(timing.endNs - timing.beginNs),
+						   toMs(timing.beginNs - readyNs), timing.onMain ? "main" : "worker");
+			readyNs = timing.endNs;
+		}
+
+		auto busyNs = std::int64_t{};
+		for (auto const & node : m_nodes) { busyNs += node.timing.ran ? node.timing.endNs - node.timing.beginNs : 0; }
+		std::format_to(std::back_inserter(out), "  total {:.2f}ms for {:.2f}ms of tasks ({} tasks)", toMs(m_endNs - m_beginNs), toMs(busyNs), m_nodes.size());
+		return out;
+	}
+} // namespace bk
@@ -10,6 +10,8 @@
 #include <vector>
 #include <cassert>
 
+#include "breakout/core/alloc_tracker.hpp"
+
 #if defined(_WIN32)
     #include "WinLite/windows.h" // for OutputDebugStringA
 #endif
@@ -28,26 +30,28 @@ namespace bk::logger
         return ThreadId{s_thisThreadId};
     }
 
-    Context Context::make(std::string_view category, Level level)
+    Context Context::make(Category const category, Level level)
     {
         return Context{
-            .category  = category,
-            .timestamp = Clock::now(),
-            .thread    = getThreadId(),
-            .level     = level,
+            .category   = category.name,
+            .categoryId = category.id,
+            .timestamp  = Clock::now(),
+            .thread     = getThreadId(),
+            .level      = level,
         };
     }
 
-    Context Context::make(std::string_view category, Level level, std::string_view function, std::string_view filePath, int currentLine)
+    Context Context::make(Category const category, Level level, std::string_view function, std::string_view filePath, int currentLine)
     {
         return Context{
-            .category  = category,
-            .timestamp = Clock::now(),
-            .thread    = getThreadId(),
-            .level     = level,
-            .func      = function,
-            .file      = filePath,
-            .line      = currentLine,
+            .category   = category.name,
+            .categoryId = category.id,
+            .timestamp  = Clock::now(),
+            .thread     = getThreadId(),
+            .level      = level,
+            .func       = function,
+            .file       = filePath,
+            .line       = currentLine,
         };
     }
 } // namespace bk::logger
@@ -234,7 +238,15 @@ namespace bk::logger
                 lock.unlock();
                 cv.notify_one();
             }
+
+            std::size_t pending()
+            {
+                auto lock = std::scoped_lock{mutex};
+                return buffer.size();
+            }
         };
+
+        constinit auto s_dropped = std::atomic<std::uint64_t>{};
     } // namespace
 
     struct Instance::Impl
@@ -246,6 +258,9 @@ namespace bk::logger
         ConsoleSink console{};
         FileSink file;
 
+        std::atomic<std::uint64_t> messages{};
+        std::atomic<std::uint64_t> filtered{};
+
         static char const * nonEmptyFilePath(char const * input)
         {
             if (input == nullptr || *input == 0) { return "genesis.log"; }
@@ -256,12 +271,16 @@ namespace bk::logger
 
         void print(std::string_view const message, Context const & context)
         {
+            // Formatting the message happened at the call site, charged to the caller; what this costs is the logger's.
+            auto const tag = alloc::Scope{alloc::Tag::eLogger};
             auto lock = std::unique_lock{mutex};
-            if (auto const itr = config.categoryMaxLevels.find(context.category); itr != config.categoryMaxLevels.end())
+            auto const itr = config.categoryMaxLevels.find(context.categoryId);
+            if (context.level > (itr != config.categoryMaxLevels.end() ? itr->second : config.maxLevel))
             {
-                if (context.level > itr->second) { return; }
+                filtered.fetch_add(1, std::memory_order_relaxed);
+                return;
             }
-            else if (context.level > config.maxLevel) { return; }
+            messages.fetch_add(1, std::memory_order_relaxed);
             auto const target = [&]
             {
                 if (auto const itr = config.levelTargets.find(context.level); itr != config.levelTargets.end()) { return itr->second; }
@@ -301,7 +320,7 @@ namespace bk::logger
 
         m_impl->config = std::move(config);
 
-        m_impl->print(std::format("logging to file: {}", filePath), Context::make("logger", Level::eInfo));
+        m_impl->print(std::format("logging to file: {}", filePath), Context::make(Category{"logger"}, Level::eInfo));
     }
 
     Instance::~Instance()
@@ -331,25 +350,41 @@ namespace bk::logger
 
     void Instance::print(std::string_view const message, Context const & context)
     {
-        if (s_instance == nullptr) { return; }
+        if (s_instance == nullptr)
+        {
+            s_dropped.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
         s_instance->print(message, context);
     }
+
+    Stats Instance::getStats()
+    {
+        auto ret = Stats{.dropped = s_dropped.load(std::memory_order_relaxed)};
+        if (s_instance == nullptr) { return ret; }
+        ret.messages         = s_instance->messages.load(std::memory_order_relaxed);
+        ret.filtered         = s_instance->filtered.load(std::memory_order_relaxed);
+        ret.pendingFileBytes = s_instance->file.pending();
+        return ret;
+    }
 } // namespace bk::logger
 
 namespace bk
 {
-    void logger::print(logger::Level level, std::string_view category, std::string_view message)
+    void logger::print(logger::Level level, logger::Category const category, std::string_view message)
     {
         Instance::print(message, Context::make(category, level));
     }
 
     void logger::print(
-        Level level, std::string_view category, std::string_view function, std::string_view filePath, int curLine, std::string_view message)
+        Level level, Category const category, std::string_view function, std::string_view filePath, int curLine, std::string_view message)
     {
         Instance::print(message, Context::make(category, level, function, filePath, curLine));
     }
 
     Logger::Logger(std::string_view const category) : m_category(category.empty() ? "unknown" : category)
     {
+        // Registers the name for StringId::name(), and catches category IDs colliding in debug builds.
+        StringId::intern(m_category.name);
     }
 } // namespace bk
@@ -0,0 +1,99 @@
+#include "breakout/core/mapped_file.hpp"
+
+#include <utility>
+
+#if defined(_WIN32)
+	#include "WinLite/windows.h"
+#else
+	#include <fcntl.h>
+	#include <sys/mman.h>
+	#include <sys/stat.h>
+	#include <unistd.h>
+#endif
+
+namespace bk
+{
+	std::optional<MappedFile> MappedFile::open(std::filesystem::path const & path)
+	{
+		auto ret = MappedFile{};
+#if defined(_WIN32)
+		auto * const file = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+		if (file == INVALID_HANDLE_VALUE) { return {}; }
+
+		auto size = LARGE_INTEGER{};
+		if (GetFileSizeEx(file, &size) == 0 || size.QuadPart == 0)
+		{
+			CloseHandle(file);
+			return {};
+		}
+
+		ret.m_mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+		CloseHandle(file);
+		if (ret.m_mapping == nullptr) { return {}; }
+
+		ret.m_data = static_cast<std::byte const *>(MapViewOfFile(ret.m_mapping, FILE_MAP_READ, 0, 0, 0));
+		if (ret.m_data == nullptr) { return {}; }
+		ret.m_size = static_cast<std::size_t>(size.QuadPart);
+#else
+		auto const fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+		if (fd < 0) { return {}; }
+
+		struct stat info{};
+		if (fstat(fd, &info) != 0 || info.st_size <= 0)
+		{
+			close(fd);
+			return {};
+		}
+
+		auto const size    = static_cast<std::size_t>(info.st_size);
+		auto * const data = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+		close(fd);
+		if (data == MAP_FAILED) { return {}; }
+
+		ret.m_data = static_cast<std::byte const *>(data);
+		ret.m_size = size;
+#endif
+		return ret;
+	}
+
+	MappedFile::MappedFile(MappedFile && other) noexcept
+	: m_data(std::exchange(other.m_data, nullptr)), m_size(std::exchange(other.m_size, 0))
+#if defined(_WIN32)
+	, m_mapping(std::exchange(other.m_mapping, nullptr))
+#endif
+	{
+	}
+
+	MappedFile & MappedFile::operator=(MappedFile && other) noexcept
+	{
+		if (this != &other)
+		{
+			release();
+			m_data = std::exchange(other.m_data, nullptr);
+			m_size = std::exchange(other.m_size, 0);
+#if defined(_WIN32)
+			m_mapping = std::exchange(other.m_mapping, nullptr);
+#endif
+		}
+		return *this;
+	}
+
+	MappedFile::~MappedFile()
+	{
+		release();
+	}
+
+	void MappedFile::release()
+	{
+#if defined(_WIN32)
+		if (m_data != nullptr) { UnmapViewOfFile(m_data); }
+		if (m_mapping != nullptr) { CloseHandle(m_mapping); }
+		m_mapping = nullptr;
+#else
+		// NOLINTNEXTLINE(cppcoreguidelines-pro-type-const-cast)
+		if (m_data != nullptr) { munmap(const_cast<std::byte *>(m_data), m_size); }
+#endif
+		m_data = nullptr;
+		m_size = 0;
+	}
+} // namespace bk
@@ -0,0 +1,177 @@
+#include "breakout/core/metrics.hpp"
+
+#include <condition_variable>
+#include <format>
+#include <iterator>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <variant>
+#include <vector>
+
+#include "breakout/core/file_io.hpp"
+#include "breakout/core/logger.hpp"
+
+namespace bk::metrics
+{
+	namespace
+	{
+		auto const s_log = Logger{"metrics"};
+
+		using Metric = std::variant<std::unique_ptr<Counter>, std::unique_ptr<Gauge>, std::unique_ptr<Histogram>>;
+
+		// Metrics are never removed, so references handed out stay valid; the mutex only guards lookups and registration.
+		struct Registry
+		{
+			std::mutex mutex{};
+			std::map<std::string, Metric, std::less<>> metrics{}; // Sorted, so output is stable between publishes
+		};
+
+		Registry & registry()
+		{
+			static auto s_registry = Registry{};
+			return s_registry;
+		}
+
+		template <typename Type>
+		Type & find(std::string_view const name)
+		{
+			auto & reg = registry();
+			auto lock  = std::scoped_lock{reg.mutex};
+			auto itr   = reg.metrics.find(name);
+			if (itr == reg.metrics.end()) { itr = reg.metrics.emplace(std::string{name}, std::make_unique<Type>()).first; }
+
+			if (auto * metric = std::get_if<std::unique_ptr<Type>>(&itr->second)) { return **metric; }
+
+			// Leaked on purpose: callers keep the reference forever.
+			s_log.error("'{}' is already registered as another kind of metric; updates to this one are not published", name);
+			return *new Type{}; // NOLINT(*-owning-memory)
+		}
+
+		std::uint64_t quantile(std::span<std::uint64_t const> const buckets, std::uint64_t const count, double const q)
+		{
+			auto const rank = std::max<std::uint64_t>(static_cast<std::uint64_t>(q * static_cast<double>(count) + 0.5), 1);
+			auto seen       = std::uint64_t{};
+			for (std::size_t i = 0; i < buckets.size(); ++i)
+			{
+				seen += buckets[i];
+				if (seen >= rank) { return Histogram::bucketUpperBound(i); }
+			}
+			return 0;
+		}
+	} // namespace
+
+	std::uint32_t detail::nextShard()
+	{
+		static constinit auto s_next = std::atomic<std::uint32_t>{};
+		return s_next.fetch_add(1, std::memory_order_relaxed) % shard_count_v;
+	}
+
+	std::uint64_t Counter::value() const
+	{
+		auto ret = std::uint64_t{};
+		for (auto const & shard : m_shards) { ret += shard.value.load(std::memory_order_relaxed); }
+		return ret;
+	}
+
+	void Gauge::set(std::int64_t const value)
+	{
+		m_shards[0].value.store(value, std::memory_order_relaxed);
+		for (std::size_t i = 1; i < shard_count_v; ++i) { m_shards[i].value.store(0, std::memory_order_relaxed); }
+	}
+
+	std::int64_t Gauge::value() const
+	{
+		auto ret = std::int64_t{};
+		for (auto const & shard : m_shards) { ret += shard.value.load(std::memory_order_relaxed); }
+		return ret;
+	}
+
+	Histogram::Summary Histogram::summarize() const
+	{
+		// Merge first: shards keep changing underneath, so quantiles must come from one consistent copy.
+		auto buckets = std::vector<std::uint64_t>(bucket_count_v);
+		auto ret     = Summary{};
+		for (auto const & shard : m_shards)
+		{
+			for (std::size_t i = 0; i < bucket_count_v; ++i) { buckets[i] += shard.buckets[i].load(std::memory_order_relaxed); }
+			ret.sum += shard.sum.load(std::memory_order_relaxed);
+		}
+
+		for (std::size_t i = 0; i < bucket_count_v; ++i)
+		{
+			if (buckets[i] == 0) { continue; }
+			ret.count += buckets[i];
+			ret.max    = bucketUpperBound(i);
+		}
+		if (ret.count == 0) { return ret; }
+
+		ret.p50 = quantile(buckets, ret.count, 0.5);
+		ret.p90 = quantile(buckets, ret.count, 0.9);
+		ret.p99 = quantile(buckets, ret.count, 0.99);
+		return ret;
+	}
+
+	Counter & counter(std::string_view const name) { return find<Counter>(name); }
+
+	Gauge & gauge(std::string_view const name) { return find<Gauge>(name); }
+
+	Histogram & histogram(std::string_view const name) { return find<Histogram>(name); }
+
+	std::string format()
+	{
+		auto & reg = registry();
+		auto out   = std::string{};
+		auto lock  = std::scoped_lock{reg.mutex};
+		for (auto const & [name, metric] : reg.metrics)
+		{
+			if (auto const * counter = std::get_if<std::unique_ptr<Counter>>(&metric))
+			{
+				std::format_to(std::back_inserter(out), "# TYPE {0} counter\n{0} {1}\n", name, (*counter)->value());
+			}
+			else if (auto const * gauge = std::get_if<std::unique_ptr<Gauge>>(&metric))
+			{
+				std::format_to(std::back_inserter(out), "# TYPE {0} gauge\n{0} {1}\n", name, (*gauge)->value());
+			}
+			else if (auto const * histogram = std::get_if<std::unique_ptr<Histogram>>(&metric))
+			{
+				auto const summary = (*histogram)->summarize();
+				std::format_to(std::back_inserter(out),
+							   "# TYPE {0} summary\n{0}{{quantile=\"0.5\"}} {1}\n{0}{{quantile=\"0.9\"}} {2}\n{0}{{quantile=\"0.99\"}} {3}\n{0}{{quantile=\"1\"}} {4}\n"
+							   "{0}_sum {5}\n{0}_count {6}\n",
+							   name, summary.p50, summary.p90, summary.p99, summary.max, summary.sum, summary.count);
+			}
+		}
+		return out;
+	}
+
+	Publisher::Publisher(Config config) : m_config(std::move(config))
+	{
+		m_thread = std::jthread{[this](std::stop_token const & stop)
+								{
+									auto mutex = std::mutex{};
+									auto wake  = std::condition_variable_any{};
+									auto lock  = std::unique_lock{mutex};
+									while (!stop.stop_requested())
+									{
+										wake.wait_for(lock, stop, m_config.interval, [] { return false; });
+										if (!stop.stop_requested()) { publish(); }
+									}
+								}};
+	}
+
+	Publisher::~Publisher()
+	{
+		m_thread.request_stop();
+		m_thread.join();
+		publish();
+	}
+
+	void Publisher::publish() const
+	{
+		auto const text = format();
+		if (!m_config.file.empty()) { writeFileAtomic(m_config.file, std::as_bytes(std::span{text})); }
+		if (m_config.log) { s_log.info("\n{}", text); }
+	}
+} // namespace bk::metrics
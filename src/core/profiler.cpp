@@ -0,0 +1,156 @@
+#include "breakout/core/profiler.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <format>
+#include <string>
+
+#include "breakout/core/logger.hpp"
+
+namespace bk
+{
+	namespace
+	{
+		auto const s_log = Logger{"profiler"};
+
+		thread_local std::uint16_t s_depth{};
+
+		double toMs(std::int64_t const ns) { return static_cast<double>(ns) / 1e6; }
+	} // namespace
+
+	Profiler::Scope::Scope(Profiler & profiler, std::string_view const name) : m_profiler(profiler), m_name(name), m_beginNs(now()) { ++s_depth; }
+
+	Profiler::Scope::~Scope()
+	{
+		--s_depth;
+		auto const zone = Zone{
+			.name    = m_name,
+			.beginNs = m_beginNs,
+			.endNs   = now(),
+			.track   = static_cast<int>(logger::Context::getThreadId()),
+			.depth   = s_depth,
+		};
+
+		auto const lock = std::scoped_lock{m_profiler.m_mutex};
+		if (auto * frame = m_profiler.find(m_profiler.m_current)) { frame->zones.push_back(zone); }
+	}
+
+	Profiler::Profiler(std::uint32_t const latency, std::uint32_t const reportInterval) : m_latency(latency), m_reportInterval(reportInterval) {}
+
+	std::int64_t Profiler::now()
+	{
+		return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+	}
+
+	Profiler::Frame * Profiler::find(std::uint64_t const number)
+	{
+		auto const itr = std::ranges::find(m_open, number, &Frame::number);
+		return itr == m_open.end() ? nullptr : &*itr;
+	}
+
+	void Profiler::beginFrame(std::uint64_t const number)
+	{
+		auto const lock = std::scoped_lock{m_mutex};
+		m_current       = number;
+		m_open.push_back({.number = number, .beginNs = now()});
+	}
+
+	void Profiler::endFrame()
+	{
+		auto ready = std::vector<Frame>{};
+		{
+			auto const lock = std::scoped_lock{m_mutex};
+			if (auto * frame = find(m_current)) { frame->endNs = now(); }
+			while (!m_open.empty() && m_open.front().number + m_latency <= m_current)
+			{
+				ready.push_back(std::move(m_open.front()));
+				m_open.pop_front();
+			}
+			if (!ready.empty()) { m_published = ready.back(); }
+		}
+
+		// Reporting (formatting) outside the lock, so recording threads never wait on it.
+		if (m_reportInterval == 0) { return; }
+		for (auto const & frame : ready)
+		{
+			if (frame.number % m_reportInterval != 0) { continue; }
+			report(frame);
+			if (auto const latency = inputLatency(); latency.samples > 0)
+			{
+				s_log.info("  input to present over {} events: p50 {:.2f}ms, p90 {:.2f}ms, p99 {:.2f}ms, max {:.2f}ms", latency.samples, latency.p50Ms,
+						   latency.p90Ms, latency.p99Ms, latency.maxMs);
+			}
+		}
+	}
+
+	void Profiler::addZone(std::uint64_t const frame, Zone const & zone)
+	{
+		auto const lock = std::scoped_lock{m_mutex};
+		if (auto * open = find(frame)) { open->zones.push_back(zone); }
+	}
+
+	void Profiler::setGpuCalibrated(std::uint64_t const frame, bool const calibrated)
+	{
+		auto const lock = std::scoped_lock{m_mutex};
+		if (auto * open = find(frame)) { open->gpuCalibrated = calibrated; }
+	}
+
+	void Profiler::setAllocations(alloc::Counts const & counts)
+	{
+		auto const lock = std::scoped_lock{m_mutex};
+		if (auto * open = find(m_current)) { open->allocations = counts; }
+	}
+
+	void Profiler::addInputLatency(std::int64_t const ns)
+	{
+		auto const lock = std::scoped_lock{m_mutex};
+		if (m_inputLatencies.size() < latency_window_v) { m_inputLatencies.push_back(ns); }
+		else { m_inputLatencies[m_inputLatencyCount % latency_window_v] = ns; }
+		++m_inputLatencyCount;
+	}
+
+	Profiler::Percentiles Profiler::inputLatency() const
+	{
+		auto samples = std::vector<std::int64_t>{};
+		{
+			auto const lock = std::scoped_lock{m_mutex};
+			samples         = m_inputLatencies;
+		}
+		if (samples.empty()) { return {}; }
+
+		std::ranges::sort(samples);
+		auto const at = [&](double const fraction) { return toMs(samples[static_cast<std::size_t>(fraction * static_cast<double>(samples.size() - 1))]); };
+		return {.samples = samples.size(), .p50Ms = at(0.5), .p90Ms = at(0.9), .p99Ms = at(0.99), .maxMs = toMs(samples.back())};
+	}
+
+	Profiler::Frame Profiler::lastFrame() const
+	{
+		auto const lock = std::scoped_lock{m_mutex};
+		return m_published;
+	}
+
+	void Profiler::report(Frame const & frame)
+	{
+		auto zones = frame.zones;
+		std::ranges::sort(zones, [](Zone const & a, Zone const & b) { return a.beginNs != b.beginNs ? a.beginNs < b.beginNs : a.depth < b.depth; });
+
+		auto gpuNs = std::int64_t{};
+		for (auto const & zone : zones)
+		{
+			if (zone.track == gpu_track_v && zone.depth == 0) { gpuNs += zone.endNs - zone.beginNs; }
+		}
+
+		s_log.info("frame {}: cpu {:.3f}ms, gpu {:.3f}ms{}", frame.number, toMs(frame.endNs - frame.beginNs), toMs(gpuNs),
+				   frame.gpuCalibrated ? "" : " (gpu timeline estimated)");
+		if constexpr (alloc::tracking_v)
+		{
+			s_log.info("  {} heap allocations, {:.1f} KiB", frame.allocations.allocations, static_cast<double>(frame.allocations.bytes) / 1024.0);
+		}
+		for (auto const & zone : zones)
+		{
+			auto const track = zone.track == gpu_track_v ? std::string{"gpu"} : std::format("T{}", zone.track);
+			s_log.info("  {:>4} {:>8.3f}ms {:>8.3f}ms  {}{}", track, toMs(zone.beginNs - frame.beginNs), toMs(zone.endNs - zone.beginNs),
+					   std::string(zone.depth * 2u, ' '), zone.name);
+		}
+	}
+} // namespace bk
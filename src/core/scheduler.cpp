@@ -0,0 +1,141 @@
+#include "breakout/core/scheduler.hpp"
+
+#include <algorithm>
+#include <exception>
+#include <utility>
+
+#include "breakout/core/logger.hpp"
+#include "breakout/core/thread_pool.hpp"
+
+namespace bk
+{
+	namespace
+	{
+		auto const s_log = Logger{"tasks"};
+
+		// std heaps are max-heaps: the earliest deadline goes on top.
+		constexpr auto s_laterDeadline = [](auto const & lhs, auto const & rhs) { return lhs.deadline > rhs.deadline; };
+	} // namespace
+
+	void Scheduler::NextFrame::await_suspend(std::coroutine_handle<> const handle) const
+	{
+		auto lock = std::scoped_lock{scheduler.m_mutex};
+		scheduler.m_nextFrame.push_back(handle);
+	}
+
+	void Scheduler::After::await_suspend(std::coroutine_handle<> const handle) const
+	{
+		auto lock = std::scoped_lock{scheduler.m_mutex};
+		scheduler.m_timers.push_back({deadline, handle});
+		std::ranges::push_heap(scheduler.m_timers, s_laterDeadline);
+	}
+
+	void Scheduler::Worker::await_suspend(std::coroutine_handle<> const handle) const
+	{
+		{
+			auto lock = std::scoped_lock{scheduler.m_mutex};
+			++scheduler.m_onWorkers;
+		}
+		scheduler.m_pool.enqueue(
+			[&scheduler = scheduler, handle]
+			{
+				// Returns once the task suspends again (or finishes), having queued itself wherever it went next.
+				handle.resume();
+				// Notify under the lock: once the count reaches 0 the destructor may tear the scheduler down, and it cannot
+				// get past its wait before this releases the mutex.
+				auto lock = std::scoped_lock{scheduler.m_mutex};
+				if (--scheduler.m_onWorkers == 0) { scheduler.m_workersDone.notify_all(); }
+			});
+	}
+
+	void Scheduler::Until::await_suspend(std::coroutine_handle<> const handle)
+	{
+		auto lock = std::scoped_lock{scheduler.m_mutex};
+		scheduler.m_waiters.push_back({std::move(predicate), handle});
+	}
+
+	Scheduler::Scheduler(ThreadPool & pool, Config config) : m_pool(pool), m_config(config), m_frameThread(std::this_thread::get_id()) {}
+
+	Scheduler::~Scheduler()
+	{
+		{
+			auto lock = std::unique_lock{m_mutex};
+			m_workersDone.wait(lock, [this] { return m_onWorkers == 0; });
+		}
+		if (!m_tasks.empty()) { s_log.info("destroying {} unfinished tasks", m_tasks.size()); }
+		// Queued handles all belong to these tasks' coroutines; the queues are dropped without resuming anything.
+		m_tasks.clear();
+	}
+
+	void Scheduler::spawn(Task<void> task)
+	{
+		m_tasks.push_back(run(std::move(task)));
+		schedule(m_tasks.back().handle());
+	}
+
+	Task<void> Scheduler::run(Task<void> task)
+	{
+		try
+		{
+			co_await task;
+		} catch (std::exception const & e)
+		{
+			s_log.error("task failed: {}", e.what());
+		} catch (...)
+		{
+			s_log.error("task failed: unknown exception");
+		}
+		// Finish on the frame thread, which is the only one tick() checks isDone() and destroys tasks from.
+		co_await frameThread();
+	}
+
+	void Scheduler::schedule(std::coroutine_handle<> const handle)
+	{
+		auto lock = std::scoped_lock{m_mutex};
+		m_ready.push_back(handle);
+	}
+
+	void Scheduler::tick()
+	{
+		auto const start = Clock::now();
+
+		// Predicates run without the lock and only ever on this thread: they may be slow, and need not be thread-safe.
+		auto waiters = std::vector<Waiter>{};
+		{
+			auto lock = std::scoped_lock{m_mutex};
+			m_ready.insert(m_ready.end(), m_nextFrame.begin(), m_nextFrame.end());
+			m_nextFrame.clear();
+			while (!m_timers.empty() && m_timers.front().deadline <= start)
+			{
+				std::ranges::pop_heap(m_timers, s_laterDeadline);
+				m_ready.push_back(m_timers.back().handle);
+				m_timers.pop_back();
+			}
+			waiters.swap(m_waiters);
+		}
+		auto const satisfied = std::ranges::partition(waiters, [](Waiter const & waiter) { return !waiter.predicate(); });
+		{
+			auto lock = std::scoped_lock{m_mutex};
+			for (auto const & waiter : satisfied) { m_ready.push_back(waiter.handle); }
+			waiters.erase(satisfied.begin(), satisfied.end());
+			m_waiters.insert(m_waiters.end(), std::make_move_iterator(waiters.begin()), std::make_move_iterator(waiters.end()));
+		}
+
+		// What the budget does not cover stays at the front of the queue, ahead of anything readied later.
+		auto resumed = std::uint32_t{};
+		while (resumed == 0 || Clock::now() - start < m_config.budget)
+		{
+			auto handle = std::coroutine_handle<>{};
+			{
+				auto lock = std::scoped_lock{m_mutex};
+				if (m_ready.empty()) { break; }
+				handle = m_ready.front();
+				m_ready.pop_front();
+			}
+			handle.resume();
+			++resumed;
+		}
+
+		std::erase_if(m_tasks, [](Task<void> const & task) { return task.isDone(); });
+	}
+} // namespace bk
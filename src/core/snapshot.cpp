@@ -0,0 +1,298 @@
+#include "breakout/core/snapshot.hpp"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cassert>
+
+#include "breakout/core/logger.hpp"
+
+namespace bk::snapshot
+{
+	namespace
+	{
+		auto const s_log = Logger{"snapshot"};
+
+		constexpr std::size_t word_v{sizeof(std::uint64_t)};
+
+		std::size_t wordCount(std::size_t const bytes) { return (bytes + word_v - 1) / word_v; }
+
+		// Four independent lanes of xxHash64 rounds over 64 bit words, so consecutive words do not wait on each other.
+		class Hasher
+		{
+		public:
+			void add(std::size_t const index, std::uint64_t const word) { round(m_lanes[index % m_lanes.size()], word); }
+
+			// Words index..index+3, index a multiple of 4.
+			void add(std::uint64_t const * const words)
+			{
+				round(m_lanes[0], words[0]);
+				round(m_lanes[1], words[1]);
+				round(m_lanes[2], words[2]);
+				round(m_lanes[3], words[3]);
+			}
+
+			[[nodiscard]] std::uint64_t finish(std::size_t const bytes) const
+			{
+				auto ret  = std::rotl(m_lanes[0], 1) + std::rotl(m_lanes[1], 7) + std::rotl(m_lanes[2], 12) + std::rotl(m_lanes[3], 18);
+				ret      ^= bytes;
+				ret      ^= ret >> 33;
+				ret      *= prime2_v;
+				ret      ^= ret >> 29;
+				ret      *= prime3_v;
+				ret      ^= ret >> 32;
+				return ret;
+			}
+
+		private:
+			static void round(std::uint64_t & lane, std::uint64_t const word) { lane = std::rotl(lane + word * prime2_v, 31) * prime1_v; }
+
+			static constexpr std::uint64_t prime1_v{0x9e3779b185ebca87};
+			static constexpr std::uint64_t prime2_v{0xc2b2ae3d27d4eb4f};
+			static constexpr std::uint64_t prime3_v{0x165667b19e3779f9};
+
+			std::array<std::uint64_t, 4> m_lanes{prime1_v + prime2_v, prime2_v, 0, 0 - prime1_v};
+		};
+
+		// Word i of a state, zero padded past its end.
+		std::uint64_t loadWord(std::span<std::byte const> const state, std::size_t const index)
+		{
+			auto ret          = std::uint64_t{};
+			auto const offset = index * word_v;
+			if (offset < state.size()) { std::memcpy(&ret, state.data() + offset, std::min(word_v, state.size() - offset)); }
+			return ret;
+		}
+
+		// Encoded deltas are runs: a header word (unchanged words to skip in the low half, changed words following in the
+		// high half), then the XOR of each changed word.
+		void applyDelta(std::span<std::uint64_t const> const encoded, std::span<std::byte> const state)
+		{
+			auto word = std::size_t{};
+			for (std::size_t read = 0; read < encoded.size();)
+			{
+				auto const header   = encoded[read++];
+				word               += header & 0xffffffffu;
+				auto const literals = static_cast<std::size_t>(header >> 32u);
+				assert((word + literals) * word_v <= state.size() && read + literals <= encoded.size());
+				for (std::size_t i = 0; i < literals; ++i, ++word)
+				{
+					auto value = std::uint64_t{};
+					std::memcpy(&value, state.data() + word * word_v, word_v);
+					value ^= encoded[read++];
+					std::memcpy(state.data() + word * word_v, &value, word_v);
+				}
+			}
+		}
+	} // namespace
+
+	std::uint64_t hash(std::span<std::byte const> const state)
+	{
+		auto hasher = Hasher{};
+		auto block  = std::array<std::uint64_t, 4>{};
+		auto i      = std::size_t{};
+		for (; (i + block.size()) * word_v <= state.size(); i += block.size())
+		{
+			std::memcpy(block.data(), state.data() + i * word_v, sizeof(block));
+			hasher.add(block.data());
+		}
+		for (; i < wordCount(state.size()); ++i) { hasher.add(i, loadWord(state, i)); }
+		return hasher.finish(state.size());
+	}
+
+	void Writer::append(std::span<std::byte const> const bytes)
+	{
+		m_out.insert(m_out.end(), bytes.begin(), bytes.end());
+		m_out.resize(wordCount(m_out.size()) * word_v);
+	}
+
+	std::span<std::byte const> Reader::take(std::size_t const size)
+	{
+		auto const padded = wordCount(size) * word_v;
+		if (padded > m_state.size() - m_offset) { return {}; }
+		auto const ret  = m_state.subspan(m_offset, size);
+		m_offset       += padded;
+		return ret;
+	}
+
+	Ring::Ring(Config const config) : m_buffer(std::max<std::size_t>(config.bytes / word_v, 1)), m_slots(std::max(config.capacity, 1U))
+	{
+		m_latest.reserve(wordCount(config.stateBytes));
+	}
+
+	std::uint64_t Ring::capture(std::uint64_t const frame, std::span<std::byte const> const state)
+	{
+		assert(m_count == 0 || frame > slot(0).frame);
+
+		auto const words = wordCount(state.size());
+		auto const total = std::max(words, wordCount(m_latestBytes));
+		assert(total < (std::uint64_t{1} << 32u)); // Run lengths are 32 bit
+		if (m_latest.size() < total) { m_latest.resize(total); }
+
+		// At worst every other word changed: one header per changed word, plus the last one.
+		auto const worst = total + total / 2 + 1;
+		if (worst > m_buffer.size())
+		{
+			// A delta that cannot be stored breaks the chain back to every older snapshot.
+			s_log.warn("a {} byte state does not fit in the {} byte snapshot ring; history dropped", state.size(), m_buffer.size() * word_v);
+			while (m_count > 0) { evictOldest(); }
+			std::ranges::fill(m_latest, 0);
+			if (!state.empty()) { std::memcpy(m_latest.data(), state.data(), state.size()); }
+			m_latestBytes      = state.size();
+			m_stats.stateBytes = state.size();
+			m_stats.deltaBytes = 0;
+			return snapshot::hash(state);
+		}
+
+		// One pass: hash the new state, XOR it with the newest one (which it then replaces) and encode the result.
+		auto const offset = allocate(worst);
+		auto * const out  = m_buffer.data() + offset;
+		auto hasher       = Hasher{};
+		auto written      = std::size_t{1};
+		auto header       = std::size_t{};
+		auto zeros        = std::uint64_t{};
+		auto literals     = std::uint64_t{};
+		auto const encode = [&](std::size_t const i, std::uint64_t const word)
+		{
+			auto const delta = word ^ m_latest[i];
+			m_latest[i]      = word;
+			if (delta == 0)
+			{
+				if (literals != 0)
+				{
+					out[header] = zeros | literals << 32u;
+					header      = written++;
+					zeros       = 0;
+					literals    = 0;
+				}
+				++zeros;
+				return;
+			}
+			out[written++] = delta;
+			++literals;
+		};
+
+		// Whole blocks of four words first, then the tail: the last partial word, and words the previous state had past
+		// the end of this one (which must become zero).
+		auto block = std::array<std::uint64_t, 4>{};
+		auto i     = std::size_t{};
+		for (; (i + block.size()) * word_v <= state.size(); i += block.size())
+		{
+			std::memcpy(block.data(), state.data() + i * word_v, sizeof(block));
+			hasher.add(block.data());
+			for (std::size_t j = 0; j < block.size(); ++j) { encode(i + j, block[j]); }
+		}
+		for (; i < total; ++i)
+		{
+			auto const word = loadWord(state, i);
+			if (i < words) { hasher.add(i, word); }
+			encode(i, word);
+		}
+		// Trailing unchanged words need no run of their own.
+		if (literals != 0 || header == 0) { out[header] = zeros | literals << 32u; }
+		else { --written; }
+
+		auto const ret = hasher.finish(state.size());
+		m_slots[(m_first + m_count) % m_slots.size()] = Slot{
+			.frame         = frame,
+			.hash          = ret,
+			.offset        = offset,
+			.words         = written,
+			.bytes         = state.size(),
+			.previousBytes = m_latestBytes,
+		};
+		++m_count;
+		m_head              = offset + written;
+		m_latestBytes       = state.size();
+		m_stats.stateBytes  = state.size();
+		m_stats.deltaBytes  = written * word_v;
+		m_stats.storedBytes += written * word_v;
+		return ret;
+	}
+
+	bool Ring::restore(std::uint64_t const frame, std::vector<std::byte> & out)
+	{
+		auto const age = find(frame);
+		if (!age) { return false; }
+
+		// Each delta turns a state into the one before it. Decoded in place in out, at the padded size of the largest state
+		// any of them covers, which m_latest has.
+		out.resize(m_latest.size() * word_v);
+		std::memcpy(out.data(), m_latest.data(), out.size());
+		for (std::uint32_t i = 0; i < *age; ++i)
+		{
+			auto const & delta = slot(i);
+			applyDelta(std::span{m_buffer}.subspan(delta.offset, delta.words), out);
+		}
+		out.resize(slot(*age).bytes);
+		return true;
+	}
+
+	bool Ring::rollback(std::uint64_t const frame, std::vector<std::byte> & out)
+	{
+		auto const age = find(frame);
+		if (!age || !restore(frame, out)) { return false; }
+
+		for (std::uint32_t i = 0; i < *age; ++i)
+		{
+			m_stats.storedBytes -= slot(0).words * word_v;
+			--m_count;
+		}
+		m_head        = slot(0).offset + slot(0).words;
+		m_latestBytes = slot(0).bytes;
+		std::ranges::fill(m_latest, 0);
+		if (!out.empty()) { std::memcpy(m_latest.data(), out.data(), out.size()); }
+		return true;
+	}
+
+	std::optional<std::uint64_t> Ring::hash(std::uint64_t const frame) const
+	{
+		if (auto const age = find(frame)) { return slot(*age).hash; }
+		return std::nullopt;
+	}
+
+	std::optional<std::uint64_t> Ring::oldest() const
+	{
+		if (m_count == 0) { return std::nullopt; }
+		return slot(m_count - 1).frame;
+	}
+
+	std::optional<std::uint64_t> Ring::newest() const
+	{
+		if (m_count == 0) { return std::nullopt; }
+		return slot(0).frame;
+	}
+
+	std::optional<std::uint32_t> Ring::find(std::uint64_t const frame) const
+	{
+		for (std::uint32_t age = 0; age < m_count; ++age)
+		{
+			if (slot(age).frame == frame) { return age; }
+		}
+		return std::nullopt;
+	}
+
+	std::size_t Ring::allocate(std::size_t const words)
+	{
+		if (m_count == m_slots.size()) { evictOldest(); }
+		if (m_count == 0) { m_head = 0; }
+
+		// Deltas are laid out in capture order, so the ones in the way are always the oldest. Past the end the next one
+		// wraps to the start, and what is left between the head and the end is older than everything there.
+		auto start = m_head;
+		if (start + words > m_buffer.size())
+		{
+			while (m_count > 0 && slot(m_count - 1).offset >= m_head) { evictOldest(); }
+			start = 0;
+		}
+		while (m_count > 0 && slot(m_count - 1).offset >= start && slot(m_count - 1).offset < start + words) { evictOldest(); }
+		return start;
+	}
+
+	void Ring::evictOldest()
+	{
+		m_stats.storedBytes -= slot(m_count - 1).words * word_v;
+		++m_stats.evictions;
+		m_first = (m_first + 1) % static_cast<std::uint32_t>(m_slots.size());
+		--m_count;
+	}
+} // namespace bk::snapshot
@@ -0,0 +1,96 @@
+#include "breakout/core/thread_pool.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <memory>
+
+#include "breakout/core/alloc_tracker.hpp"
+
+namespace bk
+{
+	std::uint32_t ThreadPool::defaultWorkerCount()
+	{
+		auto const hardware = std::thread::hardware_concurrency();
+		return std::max(hardware, 2U) - 1;
+	}
+
+	ThreadPool::ThreadPool(std::uint32_t const workerCount)
+	{
+		m_workers.reserve(std::max(workerCount, 1U));
+		for (std::uint32_t i = 0; i < std::max(workerCount, 1U); ++i)
+		{
+			m_workers.emplace_back([this](std::stop_token const & stop) { run(stop); });
+		}
+	}
+
+	void ThreadPool::enqueue(Job job)
+	{
+		auto lock = std::unique_lock{m_mutex};
+		m_jobs.push_back(std::move(job));
+		lock.unlock();
+		m_cv.notify_one();
+	}
+
+	void ThreadPool::parallelFor(std::uint32_t const count, std::function<void(std::uint32_t)> const & fn)
+	{
+		if (count == 0) { return; }
+
+		// Helpers may only get to run after the caller has finished everything, so they share ownership of the state.
+		struct State
+		{
+			std::function<void(std::uint32_t)> const * fn{};
+			std::uint32_t count{};
+			std::atomic<std::uint32_t> next{};
+			std::atomic<std::uint32_t> done{};
+
+			void work()
+			{
+				for (auto i = next.fetch_add(1); i < count; i = next.fetch_add(1))
+				{
+					(*fn)(i);
+					if (done.fetch_add(1) + 1 == count) { done.notify_all(); }
+				}
+			}
+		};
+
+		auto state   = std::make_shared<State>();
+		state->fn    = &fn;
+		state->count = count;
+
+		auto const helpers = std::min(workerCount(), count - 1);
+		for (std::uint32_t i = 0; i < helpers; ++i) { enqueue([state] { state->work(); }); }
+
+		state->work();
+		for (auto done = state->done.load(); done < count; done = state->done.load()) { state->done.wait(done); }
+	}
+
+	ThreadPool::Stats ThreadPool::getStats() const
+	{
+		auto lock = std::scoped_lock{m_mutex};
+		return {
+			.jobs   = m_finished.load(std::memory_order_relaxed),
+			.busyNs = m_busyNs.load(std::memory_order_relaxed),
+			.queued = m_jobs.size(),
+		};
+	}
+
+	void ThreadPool::run(std::stop_token const & stop)
+	{
+		auto const tag = alloc::Scope{alloc::Tag::eJobs};
+		while (!stop.stop_requested())
+		{
+			auto lock = std::unique_lock{m_mutex};
+			if (!m_cv.wait(lock, stop, [this] { return !m_jobs.empty(); })) { return; }
+
+			auto job = std::move(m_jobs.front());
+			m_jobs.pop_front();
+			lock.unlock();
+
+			auto const begin = std::chrono::steady_clock::now();
+			job();
+			m_busyNs.fetch_add(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - begin).count(), std::memory_order_relaxed);
+			m_finished.fetch_add(1, std::memory_order_relaxed);
+		}
+	}
+} // namespace bk
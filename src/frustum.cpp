@@ -0,0 +1,196 @@
+#include "breakout/frustum.hpp"
+
+#include <bit>
+#include <cassert>
+#include <cmath>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+#include <glm/geometric.hpp>
+
+namespace bk
+{
+	namespace
+	{
+		// For every 8 bit visibility mask, the lanes of its set bits in ascending order, 4 bits each, lowest first.
+		constexpr auto compress_table_v = []
+		{
+			auto table = std::array<std::uint32_t, 256>{};
+			for (auto mask = 0u; mask < table.size(); ++mask)
+			{
+				auto shift = 0u;
+				for (auto lane = 0u; lane < 8; ++lane)
+				{
+					if ((mask & (1u << lane)) == 0) { continue; }
+					table[mask] |= lane << shift;
+					shift       += 4;
+				}
+			}
+			return table;
+		}();
+
+		/**
+		 * \brief Writes the indices i < count for which isVisible(i) holds. simd(i) tests 8 elements from i at once,
+		 * returning all ones in the lanes that pass; the scalar test handles the rest, and everything without AVX2.
+		 */
+		template<typename Scalar, typename Simd>
+		std::size_t cull(std::size_t const count, std::span<std::uint32_t> const visible, Scalar const & isVisible, [[maybe_unused]] Simd const & simd)
+		{
+			assert(visible.size() >= count);
+			auto written = std::size_t{};
+			auto i       = std::size_t{};
+#if defined(__AVX2__)
+			auto const shifts = _mm256_setr_epi32(0, 4, 8, 12, 16, 20, 24, 28);
+			auto const nibble = _mm256_set1_epi32(0xf);
+			for (; i + 8 <= count; i += 8)
+			{
+				auto const mask  = static_cast<std::uint32_t>(_mm256_movemask_ps(simd(i)));
+				auto const lanes = _mm256_and_si256(_mm256_srlv_epi32(_mm256_set1_epi32(static_cast<int>(compress_table_v[mask])), shifts), nibble);
+				// Always stores 8 indices; those past the passing ones are overwritten next time or lie past the returned
+				// count. written <= i keeps the store within visible.
+				auto const indices = _mm256_add_epi32(lanes, _mm256_set1_epi32(static_cast<int>(i)));
+				_mm256_storeu_si256(reinterpret_cast<__m256i *>(visible.data() + written), indices);
+				written += static_cast<std::size_t>(std::popcount(mask));
+			}
+#endif
+			for (; i < count; ++i)
+			{
+				if (isVisible(i)) { visible[written++] = static_cast<std::uint32_t>(i); }
+			}
+			return written;
+		}
+
+#if defined(__AVX2__)
+		// dot(plane.xyz, (x, y, z)) + plane.w for 8 points.
+		__m256 distance(glm::vec4 const & plane, __m256 const x, __m256 const y, __m256 const z)
+		{
+			auto ret = _mm256_mul_ps(_mm256_set1_ps(plane.x), x);
+			ret      = _mm256_add_ps(ret, _mm256_mul_ps(_mm256_set1_ps(plane.y), y));
+			ret      = _mm256_add_ps(ret, _mm256_mul_ps(_mm256_set1_ps(plane.z), z));
+			return _mm256_add_ps(ret, _mm256_set1_ps(plane.w));
+		}
+#endif
+
+		float distance(glm::vec4 const & plane, float const x, float const y, float const z) { return plane.x * x + plane.y * y + plane.z * z + plane.w; }
+	} // namespace
+
+	Frustum Frustum::fromMatrix(glm::mat4 const & viewProj)
+	{
+		auto const row = [&](int const i) { return glm::vec4{viewProj[0][i], viewProj[1][i], viewProj[2][i], viewProj[3][i]}; };
+
+		// Gribb and Hartmann: clip space -w <= x, y <= w and 0 <= z <= w, as planes in the matrix's source space.
+		auto ret                   = Frustum{};
+		ret.planes[Plane::eLeft]   = row(3) + row(0);
+		ret.planes[Plane::eRight]  = row(3) - row(0);
+		ret.planes[Plane::eBottom] = row(3) + row(1);
+		ret.planes[Plane::eTop]    = row(3) - row(1);
+		ret.planes[Plane::eNear]   = row(2);
+		ret.planes[Plane::eFar]    = row(3) - row(2);
+		for (auto & plane : ret.planes) { plane /= glm::length(glm::vec3{plane}); }
+		return ret;
+	}
+
+	bool Frustum::intersectsSphere(glm::vec3 const & center, float const radius) const
+	{
+		for (auto const & plane : planes)
+		{
+			if (!(distance(plane, center.x, center.y, center.z) >= -radius)) { return false; }
+		}
+		return true;
+	}
+
+	bool Frustum::intersectsBox(glm::vec3 const & center, glm::vec3 const & extent) const
+	{
+		for (auto const & plane : planes)
+		{
+			// Projected half extent of the box onto the plane normal.
+			auto const radius = std::abs(plane.x) * extent.x + std::abs(plane.y) * extent.y + std::abs(plane.z) * extent.z;
+			if (!(distance(plane, center.x, center.y, center.z) >= -radius)) { return false; }
+		}
+		return true;
+	}
+
+	std::size_t cullSpheres(Frustum const & frustum, SphereBounds const & bounds, std::span<std::uint32_t> const visible)
+	{
+		assert(bounds.y.size() == bounds.x.size() && bounds.z.size() == bounds.x.size() && bounds.radius.size() == bounds.x.size());
+		return cull(
+			bounds.x.size(), visible,
+			[&](std::size_t const i) { return frustum.intersectsSphere({bounds.x[i], bounds.y[i], bounds.z[i]}, bounds.radius[i]); },
+			[&]([[maybe_unused]] std::size_t const i)
+			{
+#if defined(__AVX2__)
+				auto const x       = _mm256_loadu_ps(bounds.x.data() + i);
+				auto const y       = _mm256_loadu_ps(bounds.y.data() + i);
+				auto const z       = _mm256_loadu_ps(bounds.z.data() + i);
+				auto const minimum = _mm256_sub_ps(_mm256_setzero_ps(), _mm256_loadu_ps(bounds.radius.data() + i)); // Centre may lie this far outside
+				auto inside        = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+				for (auto const & plane : frustum.planes) { inside = _mm256_and_ps(inside, _mm256_cmp_ps(distance(plane, x, y, z), minimum, _CMP_GE_OQ)); }
+				return inside;
+#endif
+			});
+	}
+
+	std::size_t cullBoxes(Frustum const & frustum, BoxBounds const & bounds, std::span<std::uint32_t> const visible)
+	{
+		auto const count = bounds.centerX.size();
+		assert(bounds.centerY.size() == count && bounds.centerZ.size() == count);
+		assert(bounds.extentX.size() == count && bounds.extentY.size() == count && bounds.extentZ.size() == count);
+		return cull(
+			count, visible,
+			[&](std::size_t const i)
+			{
+				return frustum.intersectsBox({bounds.centerX[i], bounds.centerY[i], bounds.centerZ[i]},
+											 {bounds.extentX[i], bounds.extentY[i], bounds.extentZ[i]});
+			},
+			[&]([[maybe_unused]] std::size_t const i)
+			{
+#if defined(__AVX2__)
+				auto const x       = _mm256_loadu_ps(bounds.centerX.data() + i);
+				auto const y       = _mm256_loadu_ps(bounds.centerY.data() + i);
+				auto const z       = _mm256_loadu_ps(bounds.centerZ.data() + i);
+				auto const extentX = _mm256_loadu_ps(bounds.extentX.data() + i);
+				auto const extentY = _mm256_loadu_ps(bounds.extentY.data() + i);
+				auto const extentZ = _mm256_loadu_ps(bounds.extentZ.data() + i);
+				auto inside        = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+				for (auto const & plane : frustum.planes)
+				{
+					auto const absolute = glm::vec4{std::abs(plane.x), std::abs(plane.y), std::abs(plane.z), 0.0f};
+					auto const radius   = distance(absolute, extentX, extentY, extentZ);
+					inside = _mm256_and_ps(inside, _mm256_cmp_ps(distance(plane, x, y, z), _mm256_sub_ps(_mm256_setzero_ps(), radius), _CMP_GE_OQ));
+				}
+				return inside;
+#endif
+			});
+	}
+
+	std::size_t cullRects(glm::vec4 const & view, RectBounds const & bounds, std::span<std::uint32_t> const visible)
+	{
+		auto const count = bounds.minX.size();
+		assert(bounds.minY.size() == count && bounds.maxX.size() == count && bounds.maxY.size() == count);
+		return cull(
+			count, visible,
+			[&](std::size_t const i)
+			{ return bounds.maxX[i] >= view.x && bounds.minX[i] <= view.z && bounds.maxY[i] >= view.y && bounds.minY[i] <= view.w; },
+			[&]([[maybe_unused]] std::size_t const i)
+			{
+#if defined(__AVX2__)
+				auto const right  = _mm256_cmp_ps(_mm256_loadu_ps(bounds.maxX.data() + i), _mm256_set1_ps(view.x), _CMP_GE_OQ);
+				auto const left   = _mm256_cmp_ps(_mm256_loadu_ps(bounds.minX.data() + i), _mm256_set1_ps(view.z), _CMP_LE_OQ);
+				auto const top    = _mm256_cmp_ps(_mm256_loadu_ps(bounds.maxY.data() + i), _mm256_set1_ps(view.y), _CMP_GE_OQ);
+				auto const bottom = _mm256_cmp_ps(_mm256_loadu_ps(bounds.minY.data() + i), _mm256_set1_ps(view.w), _CMP_LE_OQ);
+				return _mm256_and_ps(_mm256_and_ps(right, left), _mm256_and_ps(top, bottom));
+#endif
+			});
+	}
+
+	bool isCullingSimd()
+	{
+#if defined(__AVX2__)
+		return true;
+#else
+		return false;
+#endif
+	}
+} // namespace bk
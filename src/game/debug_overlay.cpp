@@ -0,0 +1,252 @@
+#include "breakout/game/debug_overlay.hpp"
+
+#include <algorithm>
+#include <cfloat>
+#include <format>
+#include <limits>
+#include <span>
+
+#include <SDL3/SDL.h>
+
+#include <imgui.h>
+
+#include "breakout/core/alloc_tracker.hpp"
+#include "breakout/core/logger.hpp"
+#include "breakout/core/profiler.hpp"
+#include "breakout/core/thread_pool.hpp"
+#include "breakout/gpu/vk_device.hpp"
+
+namespace game
+{
+	namespace
+	{
+		constexpr auto job_sample_interval_v = std::chrono::milliseconds{250};
+		constexpr float mib_v{1024.0f * 1024.0f};
+
+		double durationMs(bk::Profiler::Zone const & zone) { return static_cast<double>(zone.endNs - zone.beginNs) / 1e6; }
+
+		void textView(std::string_view const text) { ImGui::TextUnformatted(text.data(), text.data() + text.size()); }
+
+		// The overlay's own cost first, then every zone of the last published frame, CPU tracks before the GPU's.
+		void drawZones(bk::Profiler::Frame const & frame)
+		{
+			auto overlayCpuMs = 0.0;
+			auto overlayGpuMs = 0.0;
+			for (auto const & zone : frame.zones)
+			{
+				if (zone.name != DebugOverlay::zone_name_v) { continue; }
+				(zone.track == bk::Profiler::gpu_track_v ? overlayGpuMs : overlayCpuMs) += durationMs(zone);
+			}
+			ImGui::Text("overlay: CPU %.3f ms, GPU %.3f ms", overlayCpuMs, overlayGpuMs);
+
+			if (!ImGui::CollapsingHeader("Zones", ImGuiTreeNodeFlags_DefaultOpen)) { return; }
+			ImGui::Text("frame %llu%s", static_cast<unsigned long long>(frame.number), frame.gpuCalibrated ? "" : " (GPU offsets estimated)");
+
+			auto zones = frame.zones;
+			std::ranges::sort(zones, [](bk::Profiler::Zone const & lhs, bk::Profiler::Zone const & rhs)
+							  {
+								  // GPU (-1) after CPU threads, each in time order.
+								  constexpr auto last_v = std::numeric_limits<int>::max();
+								  auto const lhsTrack   = lhs.track == bk::Profiler::gpu_track_v ? last_v : lhs.track;
+								  auto const rhsTrack   = rhs.track == bk::Profiler::gpu_track_v ? last_v : rhs.track;
+								  return lhsTrack != rhsTrack ? lhsTrack < rhsTrack : lhs.beginNs < rhs.beginNs;
+							  });
+
+			if (!ImGui::BeginTable("zones", 3, ImGuiTableFlags_RowBg | ImGuiTableFlags_SizingFixedFit)) { return; }
+			ImGui::TableSetupColumn("zone");
+			ImGui::TableSetupColumn("track");
+			ImGui::TableSetupColumn("ms");
+			ImGui::TableHeadersRow();
+			for (auto const & zone : zones)
+			{
+				ImGui::TableNextRow();
+				ImGui::TableSetColumnIndex(0);
+				ImGui::SetCursorPosX(ImGui::GetCursorPosX() + static_cast<float>(zone.depth) * ImGui::GetFontSize());
+				textView(zone.name);
+				ImGui::TableSetColumnIndex(1);
+				if (zone.track == bk::Profiler::gpu_track_v) { ImGui::TextUnformatted("GPU"); }
+				else { ImGui::Text("T%d", zone.track); }
+				ImGui::TableSetColumnIndex(2);
+				ImGui::Text("%.3f", durationMs(zone));
+			}
+			ImGui::EndTable();
+		}
+	} // namespace
+
+	DebugOverlay::DebugOverlay(bk::gpu::Device const & device, bk::gpu::UploadQueue & uploads, bk::gpu::TextureTable & textures)
+	: m_context(ImGui::CreateContext())
+	{
+		ImGui::SetCurrentContext(m_context);
+		auto & io       = ImGui::GetIO();
+		io.IniFilename  = nullptr; // Window positions are not worth a file next to the executable
+		io.LogFilename  = nullptr;
+		io.ConfigFlags |= ImGuiConfigFlags_NoMouseCursorChange;
+		ImGui::StyleColorsDark();
+		m_renderer = std::make_unique<bk::gpu::ImGuiRenderer>(device, uploads, textures);
+	}
+
+	DebugOverlay::~DebugOverlay()
+	{
+		ImGui::SetCurrentContext(m_context);
+		m_renderer.reset();
+		ImGui::DestroyContext(m_context);
+	}
+
+	bool DebugOverlay::handleEvent(SDL_Event const & event)
+	{
+		if (event.type == SDL_EVENT_KEY_DOWN && event.key.key == SDLK_F3 && !event.key.repeat)
+		{
+			setVisible(!m_visible);
+			return true;
+		}
+		if (!m_visible) { return false; }
+
+		ImGui::SetCurrentContext(m_context);
+		auto & io = ImGui::GetIO();
+		switch (event.type)
+		{
+		case SDL_EVENT_MOUSE_MOTION: io.AddMousePosEvent(event.motion.x, event.motion.y); return io.WantCaptureMouse;
+		case SDL_EVENT_MOUSE_BUTTON_DOWN:
+		case SDL_EVENT_MOUSE_BUTTON_UP:
+		{
+			// ImGui numbers buttons left, right, middle; SDL left, middle, right.
+			constexpr auto buttons_v = std::array{-1, 0, 2, 1};
+			if (event.button.button < buttons_v.size() && buttons_v[event.button.button] >= 0)
+			{
+				io.AddMouseButtonEvent(buttons_v[event.button.button], event.button.down);
+			}
+			return io.WantCaptureMouse;
+		}
+		case SDL_EVENT_MOUSE_WHEEL: io.AddMouseWheelEvent(event.wheel.x, event.wheel.y); return io.WantCaptureMouse;
+		case SDL_EVENT_WINDOW_MOUSE_LEAVE: io.AddMousePosEvent(-FLT_MAX, -FLT_MAX); return false;
+		default: return false;
+		}
+	}
+
+	void DebugOverlay::setVisible(bool const visible)
+	{
+		m_visible = visible;
+		// Time spent hidden is not a frame's delta time.
+		m_lastBuild = {};
+	}
+
+	void DebugOverlay::build(Sources const & sources, VkExtent2D const display, VkExtent2D const framebuffer, bk::gpu::FrameRingAllocator & ring)
+	{
+		m_prepared = false;
+		if (!m_visible || display.width == 0 || display.height == 0) { return; }
+
+		ImGui::SetCurrentContext(m_context);
+		auto & io      = ImGui::GetIO();
+		auto const now = std::chrono::steady_clock::now();
+		io.DeltaTime   = m_lastBuild == std::chrono::steady_clock::time_point{} ? 1.0f / 60.0f : std::max(std::chrono::duration<float>{now - m_lastBuild}.count(), 1e-4f);
+		m_lastBuild    = now;
+		io.DisplaySize = ImVec2{static_cast<float>(display.width), static_cast<float>(display.height)};
+		io.DisplayFramebufferScale = ImVec2{static_cast<float>(framebuffer.width) / io.DisplaySize.x, static_cast<float>(framebuffer.height) / io.DisplaySize.y};
+
+		ImGui::NewFrame();
+		ImGui::SetNextWindowPos(ImVec2{8.0f, 8.0f}, ImGuiCond_FirstUseEver);
+		ImGui::SetNextWindowBgAlpha(0.85f);
+		if (ImGui::Begin("Performance (F3)", nullptr, ImGuiWindowFlags_AlwaysAutoResize | ImGuiWindowFlags_NoFocusOnAppearing))
+		{
+			auto const frame = sources.profiler.lastFrame();
+			drawFrameTimes();
+			drawZones(frame);
+
+			if (ImGui::CollapsingHeader("Allocations", ImGuiTreeNodeFlags_DefaultOpen))
+			{
+				if constexpr (bk::alloc::tracking_v)
+				{
+					ImGui::Text("%llu this frame, %.1f KiB", static_cast<unsigned long long>(frame.allocations.allocations),
+								static_cast<double>(frame.allocations.bytes) / 1024.0);
+				}
+				else { ImGui::TextUnformatted("not tracked (configure with -DBK_TRACK_ALLOCATIONS=ON)"); }
+			}
+			drawSystems(sources);
+
+			auto const & stats = m_renderer->getStats();
+			ImGui::Text("overlay geometry: %u draws, %u vertices, %u indices", stats.draws, stats.vertices, stats.indices);
+		}
+		ImGui::End();
+		ImGui::Render();
+
+		m_prepared = m_renderer->prepare(*ImGui::GetDrawData(), ring, framebuffer);
+	}
+
+	void DebugOverlay::record(VkCommandBuffer const cmd, VkPipeline const pipeline) const
+	{
+		if (m_prepared) { m_renderer->record(cmd, pipeline); }
+	}
+
+	void DebugOverlay::drawFrameTimes() const
+	{
+		auto const count = static_cast<std::size_t>(std::min<std::uint64_t>(m_frameCount, history_v));
+		if (count == 0) { return; }
+
+		auto sorted           = m_frameTimesMs;
+		auto const samples    = std::span{sorted}.first(count);
+		auto const percentile = [&](double const p)
+		{
+			auto const nth = samples.begin() + static_cast<std::ptrdiff_t>(p * static_cast<double>(count - 1));
+			std::ranges::nth_element(samples, nth);
+			return *nth;
+		};
+		auto const p50 = percentile(0.5);
+		auto const p99 = percentile(0.99);
+		auto const max = std::ranges::max(samples);
+
+		ImGui::Text("frame: p50 %.2f ms, p99 %.2f ms, max %.2f ms (last %zu)", p50, p99, max, count);
+		// Oldest first: once the ring has wrapped, the oldest sample is the one about to be overwritten.
+		auto const offset = m_frameCount > history_v ? static_cast<int>(m_frameCount % history_v) : 0;
+		ImGui::PlotLines("##frame times", m_frameTimesMs.data(), static_cast<int>(count), offset, nullptr, 0.0f, std::max(max * 1.1f, 1.0f),
+						 ImVec2{static_cast<float>(history_v) * 1.5f, 60.0f});
+	}
+
+	void DebugOverlay::drawSystems(Sources const & sources)
+	{
+		if (ImGui::CollapsingHeader("Logger"))
+		{
+			auto const stats = bk::logger::Instance::getStats();
+			ImGui::Text("%llu messages, %llu filtered, %llu dropped", static_cast<unsigned long long>(stats.messages),
+						static_cast<unsigned long long>(stats.filtered), static_cast<unsigned long long>(stats.dropped));
+			ImGui::Text("file sink backlog: %zu bytes", stats.pendingFileBytes);
+		}
+
+		if (ImGui::CollapsingHeader("GPU memory", ImGuiTreeNodeFlags_DefaultOpen))
+		{
+			VkPhysicalDeviceMemoryProperties const * properties = nullptr;
+			vmaGetMemoryProperties(sources.device.allocator, &properties);
+			auto budgets = std::array<VmaBudget, VK_MAX_MEMORY_HEAPS>{};
+			vmaGetHeapBudgets(sources.device.allocator, budgets.data());
+			for (std::uint32_t heap = 0; heap < properties->memoryHeapCount; ++heap)
+			{
+				auto const & budget = budgets[heap];
+				if (budget.budget == 0) { continue; }
+				auto const local = (properties->memoryHeaps[heap].flags & VK_MEMORY_HEAP_DEVICE_LOCAL_BIT) != 0;
+				auto const label = std::format("heap {} ({}): {:.1f} / {:.1f} MiB, {} allocations", heap, local ? "device" : "host",
+											   static_cast<float>(budget.usage) / mib_v, static_cast<float>(budget.budget) / mib_v,
+											   budget.statistics.allocationCount);
+				ImGui::ProgressBar(static_cast<float>(budget.usage) / static_cast<float>(budget.budget), ImVec2{-FLT_MIN, 0.0f}, label.c_str());
+			}
+		}
+
+		if (ImGui::CollapsingHeader("Jobs", ImGuiTreeNodeFlags_DefaultOpen))
+		{
+			auto const stats = sources.jobs.getStats();
+			auto const now   = std::chrono::steady_clock::now();
+			if (now - m_jobSampleTime >= job_sample_interval_v)
+			{
+				if (m_jobSampleTime != std::chrono::steady_clock::time_point{})
+				{
+					auto const elapsedNs = std::chrono::duration_cast<std::chrono::nanoseconds>(now - m_jobSampleTime).count();
+					m_jobUtilisation     = static_cast<float>(stats.busyNs - m_jobSampleBusyNs) /
+									   (static_cast<float>(elapsedNs) * static_cast<float>(sources.jobs.workerCount()));
+				}
+				m_jobSampleTime   = now;
+				m_jobSampleBusyNs = stats.busyNs;
+			}
+			auto const label = std::format("{} workers, {:.0f}% busy", sources.jobs.workerCount(), m_jobUtilisation * 100.0f);
+			ImGui::ProgressBar(std::clamp(m_jobUtilisation, 0.0f, 1.0f), ImVec2{-FLT_MIN, 0.0f}, label.c_str());
+			ImGui::Text("%zu queued, %llu done", stats.queued, static_cast<unsigned long long>(stats.jobs));
+		}
+	}
+} // namespace game
@@ -0,0 +1,193 @@
+#include "breakout/game/font.hpp"
+
+// imgui builds its own static copy of stb_truetype; this one is private to this file the same way.
+#define STBTT_STATIC
+#define STB_TRUETYPE_IMPLEMENTATION
+#include <imstb_truetype.h>
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <numeric>
+
+#include "breakout/core/logger.hpp"
+#include "breakout/core/mapped_file.hpp"
+#include "breakout/game/resource_manager.hpp"
+#include "breakout/gpu/upload_queue.hpp"
+#include "breakout/gpu/vk_images.hpp"
+
+namespace game {
+	namespace {
+		auto const s_log = bk::Logger{"font"};
+
+		constexpr unsigned char on_edge_v{128};
+
+		std::atomic<std::uint64_t> s_nextAtlasId{1};
+
+		// One glyph's distance field as stb_truetype returns it, before packing.
+		struct Bitmap {
+			unsigned char * pixels{};
+			int width{};
+			int height{};
+			int xoff{};
+			int yoff{};
+			std::uint32_t x{};
+			std::uint32_t y{};
+		};
+	} // namespace
+
+	std::optional<GlyphAtlas> GlyphAtlas::bake(std::span<std::byte const> ttf, Config const & config) {
+		auto const * const data = reinterpret_cast<unsigned char const *>(ttf.data()); // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+		auto info = stbtt_fontinfo{};
+		auto const offset = ttf.empty() ? -1 : stbtt_GetFontOffsetForIndex(data, 0);
+		if (offset < 0 || stbtt_InitFont(&info, data, offset) == 0) {
+			s_log.error("not a TrueType or OpenType font");
+			return std::nullopt;
+		}
+
+		// Pixels at bake size to ems: one em is the font's ascent to descent.
+		auto const scale = stbtt_ScaleForPixelHeight(&info, config.pixelHeight);
+		auto const toEm = 1.0f / config.pixelHeight;
+		auto ret = GlyphAtlas{};
+		auto ascent = int{};
+		auto descent = int{};
+		auto lineGap = int{};
+		stbtt_GetFontVMetrics(&info, &ascent, &descent, &lineGap);
+		ret.m_ascent = static_cast<float>(ascent) * scale * toEm;
+		ret.m_lineHeight = static_cast<float>(ascent - descent + lineGap) * scale * toEm;
+
+		// Distance falls off by 128 over the padding, so the field spans exactly the padding on either side of the outline.
+		auto bitmaps = std::array<Bitmap, count_v>{};
+		for (std::size_t i = 0; i < count_v; ++i) {
+			auto & bitmap = bitmaps[i];
+			auto const codepoint = static_cast<int>(first_v) + static_cast<int>(i);
+			bitmap.pixels = stbtt_GetCodepointSDF(&info, scale, codepoint, config.padding, on_edge_v, static_cast<float>(on_edge_v) / static_cast<float>(config.padding),
+				&bitmap.width, &bitmap.height, &bitmap.xoff, &bitmap.yoff);
+
+			auto advance = int{};
+			auto bearing = int{};
+			stbtt_GetCodepointHMetrics(&info, codepoint, &advance, &bearing);
+			ret.m_glyphs[i].advance = static_cast<float>(advance) * scale * toEm;
+		}
+		auto const release = [&bitmaps] {
+			for (auto const & bitmap : bitmaps) {
+				stbtt_FreeSDF(bitmap.pixels, nullptr);
+			}
+		};
+
+		// Shelf packing, tallest first: each shelf is as tall as its first glyph, and glyphs of similar height end up sharing one.
+		auto order = std::array<std::size_t, count_v>{};
+		std::iota(order.begin(), order.end(), std::size_t{});
+		std::ranges::stable_sort(order, std::ranges::greater{}, [&bitmaps](std::size_t const i) { return bitmaps[i].height; });
+		auto x = std::uint32_t{};
+		auto y = std::uint32_t{};
+		auto shelf = std::uint32_t{};
+		for (auto const i : order) {
+			auto & bitmap = bitmaps[i];
+			if (bitmap.pixels == nullptr) {
+				continue;
+			}
+			auto const width = static_cast<std::uint32_t>(bitmap.width);
+			if (width > config.width) {
+				s_log.error("a {}px wide glyph does not fit in a {}px wide atlas", width, config.width);
+				release();
+				return std::nullopt;
+			}
+			if (x + width > config.width) {
+				x = 0;
+				y += shelf;
+				shelf = 0;
+			}
+			bitmap.x = x;
+			bitmap.y = y;
+			x += width;
+			shelf = std::max(shelf, static_cast<std::uint32_t>(bitmap.height));
+		}
+		ret.m_width = config.width;
+		ret.m_height = std::bit_ceil(std::max(y + shelf, 1U));
+
+		// Texels nothing was packed into read as far outside any outline.
+		ret.m_pixels.assign(static_cast<std::size_t>(ret.m_width) * ret.m_height, 0);
+		auto const atlasSize = glm::vec2{static_cast<float>(ret.m_width), static_cast<float>(ret.m_height)};
+		for (std::size_t i = 0; i < count_v; ++i) {
+			auto const & bitmap = bitmaps[i];
+			if (bitmap.pixels == nullptr) {
+				continue;
+			}
+			for (int row = 0; row < bitmap.height; ++row) {
+				std::copy_n(bitmap.pixels + static_cast<std::ptrdiff_t>(row) * bitmap.width, bitmap.width,
+					ret.m_pixels.begin() + static_cast<std::ptrdiff_t>((bitmap.y + static_cast<std::uint32_t>(row)) * ret.m_width + bitmap.x));
+			}
+			auto & glyph = ret.m_glyphs[i];
+			auto const position = glm::vec2{static_cast<float>(bitmap.x), static_cast<float>(bitmap.y)};
+			auto const size = glm::vec2{static_cast<float>(bitmap.width), static_cast<float>(bitmap.height)};
+			glyph.offset = glm::vec2{static_cast<float>(bitmap.xoff), static_cast<float>(bitmap.yoff)} * toEm;
+			glyph.size = size * toEm;
+			auto const uvMin = position / atlasSize;
+			auto const uvMax = (position + size) / atlasSize;
+			glyph.uvRect = glm::vec4{uvMin.x, uvMin.y, uvMax.x, uvMax.y};
+		}
+		release();
+
+		// Dense, since layout looks up every adjacent pair; most fonts have no kerning for most of them, and many for none.
+		auto kerning = std::vector<float>(count_v * count_v);
+		auto anyKerning = false;
+		for (std::size_t left = 0; left < count_v; ++left) {
+			for (std::size_t right = 0; right < count_v; ++right) {
+				auto const kern = stbtt_GetCodepointKernAdvance(&info, static_cast<int>(first_v) + static_cast<int>(left), static_cast<int>(first_v) + static_cast<int>(right));
+				kerning[left * count_v + right] = static_cast<float>(kern) * scale * toEm;
+				anyKerning = anyKerning || kern != 0;
+			}
+		}
+		if (anyKerning) {
+			ret.m_kerning = std::move(kerning);
+		}
+
+		ret.m_id = s_nextAtlasId.fetch_add(1, std::memory_order_relaxed);
+		return ret;
+	}
+
+	float GlyphAtlas::kerning(char left, char right) const {
+		if (m_kerning.empty() || left < first_v || left > last_v || right < first_v || right > last_v) {
+			return 0.0f;
+		}
+		return m_kerning[static_cast<std::size_t>(left - first_v) * count_v + static_cast<std::size_t>(right - first_v)];
+	}
+
+	std::shared_ptr<Font const> Font::load(LoadContext const & context, bk::gpu::Device const & device, GlyphAtlas::Config const & config) {
+		auto const & path = context.path();
+		auto const file = bk::MappedFile::open(path);
+		if (!file) {
+			s_log.error("failed to open '{}'", path.string());
+			return {};
+		}
+		auto atlas = GlyphAtlas::bake(file->bytes(), config);
+		if (!atlas) {
+			s_log.error("failed to bake '{}'", path.string());
+			return {};
+		}
+
+		auto const extent = atlas->extent();
+		auto image = bk::gpu::createImage(device, extent, VK_FORMAT_R8_UNORM, VK_IMAGE_USAGE_SAMPLED_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT);
+
+		// Linear filtering: the distance interpolates between texels, which is what keeps scaled edges smooth.
+		auto const slot = context.allocateTextureSlot(image.view);
+		if (!slot) {
+			bk::gpu::destroyImage(device, image);
+			return {};
+		}
+
+		context.waitFor(context.uploads().upload(std::as_bytes(atlas->pixels()), image.image, extent, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL));
+		atlas->releasePixels();
+		s_log.info("baked '{}' into a {}x{} atlas", path.string(), extent.width, extent.height);
+
+		return std::make_shared<Font const>(device, std::move(*atlas), image, *slot);
+	}
+
+	Font::Font(bk::gpu::Device const & device, GlyphAtlas atlas, bk::gpu::AllocatedImage image, std::uint32_t slot)
+	: m_device(&device), m_atlas(std::move(atlas)), m_image(image), m_slot(slot) {}
+
+	Font::~Font() {
+		bk::gpu::destroyImage(*m_device, m_image);
+	}
+}
@@ -4,41 +4,463 @@
 #include <SDL3/SDL.h>
 #include <SDL3/SDL_vulkan.h>
 
+#include <VkBootstrap.h>
+
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <breakout/gpu/vk_images.hpp>
 #include <breakout/gpu/vk_initializers.hpp>
 #include <breakout/gpu/vk_types.hpp>
 
+#include <algorithm>
+#include <array>
 #include <chrono>
+#include <memory_resource>
+#include <optional>
+#include <span>
 #include <thread>
 
+#include "breakout/core/alloc_tracker.hpp"
+#include "breakout/core/init_graph.hpp"
 #include "breakout/core/logger.hpp"
+#include "breakout/core/metrics.hpp"
+#include "breakout/game/font.hpp"
+#include "breakout/game/shader.hpp"
 
 namespace brk {
 
+	namespace {
+		// Looked up once: updating a metric is then a relaxed atomic add.
+		auto & s_framesTotal = bk::metrics::counter("breakout_frames_total");
+		auto & s_frameTime = bk::metrics::histogram("breakout_frame_time_ns");
+		auto & s_inputLatency = bk::metrics::histogram("breakout_input_latency_ns");
+		auto & s_sprites = bk::metrics::gauge("breakout_sprites");
+
+		// Indices into the pipelines draw() passes to SpriteBatch::record, as set in Sprite::pipeline.
+		constexpr std::uint8_t sprite_pipeline_v{ 0 };
+		constexpr std::uint8_t text_pipeline_v{ 1 };
+	}
+
 	Game* loadedGame = nullptr;
 
 	bool Game::init() {
 		assert(loadedGame == nullptr);
 		loadedGame = this;
 
-		SDL_Init(SDL_INIT_VIDEO);
+		m_framesInFlight = std::clamp(config.framesInFlight, 1U, max_frames_in_flight_v);
+		m_drawExtent = config.startupWindowSize;
+
+		// Results for a frame are complete once its GPU timestamps are read back, m_framesInFlight frames later.
+		m_profiler = std::make_unique<bk::Profiler>(m_framesInFlight, config.profileReportInterval);
+		m_jobs = std::make_unique<bk::ThreadPool>();
+		m_frameArena = std::make_unique<bk::FrameArena>(config.frameArenaCapacity);
+		m_scheduler = std::make_unique<bk::Scheduler>(*m_jobs, bk::Scheduler::Config{
+			.budget = config.taskBudget,
+		});
+		if (config.metricsInterval.count() > 0) {
+			m_metrics = std::make_unique<bk::metrics::Publisher>(bk::metrics::Publisher::Config{
+				.interval = config.metricsInterval,
+				.file = config.metricsFile,
+				.log = config.metricsFile.empty(),
+			});
+		}
+
+		// Everything else is a graph of tasks that start as soon as what they need exists. SDL and the ResourceManager
+		// stay on this thread; Vulkan object creation that only needs the device goes to the workers.
+		using Thread = bk::InitGraph::Thread;
+		auto graph = bk::InitGraph{};
+		if (config.enableHotReload) {
+			graph.add("hot reload", [this] { m_resources.enableHotReload(*m_jobs); return true; }, {}, Thread::eMain);
+		}
+
+		if (config.softwareRenderer) {
+			graph.add("rasterizer", [this] {
+				m_rasterizer = std::make_unique<bk::soft::Rasterizer>(*m_jobs, bk::soft::Rasterizer::Config{
+					.width = m_drawExtent.width,
+					.height = m_drawExtent.height,
+				});
+				BK_LOG_INFO(bk::logger::general, "software renderer: {}x{}, {} kernels, {} threads", m_drawExtent.width, m_drawExtent.height,
+					bk::soft::Rasterizer::isSimd() ? "AVX2" : "scalar", m_jobs->workerCount() + 1);
+				return true;
+			});
+		} else {
+			auto const window = graph.add("window", [this] { return initWindow(); }, {}, Thread::eMain);
+			auto const device = graph.add("device", [this] {
+				m_device = bk::gpu::Device::create({
+					.appName = config.startupWindowTitle,
+					.enableValidationLayers = config.enableValidationLayers,
+					.window = m_window.get(),
+				});
+				return m_device != nullptr;
+			}, {window}, Thread::eMain);
+
+			auto const uploads = graph.add("uploads", [this] {
+				m_uploads = std::make_unique<bk::gpu::UploadQueue>(*m_device, bk::gpu::UploadQueue::Config{
+					.stagingCapacity = config.uploadStagingCapacity,
+				});
+				return true;
+			}, {device});
+			// On this thread as it waits for an upload, and only the frame thread may submit and poll them.
+			auto const textures = graph.add("textures", [this] { initTextures(); return true; }, {uploads}, Thread::eMain);
+			auto const resources = graph.add("resource manager", [this] {
+				m_resources.setUploadQueue(m_uploads.get());
+				m_resources.setTextureTable(m_textures.get());
+				return true;
+			}, {uploads, textures}, Thread::eMain);
+			if (!config.font.empty()) {
+				// Optional: a font that fails to load only costs the HUD text.
+				graph.add("font", [this] {
+					m_font = m_resources.add<game::Font>(config.font, [&device = *m_device](game::LoadContext const & context) {
+						return game::Font::load(context, device, {});
+					});
+					return true;
+				}, {resources}, Thread::eMain);
+			}
+			graph.add("frames", [this] { initFrames(); return true; }, {device});
+			graph.add("swapchain", [this] {
+				if (m_device->isHeadless()) {
+					return true;
+				}
+				if (!initSwapchain()) {
+					return false;
+				}
+				SDL_AddEventWatch(&Game::onEvent, this);
+				return true;
+			}, {device}, Thread::eMain);
+
+			auto const cache = graph.add("pipeline cache", [this] {
+				m_pipelines = std::make_unique<bk::gpu::PipelineCache>(*m_device, *m_jobs, config.cacheDirectory, m_framesInFlight);
+				return true;
+			}, {device});
+			auto const shaders = graph.add("shaders", [this] { return initShaders(); }, {device}, Thread::eMain);
+			// On this thread as it reads the shaders back from the ResourceManager.
+			graph.add("pipelines", [this] { return initPipelines(); }, {cache, shaders, textures}, Thread::eMain);
+			graph.add("overlay", [this] {
+				m_overlay = std::make_unique<game::DebugOverlay>(*m_device, *m_uploads, *m_textures);
+				m_overlay->setVisible(config.showOverlay);
+				return true;
+			}, {uploads, textures});
+		}
+
+		auto const ok = graph.run(*m_jobs);
+		if (config.startupReport) {
+			bk::logger::general.info("{}", graph.report());
+		}
+		if (!ok) {
+			return false;
+		}
+
+		m_isInitialized = true;
+
+		return true;
+	}
+
+	bool Game::initWindow() {
+		if (config.headless) {
+			return true;
+		}
+
+		if (!SDL_Init(SDL_INIT_VIDEO)) {
+			bk::logger::general.error("failed to initialize SDL: {}", SDL_GetError());
+			return false;
+		}
 
 		auto window_flags = SDL_WINDOW_VULKAN;
+		if (config.enableResizableWindow) {
+			window_flags |= SDL_WINDOW_RESIZABLE;
+		}
 		SDL_Window* window = SDL_CreateWindow(
 			config.startupWindowTitle.data(),
 			static_cast<int>(config.startupWindowSize.width),
 			static_cast<int>(config.startupWindowSize.height),
 			window_flags
 			);
+		if (window == nullptr) {
+			bk::logger::general.error("failed to create window: {}", SDL_GetError());
+			return false;
+		}
 
 		m_window = std::unique_ptr<SDL_Window, Deleter>(window);
+		return true;
+	}
 
-		m_isInitialized = true;
+	bool Game::initShaders() {
+		auto const loadShader = [device = m_device->device](game::LoadContext const & context) {
+			return game::Shader::load(device, context.path());
+		};
+		m_spriteVertex = m_resources.add<game::Shader>(game::Shader::directory() / "sprite.vert.spv", loadShader);
+		m_spriteFragment = m_resources.add<game::Shader>(game::Shader::directory() / "sprite.frag.spv", loadShader);
+		m_fallbackFragment = m_resources.add<game::Shader>(game::Shader::directory() / "fallback.frag.spv", loadShader);
+		m_imguiVertex = m_resources.add<game::Shader>(game::Shader::directory() / "imgui.vert.spv", loadShader);
+		m_textFragment = m_resources.add<game::Shader>(game::Shader::directory() / "text.frag.spv", loadShader);
+		for (auto const id : {m_spriteVertex, m_spriteFragment, m_fallbackFragment, m_imguiVertex, m_textFragment}) {
+			if (!m_resources.get<game::Shader>(id)) {
+				return false;
+			}
+		}
+		return true;
+	}
+
+	bool Game::initPipelines() {
+		auto const start = std::chrono::steady_clock::now();
+		auto pushConstants = VkPushConstantRange{};
+		pushConstants.stageFlags = VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT;
+		pushConstants.size = sizeof(bk::gpu::SpritePushConstants);
+
+		auto const textures = m_textures->layout();
+		auto layoutInfo = VkPipelineLayoutCreateInfo{};
+		layoutInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+		layoutInfo.setLayoutCount = 1;
+		layoutInfo.pSetLayouts = &textures;
+		layoutInfo.pushConstantRangeCount = 1;
+		layoutInfo.pPushConstantRanges = &pushConstants;
+		VK_CHECK(vkCreatePipelineLayout(m_device->device, &layoutInfo, nullptr, &m_spriteLayout));
+
+		// The fallback is what gets drawn while other pipelines compile, so it has to exist up front.
+		auto const vertex = m_resources.get<game::Shader>(m_spriteVertex);
+		auto const fragment = m_resources.get<game::Shader>(m_fallbackFragment);
+		m_fallbackPipeline = m_pipelines->getNow({
+			.vertex = vertex,
+			.fragment = fragment,
+			.vertexHash = vertex->hash(),
+			.fragmentHash = fragment->hash(),
+			.layout = m_spriteLayout,
+			.colorFormat = draw_image_format_v,
+			.alphaBlend = true,
+		});
+		if (m_fallbackPipeline == VK_NULL_HANDLE) {
+			return false;
+		}
+
+		BK_LOG_INFO(bk::logger::general, "pipelines ready in {:.2f}ms ({} cached bytes)",
+			std::chrono::duration<double, std::milli>{std::chrono::steady_clock::now() - start}.count(),
+			m_pipelines->getStats().loadedBytes);
+		return true;
+	}
+
+	void Game::initTextures() {
+		m_textures = std::make_unique<bk::gpu::TextureTable>(*m_device, bk::gpu::TextureTable::Config{
+			.capacity = config.textureTableCapacity,
+			.frameCount = m_framesInFlight,
+		});
+
+		// Every untextured sprite samples the default slot from the first frame on, and frames only wait for uploads that
+		// had completed by their poll(): wait here, so the first frame finds the image written and records its acquire.
+		constexpr auto white_v = std::array<std::uint8_t, 4>{ 0xff, 0xff, 0xff, 0xff };
+		m_defaultTexture = bk::gpu::createImage(*m_device, VkExtent3D{1, 1, 1}, VK_FORMAT_R8G8B8A8_UNORM,
+			VK_IMAGE_USAGE_SAMPLED_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT);
+		m_uploads->wait(m_uploads->upload(std::as_bytes(std::span{white_v}), m_defaultTexture.image, m_defaultTexture.extent,
+			VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL));
+		m_textures->setDefault(m_defaultTexture.view);
+	}
+
+	void Game::initFrames() {
+		auto poolInfo = VkCommandPoolCreateInfo{};
+		poolInfo.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+		poolInfo.flags = VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT;
+		poolInfo.queueFamilyIndex = m_device->graphicsQueueFamily;
+
+		// Start signalled so the first wait on each frame returns immediately.
+		auto fenceInfo = VkFenceCreateInfo{};
+		fenceInfo.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
+		fenceInfo.flags = VK_FENCE_CREATE_SIGNALED_BIT;
+
+		auto semaphoreInfo = VkSemaphoreCreateInfo{};
+		semaphoreInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
+
+		m_frames.resize(m_framesInFlight);
+		for (auto& frame : m_frames) {
+			VK_CHECK(vkCreateCommandPool(m_device->device, &poolInfo, nullptr, &frame.commandPool));
+
+			auto allocInfo = VkCommandBufferAllocateInfo{};
+			allocInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+			allocInfo.commandPool = frame.commandPool;
+			allocInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+			allocInfo.commandBufferCount = 1;
+			VK_CHECK(vkAllocateCommandBuffers(m_device->device, &allocInfo, &frame.commandBuffer));
+
+			VK_CHECK(vkCreateFence(m_device->device, &fenceInfo, nullptr, &frame.renderFence));
+			VK_CHECK(vkCreateSemaphore(m_device->device, &semaphoreInfo, nullptr, &frame.swapchainSemaphore));
+		}
+
+		m_frameRing = std::make_unique<bk::gpu::FrameRingAllocator>(*m_device, bk::gpu::FrameRingAllocator::Config{
+			.slotCount = m_framesInFlight,
+			.capacity = config.frameRingCapacity,
+		});
+		m_recorder = std::make_unique<bk::gpu::CommandRecorder>(*m_device, *m_jobs, bk::gpu::CommandRecorder::Config{
+			.frameCount = m_framesInFlight,
+			.contextCount = std::max(config.recordThreadCount, 1U),
+		});
+		m_graph = std::make_unique<bk::gpu::RenderGraph>(*m_device, bk::gpu::RenderGraph::Config{
+			.frameCount = m_framesInFlight,
+		});
+		m_gpuProfiler = std::make_unique<bk::gpu::GpuProfiler>(*m_device, *m_profiler, bk::gpu::GpuProfiler::Config{
+			.frameCount = m_framesInFlight,
+		});
+		m_capture = std::make_unique<bk::gpu::FrameCapture>(*m_device, *m_jobs, bk::gpu::FrameCapture::Config{
+			.directory = config.captureDirectory,
+			.format = config.captureFormat,
+			.frameCount = m_framesInFlight,
+		});
+		m_capture->setInterval(config.captureInterval);
+	}
+
+	bool Game::initSwapchain(VkSwapchainKHR const oldSwapchain) {
+		auto const extent = m_drawExtent;
+		auto result = vkb::SwapchainBuilder{m_device->physicalDevice, m_device->device, m_device->surface}
+			.set_desired_format(VkSurfaceFormatKHR{.format = VK_FORMAT_B8G8R8A8_UNORM, .colorSpace = VK_COLOR_SPACE_SRGB_NONLINEAR_KHR})
+			.set_desired_present_mode(config.presentMode)
+			.add_fallback_present_mode(VK_PRESENT_MODE_FIFO_KHR)
+			.set_desired_extent(extent.width, extent.height)
+			.add_image_usage_flags(VK_IMAGE_USAGE_TRANSFER_DST_BIT)
+			.set_old_swapchain(oldSwapchain)
+			.build();
+		if (!result) {
+			bk::logger::general.error("failed to create swapchain: {}", result.error().message());
+			return false;
+		}
+
+		auto swapchain = result.value();
+		m_swapchain = swapchain.swapchain;
+		m_swapchainImageFormat = swapchain.image_format;
+		m_swapchainExtent = swapchain.extent;
+		m_swapchainImages = swapchain.get_images().value();
+		m_swapchainImageViews = swapchain.get_image_views().value();
+		if (swapchain.present_mode != config.presentMode) {
+			bk::logger::general.warn("{} is not supported, presenting with {}", string_VkPresentModeKHR(config.presentMode),
+				string_VkPresentModeKHR(swapchain.present_mode));
+		}
+
+		auto semaphoreInfo = VkSemaphoreCreateInfo{};
+		semaphoreInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
+		m_renderSemaphores.resize(m_swapchainImages.size());
+		for (auto& semaphore : m_renderSemaphores) {
+			VK_CHECK(vkCreateSemaphore(m_device->device, &semaphoreInfo, nullptr, &semaphore));
+		}
+		return true;
+	}
+
+	bool Game::recreateSwapchain() {
+		auto const start = std::chrono::steady_clock::now();
+		int width = 0;
+		int height = 0;
+		SDL_GetWindowSizeInPixels(m_window.get(), &width, &height);
+		if (width <= 0 || height <= 0) {
+			return false; // Minimized: nothing to present to until the window comes back
+		}
+
+		// No device wait: frames in flight keep presenting to the old swapchain, which the driver retires once it is
+		// passed as oldSwapchain, and its images and semaphores are only destroyed after those frames' fences signal.
+		// After a failed recreation there is none: the old one was retired then, and passing it again is not allowed.
+		auto const oldSwapchain = m_swapchain;
+		if (oldSwapchain != VK_NULL_HANDLE) {
+			m_retiredSwapchains.push_back({
+				.swapchain = oldSwapchain,
+				.imageViews = std::move(m_swapchainImageViews),
+				.renderSemaphores = std::move(m_renderSemaphores),
+				.frame = static_cast<std::uint64_t>(m_frameNumber),
+			});
+		}
+		m_swapchain = VK_NULL_HANDLE;
+		m_swapchainImages.clear();
+		m_swapchainImageViews.clear();
+		m_renderSemaphores.clear();
+
+		m_drawExtent = VkExtent2D{static_cast<std::uint32_t>(width), static_cast<std::uint32_t>(height)};
+		if (!initSwapchain(oldSwapchain)) {
+			return false;
+		}
+		// The draw image is a render graph transient: it follows m_drawExtent, per frame slot, once the slot is free.
+		m_drawExtent = m_swapchainExtent;
+		m_swapchainDirty = false;
 
+		auto const ms = std::chrono::duration<double, std::milli>{std::chrono::steady_clock::now() - start}.count();
+		++m_resize.recreations;
+		m_resize.worstRecreateMs = std::max(m_resize.worstRecreateMs, ms);
+		m_resize.lastRecreate = std::chrono::steady_clock::now();
+		BK_LOG_INFO(bk::logger::general, "swapchain recreated at {}x{} in {:.2f}ms", m_swapchainExtent.width, m_swapchainExtent.height, ms);
 		return true;
 	}
 
+	void Game::destroyRetiredSwapchains(bool const all) {
+		std::erase_if(m_retiredSwapchains, [&](RetiredSwapchain const & retired) {
+			// Called right after a frame's fence wait, which covers every frame up to m_frameNumber - m_framesInFlight; one
+			// frame more than strictly needed, as the presentation of the last old image may still be waiting on its semaphore.
+			if (!all && retired.frame + m_framesInFlight > static_cast<std::uint64_t>(m_frameNumber)) {
+				return false;
+			}
+			for (auto const semaphore : retired.renderSemaphores) {
+				vkDestroySemaphore(m_device->device, semaphore, nullptr);
+			}
+			for (auto const view : retired.imageViews) {
+				vkDestroyImageView(m_device->device, view, nullptr);
+			}
+			vkDestroySwapchainKHR(m_device->device, retired.swapchain, nullptr);
+			return true;
+		});
+	}
+
+	void Game::destroySwapchain() {
+		destroyRetiredSwapchains(true);
+		for (auto const semaphore : m_renderSemaphores) {
+			vkDestroySemaphore(m_device->device, semaphore, nullptr);
+		}
+		for (auto const view : m_swapchainImageViews) {
+			vkDestroyImageView(m_device->device, view, nullptr);
+		}
+		if (m_swapchain != VK_NULL_HANDLE) {
+			vkDestroySwapchainKHR(m_device->device, m_swapchain, nullptr);
+		}
+		m_renderSemaphores.clear();
+		m_swapchainImageViews.clear();
+		m_swapchainImages.clear();
+		m_swapchain = VK_NULL_HANDLE;
+	}
+
 	// ReSharper disable once CppMemberFunctionMayBeStatic
 	void Game::cleanup() { // NOLINT(*-convert-member-functions-to-static)
+		// Unfinished tasks may hold resources or GPU objects: destroy them while everything they use is still alive.
+		m_scheduler.reset();
+		if (m_device) {
+			vkDeviceWaitIdle(m_device->device);
+
+			m_capture.reset();
+			m_overlay.reset();
+			m_pipelines.reset();
+			m_frameRing.reset();
+			m_recorder.reset();
+			m_graph.reset();
+			m_gpuProfiler.reset();
+			for (auto const& frame : m_frames) {
+				vkDestroyFence(m_device->device, frame.renderFence, nullptr);
+				vkDestroySemaphore(m_device->device, frame.swapchainSemaphore, nullptr);
+				vkDestroyCommandPool(m_device->device, frame.commandPool, nullptr);
+			}
+			vkDestroyPipelineLayout(m_device->device, m_spriteLayout, nullptr);
+			destroySwapchain();
+			m_resources.clear();
+			m_textures.reset();
+			bk::gpu::destroyImage(*m_device, m_defaultTexture);
+			m_uploads.reset();
+			m_device.reset();
+		}
+		if (m_window) {
+			SDL_RemoveEventWatch(&Game::onEvent, this);
+		}
+		m_window.reset();
+
+		m_rasterizer.reset();
+
+		if (m_frameArena) {
+			auto const & stats = m_frameArena->getStats();
+			BK_LOG_INFO(bk::logger::general, "frame arena: {:.1f} of {:.1f} KiB used at most, {} overflow allocations", static_cast<double>(stats.highWater) / 1024.0,
+				static_cast<double>(stats.capacity) / 1024.0, stats.overflows);
+			m_frameArena.reset();
+		}
+		bk::alloc::report();
+		// Publishes the final values.
+		m_metrics.reset();
+
 		loadedGame = nullptr; // TODO: Using basic singleton for now. Update this later to use something better.
 	}
 
@@ -47,9 +469,26 @@ namespace brk {
 	}
 
 	void Game::run() {
+		if (config.headless || m_rasterizer) {
+			for (std::uint32_t i = 0; i < config.headlessFrameCount; ++i) {
+				frame();
+			}
+			if (m_rasterizer && !config.softwareOutput.empty() && m_rasterizer->write(config.softwareOutput)) {
+				BK_LOG_INFO(bk::logger::general, "wrote the last frame to '{}'", config.softwareOutput.string());
+			}
+			return;
+		}
+
 		bool ready_to_quit = false;
 		SDL_Event e;
 		while(!ready_to_quit) {
+			// Input sampled as late as the frame allows: the time draw() would otherwise block on its fence is spent here,
+			// before polling, so the events it picks up are that much fresher when presented.
+			m_inputSleptMs = config.justInTimeInput && !m_stop_rendering ? m_inputWaitMs : 0.0;
+			if (m_inputSleptMs > 0.0) {
+				std::this_thread::sleep_for(std::chrono::duration<double, std::milli>{m_inputSleptMs});
+			}
+
 			while(SDL_PollEvent(&e)) {
 				if(e.type == SDL_EVENT_QUIT) {
 					ready_to_quit = true;
@@ -63,6 +502,16 @@ namespace brk {
 					m_stop_rendering = false;
 				}
 
+				// F3, and mouse input over the overlay while it is open, are the overlay's rather than the game's.
+				if (m_overlay && m_overlay->handleEvent(e)) {
+					continue;
+				}
+
+				if (e.type == SDL_EVENT_KEY_DOWN && e.key.key == SDLK_F12 && !e.key.repeat && m_capture) {
+					m_capture->captureNext();
+				}
+
+				handleInput(e);
 			}
 			if (m_stop_rendering) {
 				// Slow down the loop if we're not rendering. No need for unnecessary CPU usage.
@@ -70,16 +519,428 @@ namespace brk {
 				continue;
 			}
 
-			draw();
+			frame();
+		}
+
+
+	}
+
+	void Game::frame() {
+		constexpr auto resize_settle_v = std::chrono::milliseconds{500};
+
+		m_inFrame = true;
+		auto const start = std::chrono::steady_clock::now();
+		m_profiler->beginFrame(static_cast<std::uint64_t>(m_frameNumber));
+		update();
+		draw();
+		m_profiler->setAllocations(bk::alloc::sum(bk::alloc::endFrame()));
+		m_profiler->endFrame();
+		// Nothing allocated from the arena outlives the frame that allocated it.
+		m_frameArena->reset();
+		auto const end = std::chrono::steady_clock::now();
+		m_inFrame = false;
+		s_framesTotal.add();
+		s_frameTime.record(end - start);
+		if (m_overlay) {
+			m_overlay->addFrameTime(end - start);
+		}
+
+		if (m_resize.recreations == 0) {
+			return;
+		}
+		++m_resize.frames;
+		m_resize.worstFrameMs = std::max(m_resize.worstFrameMs, std::chrono::duration<double, std::milli>{end - start}.count());
+		if (end - m_resize.lastRecreate > resize_settle_v) {
+			BK_LOG_INFO(bk::logger::general, "resize: {} swapchain recreations over {} frames, worst frame {:.2f}ms, slowest recreation {:.2f}ms",
+				m_resize.recreations, m_resize.frames, m_resize.worstFrameMs, m_resize.worstRecreateMs);
+			m_resize = {};
+		}
+	}
+
+	bool Game::onEvent(void * userdata, SDL_Event * event) {
+		auto & game = *static_cast<Game *>(userdata);
+		if (event->type == SDL_EVENT_WINDOW_PIXEL_SIZE_CHANGED) {
+			game.m_swapchainDirty = true;
+		}
+		// While a window is dragged some platforms (Windows, macOS) only run their own loop and send exposures from it;
+		// drawing here keeps frames coming. Elsewhere this runs inside SDL_PollEvent, between frames.
+		if (event->type == SDL_EVENT_WINDOW_EXPOSED && game.m_swapchainDirty && !game.m_inFrame && !game.m_stop_rendering) {
+			game.frame();
+		}
+		return true;
+	}
+
+	void Game::update() {
+		auto const zone = m_profiler->zone("update");
+		auto const tag = bk::alloc::Scope{bk::alloc::Tag::eGame};
+		// Frame boundary: retire finished uploads first so the resources waiting on them can be swapped in right away.
+		if (m_uploads) {
+			m_uploads->poll();
 		}
+		{
+			auto const resourcesTag = bk::alloc::Scope{bk::alloc::Tag::eResources};
+			m_resources.update();
+		}
+		{
+			// After the resource swap, so tasks waiting on a resource resume in the frame it becomes ready.
+			auto const tasksZone = m_profiler->zone("tasks");
+			m_scheduler->tick();
+		}
+
+		constexpr auto paddle_speed_v = 1.0f; // Draw widths per second
 
+		auto const now = std::chrono::steady_clock::now();
+		auto const dt = m_lastUpdate == std::chrono::steady_clock::time_point{} ? 0.0f : std::chrono::duration<float>{now - m_lastUpdate}.count();
+		m_lastUpdate = now;
+		m_input.paddleX = std::clamp(m_input.paddleX + static_cast<float>(m_input.paddleDirection) * paddle_speed_v * dt, 0.0f, 1.0f);
 
+		// Held keys send no new events: only what arrived since the last frame counts towards latency.
+		m_frameInputNs = m_input.oldestEventNs;
+		m_input.oldestEventNs = 0;
 	}
 
+	void Game::handleInput(SDL_Event const & event) {
+		switch (event.type) {
+		case SDL_EVENT_MOUSE_MOTION: {
+			auto width = 0;
+			auto height = 0;
+			SDL_GetWindowSize(m_window.get(), &width, &height);
+			if (width > 0) {
+				m_input.paddleX = std::clamp(event.motion.x / static_cast<float>(width), 0.0f, 1.0f);
+			}
+			break;
+		}
+		case SDL_EVENT_KEY_DOWN:
+		case SDL_EVENT_KEY_UP: {
+			if (event.key.repeat || (event.key.key != SDLK_LEFT && event.key.key != SDLK_RIGHT)) {
+				return;
+			}
+			auto const direction = event.key.key == SDLK_LEFT ? -1 : 1;
+			if (event.key.down) {
+				m_input.paddleDirection = direction;
+			} else if (m_input.paddleDirection == direction) {
+				m_input.paddleDirection = 0;
+			}
+			break;
+		}
+		default:
+			return;
+		}
+
+		if (m_input.oldestEventNs == 0) {
+			m_input.oldestEventNs = event.common.timestamp;
+		}
+	}
 
 
 	void Game::draw() {
-		// nothing yet
+		constexpr auto fence_timeout_v = std::chrono::nanoseconds{std::chrono::seconds{1}}.count();
+		auto const tag = bk::alloc::Scope{bk::alloc::Tag::eRenderer};
+
+		if (m_rasterizer) {
+			drawSoftware();
+			return;
+		}
+
+		// Everything uploaded since the last frame goes out in one batch, ahead of the frame that may use it.
+		m_uploads->submit();
+
+		auto& frame = getCurrentFrame();
+		auto const slot = static_cast<std::uint32_t>(m_frameNumber) % m_framesInFlight;
+		auto const windowed = !m_device->isHeadless();
+		std::uint32_t imageIndex = 0;
+		{
+			auto const zone = m_profiler->zone("wait for frame");
+			auto const waitStart = std::chrono::steady_clock::now();
+			VK_CHECK(vkWaitForFences(m_device->device, 1, &frame.renderFence, VK_TRUE, fence_timeout_v));
+			if (windowed) {
+				destroyRetiredSwapchains(false);
+				if (m_swapchainDirty && !recreateSwapchain()) {
+					return;
+				}
+
+				auto const acquire = [&] {
+					return vkAcquireNextImageKHR(m_device->device, m_swapchain, fence_timeout_v, frame.swapchainSemaphore, VK_NULL_HANDLE, &imageIndex);
+				};
+				auto result = acquire();
+				// Can come before the resize event does: recreate right away so this frame still goes out.
+				if (result == VK_ERROR_OUT_OF_DATE_KHR && recreateSwapchain()) {
+					result = acquire();
+				}
+				if (result == VK_ERROR_OUT_OF_DATE_KHR) {
+					m_swapchainDirty = true;
+					return;
+				}
+				if (result == VK_SUBOPTIMAL_KHR) {
+					m_swapchainDirty = true; // Still presentable; replaced before the next acquire
+				} else {
+					VK_CHECK(result);
+				}
+			}
+
+			// The shortest recent slack is what the next frame can safely spend sampling input later instead; the margin
+			// absorbs jitter, since sleeping past the point the GPU frees the frame delays its present. Slack includes
+			// this frame's sleep, which the wait above no longer shows: measuring the wait alone would shrink the next
+			// sleep by whatever this one already took, and the two would oscillate instead of settling.
+			m_recentWaitsMs[static_cast<std::size_t>(m_frameNumber) % m_recentWaitsMs.size()] = m_inputSleptMs +
+				std::chrono::duration<double, std::milli>{std::chrono::steady_clock::now() - waitStart}.count();
+			m_inputWaitMs = std::max(0.0, std::ranges::min(m_recentWaitsMs) - config.inputWaitMarginMs);
+		}
+		// The GPU is done with everything this frame slot handed out last time around.
+		m_frameRing->reclaim(slot);
+		m_recorder->beginFrame(slot);
+		m_textures->beginFrame(static_cast<std::uint64_t>(m_frameNumber));
+		m_pipelines->beginFrame(static_cast<std::uint64_t>(m_frameNumber));
+		m_capture->beginFrame(static_cast<std::uint64_t>(m_frameNumber));
+		VK_CHECK(vkResetFences(m_device->device, 1, &frame.renderFence));
+
+		auto const cmd = frame.commandBuffer;
+		VK_CHECK(vkResetCommandBuffer(cmd, 0));
+		auto const beginInfo = bk::gpu::init::commandBufferBeginInfo(VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT);
+		VK_CHECK(vkBeginCommandBuffer(cmd, &beginInfo));
+		m_gpuProfiler->beginFrame(cmd, slot, static_cast<std::uint64_t>(m_frameNumber));
+		auto const uploadWait = m_uploads->recordAcquires(cmd);
+
+		// Has to end before the command buffer does, so it is closed explicitly.
+		auto gpuFrame = std::optional<bk::gpu::GpuProfiler::Scope>{};
+		gpuFrame.emplace(*m_gpuProfiler, cmd, "frame");
+
+		auto buildZone = std::optional<bk::Profiler::Scope>{};
+		buildZone.emplace(*m_profiler, "build sprites");
+		m_sprites.clear();
+		drawScene();
+		s_sprites.set(static_cast<std::int64_t>(m_sprites.size()));
+
+		// Sprite draws are split into contiguous chunks, each recorded into a secondary command buffer on its own thread.
+		auto passes = std::pmr::vector<bk::gpu::CommandRecorder::Pass>{m_frameArena->allocator<bk::gpu::CommandRecorder::Pass>()};
+		if (auto const instances = m_frameRing->allocate(m_sprites.bytes(), alignof(bk::gpu::SpriteInstance))) {
+			auto const draws = m_sprites.build(instances->as<bk::gpu::SpriteInstance>());
+
+			auto const vertex = m_resources.get<game::Shader>(m_spriteVertex);
+			auto const spritePipeline = [&](game::ResourceId const fragmentId) {
+				auto const fragment = m_resources.get<game::Shader>(fragmentId);
+				return m_pipelines->get({
+					.vertex = vertex,
+					.fragment = fragment,
+					.vertexHash = vertex->hash(),
+					.fragmentHash = fragment->hash(),
+					.layout = m_spriteLayout,
+					.colorFormat = draw_image_format_v,
+					.alphaBlend = true,
+				}, m_fallbackPipeline);
+			};
+			auto pipelines = std::array<VkPipeline, 2>{};
+			pipelines[sprite_pipeline_v] = spritePipeline(m_spriteFragment);
+			pipelines[text_pipeline_v] = spritePipeline(m_textFragment);
+
+			// Pixel coordinates, y down.
+			auto const viewProj = glm::ortho(0.0f, static_cast<float>(m_drawExtent.width), 0.0f, static_cast<float>(m_drawExtent.height), -1.0f, 1.0f);
+			auto const chunks = std::min<std::size_t>(std::max(config.recordThreadCount, 1U), draws.size());
+			for (std::size_t chunk = 0; chunk < chunks; ++chunk) {
+				auto const range = draws.subspan(draws.size() * chunk / chunks, draws.size() * (chunk + 1) / chunks - draws.size() * chunk / chunks);
+				passes.emplace_back([this, range, pipelines, viewProj, address = instances->address](VkCommandBuffer const secondary) {
+					// Secondaries inherit no bindings, so the table is bound once per secondary rather than once per frame.
+					m_textures->bind(secondary, m_spriteLayout);
+					bk::gpu::SpriteBatch::record(secondary, m_spriteLayout, pipelines, viewProj, address, range);
+				});
+			}
+		}
+		buildZone.reset();
+		{
+			auto const zone = m_profiler->zone("record sprites");
+			m_recorder->record(passes, {.colorFormat = draw_image_format_v, .extent = m_drawExtent});
+		}
+
+		// Barriers and layouts follow from what each pass declares; the draw image only exists within the frame.
+		using Access = bk::gpu::RenderGraph::Access;
+		m_graph->reset();
+		auto const drawImage = m_graph->createImage("draw image", {.extent = m_drawExtent, .format = draw_image_format_v});
+		m_graph->addPass("sprites", [&](bk::gpu::RenderGraph::PassBuilder & pass) {
+			pass.write(drawImage, Access::eColorAttachment);
+		}, [this, drawImage](VkCommandBuffer const cmd, bk::gpu::RenderGraph const & graph) {
+			auto const zone = m_gpuProfiler->zone(cmd, "sprites");
+			auto clear = VkClearValue{};
+			clear.color = VkClearColorValue{{0.02f, 0.02f, 0.05f, 1.0f}};
+			auto const colorAttachment = bk::gpu::init::attachmentInfo(graph.image(drawImage).view, &clear);
+			auto renderInfo = bk::gpu::init::renderingInfo(m_drawExtent, &colorAttachment, nullptr);
+			renderInfo.flags = VK_RENDERING_CONTENTS_SECONDARY_COMMAND_BUFFERS_BIT;
+			vkCmdBeginRendering(cmd, &renderInfo);
+			m_recorder->execute(cmd);
+			vkCmdEndRendering(cmd);
+		});
+		// Copies the frame out only when a capture is due; a no-op otherwise.
+		m_capture->addPass(*m_graph, drawImage, m_drawExtent, draw_image_format_v);
+
+		// Hidden, the overlay adds neither CPU work nor a pass; shown, both are zones of their own.
+		if (m_overlay->isVisible()) {
+			{
+				auto const zone = m_profiler->zone(game::DebugOverlay::zone_name_v);
+				auto display = m_drawExtent;
+				if (windowed) {
+					auto width = 0;
+					auto height = 0;
+					SDL_GetWindowSize(m_window.get(), &width, &height);
+					display = VkExtent2D{static_cast<std::uint32_t>(width), static_cast<std::uint32_t>(height)};
+				}
+				m_overlay->build({.profiler = *m_profiler, .jobs = *m_jobs, .device = *m_device}, display, m_drawExtent, *m_frameRing);
+			}
+
+			auto const vertex = m_resources.get<game::Shader>(m_imguiVertex);
+			auto const fragment = m_resources.get<game::Shader>(m_spriteFragment);
+			// No fallback (it uses the sprite layout): the overlay just skips frames until its pipeline is compiled.
+			auto const pipeline = m_pipelines->get({
+				.vertex = vertex,
+				.fragment = fragment,
+				.vertexHash = vertex->hash(),
+				.fragmentHash = fragment->hash(),
+				.layout = m_overlay->pipelineLayout(),
+				.colorFormat = draw_image_format_v,
+				.alphaBlend = true,
+			}, VK_NULL_HANDLE);
+			m_graph->addPass("overlay", [&](bk::gpu::RenderGraph::PassBuilder & pass) {
+				pass.write(drawImage, Access::eColorAttachment);
+			}, [this, drawImage, pipeline](VkCommandBuffer const cmd, bk::gpu::RenderGraph const & graph) {
+				auto const zone = m_gpuProfiler->zone(cmd, game::DebugOverlay::zone_name_v);
+				auto const colorAttachment = bk::gpu::init::attachmentInfo(graph.image(drawImage).view, nullptr);
+				auto const renderInfo = bk::gpu::init::renderingInfo(m_drawExtent, &colorAttachment, nullptr);
+				vkCmdBeginRendering(cmd, &renderInfo);
+				m_overlay->record(cmd, pipeline);
+				vkCmdEndRendering(cmd);
+			});
+		}
+
+		if (windowed) {
+			auto const swapchainImage = m_graph->importImage("swapchain", {
+				.image = m_swapchainImages[imageIndex],
+				.view = m_swapchainImageViews[imageIndex],
+				.extent = m_swapchainExtent,
+				.format = m_swapchainImageFormat,
+				.finalLayout = VK_IMAGE_LAYOUT_PRESENT_SRC_KHR,
+			});
+			m_graph->addPass("blit to swapchain", [&](bk::gpu::RenderGraph::PassBuilder & pass) {
+				pass.read(drawImage, Access::eTransferSrc);
+				pass.write(swapchainImage, Access::eTransferDst);
+			}, [this, drawImage, swapchainImage](VkCommandBuffer const cmd, bk::gpu::RenderGraph const & graph) {
+				auto const zone = m_gpuProfiler->zone(cmd, "blit to swapchain");
+				bk::gpu::copyImageToImage(cmd, graph.image(drawImage).image, graph.image(swapchainImage).image, m_drawExtent, m_swapchainExtent);
+			});
+		} else {
+			// Nothing reads the frame without a window, but headless runs are there to exercise (and time) the drawing.
+			m_graph->keep(drawImage);
+		}
+
+		m_graph->compile(slot);
+		if (config.dumpRenderGraph && m_frameNumber == 0) {
+			BK_LOG_INFO(bk::logger::general, "{}", m_graph->dump());
+		}
+		m_graph->execute(cmd);
+		gpuFrame.reset();
+		VK_CHECK(vkEndCommandBuffer(cmd));
+
+		auto const submitZone = m_profiler->zone("submit");
+		m_frameRing->flush();
+
+		auto waits = std::array<VkSemaphoreSubmitInfo, 2>{};
+		auto waitCount = std::size_t{0};
+		if (uploadWait > 0) {
+			waits[waitCount++] = bk::gpu::init::semaphoreSubmitInfo(VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT, m_uploads->semaphore(), uploadWait);
+		}
+		auto signal = std::span<VkSemaphoreSubmitInfo const>{};
+		auto renderSignal = VkSemaphoreSubmitInfo{};
+		if (windowed) {
+			waits[waitCount++] = bk::gpu::init::semaphoreSubmitInfo(VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT, frame.swapchainSemaphore);
+			renderSignal = bk::gpu::init::semaphoreSubmitInfo(VK_PIPELINE_STAGE_2_ALL_GRAPHICS_BIT, m_renderSemaphores[imageIndex]);
+			signal = {&renderSignal, 1};
+		}
+
+		auto const cmdInfo = bk::gpu::init::commandBufferSubmitInfo(cmd);
+		auto const submitInfo = bk::gpu::init::submitInfo(&cmdInfo, std::span{waits.data(), waitCount}, signal);
+		VK_CHECK(vkQueueSubmit2(m_device->graphicsQueue, 1, &submitInfo, frame.renderFence));
+
+		if (windowed) {
+			auto presentInfo = VkPresentInfoKHR{};
+			presentInfo.sType = VK_STRUCTURE_TYPE_PRESENT_INFO_KHR;
+			presentInfo.waitSemaphoreCount = 1;
+			presentInfo.pWaitSemaphores = &m_renderSemaphores[imageIndex];
+			presentInfo.swapchainCount = 1;
+			presentInfo.pSwapchains = &m_swapchain;
+			presentInfo.pImageIndices = &imageIndex;
+			auto const result = vkQueuePresentKHR(m_device->graphicsQueue, &presentInfo);
+			if (result == VK_ERROR_OUT_OF_DATE_KHR || result == VK_SUBOPTIMAL_KHR) {
+				m_swapchainDirty = true;
+			} else {
+				VK_CHECK(result);
+			}
+
+			// Up to the present call, not to photons: the queue, the compositor and scanout come on top.
+			if (m_frameInputNs != 0) {
+				auto const latencyNs = SDL_GetTicksNS() - m_frameInputNs;
+				m_profiler->addInputLatency(static_cast<std::int64_t>(latencyNs));
+				s_inputLatency.record(latencyNs);
+				m_frameInputNs = 0;
+			}
+		}
+
+		++m_frameNumber;
+	}
+
+	void Game::drawSoftware() {
+		constexpr std::uint32_t clear_color_v{ 0xff0d0505 }; // The sprites pass's clear value in RGBA8
+
+		auto const zone = m_profiler->zone("software draw");
+		m_sprites.clear();
+		drawScene();
+		m_softwareInstances.resize(m_sprites.size());
+		m_sprites.build(m_softwareInstances);
+
+		auto const viewProj = glm::ortho(0.0f, static_cast<float>(m_drawExtent.width), 0.0f, static_cast<float>(m_drawExtent.height), -1.0f, 1.0f);
+		m_rasterizer->draw(m_softwareInstances, viewProj, clear_color_v);
+		++m_frameNumber;
+	}
+
+	void Game::drawScene() {
+		// Stand-in playfield until there is game state: the classic wall, a paddle and a ball.
+		constexpr std::uint32_t columns = 14;
+		constexpr std::uint32_t rows = 8;
+		constexpr auto row_colors_v = std::array<std::uint32_t, 4>{ 0xff3a3ad2, 0xff2f8cef, 0xff3dbd44, 0xff2ed6e8 }; // red, orange, green, yellow
+
+		auto const width = static_cast<float>(m_drawExtent.width);
+		auto const height = static_cast<float>(m_drawExtent.height);
+		auto const brick = glm::vec2{width / columns, height * 0.035f};
+		auto const gap = glm::vec2{2.0f};
+		auto const top = height * 0.12f;
+
+		for (std::uint32_t row = 0; row < rows; ++row) {
+			for (std::uint32_t column = 0; column < columns; ++column) {
+				m_sprites.submit({
+					.position = glm::vec2{(static_cast<float>(column) + 0.5f) * brick.x, top + (static_cast<float>(row) + 0.5f) * brick.y},
+					.size = brick - gap,
+					.color = row_colors_v[row / 2],
+				});
+			}
+		}
+
+		m_sprites.submit({ .position = glm::vec2{width * m_input.paddleX, height * 0.92f}, .size = glm::vec2{brick.x * 1.5f, brick.y * 0.5f}, .color = 0xffd0d0d0, .layer = 1 });
+		m_sprites.submit({ .position = glm::vec2{width * 0.5f, height * 0.7f}, .size = glm::vec2{brick.y * 0.5f}, .color = 0xffffffff, .layer = 1 });
+
+		// HUD, once the font's atlas is on the GPU. Stand-in values until there is game state.
+		if (m_font && m_resources.isReady(*m_font)) {
+			if (auto const font = m_resources.get<game::Font>(*m_font)) {
+				auto label = game::TextCache::Label{
+					.position = glm::vec2{brick.y * 0.5f},
+					.size = top * 0.4f,
+					.color = 0xffe0e0e0,
+					.texture = static_cast<std::uint16_t>(font->slot()),
+					.pipeline = text_pipeline_v,
+					.layer = 2,
+				};
+				m_text.submit(m_sprites, font->atlas(), "SCORE 000000", label);
+				label.position.x = width - brick.y * 0.5f;
+				label.anchor = glm::vec2{1.0f, 0.0f};
+				m_text.submit(m_sprites, font->atlas(), "BALLS 3", label);
+			}
+		}
+		m_text.endFrame();
 	}
 
 
@@ -0,0 +1,198 @@
+#include "breakout/game/mesh.hpp"
+
+#include <array>
+#include <cstring>
+
+#include "breakout/core/file_io.hpp"
+#include "breakout/core/logger.hpp"
+#include "breakout/game/mesh_importer.hpp"
+#include "breakout/game/resource_manager.hpp"
+#include "breakout/gpu/upload_queue.hpp"
+#include "breakout/gpu/vk_device.hpp"
+
+namespace game
+{
+	namespace
+	{
+		auto const s_log = bk::Logger{"mesh"};
+
+		constexpr auto magic_v = std::array<char, 4>{'B', 'K', 'M', 'S'};
+		constexpr std::uint64_t section_alignment_v{16};
+
+		/**
+		 * \brief Identifies the source file a cache was built from, so edits to it invalidate the cache.
+		 */
+		struct SourceStamp
+		{
+			std::uint64_t size{};
+			std::int64_t writeTime{};
+
+			bool operator==(SourceStamp const &) const = default;
+		};
+
+		/**
+		 * \brief Layout of a .bkmesh file: this header, then the vertex and index arrays at the given offsets.
+		 */
+		struct CacheHeader
+		{
+			std::array<char, 4> magic{magic_v};
+			std::uint32_t version{Mesh::cache_version_v};
+			std::uint32_t vertexStride{sizeof(Vertex)};
+			std::uint32_t vertexCount{};
+			std::uint32_t indexCount{};
+			std::uint32_t reserved{};
+			SourceStamp source{};
+			std::uint64_t vertexOffset{};
+			std::uint64_t indexOffset{};
+		};
+
+		constexpr std::uint64_t alignUp(std::uint64_t const value) { return (value + section_alignment_v - 1) & ~(section_alignment_v - 1); }
+
+		std::optional<SourceStamp> stampOf(std::filesystem::path const & source)
+		{
+			auto error      = std::error_code{};
+			auto const size = std::filesystem::file_size(source, error);
+			if (error) { return {}; }
+			auto const time = std::filesystem::last_write_time(source, error);
+			if (error) { return {}; }
+			return SourceStamp{.size = size, .writeTime = static_cast<std::int64_t>(time.time_since_epoch().count())};
+		}
+
+		std::shared_ptr<Mesh const> readCache(std::filesystem::path const & path, SourceStamp const & stamp)
+		{
+			auto file = bk::MappedFile::open(path);
+			if (!file) { return {}; }
+
+			auto const bytes = file->bytes();
+			auto header      = CacheHeader{};
+			if (bytes.size() < sizeof(CacheHeader)) { return {}; }
+			std::memcpy(&header, bytes.data(), sizeof(CacheHeader));
+
+			if (header.magic != magic_v || header.version != Mesh::cache_version_v || header.vertexStride != sizeof(Vertex)) { return {}; }
+			if (header.source != stamp) { return {}; }
+
+			auto const vertexBytes = std::uint64_t{header.vertexCount} * sizeof(Vertex);
+			auto const indexBytes  = std::uint64_t{header.indexCount} * sizeof(std::uint32_t);
+			if (header.vertexOffset > bytes.size() || vertexBytes > bytes.size() - header.vertexOffset) { return {}; }
+			if (header.indexOffset > bytes.size() || indexBytes > bytes.size() - header.indexOffset) { return {}; }
+			if (header.vertexOffset % alignof(Vertex) != 0 || header.indexOffset % alignof(std::uint32_t) != 0) { return {}; }
+
+			// The mapping is page aligned and the sections are aligned within it, so they can be viewed in place.
+			// NOLINTBEGIN(cppcoreguidelines-pro-type-reinterpret-cast)
+			auto const vertices = std::span{reinterpret_cast<Vertex const *>(bytes.data() + header.vertexOffset), header.vertexCount};
+			auto const indices  = std::span{reinterpret_cast<std::uint32_t const *>(bytes.data() + header.indexOffset), header.indexCount};
+			// NOLINTEND(cppcoreguidelines-pro-type-reinterpret-cast)
+			return std::make_shared<Mesh const>(std::move(*file), vertices, indices);
+		}
+
+		bool writeCache(std::filesystem::path const & path, MeshData const & mesh, SourceStamp const & stamp)
+		{
+			auto header         = CacheHeader{};
+			header.vertexCount  = static_cast<std::uint32_t>(mesh.vertices.size());
+			header.indexCount   = static_cast<std::uint32_t>(mesh.indices.size());
+			header.source       = stamp;
+			header.vertexOffset = alignUp(sizeof(CacheHeader));
+			header.indexOffset  = alignUp(header.vertexOffset + mesh.vertices.size() * sizeof(Vertex));
+
+			// Sections start at aligned offsets, so the padding before each is shorter than the alignment.
+			static constexpr auto zeros_v = std::array<std::byte, section_alignment_v>{};
+			auto const vertexBytes        = std::as_bytes(std::span{mesh.vertices});
+			auto const indexBytes         = std::as_bytes(std::span{mesh.indices});
+			auto const parts              = std::array{
+				std::as_bytes(std::span{&header, 1}),
+				std::span{zeros_v}.first(header.vertexOffset - sizeof(CacheHeader)),
+				vertexBytes,
+				std::span{zeros_v}.first(header.indexOffset - header.vertexOffset - vertexBytes.size()),
+				indexBytes,
+			};
+			return bk::writeFileAtomic(path, parts);
+		}
+
+		GpuMesh::Buffer createBuffer(bk::gpu::Device const & device, VkDeviceSize const size, VkBufferUsageFlags const usage)
+		{
+			auto bufferInfo  = VkBufferCreateInfo{};
+			bufferInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+			bufferInfo.size  = size;
+			bufferInfo.usage = usage | VK_BUFFER_USAGE_TRANSFER_DST_BIT;
+
+			auto allocInfo          = VmaAllocationCreateInfo{};
+			allocInfo.usage         = VMA_MEMORY_USAGE_GPU_ONLY;
+			allocInfo.requiredFlags = VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT;
+
+			auto ret = GpuMesh::Buffer{};
+			VK_CHECK(vmaCreateBuffer(device.allocator, &bufferInfo, &allocInfo, &ret.buffer, &ret.allocation, nullptr));
+			return ret;
+		}
+	} // namespace
+
+	std::shared_ptr<Mesh const> Mesh::load(std::filesystem::path const & source, bk::ThreadPool & pool)
+	{
+		auto const stamp = stampOf(source);
+		if (!stamp)
+		{
+			s_log.error("mesh source not found: '{}'", source.string());
+			return {};
+		}
+
+		auto const cache = cachePath(source);
+		if (auto mesh = readCache(cache, *stamp)) { return mesh; }
+
+		auto data = mesh_import::importFile(source, pool);
+		if (!data) { return {}; }
+
+		writeCache(cache, *data, *stamp);
+		s_log.info("imported '{}': {} vertices, {} triangles", source.string(), data->vertices.size(), data->indices.size() / 3);
+		return std::make_shared<Mesh const>(std::move(*data));
+	}
+
+	std::filesystem::path Mesh::cachePath(std::filesystem::path const & source)
+	{
+		auto ret = source;
+		ret += cache_extension_v;
+		return ret;
+	}
+
+	Mesh::Mesh(MeshData data) : m_data(std::move(data)), m_vertices(m_data.vertices), m_indices(m_data.indices) {}
+
+	Mesh::Mesh(bk::MappedFile file, std::span<Vertex const> vertices, std::span<std::uint32_t const> indices)
+	: m_file(std::move(file)), m_vertices(vertices), m_indices(indices)
+	{
+	}
+
+	std::shared_ptr<GpuMesh const> GpuMesh::load(LoadContext const & context, bk::gpu::Device const & device, bk::ThreadPool & pool)
+	{
+		auto const mesh = Mesh::load(context.path(), pool);
+		if (!mesh) { return {}; }
+		if (mesh->vertices().empty() || mesh->indices().empty())
+		{
+			s_log.error("mesh '{}' has no triangles", context.path().string());
+			return {};
+		}
+
+		auto const vertexBytes = std::as_bytes(mesh->vertices());
+		auto const indexBytes  = std::as_bytes(mesh->indices());
+		auto const vertices    = createBuffer(device, vertexBytes.size(), VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT);
+		auto const indices     = createBuffer(device, indexBytes.size(), VK_BUFFER_USAGE_INDEX_BUFFER_BIT);
+
+		// Both go into the same batch; the spans of a cached mesh point into the mapping, which may close on return.
+		auto & uploads = context.uploads();
+		context.waitFor(uploads.upload(vertexBytes, vertices.buffer));
+		context.waitFor(uploads.upload(indexBytes, indices.buffer));
+		return std::make_shared<GpuMesh const>(device, vertices, indices, static_cast<std::uint32_t>(mesh->indices().size()));
+	}
+
+	GpuMesh::GpuMesh(bk::gpu::Device const & device, Buffer vertices, Buffer indices, std::uint32_t const indexCount)
+	: m_device(&device), m_vertices(vertices), m_indices(indices), m_indexCount(indexCount)
+	{
+		auto addressInfo   = VkBufferDeviceAddressInfo{};
+		addressInfo.sType  = VK_STRUCTURE_TYPE_BUFFER_DEVICE_ADDRESS_INFO;
+		addressInfo.buffer = m_vertices.buffer;
+		m_vertexAddress    = vkGetBufferDeviceAddress(device.device, &addressInfo);
+	}
+
+	GpuMesh::~GpuMesh()
+	{
+		vmaDestroyBuffer(m_device->allocator, m_vertices.buffer, m_vertices.allocation);
+		vmaDestroyBuffer(m_device->allocator, m_indices.buffer, m_indices.allocation);
+	}
+} // namespace game
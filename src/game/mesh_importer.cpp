@@ -0,0 +1,371 @@
+#include "breakout/game/mesh_importer.hpp"
+
+#include <tiny_obj_loader.h>
+
+#include <fastgltf/core.hpp>
+#include <fastgltf/glm_element_traits.hpp>
+#include <fastgltf/tools.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <string>
+#include <unordered_map>
+
+#include "breakout/core/logger.hpp"
+#include "breakout/core/thread_pool.hpp"
+
+namespace game::mesh_import
+{
+	namespace
+	{
+		auto const s_log = bk::Logger{"mesh-import"};
+
+		std::optional<std::vector<Vertex>> parseObj(std::filesystem::path const & path)
+		{
+			auto config            = tinyobj::ObjReaderConfig{};
+			config.triangulate     = true;
+			config.mtl_search_path = path.parent_path().string();
+
+			auto reader = tinyobj::ObjReader{};
+			if (!reader.ParseFromFile(path.string(), config))
+			{
+				s_log.error("failed to parse '{}': {}", path.string(), reader.Error());
+				return {};
+			}
+
+			auto const & attrib = reader.GetAttrib();
+			auto corners        = std::vector<Vertex>{};
+			for (auto const & shape : reader.GetShapes())
+			{
+				for (auto const & index : shape.mesh.indices)
+				{
+					auto vertex = Vertex{};
+					auto const position = static_cast<std::size_t>(index.vertex_index) * 3;
+					vertex.position     = {attrib.vertices[position], attrib.vertices[position + 1], attrib.vertices[position + 2]};
+					if (index.normal_index >= 0)
+					{
+						auto const normal = static_cast<std::size_t>(index.normal_index) * 3;
+						vertex.normal     = {attrib.normals[normal], attrib.normals[normal + 1], attrib.normals[normal + 2]};
+					}
+					if (index.texcoord_index >= 0)
+					{
+						// OBJ puts the texture origin at the bottom left, Vulkan samples from the top left.
+						auto const uv = static_cast<std::size_t>(index.texcoord_index) * 2;
+						vertex.uv     = {attrib.texcoords[uv], 1.0f - attrib.texcoords[uv + 1]};
+					}
+					corners.push_back(vertex);
+				}
+			}
+			return corners;
+		}
+
+		std::optional<std::vector<Vertex>> parseGltf(std::filesystem::path const & path)
+		{
+			auto data = fastgltf::GltfDataBuffer::FromPath(path);
+			if (data.error() != fastgltf::Error::None)
+			{
+				s_log.error("failed to read '{}': {}", path.string(), fastgltf::getErrorMessage(data.error()));
+				return {};
+			}
+
+			auto parser = fastgltf::Parser{};
+			auto asset  = parser.loadGltf(data.get(), path.parent_path(), fastgltf::Options::LoadExternalBuffers);
+			if (asset.error() != fastgltf::Error::None)
+			{
+				s_log.error("failed to parse '{}': {}", path.string(), fastgltf::getErrorMessage(asset.error()));
+				return {};
+			}
+
+			auto corners = std::vector<Vertex>{};
+			for (auto const & mesh : asset->meshes)
+			{
+				for (auto const & primitive : mesh.primitives)
+				{
+					if (primitive.type != fastgltf::PrimitiveType::Triangles) { continue; }
+
+					auto const position = primitive.findAttribute("POSITION");
+					if (position == primitive.attributes.end()) { continue; }
+
+					auto const & positions = asset->accessors[position->accessorIndex];
+					auto vertices          = std::vector<Vertex>(positions.count);
+					fastgltf::iterateAccessorWithIndex<glm::vec3>(
+						asset.get(), positions, [&](glm::vec3 const value, std::size_t const i) { vertices[i].position = value; });
+
+					if (auto const normal = primitive.findAttribute("NORMAL"); normal != primitive.attributes.end())
+					{
+						fastgltf::iterateAccessorWithIndex<glm::vec3>(
+							asset.get(), asset->accessors[normal->accessorIndex], [&](glm::vec3 const value, std::size_t const i) { if (i < vertices.size()) { vertices[i].normal = value; } });
+					}
+					if (auto const uv = primitive.findAttribute("TEXCOORD_0"); uv != primitive.attributes.end())
+					{
+						fastgltf::iterateAccessorWithIndex<glm::vec2>(
+							asset.get(), asset->accessors[uv->accessorIndex], [&](glm::vec2 const value, std::size_t const i) { if (i < vertices.size()) { vertices[i].uv = value; } });
+					}
+
+					if (!primitive.indicesAccessor.has_value())
+					{
+						corners.insert(corners.end(), vertices.begin(), vertices.end());
+						continue;
+					}
+					// Indices come from the file: a primitive that points past its vertices is dropped rather than trusted.
+					auto const first = corners.size();
+					auto valid       = true;
+					fastgltf::iterateAccessor<std::uint32_t>(asset.get(), asset->accessors[*primitive.indicesAccessor], [&](std::uint32_t const index) {
+						if (index < vertices.size()) { corners.push_back(vertices[index]); }
+						else { valid = false; }
+					});
+					if (!valid)
+					{
+						s_log.error("'{}': skipped a primitive with indices past its {} vertices", path.string(), vertices.size());
+						corners.resize(first);
+					}
+				}
+			}
+			return corners;
+		}
+
+		std::uint64_t hashVertex(Vertex const & vertex)
+		{
+			// FNV-1a over the raw bits, so only bitwise identical vertices are merged.
+			auto bytes = std::array<unsigned char, sizeof(Vertex)>{};
+			std::memcpy(bytes.data(), &vertex, sizeof(Vertex));
+			auto hash = std::uint64_t{14695981039346656037ULL};
+			for (auto const byte : bytes) { hash = (hash ^ byte) * 1099511628211ULL; }
+			return hash;
+		}
+
+		struct VertexKey
+		{
+			Vertex const * vertex{};
+			std::uint64_t hash{};
+
+			bool operator==(VertexKey const & other) const { return hash == other.hash && std::memcmp(vertex, other.vertex, sizeof(Vertex)) == 0; }
+		};
+
+		struct VertexKeyHash
+		{
+			std::size_t operator()(VertexKey const & key) const { return static_cast<std::size_t>(key.hash); }
+		};
+
+		/**
+		 * \brief Tom Forsyth's "Linear-Speed Vertex Cache Optimisation" scoring.
+		 */
+		struct ForsythScore
+		{
+			static constexpr std::uint32_t cache_size_v{32};
+			static constexpr float decay_power_v{1.5f};
+			static constexpr float last_triangle_score_v{0.75f};
+			static constexpr float valence_scale_v{2.0f};
+			static constexpr float valence_power_v{-0.5f};
+
+			static float get(std::int32_t const cachePosition, std::uint32_t const remaining)
+			{
+				if (remaining == 0) { return -1.0f; }
+
+				auto score = 0.0f;
+				if (cachePosition >= 0)
+				{
+					if (cachePosition < 3) { score = last_triangle_score_v; }
+					else
+					{
+						auto const scaled = 1.0f - static_cast<float>(cachePosition - 3) / static_cast<float>(cache_size_v - 3);
+						score             = std::pow(scaled, decay_power_v);
+					}
+				}
+				return score + valence_scale_v * std::pow(static_cast<float>(remaining), valence_power_v);
+			}
+		};
+
+		void optimizeTriangleOrder(MeshData & mesh)
+		{
+			auto const vertexCount   = mesh.vertices.size();
+			auto const triangleCount = mesh.indices.size() / 3;
+			if (triangleCount == 0) { return; }
+
+			// Vertex -> triangle adjacency in CSR form.
+			auto offsets = std::vector<std::uint32_t>(vertexCount + 1);
+			for (auto const index : mesh.indices) { ++offsets[index + 1]; }
+			for (std::size_t i = 0; i < vertexCount; ++i) { offsets[i + 1] += offsets[i]; }
+			auto adjacency = std::vector<std::uint32_t>(mesh.indices.size());
+			auto fill      = std::vector<std::uint32_t>(offsets.begin(), offsets.end() - 1);
+			for (std::size_t i = 0; i < mesh.indices.size(); ++i) { adjacency[fill[mesh.indices[i]]++] = static_cast<std::uint32_t>(i / 3); }
+
+			auto remaining     = std::vector<std::uint32_t>(vertexCount);
+			auto cachePosition = std::vector<std::int32_t>(vertexCount, -1);
+			auto vertexScore   = std::vector<float>(vertexCount);
+			for (std::size_t v = 0; v < vertexCount; ++v)
+			{
+				remaining[v]   = offsets[v + 1] - offsets[v];
+				vertexScore[v] = ForsythScore::get(-1, remaining[v]);
+			}
+
+			auto triangleScore = std::vector<float>(triangleCount);
+			auto emitted       = std::vector<bool>(triangleCount);
+			auto const score   = [&](std::size_t const t)
+			{ return vertexScore[mesh.indices[t * 3]] + vertexScore[mesh.indices[t * 3 + 1]] + vertexScore[mesh.indices[t * 3 + 2]]; };
+			for (std::size_t t = 0; t < triangleCount; ++t) { triangleScore[t] = score(t); }
+
+			auto cache     = std::vector<std::uint32_t>{};
+			auto output    = std::vector<std::uint32_t>{};
+			auto scanStart = std::size_t{};
+			output.reserve(mesh.indices.size());
+			cache.reserve(ForsythScore::cache_size_v + 3);
+
+			auto best = std::optional<std::size_t>{0};
+			while (best.has_value())
+			{
+				auto const triangle = *best;
+				emitted[triangle]   = true;
+
+				// Emit the triangle and move its vertices to the front of the simulated LRU cache.
+				for (std::size_t k = 0; k < 3; ++k)
+				{
+					auto const vertex = mesh.indices[triangle * 3 + k];
+					output.push_back(vertex);
+					std::erase(cache, vertex);
+					cache.insert(cache.begin(), vertex);
+
+					// Keep the triangles still to be emitted at the front of the vertex's adjacency range.
+					auto const first = adjacency.begin() + offsets[vertex];
+					auto const last  = first + remaining[vertex];
+					std::iter_swap(std::find(first, last, static_cast<std::uint32_t>(triangle)), last - 1);
+					--remaining[vertex];
+				}
+
+				// Vertices that fell out of the cache lose their cache bonus.
+				auto const evicted = std::vector<std::uint32_t>(
+					cache.begin() + std::min<std::ptrdiff_t>(std::ssize(cache), ForsythScore::cache_size_v), cache.end());
+				cache.resize(std::min<std::size_t>(cache.size(), ForsythScore::cache_size_v));
+				for (auto const vertex : evicted)
+				{
+					cachePosition[vertex] = -1;
+					vertexScore[vertex]   = ForsythScore::get(-1, remaining[vertex]);
+				}
+				for (std::size_t i = 0; i < cache.size(); ++i)
+				{
+					auto const vertex     = cache[i];
+					cachePosition[vertex] = static_cast<std::int32_t>(i);
+					vertexScore[vertex]   = ForsythScore::get(cachePosition[vertex], remaining[vertex]);
+				}
+
+				// Only triangles touching cached vertices changed score; pick the best among them.
+				best.reset();
+				auto bestScore = -std::numeric_limits<float>::max();
+				for (auto const vertex : cache)
+				{
+					for (auto i = offsets[vertex]; i < offsets[vertex] + remaining[vertex]; ++i)
+					{
+						auto const t     = adjacency[i];
+						triangleScore[t] = score(t);
+						if (triangleScore[t] > bestScore)
+						{
+							bestScore = triangleScore[t];
+							best      = t;
+						}
+					}
+				}
+
+				// Cache ran dry: fall back to the next triangle not yet emitted.
+				if (!best.has_value())
+				{
+					while (scanStart < triangleCount && emitted[scanStart]) { ++scanStart; }
+					if (scanStart < triangleCount) { best = scanStart; }
+				}
+			}
+
+			mesh.indices = std::move(output);
+		}
+
+		void optimizeVertexOrder(MeshData & mesh)
+		{
+			constexpr auto unused_v = std::numeric_limits<std::uint32_t>::max();
+			auto remap              = std::vector<std::uint32_t>(mesh.vertices.size(), unused_v);
+			auto vertices           = std::vector<Vertex>{};
+			vertices.reserve(mesh.vertices.size());
+			for (auto & index : mesh.indices)
+			{
+				if (remap[index] == unused_v)
+				{
+					remap[index] = static_cast<std::uint32_t>(vertices.size());
+					vertices.push_back(mesh.vertices[index]);
+				}
+				index = remap[index];
+			}
+			mesh.vertices = std::move(vertices);
+		}
+	} // namespace
+
+	std::optional<MeshData> importFile(std::filesystem::path const & path, bk::ThreadPool & pool)
+	{
+		auto extension = path.extension().string();
+		std::ranges::transform(extension, extension.begin(), [](unsigned char const c) { return static_cast<char>(std::tolower(c)); });
+
+		auto corners = std::optional<std::vector<Vertex>>{};
+		if (extension == ".obj") { corners = parseObj(path); }
+		else if (extension == ".gltf" || extension == ".glb") { corners = parseGltf(path); }
+		else
+		{
+			s_log.error("unsupported mesh format: '{}'", path.string());
+			return {};
+		}
+		if (!corners) { return {}; }
+
+		auto mesh = weld(*corners, pool);
+		optimize(mesh);
+		return mesh;
+	}
+
+	MeshData weld(std::span<Vertex const> corners, bk::ThreadPool & pool)
+	{
+		auto hashes = std::vector<std::uint64_t>(corners.size());
+		auto const shards = pool.workerCount() + 1;
+		auto const chunk  = (corners.size() + shards - 1) / shards;
+		pool.parallelFor(
+			shards,
+			[&](std::uint32_t const shard)
+			{
+				auto const first = std::min(corners.size(), shard * chunk);
+				auto const last  = std::min(corners.size(), first + chunk);
+				for (auto i = first; i < last; ++i) { hashes[i] = hashVertex(corners[i]); }
+			});
+
+		// Each shard owns the vertices whose hash falls in it, so shards never touch the same output slot.
+		auto local    = std::vector<std::uint32_t>(corners.size());
+		auto owned    = std::vector<std::vector<Vertex>>(shards);
+		pool.parallelFor(
+			shards,
+			[&](std::uint32_t const shard)
+			{
+				auto unique = std::unordered_map<VertexKey, std::uint32_t, VertexKeyHash>{};
+				for (std::size_t i = 0; i < corners.size(); ++i)
+				{
+					if (hashes[i] % shards != shard) { continue; }
+					auto const [itr, inserted] = unique.try_emplace(VertexKey{&corners[i], hashes[i]}, static_cast<std::uint32_t>(owned[shard].size()));
+					if (inserted) { owned[shard].push_back(corners[i]); }
+					local[i] = itr->second;
+				}
+			});
+
+		auto first = std::vector<std::uint32_t>(shards + 1);
+		auto mesh  = MeshData{};
+		for (std::uint32_t shard = 0; shard < shards; ++shard)
+		{
+			first[shard + 1] = first[shard] + static_cast<std::uint32_t>(owned[shard].size());
+			mesh.vertices.insert(mesh.vertices.end(), owned[shard].begin(), owned[shard].end());
+		}
+
+		mesh.indices.resize(corners.size());
+		for (std::size_t i = 0; i < corners.size(); ++i) { mesh.indices[i] = first[hashes[i] % shards] + local[i]; }
+		return mesh;
+	}
+
+	void optimize(MeshData & mesh)
+	{
+		optimizeTriangleOrder(mesh);
+		optimizeVertexOrder(mesh);
+	}
+} // namespace game::mesh_import
@@ -1,2 +1,373 @@
 #include "breakout/game/resource_manager.hpp"
 
+#include <algorithm>
+#include <cassert>
+#include <exception>
+#include <utility>
+
+#include "breakout/core/logger.hpp"
+#include "breakout/core/thread_pool.hpp"
+#include "breakout/gpu/texture_table.hpp"
+#include "breakout/gpu/upload_queue.hpp"
+
+namespace game
+{
+	namespace
+	{
+		auto const s_log = bk::Logger{"resources"};
+
+		std::filesystem::path normalize(std::filesystem::path const & path)
+		{
+			auto error  = std::error_code{};
+			auto result = std::filesystem::weakly_canonical(path, error);
+			if (error) { return std::filesystem::absolute(path); }
+			return result;
+		}
+	} // namespace
+
+	namespace detail
+	{
+		/**
+		 * \brief Set of resources reloaded and swapped in together: a changed file plus everything depending on it.
+		 */
+		struct ReloadBatch
+		{
+			std::string trigger{};
+			ResourceManager::Clock::time_point detected{};
+
+			// Dependents within the batch, and how many of each member's dependencies within the batch are still loading.
+			std::unordered_map<ResourceId, std::vector<ResourceId>> dependents{};
+			std::unordered_map<ResourceId, std::uint32_t> waitingOn{};
+
+			std::mutex mutex{};
+			std::unordered_map<ResourceId, std::shared_ptr<void const>> staged{};
+			std::unordered_map<ResourceId, std::vector<std::uint32_t>> textureSlots{};
+			std::uint64_t upload{};
+			std::size_t remaining{};
+			bool failed{};
+		};
+	} // namespace detail
+
+	std::shared_ptr<void const> LoadContext::resolve(ResourceId const id, std::type_info const & type) const
+	{
+		if (m_batch != nullptr)
+		{
+			auto lock = std::scoped_lock{m_batch->mutex};
+			if (auto const itr = m_batch->staged.find(id); itr != m_batch->staged.end()) { return itr->second; }
+		}
+
+		auto lock = std::scoped_lock{m_manager.m_entriesMutex};
+		auto const & entry = *m_manager.m_entries.at(static_cast<std::size_t>(id));
+		assert(*entry.type == type);
+		(void)type;
+		return entry.value;
+	}
+
+	bk::gpu::UploadQueue & LoadContext::uploads() const
+	{
+		assert(m_manager.m_uploads != nullptr);
+		return *m_manager.m_uploads;
+	}
+
+	void LoadContext::waitFor(bk::gpu::UploadTicket const ticket) const
+	{
+		m_upload = std::max(m_upload, static_cast<std::uint64_t>(ticket));
+	}
+
+	std::optional<std::uint32_t> LoadContext::allocateTextureSlot(VkImageView const view, bool const nearest) const
+	{
+		assert(m_manager.m_textures != nullptr);
+		auto const sampler = nearest ? bk::gpu::TextureTable::Sampler::eNearest : bk::gpu::TextureTable::Sampler::eLinear;
+		auto const slot    = m_manager.m_textures->allocate(view, sampler);
+		if (slot) { m_textureSlots.push_back(*slot); }
+		return slot;
+	}
+
+	ResourceManager::~ResourceManager()
+	{
+		waitForReloads();
+	}
+
+	void ResourceManager::clear()
+	{
+		waitForReloads();
+		m_completed.clear();
+		m_uploading.clear();
+		m_inFlight.clear();
+		m_deferred.clear();
+		m_byPath.clear();
+
+		auto lock = std::scoped_lock{m_entriesMutex};
+		if (m_textures != nullptr)
+		{
+			for (auto const & entry : m_entries) { m_textures->release(entry->textureSlots); }
+		}
+		m_entries.clear();
+	}
+
+	void ResourceManager::waitForReloads()
+	{
+		auto lock = std::unique_lock{m_completedMutex};
+		m_completedCv.wait(lock, [this] { return m_running == 0; });
+	}
+
+	ResourceId ResourceManager::add(std::filesystem::path path, std::type_info const & type, Erased loader, std::span<ResourceId const> dependencies)
+	{
+		path = normalize(path);
+
+		auto value   = std::shared_ptr<void const>{};
+		auto context = LoadContext{*this, path, nullptr};
+		try
+		{
+			value = loader(context);
+		} catch (std::exception const & e)
+		{
+			s_log.error("failed to load '{}': {}", path.string(), e.what());
+		}
+		if (!value)
+		{
+			s_log.error("failed to load '{}'", path.string());
+			if (m_textures != nullptr) { m_textures->release(context.m_textureSlots); }
+			context.m_textureSlots.clear();
+		}
+
+		auto lock     = std::unique_lock{m_entriesMutex};
+		auto const id = ResourceId{static_cast<std::uint32_t>(m_entries.size())};
+		for (auto const dependency : dependencies) { m_entries.at(static_cast<std::size_t>(dependency))->dependents.push_back(id); }
+
+		auto entry          = std::make_unique<Entry>();
+		entry->path         = path;
+		entry->type         = &type;
+		entry->loader       = std::move(loader);
+		entry->dependencies = {dependencies.begin(), dependencies.end()};
+		entry->value        = std::move(value);
+		entry->version      = entry->value ? 1 : 0;
+		entry->upload       = context.m_upload;
+		entry->textureSlots = std::move(context.m_textureSlots);
+		m_entries.push_back(std::move(entry));
+		lock.unlock();
+
+		m_byPath[bk::StringId::intern(path.generic_string())].push_back(id);
+		if (m_watcher) { watchDirectory(path); }
+		return id;
+	}
+
+	ResourceManager::Entry const & ResourceManager::at(ResourceId const id) const
+	{
+		assert(static_cast<std::size_t>(id) < m_entries.size());
+		return *m_entries[static_cast<std::size_t>(id)];
+	}
+
+	bool ResourceManager::isReady(ResourceId const id) const
+	{
+		return isUploaded(at(id).upload);
+	}
+
+	bool ResourceManager::isUploaded(std::uint64_t const ticket) const
+	{
+		return ticket == 0 || m_uploads == nullptr || m_uploads->isComplete(bk::gpu::UploadTicket{ticket});
+	}
+
+	void ResourceManager::enableHotReload(bk::ThreadPool & pool)
+	{
+		m_pool    = &pool;
+		m_watcher = std::make_unique<bk::FileWatcher>();
+		if (!m_watcher->isSupported())
+		{
+			s_log.info("hot reload is not supported on this platform ({} resources)", m_entries.size());
+			m_watcher.reset();
+			return;
+		}
+
+		for (auto const & [pathId, ids] : m_byPath) { watchDirectory(at(ids.front()).path); }
+		s_log.info("hot reload enabled for {} resources", m_entries.size());
+	}
+
+	void ResourceManager::watchDirectory(std::filesystem::path const & path)
+	{
+		assert(m_watcher);
+		m_watcher->watch(path.parent_path());
+	}
+
+	void ResourceManager::update()
+	{
+		if (m_watcher)
+		{
+			auto events = std::exchange(m_deferred, {});
+			for (auto & event : m_watcher->poll())
+			{
+				if (std::ranges::find(events, event.path, &bk::FileWatcher::Event::path) == events.end()) { events.push_back(std::move(event)); }
+			}
+
+			for (auto & event : events)
+			{
+				// A reload touching the same resources is still running: retry once it has been swapped in.
+				if (!schedule(event)) { m_deferred.push_back(std::move(event)); }
+			}
+		}
+
+		auto completed = std::exchange(m_uploading, {});
+		{
+			auto lock = std::scoped_lock{m_completedMutex};
+			completed.insert(completed.end(), m_completed.begin(), m_completed.end());
+			m_completed.clear();
+		}
+		for (auto const & batch : completed)
+		{
+			// Swapping in a version whose buffers or images are still being written would draw garbage for a frame; dropping
+			// a failed one would free memory the upload still writes to.
+			if (!isUploaded(batch->upload)) { m_uploading.push_back(batch); }
+			else { commit(*batch); }
+		}
+	}
+
+	bool ResourceManager::schedule(bk::FileWatcher::Event const & event)
+	{
+		auto const itr = m_byPath.find(bk::StringId{event.path.generic_string()});
+		if (itr == m_byPath.end()) { return true; }
+
+		// Collect the changed resources and everything depending on them, in an order where dependencies come first.
+		auto affected = std::vector<ResourceId>{};
+		auto visited  = std::unordered_set<ResourceId>{};
+		auto visit    = [&](auto const & self, ResourceId const id) -> void
+		{
+			if (!visited.insert(id).second) { return; }
+			for (auto const dependent : at(id).dependents) { self(self, dependent); }
+			affected.push_back(id);
+		};
+		for (auto const id : itr->second) { visit(visit, id); }
+		std::ranges::reverse(affected);
+
+		if (std::ranges::any_of(affected, [this](ResourceId const id) { return m_inFlight.contains(id); })) { return false; }
+
+		auto batch       = std::make_shared<detail::ReloadBatch>();
+		batch->trigger   = event.path.generic_string();
+		batch->detected  = event.detected;
+		batch->remaining = affected.size();
+		for (auto const id : affected)
+		{
+			auto & waiting = batch->waitingOn[id];
+			for (auto const dependency : at(id).dependencies)
+			{
+				if (!visited.contains(dependency)) { continue; }
+				++waiting;
+				batch->dependents[dependency].push_back(id);
+			}
+		}
+
+		m_inFlight.insert(affected.begin(), affected.end());
+		for (auto const id : affected)
+		{
+			if (batch->waitingOn[id] == 0) { launch(batch, id); }
+		}
+		return true;
+	}
+
+	void ResourceManager::launch(std::shared_ptr<detail::ReloadBatch> const & batch, ResourceId const id)
+	{
+		assert(m_pool != nullptr);
+		{
+			auto lock = std::scoped_lock{m_completedMutex};
+			++m_running;
+		}
+
+		m_pool->enqueue(
+			[this, batch, id]
+			{
+				auto const * entry = [&]
+				{
+					auto lock = std::scoped_lock{m_entriesMutex};
+					return m_entries[static_cast<std::size_t>(id)].get();
+				}();
+
+				// Launched only once its dependencies are done, so if one of them failed the batch says so by now: the
+				// loader would see a null value for it, and the batch is discarded anyway.
+				auto const failed = [&]
+				{
+					auto lock = std::scoped_lock{batch->mutex};
+					return batch->failed;
+				}();
+
+				auto value   = std::shared_ptr<void const>{};
+				auto context = LoadContext{*this, entry->path, batch.get()};
+				if (failed) { s_log.debug("not reloading '{}': the reload it is part of failed", entry->path.string()); }
+				else
+				{
+					// Anything escaping here would skip the bookkeeping below, and waitForReloads() would never return.
+					try
+					{
+						value = entry->loader(context);
+					} catch (std::exception const & e)
+					{
+						s_log.error("failed to reload '{}': {}", entry->path.string(), e.what());
+					} catch (...)
+					{
+						s_log.error("failed to reload '{}': unknown exception", entry->path.string());
+					}
+				}
+
+				auto ready = std::vector<ResourceId>{};
+				auto lock  = std::unique_lock{batch->mutex};
+				if (!value) { batch->failed = true; }
+				batch->staged.insert_or_assign(id, std::move(value));
+				batch->textureSlots.insert_or_assign(id, std::move(context.m_textureSlots));
+				batch->upload = std::max(batch->upload, context.m_upload);
+				for (auto const dependent : batch->dependents[id])
+				{
+					if (--batch->waitingOn[dependent] == 0) { ready.push_back(dependent); }
+				}
+				auto const done = --batch->remaining == 0;
+				lock.unlock();
+
+				for (auto const dependent : ready) { launch(batch, dependent); }
+
+				auto completed = std::scoped_lock{m_completedMutex};
+				if (done) { m_completed.push_back(batch); }
+				--m_running;
+				m_completedCv.notify_all();
+			});
+	}
+
+	void ResourceManager::commit(detail::ReloadBatch & batch)
+	{
+		for (auto const & [id, value] : batch.staged) { m_inFlight.erase(id); }
+
+		if (batch.failed)
+		{
+			// Never drawn with, so the slots of the members that did load are free right away.
+			if (m_textures != nullptr)
+			{
+				for (auto const & [id, slots] : batch.textureSlots) { m_textures->release(slots); }
+			}
+			++m_stats.failures;
+			s_log.warn("hot reload of '{}' failed, keeping the previous version", batch.trigger);
+			return;
+		}
+
+		{
+			auto lock = std::scoped_lock{m_entriesMutex};
+			for (auto & [id, value] : batch.staged)
+			{
+				auto & entry = *m_entries[static_cast<std::size_t>(id)];
+				auto slots   = std::move(batch.textureSlots[id]);
+				// Frames in flight may still sample the old version through its slots.
+				if (m_textures != nullptr && !entry.textureSlots.empty()) { m_textures->retire(entry.textureSlots, std::move(entry.value)); }
+				entry.value        = std::move(value);
+				entry.upload       = batch.upload;
+				entry.textureSlots = std::move(slots);
+				++entry.version;
+			}
+		}
+
+		// Swapping happens at the start of a frame, so this is also the latency until the change is drawn.
+		auto const latency   = Clock::now() - batch.detected;
+		m_stats.lastLatency  = latency;
+		m_stats.maxLatency   = std::max(m_stats.maxLatency, latency);
+		m_stats.reloads     += 1;
+		s_log.info(
+			"hot reloaded {} resource(s) after change to '{}' in {:.2f}ms",
+			batch.staged.size(),
+			batch.trigger,
+			std::chrono::duration<double, std::milli>{latency}.count());
+	}
+} // namespace game
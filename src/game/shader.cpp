@@ -2,6 +2,62 @@
 
 #include "breakout/game/shader.hpp"
 
+#include <fstream>
+#include <vector>
+
+#include "breakout/core/logger.hpp"
+
 namespace game {
+	namespace {
+		auto const s_log = bk::Logger{"shader"};
+
+		constexpr std::uint32_t spirv_magic_v{0x07230203};
+	} // namespace
+
+	std::shared_ptr<Shader const> Shader::load(VkDevice device, std::filesystem::path const & path) {
+		auto file = std::ifstream{path, std::ios::binary | std::ios::ate};
+		if (!file) {
+			s_log.error("failed to open shader '{}'", path.string());
+			return {};
+		}
+
+		auto const size = static_cast<std::size_t>(file.tellg());
+		if (size < sizeof(std::uint32_t) || size % sizeof(std::uint32_t) != 0) {
+			s_log.error("'{}' is not a SPIR-V binary ({} bytes)", path.string(), size);
+			return {};
+		}
+
+		auto code = std::vector<std::uint32_t>(size / sizeof(std::uint32_t));
+		file.seekg(0);
+		file.read(reinterpret_cast<char *>(code.data()), static_cast<std::streamsize>(size)); // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+		if (!file || code.front() != spirv_magic_v) {
+			s_log.error("'{}' is not a SPIR-V binary", path.string());
+			return {};
+		}
+
+		auto hash = std::uint64_t{14695981039346656037ULL};
+		for (auto const word : code) { hash = (hash ^ word) * 1099511628211ULL; }
+
+		auto createInfo = VkShaderModuleCreateInfo{};
+		createInfo.sType = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO;
+		createInfo.codeSize = size;
+		createInfo.pCode = code.data();
+
+		auto module = VkShaderModule{};
+		if (vkCreateShaderModule(device, &createInfo, nullptr, &module) != VK_SUCCESS) {
+			s_log.error("failed to create shader module from '{}'", path.string());
+			return {};
+		}
+		return std::make_shared<Shader const>(device, module, hash);
+	}
+
+	std::filesystem::path Shader::directory() {
+		return BK_SHADER_DIR;
+	}
+
+	Shader::Shader(VkDevice device, VkShaderModule module, std::uint64_t hash) : m_device(device), m_module(module), m_hash(hash) {}
 
-}
\ No newline at end of file
+	Shader::~Shader() {
+		vkDestroyShaderModule(m_device, m_module, nullptr);
+	}
+}
@@ -0,0 +1,98 @@
+#include "breakout/game/text_cache.hpp"
+
+#include <algorithm>
+#include <utility>
+
+#include "breakout/game/font.hpp"
+
+namespace game {
+	void TextCache::layout(GlyphAtlas const & atlas, std::string_view text, Layout & out) {
+		out.quads.clear();
+		auto pen = glm::vec2{0.0f, atlas.ascent()};
+		auto width = 0.0f;
+		auto lines = 1U;
+		for (std::size_t i = 0; i < text.size(); ++i) {
+			auto const c = text[i];
+			if (c == '\n') {
+				width = std::max(width, pen.x);
+				pen = glm::vec2{0.0f, pen.y + atlas.lineHeight()};
+				++lines;
+				continue;
+			}
+			auto const & glyph = atlas.glyph(c);
+			if (glyph.size.x > 0.0f) {
+				out.quads.push_back({
+					.position = pen + glyph.offset + glyph.size * 0.5f,
+					.size = glyph.size,
+					.uvRect = glyph.uvRect,
+				});
+			}
+			pen.x += glyph.advance;
+			if (i + 1 < text.size()) {
+				pen.x += atlas.kerning(c, text[i + 1]);
+			}
+		}
+		out.extent = glm::vec2{std::max(width, pen.x), static_cast<float>(lines) * atlas.lineHeight()};
+	}
+
+	void TextCache::submit(bk::gpu::SpriteBatch & batch, Layout const & layout, Label const & label) {
+		auto const origin = label.position - label.anchor * layout.extent * label.size;
+		for (auto const & quad : layout.quads) {
+			batch.submit({
+				.position = origin + quad.position * label.size,
+				.size = quad.size * label.size,
+				.uvRect = quad.uvRect,
+				.color = label.color,
+				.texture = label.texture,
+				.pipeline = label.pipeline,
+				.layer = label.layer,
+			});
+		}
+	}
+
+	void TextCache::submit(bk::gpu::SpriteBatch & batch, GlyphAtlas const & atlas, std::string_view text, Label const & label) {
+		auto it = m_entries.find(text);
+		if (it == m_entries.end()) {
+			it = m_entries.emplace(std::string{text}, Entry{}).first;
+			if (!m_spare.empty()) {
+				it->second.layout.quads = std::move(m_spare.back());
+				m_spare.pop_back();
+			}
+		}
+
+		auto & entry = it->second;
+		if (entry.atlas != atlas.id()) {
+			layout(atlas, text, entry.layout);
+			entry.atlas = atlas.id();
+			++m_current.rebuilds;
+		} else {
+			++m_current.hits;
+		}
+		entry.lastUsed = m_frame;
+		m_current.glyphs += static_cast<std::uint32_t>(entry.layout.quads.size());
+		submit(batch, entry.layout, label);
+	}
+
+	void TextCache::endFrame() {
+		++m_frame;
+		if (m_config.evictAfter > 0 && m_frame % m_config.evictAfter == 0) {
+			for (auto it = m_entries.begin(); it != m_entries.end();) {
+				if (it->second.lastUsed + m_config.evictAfter >= m_frame) {
+					++it;
+					continue;
+				}
+				it->second.layout.quads.clear();
+				m_spare.push_back(std::move(it->second.layout.quads));
+				it = m_entries.erase(it);
+				++m_current.evictions;
+			}
+		}
+		m_current.entries = m_entries.size();
+		m_stats = std::exchange(m_current, Stats{.evictions = m_current.evictions});
+	}
+
+	void TextCache::clear() {
+		m_entries.clear();
+		m_spare.clear();
+	}
+}
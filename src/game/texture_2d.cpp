@@ -1,7 +1,54 @@
+#include "breakout/game/texture_2d.hpp"
 
+#include <stb/stb_image.h>
 
-#include "breakout/game/texture_2d.hpp"
+#include <span>
+
+#include "breakout/core/logger.hpp"
+#include "breakout/game/resource_manager.hpp"
+#include "breakout/gpu/upload_queue.hpp"
+#include "breakout/gpu/vk_images.hpp"
 
 namespace game {
+	namespace {
+		auto const s_log = bk::Logger{"texture"};
+
+		constexpr int channels_v{4};
+	} // namespace
+
+	std::shared_ptr<Texture2D const> Texture2D::load(LoadContext const & context, bk::gpu::Device const & device) {
+		auto const & path = context.path();
+
+		auto width = int{};
+		auto height = int{};
+		auto * const pixels = stbi_load(path.string().c_str(), &width, &height, nullptr, channels_v);
+		if (pixels == nullptr) {
+			s_log.error("failed to decode '{}': {}", path.string(), stbi_failure_reason());
+			return {};
+		}
+
+		auto const extent = VkExtent3D{static_cast<std::uint32_t>(width), static_cast<std::uint32_t>(height), 1};
+		auto image = bk::gpu::createImage(device, extent, VK_FORMAT_R8G8B8A8_UNORM, VK_IMAGE_USAGE_SAMPLED_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT);
+
+		// The slot is written now but only drawn with once the resource is swapped in, which waits for the upload.
+		auto const slot = context.allocateTextureSlot(image.view);
+		if (!slot) {
+			stbi_image_free(pixels);
+			bk::gpu::destroyImage(device, image);
+			return {};
+		}
+
+		auto const size = static_cast<std::size_t>(width) * static_cast<std::size_t>(height) * channels_v;
+		auto const bytes = std::span{reinterpret_cast<std::byte const *>(pixels), size}; // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+		context.waitFor(context.uploads().upload(bytes, image.image, extent, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL));
+		stbi_image_free(pixels);
+
+		return std::make_shared<Texture2D const>(device, image, *slot);
+	}
+
+	Texture2D::Texture2D(bk::gpu::Device const & device, bk::gpu::AllocatedImage image, std::uint32_t slot) : m_device(&device), m_image(image), m_slot(slot) {}
 
-}
\ No newline at end of file
+	Texture2D::~Texture2D() {
+		bk::gpu::destroyImage(*m_device, m_image);
+	}
+}
@@ -0,0 +1,112 @@
+#include "breakout/gpu/command_recorder.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+
+#include "breakout/core/thread_pool.hpp"
+#include "breakout/gpu/vk_device.hpp"
+#include "breakout/gpu/vk_initializers.hpp"
+
+namespace bk::gpu
+{
+	CommandRecorder::CommandRecorder(Device const & device, ThreadPool & pool, Config const & config)
+	: m_device(device.device), m_pool(pool), m_contextCount(std::max(config.contextCount, 1U)), m_contexts(config.frameCount * m_contextCount)
+	{
+		assert(config.frameCount > 0);
+
+		auto poolInfo             = VkCommandPoolCreateInfo{};
+		poolInfo.sType            = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+		poolInfo.flags            = VK_COMMAND_POOL_CREATE_TRANSIENT_BIT;
+		poolInfo.queueFamilyIndex = device.graphicsQueueFamily;
+		for (auto & context : m_contexts) { VK_CHECK(vkCreateCommandPool(m_device, &poolInfo, nullptr, &context.pool)); }
+	}
+
+	CommandRecorder::~CommandRecorder()
+	{
+		for (auto const & context : m_contexts) { vkDestroyCommandPool(m_device, context.pool, nullptr); }
+	}
+
+	void CommandRecorder::beginFrame(std::uint32_t const frame)
+	{
+		m_frame = frame % (static_cast<std::uint32_t>(m_contexts.size()) / m_contextCount);
+		m_recorded.clear();
+		for (std::uint32_t i = 0; i < m_contextCount; ++i)
+		{
+			auto & context = m_contexts[m_frame * m_contextCount + i];
+			if (context.used == 0) { continue; }
+			VK_CHECK(vkResetCommandPool(m_device, context.pool, 0));
+			context.used = 0;
+		}
+	}
+
+	VkCommandBuffer CommandRecorder::acquire(Context & context) const
+	{
+		if (context.used == context.buffers.size())
+		{
+			auto allocInfo               = VkCommandBufferAllocateInfo{};
+			allocInfo.sType              = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+			allocInfo.commandPool        = context.pool;
+			allocInfo.level              = VK_COMMAND_BUFFER_LEVEL_SECONDARY;
+			allocInfo.commandBufferCount = 1;
+			VK_CHECK(vkAllocateCommandBuffers(m_device, &allocInfo, &context.buffers.emplace_back()));
+		}
+		return context.buffers[context.used++];
+	}
+
+	std::span<VkCommandBuffer const> CommandRecorder::record(std::span<Pass const> const passes, RenderTarget const & target)
+	{
+		auto const start = std::chrono::steady_clock::now();
+		m_recorded.assign(passes.size(), VK_NULL_HANDLE);
+
+		auto const passCount = static_cast<std::uint32_t>(passes.size());
+		auto const contexts  = std::min(m_contextCount, passCount);
+		m_pool.parallelFor(contexts, [&](std::uint32_t const index) {
+			auto & context = m_contexts[m_frame * m_contextCount + index];
+
+			auto renderingInfo                    = VkCommandBufferInheritanceRenderingInfo{};
+			renderingInfo.sType                   = VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_RENDERING_INFO;
+			renderingInfo.colorAttachmentCount    = target.colorFormat == VK_FORMAT_UNDEFINED ? 0 : 1;
+			renderingInfo.pColorAttachmentFormats = &target.colorFormat;
+			renderingInfo.depthAttachmentFormat   = target.depthFormat;
+			renderingInfo.rasterizationSamples    = VK_SAMPLE_COUNT_1_BIT;
+
+			auto inheritance  = VkCommandBufferInheritanceInfo{};
+			inheritance.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_INFO;
+			inheritance.pNext = &renderingInfo;
+
+			auto beginInfo = init::commandBufferBeginInfo(VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT | VK_COMMAND_BUFFER_USAGE_RENDER_PASS_CONTINUE_BIT);
+			beginInfo.pInheritanceInfo = &inheritance;
+
+			auto const viewport = VkViewport{0.0f, 0.0f, static_cast<float>(target.extent.width), static_cast<float>(target.extent.height), 0.0f, 1.0f};
+			auto const scissor  = VkRect2D{VkOffset2D{0, 0}, target.extent};
+
+			// Contiguous chunks rather than striding, so neighbouring passes (often sharing state) land in the same context.
+			auto const first = passCount * index / contexts;
+			auto const last  = passCount * (index + 1) / contexts;
+			for (auto pass = first; pass < last; ++pass)
+			{
+				auto const cmd = acquire(context);
+				VK_CHECK(vkBeginCommandBuffer(cmd, &beginInfo));
+				vkCmdSetViewport(cmd, 0, 1, &viewport);
+				vkCmdSetScissor(cmd, 0, 1, &scissor);
+				passes[pass](cmd);
+				VK_CHECK(vkEndCommandBuffer(cmd));
+				m_recorded[pass] = cmd;
+			}
+		});
+
+		m_stats.passes         = passCount;
+		m_stats.contexts       = contexts;
+		m_stats.commandBuffers = 0;
+		for (auto const & context : m_contexts) { m_stats.commandBuffers += static_cast<std::uint32_t>(context.buffers.size()); }
+		m_stats.recordMs = std::chrono::duration<double, std::milli>{std::chrono::steady_clock::now() - start}.count();
+		return m_recorded;
+	}
+
+	void CommandRecorder::execute(VkCommandBuffer const primary) const
+	{
+		if (m_recorded.empty()) { return; }
+		vkCmdExecuteCommands(primary, static_cast<std::uint32_t>(m_recorded.size()), m_recorded.data());
+	}
+} // namespace bk::gpu
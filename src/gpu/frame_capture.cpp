@@ -0,0 +1,203 @@
+#include "breakout/gpu/frame_capture.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <format>
+#include <span>
+
+#include "breakout/core/file_io.hpp"
+#include "breakout/core/image_writer.hpp"
+#include "breakout/core/logger.hpp"
+#include "breakout/core/thread_pool.hpp"
+#include "breakout/gpu/vk_device.hpp"
+
+namespace bk::gpu
+{
+	namespace
+	{
+		auto const s_log = Logger{"gpu"};
+
+		constexpr VkDeviceSize bytes_per_pixel_v{4};
+	} // namespace
+
+	FrameCapture::FrameCapture(Device const & device, ThreadPool & pool, Config const & config)
+	: m_device(device.device), m_allocator(device.allocator), m_pool(pool), m_config(config)
+	{
+		m_readbacks.resize(std::max(m_config.frameCount + m_config.maxPending, 1U));
+	}
+
+	FrameCapture::~FrameCapture()
+	{
+		auto lock = std::unique_lock{m_mutex};
+		m_idle.wait(lock, [&] { return m_encoding == 0; });
+		for (auto const & readback : m_readbacks)
+		{
+			if (readback.buffer != VK_NULL_HANDLE) { vmaDestroyBuffer(m_allocator, readback.buffer, readback.allocation); }
+		}
+		if (m_stats.captured > 0)
+		{
+			s_log.info("frame capture: {} captured, {} written, {} dropped, {} failed", m_stats.captured, m_stats.written, m_stats.dropped, m_stats.failed);
+		}
+	}
+
+	void FrameCapture::captureNext()
+	{
+		auto const lock = std::scoped_lock{m_mutex};
+		m_captureNext   = true;
+	}
+
+	void FrameCapture::setInterval(std::uint32_t const interval)
+	{
+		auto const lock = std::scoped_lock{m_mutex};
+		m_interval      = interval;
+	}
+
+	void FrameCapture::beginFrame(std::uint64_t const frame)
+	{
+		auto const lock = std::scoped_lock{m_mutex};
+		m_frame         = frame;
+		for (auto & readback : m_readbacks)
+		{
+			if (readback.state != State::eRecorded || readback.frame + m_config.frameCount > frame) { continue; }
+			readback.state = State::eEncoding;
+			++m_encoding;
+			m_pool.enqueue([this, &readback] { encode(readback); });
+		}
+	}
+
+	void FrameCapture::addPass(RenderGraph & graph, RenderGraph::Image const image, VkExtent2D const extent, VkFormat const format)
+	{
+		auto * readback = static_cast<Readback *>(nullptr);
+		auto const size = static_cast<VkDeviceSize>(extent.width) * extent.height * bytes_per_pixel_v;
+		{
+			auto const lock = std::scoped_lock{m_mutex};
+			auto const single = m_captureNext;
+			if (!single && (m_interval == 0 || m_frame % m_interval != 0)) { return; }
+			m_captureNext = false;
+
+			auto const bgra = format == VK_FORMAT_B8G8R8A8_UNORM || format == VK_FORMAT_B8G8R8A8_SRGB;
+			if (!bgra && format != VK_FORMAT_R8G8B8A8_UNORM && format != VK_FORMAT_R8G8B8A8_SRGB)
+			{
+				s_log.error("cannot capture images of format {}", string_VkFormat(format));
+				++m_stats.failed;
+				return;
+			}
+
+			auto const free = std::ranges::find(m_readbacks, State::eFree, &Readback::state);
+			if (free == m_readbacks.end())
+			{
+				++m_stats.dropped;
+				return;
+			}
+			readback = &*free;
+
+			if (readback->capacity < size)
+			{
+				if (readback->buffer != VK_NULL_HANDLE) { vmaDestroyBuffer(m_allocator, readback->buffer, readback->allocation); }
+
+				auto bufferInfo  = VkBufferCreateInfo{};
+				bufferInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+				bufferInfo.size  = size;
+				bufferInfo.usage = VK_BUFFER_USAGE_TRANSFER_DST_BIT;
+
+				// Read back by the CPU: cached host memory, where the driver has it.
+				auto allocInfo  = VmaAllocationCreateInfo{};
+				allocInfo.usage = VMA_MEMORY_USAGE_AUTO;
+				allocInfo.flags = VMA_ALLOCATION_CREATE_HOST_ACCESS_RANDOM_BIT | VMA_ALLOCATION_CREATE_MAPPED_BIT;
+
+				auto info = VmaAllocationInfo{};
+				VK_CHECK(vmaCreateBuffer(m_allocator, &bufferInfo, &allocInfo, &readback->buffer, &readback->allocation, &info));
+				readback->data     = info.pMappedData;
+				readback->capacity = size;
+			}
+
+			readback->state  = State::eRecorded;
+			readback->frame  = m_frame;
+			readback->extent = extent;
+			readback->bgra   = bgra;
+			readback->single = single;
+			++m_stats.captured;
+		}
+
+		// Nothing touches the buffer before the copy: the previous encode from it has finished on the CPU.
+		auto const buffer = graph.importBuffer("capture readback", {
+																	   .buffer        = readback->buffer,
+																	   .size          = size,
+																	   .initialStage  = VK_PIPELINE_STAGE_2_NONE,
+																	   .initialAccess = VK_ACCESS_2_NONE,
+																   });
+		graph.addPass(
+			"capture",
+			[&](RenderGraph::PassBuilder & pass)
+			{
+				pass.read(image, RenderGraph::Access::eTransferSrc);
+				pass.write(buffer, RenderGraph::Access::eTransferDst);
+			},
+			[image, buffer, extent](VkCommandBuffer const cmd, RenderGraph const & graph)
+			{
+				auto region                            = VkBufferImageCopy{};
+				region.imageSubresource.aspectMask     = VK_IMAGE_ASPECT_COLOR_BIT;
+				region.imageSubresource.layerCount     = 1;
+				region.imageExtent                     = {extent.width, extent.height, 1};
+				vkCmdCopyImageToBuffer(cmd, graph.image(image).image, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, graph.buffer(buffer), 1, &region);
+
+				// The fence makes the copy available to the device only; host reads need this on top.
+				auto barrier          = VkMemoryBarrier2{};
+				barrier.sType         = VK_STRUCTURE_TYPE_MEMORY_BARRIER_2;
+				barrier.srcStageMask  = VK_PIPELINE_STAGE_2_ALL_TRANSFER_BIT;
+				barrier.srcAccessMask = VK_ACCESS_2_TRANSFER_WRITE_BIT;
+				barrier.dstStageMask  = VK_PIPELINE_STAGE_2_HOST_BIT;
+				barrier.dstAccessMask = VK_ACCESS_2_HOST_READ_BIT;
+
+				auto dependency               = VkDependencyInfo{};
+				dependency.sType              = VK_STRUCTURE_TYPE_DEPENDENCY_INFO;
+				dependency.memoryBarrierCount = 1;
+				dependency.pMemoryBarriers    = &barrier;
+				vkCmdPipelineBarrier2(cmd, &dependency);
+			});
+	}
+
+	void FrameCapture::encode(Readback & readback)
+	{
+		auto const start = std::chrono::steady_clock::now();
+		VK_CHECK(vmaInvalidateAllocation(m_allocator, readback.allocation, 0, VK_WHOLE_SIZE));
+
+		auto const count = static_cast<std::size_t>(readback.extent.width) * readback.extent.height;
+		auto pixels      = std::span{static_cast<std::uint32_t const *>(readback.data), count};
+		auto swizzled    = std::vector<std::uint32_t>{};
+		if (readback.bgra)
+		{
+			swizzled.resize(count);
+			std::ranges::transform(pixels, swizzled.begin(),
+								   [](std::uint32_t const pixel) { return (pixel & 0xff00ff00u) | ((pixel >> 16u) & 0xffu) | ((pixel & 0xffu) << 16u); });
+			pixels = swizzled;
+		}
+
+		auto const png   = m_config.format == Format::ePng;
+		auto const bytes = png ? image::encodePng(readback.extent.width, readback.extent.height, pixels)
+							   : image::encodeQoi(readback.extent.width, readback.extent.height, pixels);
+		auto const path  = m_config.directory / std::format("frame_{:06}.{}", readback.frame, png ? "png" : "qoi");
+		auto const ok    = writeFileAtomic(path, bytes);
+		auto const ms    = std::chrono::duration<double, std::milli>{std::chrono::steady_clock::now() - start}.count();
+		if (ok && readback.single) { s_log.info("captured frame {} to '{}' ({:.2f}ms)", readback.frame, path.string(), ms); }
+
+		{
+			auto const lock = std::scoped_lock{m_mutex};
+			readback.state  = State::eFree;
+			--m_encoding;
+			if (ok)
+			{
+				++m_stats.written;
+				m_stats.lastEncodeMs = ms;
+			}
+			else { ++m_stats.failed; }
+		}
+		m_idle.notify_all();
+	}
+
+	FrameCapture::Stats FrameCapture::getStats() const
+	{
+		auto const lock = std::scoped_lock{m_mutex};
+		return m_stats;
+	}
+} // namespace bk::gpu
@@ -0,0 +1,131 @@
+#include "breakout/gpu/frame_ring_allocator.hpp"
+
+#include <algorithm>
+#include <cassert>
+
+#include "breakout/core/logger.hpp"
+#include "breakout/gpu/vk_device.hpp"
+
+namespace bk::gpu
+{
+	namespace
+	{
+		auto const s_log = Logger{"gpu"};
+
+		constexpr VkDeviceSize alignUp(VkDeviceSize const value, VkDeviceSize const alignment)
+		{
+			return (value + alignment - 1) / alignment * alignment;
+		}
+	} // namespace
+
+	FrameRingAllocator::FrameRingAllocator(Device const & device, Config const & config)
+	: m_allocator(device.allocator), m_slots(config.slotCount), m_capacity(config.capacity)
+	{
+		assert(config.slotCount > 0);
+
+		auto const & limits = device.properties.limits;
+		m_minAlignment      = std::max({limits.minUniformBufferOffsetAlignment, limits.minStorageBufferOffsetAlignment, VkDeviceSize{16}});
+
+		auto bufferInfo  = VkBufferCreateInfo{};
+		bufferInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+		bufferInfo.size  = m_capacity;
+		bufferInfo.usage = config.usage;
+
+		// Sequential-write host memory, preferably device local (ReBAR/UMA) so shaders read it without a copy.
+		auto allocInfo  = VmaAllocationCreateInfo{};
+		allocInfo.usage = VMA_MEMORY_USAGE_AUTO;
+		allocInfo.flags = VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT | VMA_ALLOCATION_CREATE_MAPPED_BIT;
+
+		for (auto & slot : m_slots)
+		{
+			auto info = VmaAllocationInfo{};
+			VK_CHECK(vmaCreateBuffer(m_allocator, &bufferInfo, &allocInfo, &slot.buffer, &slot.allocation, &info));
+			slot.mapped = static_cast<std::byte *>(info.pMappedData);
+
+			if ((config.usage & VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT) != 0)
+			{
+				auto addressInfo   = VkBufferDeviceAddressInfo{};
+				addressInfo.sType  = VK_STRUCTURE_TYPE_BUFFER_DEVICE_ADDRESS_INFO;
+				addressInfo.buffer = slot.buffer;
+				slot.address       = vkGetBufferDeviceAddress(device.device, &addressInfo);
+			}
+		}
+
+		auto memoryFlags = VkMemoryPropertyFlags{};
+		vmaGetAllocationMemoryProperties(m_allocator, m_slots.front().allocation, &memoryFlags);
+		m_coherent = (memoryFlags & VK_MEMORY_PROPERTY_HOST_COHERENT_BIT) != 0;
+		if (!m_coherent)
+		{
+			// Keep every allocation on its own atoms so flushing one frame never touches another's.
+			m_minAlignment = std::max(m_minAlignment, limits.nonCoherentAtomSize);
+		}
+
+		m_stats.capacity = m_capacity;
+	}
+
+	FrameRingAllocator::~FrameRingAllocator()
+	{
+		auto const stats = getStats();
+		s_log.info("frame ring high-water: {} of {} bytes, {} allocations, {} failed", stats.highWaterBytes, stats.capacity,
+				   stats.highWaterAllocations, stats.failedAllocations);
+
+		for (auto & slot : m_slots) { vmaDestroyBuffer(m_allocator, slot.buffer, slot.allocation); }
+	}
+
+	void FrameRingAllocator::reclaim(std::uint32_t const slot)
+	{
+		assert(slot < m_slots.size());
+		auto & target     = m_slots[slot];
+		auto const used   = target.head.exchange(0, std::memory_order_relaxed);
+		auto const allocs = target.allocations.exchange(0, std::memory_order_relaxed);
+
+		m_stats.lastFrameBytes       = used;
+		m_stats.lastFrameAllocations = allocs;
+		m_stats.highWaterBytes       = std::max(m_stats.highWaterBytes, used);
+		m_stats.highWaterAllocations = std::max(m_stats.highWaterAllocations, allocs);
+		m_current                    = slot;
+	}
+
+	std::optional<FrameRingAllocator::Allocation> FrameRingAllocator::allocate(VkDeviceSize const size, VkDeviceSize const alignment)
+	{
+		auto & slot       = m_slots[m_current];
+		auto const align  = std::max(alignment, m_minAlignment);
+		auto head         = slot.head.load(std::memory_order_relaxed);
+		auto offset       = VkDeviceSize{};
+		do {
+			offset = alignUp(head, align);
+			if (offset + size > m_capacity)
+			{
+				if (m_failed.fetch_add(1, std::memory_order_relaxed) == 0)
+				{
+					s_log.warn("frame ring slot full ({} + {} > {} bytes); raise its capacity", offset, size, m_capacity);
+				}
+				return std::nullopt;
+			}
+		} while (!slot.head.compare_exchange_weak(head, offset + size, std::memory_order_relaxed));
+		slot.allocations.fetch_add(1, std::memory_order_relaxed);
+
+		return Allocation{
+			.buffer  = slot.buffer,
+			.offset  = offset,
+			.size    = size,
+			.address = slot.address == 0 ? 0 : slot.address + offset,
+			.data    = slot.mapped + offset,
+		};
+	}
+
+	void FrameRingAllocator::flush() const
+	{
+		if (m_coherent) { return; }
+		auto const & slot = m_slots[m_current];
+		auto const used   = slot.head.load(std::memory_order_relaxed);
+		if (used > 0) { VK_CHECK(vmaFlushAllocation(m_allocator, slot.allocation, 0, used)); }
+	}
+
+	FrameRingAllocator::Stats FrameRingAllocator::getStats() const
+	{
+		auto ret              = m_stats;
+		ret.failedAllocations = m_failed.load(std::memory_order_relaxed);
+		return ret;
+	}
+} // namespace bk::gpu
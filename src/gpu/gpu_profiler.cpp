@@ -0,0 +1,184 @@
+#include "breakout/gpu/gpu_profiler.hpp"
+
+#include <array>
+#include <cmath>
+
+#include "breakout/core/logger.hpp"
+#include "breakout/gpu/vk_device.hpp"
+
+namespace bk::gpu
+{
+	namespace
+	{
+		auto const s_log = Logger{"gpu"};
+
+		// steady_clock is CLOCK_MONOTONIC with libstdc++ and libc++; other platforms fall back to the estimate for now.
+#if defined(__linux__)
+		constexpr auto cpu_time_domain_v = VK_TIME_DOMAIN_CLOCK_MONOTONIC_EXT;
+		constexpr bool has_cpu_time_domain_v{true};
+#else
+		constexpr auto cpu_time_domain_v = VK_TIME_DOMAIN_DEVICE_EXT;
+		constexpr bool has_cpu_time_domain_v{false};
+#endif
+
+		bool supportsTimeDomain(Device const & device)
+		{
+			auto const getDomains = reinterpret_cast<PFN_vkGetPhysicalDeviceCalibrateableTimeDomainsEXT>( // NOLINT(*-reinterpret-cast)
+				vkGetInstanceProcAddr(device.instance, "vkGetPhysicalDeviceCalibrateableTimeDomainsEXT"));
+			if (getDomains == nullptr) { return false; }
+
+			auto count = std::uint32_t{};
+			VK_CHECK(getDomains(device.physicalDevice, &count, nullptr));
+			auto domains = std::vector<VkTimeDomainEXT>(count);
+			VK_CHECK(getDomains(device.physicalDevice, &count, domains.data()));
+
+			auto hasDevice = false;
+			auto hasCpu    = false;
+			for (auto const domain : domains)
+			{
+				hasDevice = hasDevice || domain == VK_TIME_DOMAIN_DEVICE_EXT;
+				hasCpu    = hasCpu || domain == cpu_time_domain_v;
+			}
+			return hasDevice && hasCpu;
+		}
+	} // namespace
+
+	GpuProfiler::Scope::Scope(GpuProfiler & profiler, VkCommandBuffer const cmd, std::string_view const name)
+	: m_profiler(profiler), m_cmd(cmd), m_zone(profiler.begin(cmd, name))
+	{
+	}
+
+	GpuProfiler::Scope::~Scope() { m_profiler.end(m_cmd, m_zone); }
+
+	GpuProfiler::GpuProfiler(Device const & device, Profiler & profiler, Config const & config)
+	: m_device(device.device), m_profiler(profiler), m_config(config), m_period(static_cast<double>(device.properties.limits.timestampPeriod))
+	{
+		auto familyCount = std::uint32_t{};
+		vkGetPhysicalDeviceQueueFamilyProperties(device.physicalDevice, &familyCount, nullptr);
+		auto families = std::vector<VkQueueFamilyProperties>(familyCount);
+		vkGetPhysicalDeviceQueueFamilyProperties(device.physicalDevice, &familyCount, families.data());
+
+		auto const validBits = families[device.graphicsQueueFamily].timestampValidBits;
+		if (validBits == 0)
+		{
+			s_log.warn("the graphics queue does not support timestamps, GPU zones disabled");
+			return;
+		}
+		m_mask = validBits >= 64 ? ~std::uint64_t{} : (std::uint64_t{1} << validBits) - 1;
+
+		auto poolInfo       = VkQueryPoolCreateInfo{};
+		poolInfo.sType      = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO;
+		poolInfo.queryType  = VK_QUERY_TYPE_TIMESTAMP;
+		poolInfo.queryCount = m_config.maxZones * 2;
+		m_slots.resize(m_config.frameCount);
+		for (auto & slot : m_slots) { VK_CHECK(vkCreateQueryPool(m_device, &poolInfo, nullptr, &slot.pool)); }
+
+		if (has_cpu_time_domain_v && device.calibratedTimestamps && supportsTimeDomain(device))
+		{
+			m_getCalibratedTimestamps = reinterpret_cast<PFN_vkGetCalibratedTimestampsEXT>( // NOLINT(*-reinterpret-cast)
+				vkGetDeviceProcAddr(m_device, "vkGetCalibratedTimestampsEXT"));
+		}
+		if (isCalibrated()) { calibrate(); }
+
+		s_log.info("GPU zones: {:.2f}ns per tick, {} valid bits, {}", m_period, validBits,
+				   isCalibrated() ? "calibrated to steady_clock" : "estimated (no calibrated timestamps)");
+	}
+
+	GpuProfiler::~GpuProfiler()
+	{
+		for (auto const & slot : m_slots) { vkDestroyQueryPool(m_device, slot.pool, nullptr); }
+	}
+
+	void GpuProfiler::beginFrame(VkCommandBuffer const cmd, std::uint32_t const slot, std::uint64_t const frame)
+	{
+		if (!isSupported()) { return; }
+
+		auto & current = m_slots[slot % m_slots.size()];
+		collect(current);
+
+		vkCmdResetQueryPool(cmd, current.pool, 0, m_config.maxZones * 2);
+		current.queries  = 0;
+		current.frame    = frame;
+		current.recordNs = Profiler::now();
+		m_current        = &current;
+		m_depth          = 0;
+
+		if (isCalibrated() && ++m_sinceCalibration >= m_config.recalibrateInterval) { calibrate(); }
+	}
+
+	std::uint32_t GpuProfiler::begin(VkCommandBuffer const cmd, std::string_view const name)
+	{
+		if (m_current == nullptr || m_current->queries + 2 > m_config.maxZones * 2) { return no_zone_v; }
+
+		auto const query = m_current->queries;
+		m_current->queries += 2;
+		m_current->zones.push_back({.name = name, .beginQuery = query, .endQuery = query + 1, .depth = m_depth++});
+		vkCmdWriteTimestamp2(cmd, VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT, m_current->pool, query);
+		return static_cast<std::uint32_t>(m_current->zones.size() - 1);
+	}
+
+	void GpuProfiler::end(VkCommandBuffer const cmd, std::uint32_t const zone)
+	{
+		if (zone == no_zone_v) { return; }
+		--m_depth;
+		vkCmdWriteTimestamp2(cmd, VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT, m_current->pool, m_current->zones[zone].endQuery);
+	}
+
+	void GpuProfiler::collect(Slot & slot)
+	{
+		if (slot.zones.empty()) { return; }
+
+		// Pairs of (timestamp, availability). No WAIT_BIT: the slot's fence has signalled, and anything still missing is skipped.
+		m_results.assign(static_cast<std::size_t>(slot.queries) * 2, 0);
+		auto const result = vkGetQueryPoolResults(m_device, slot.pool, 0, slot.queries, m_results.size() * sizeof(std::uint64_t), m_results.data(),
+												  2 * sizeof(std::uint64_t), VK_QUERY_RESULT_64_BIT | VK_QUERY_RESULT_WITH_AVAILABILITY_BIT);
+		if (result != VK_NOT_READY) { VK_CHECK(result); }
+
+		if (!isCalibrated())
+		{
+			m_gpuBase = m_results[static_cast<std::size_t>(slot.zones.front().beginQuery) * 2];
+			m_cpuBase = slot.recordNs;
+			m_profiler.setGpuCalibrated(slot.frame, false);
+		}
+
+		for (auto const & zone : slot.zones)
+		{
+			auto const begin = static_cast<std::size_t>(zone.beginQuery) * 2;
+			auto const end   = static_cast<std::size_t>(zone.endQuery) * 2;
+			if (m_results[begin + 1] == 0 || m_results[end + 1] == 0) { continue; }
+
+			auto const timed = Profiler::Zone{
+				.name    = zone.name,
+				.beginNs = toCpuNs(m_results[begin]),
+				.endNs   = toCpuNs(m_results[end]),
+				.track   = Profiler::gpu_track_v,
+				.depth   = zone.depth,
+			};
+			m_profiler.addZone(slot.frame, timed);
+		}
+		slot.zones.clear();
+	}
+
+	void GpuProfiler::calibrate()
+	{
+		auto infos = std::array<VkCalibratedTimestampInfoEXT, 2>{};
+		for (auto & info : infos) { info.sType = VK_STRUCTURE_TYPE_CALIBRATED_TIMESTAMP_INFO_EXT; }
+		infos[0].timeDomain = VK_TIME_DOMAIN_DEVICE_EXT;
+		infos[1].timeDomain = cpu_time_domain_v;
+
+		auto timestamps   = std::array<std::uint64_t, 2>{};
+		auto maxDeviation = std::uint64_t{};
+		VK_CHECK(m_getCalibratedTimestamps(m_device, static_cast<std::uint32_t>(infos.size()), infos.data(), timestamps.data(), &maxDeviation));
+		m_gpuBase          = timestamps[0];
+		m_cpuBase          = static_cast<std::int64_t>(timestamps[1]); // CLOCK_MONOTONIC is in nanoseconds
+		m_sinceCalibration = 0;
+	}
+
+	std::int64_t GpuProfiler::toCpuNs(std::uint64_t const ticks) const
+	{
+		// Difference within the counter's valid bits, sign extended: timestamps may predate the calibration.
+		auto diff = (ticks - m_gpuBase) & m_mask;
+		if ((diff & ((m_mask >> 1u) + 1)) != 0) { diff |= ~m_mask; }
+		return m_cpuBase + std::llround(static_cast<double>(static_cast<std::int64_t>(diff)) * m_period);
+	}
+} // namespace bk::gpu
@@ -0,0 +1,166 @@
+#include "breakout/gpu/imgui_renderer.hpp"
+
+#include <algorithm>
+#include <span>
+
+#include <imgui.h>
+
+#include "breakout/core/logger.hpp"
+#include "breakout/gpu/frame_ring_allocator.hpp"
+#include "breakout/gpu/texture_table.hpp"
+#include "breakout/gpu/upload_queue.hpp"
+#include "breakout/gpu/vk_device.hpp"
+#include "breakout/gpu/vk_images.hpp"
+
+namespace bk::gpu
+{
+	namespace
+	{
+		auto const s_log = Logger{"gpu"};
+
+		// imgui.vert reads vertices as 5 words and indices as halves of words.
+		static_assert(sizeof(ImDrawVert) == 20 && sizeof(ImDrawIdx) == 2);
+
+		ImTextureID toTextureId(std::uint32_t const slot) { return reinterpret_cast<ImTextureID>(static_cast<std::uintptr_t>(slot)); } // NOLINT(*-int-to-ptr)
+
+		std::uint32_t toSlot(ImTextureID const id) { return static_cast<std::uint32_t>(reinterpret_cast<std::uintptr_t>(id)); }
+	} // namespace
+
+	ImGuiRenderer::ImGuiRenderer(Device const & device, UploadQueue & uploads, TextureTable & textures) : m_device(device), m_textures(textures), m_uploads(uploads)
+	{
+		auto & io = ImGui::GetIO();
+		io.BackendRendererName = "breakout";
+		io.BackendFlags |= ImGuiBackendFlags_RendererHasVtxOffset; // Vertex offsets go through firstInstance
+
+		unsigned char * pixels = nullptr;
+		auto width             = 0;
+		auto height            = 0;
+		io.Fonts->GetTexDataAsRGBA32(&pixels, &width, &height);
+		auto const extent = VkExtent3D{static_cast<std::uint32_t>(width), static_cast<std::uint32_t>(height), 1};
+		m_font = createImage(device, extent, VK_FORMAT_R8G8B8A8_UNORM, VK_IMAGE_USAGE_SAMPLED_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT);
+		// Goes out with the next frame's upload batch, but frames do not wait for it: prepare() skips drawing until it is done.
+		auto const texels = std::span{pixels, static_cast<std::size_t>(width) * static_cast<std::size_t>(height) * 4};
+		m_fontUpload      = uploads.upload(std::as_bytes(texels), m_font.image, extent, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+
+		if (auto const slot = textures.allocate(m_font.view)) { m_fontSlot = *slot; }
+		else
+		{
+			// Text then samples the default (white) texture: boxes instead of glyphs, but still usable.
+			s_log.warn("texture table full, imgui font atlas not bound");
+			m_fontSlot = TextureTable::default_slot_v;
+		}
+		io.Fonts->SetTexID(toTextureId(m_fontSlot));
+
+		auto pushConstants       = VkPushConstantRange{};
+		pushConstants.stageFlags = VK_SHADER_STAGE_VERTEX_BIT;
+		pushConstants.size       = sizeof(ImGuiPushConstants);
+
+		auto const setLayout              = textures.layout();
+		auto layoutInfo                   = VkPipelineLayoutCreateInfo{};
+		layoutInfo.sType                  = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+		layoutInfo.setLayoutCount         = 1;
+		layoutInfo.pSetLayouts            = &setLayout;
+		layoutInfo.pushConstantRangeCount = 1;
+		layoutInfo.pPushConstantRanges    = &pushConstants;
+		VK_CHECK(vkCreatePipelineLayout(device.device, &layoutInfo, nullptr, &m_layout));
+	}
+
+	ImGuiRenderer::~ImGuiRenderer()
+	{
+		if (m_fontSlot != TextureTable::default_slot_v) { m_textures.release(std::span{&m_fontSlot, 1}); }
+		ImGui::GetIO().Fonts->SetTexID(ImTextureID{});
+		destroyImage(m_device, m_font);
+		vkDestroyPipelineLayout(m_device.device, m_layout, nullptr);
+	}
+
+	bool ImGuiRenderer::prepare(ImDrawData const & data, FrameRingAllocator & ring, VkExtent2D const framebuffer)
+	{
+		m_draws.clear();
+		m_stats = {};
+		// Complete as of this frame's poll(), so the frame has also recorded the atlas's queue family acquire.
+		if (!m_uploads.isComplete(m_fontUpload)) { return true; }
+		if (data.TotalVtxCount == 0 || data.DisplaySize.x <= 0.0f || data.DisplaySize.y <= 0.0f) { return true; }
+
+		// One allocation for both arrays; indices stay 4 byte aligned so the shader can read them as words.
+		auto const vertexBytes = static_cast<VkDeviceSize>(data.TotalVtxCount) * sizeof(ImDrawVert);
+		auto const indexBytes  = (static_cast<VkDeviceSize>(data.TotalIdxCount) * sizeof(ImDrawIdx) + 3) & ~VkDeviceSize{3};
+		auto const allocation  = ring.allocate(vertexBytes + indexBytes, 4);
+		if (!allocation) { return false; }
+
+		auto * vertices = static_cast<ImDrawVert *>(allocation->data);
+		auto * indices  = reinterpret_cast<ImDrawIdx *>(static_cast<std::byte *>(allocation->data) + vertexBytes); // NOLINT(*-reinterpret-cast)
+
+		// Display coordinates to NDC, and to framebuffer pixels for clip rects.
+		auto const clipScale = ImVec2{static_cast<float>(framebuffer.width) / data.DisplaySize.x, static_cast<float>(framebuffer.height) / data.DisplaySize.y};
+		m_framebuffer        = framebuffer;
+		m_constants          = ImGuiPushConstants{
+			.scale     = glm::vec2{2.0f / data.DisplaySize.x, 2.0f / data.DisplaySize.y},
+			.translate = glm::vec2{-1.0f - data.DisplayPos.x * 2.0f / data.DisplaySize.x, -1.0f - data.DisplayPos.y * 2.0f / data.DisplaySize.y},
+			.vertices  = allocation->address,
+			.indices   = allocation->address + vertexBytes,
+		};
+
+		auto vertexBase = std::uint32_t{};
+		auto indexBase  = std::uint32_t{};
+		for (auto const * list : std::span{data.CmdLists, static_cast<std::size_t>(data.CmdListsCount)})
+		{
+			std::ranges::copy(list->VtxBuffer, vertices + vertexBase);
+			std::ranges::copy(list->IdxBuffer, indices + indexBase);
+
+			for (auto const & command : list->CmdBuffer)
+			{
+				// No user callbacks: nothing in the overlay registers any.
+				if (command.UserCallback != nullptr || command.ElemCount == 0) { continue; }
+
+				auto const minX = std::clamp((command.ClipRect.x - data.DisplayPos.x) * clipScale.x, 0.0f, static_cast<float>(framebuffer.width));
+				auto const minY = std::clamp((command.ClipRect.y - data.DisplayPos.y) * clipScale.y, 0.0f, static_cast<float>(framebuffer.height));
+				auto const maxX = std::clamp((command.ClipRect.z - data.DisplayPos.x) * clipScale.x, 0.0f, static_cast<float>(framebuffer.width));
+				auto const maxY = std::clamp((command.ClipRect.w - data.DisplayPos.y) * clipScale.y, 0.0f, static_cast<float>(framebuffer.height));
+				if (maxX <= minX || maxY <= minY) { continue; }
+
+				m_draws.push_back({
+					.scissor      = {{static_cast<std::int32_t>(minX), static_cast<std::int32_t>(minY)},
+									 {static_cast<std::uint32_t>(maxX - minX), static_cast<std::uint32_t>(maxY - minY)}},
+					.indexCount   = command.ElemCount,
+					.firstIndex   = indexBase + command.IdxOffset,
+					.vertexOffset = vertexBase + command.VtxOffset,
+					.texture      = toSlot(command.GetTexID()),
+				});
+			}
+			vertexBase += static_cast<std::uint32_t>(list->VtxBuffer.Size);
+			indexBase  += static_cast<std::uint32_t>(list->IdxBuffer.Size);
+		}
+
+		m_stats = {
+			.vertices = static_cast<std::uint32_t>(data.TotalVtxCount),
+			.indices  = static_cast<std::uint32_t>(data.TotalIdxCount),
+			.draws    = static_cast<std::uint32_t>(m_draws.size()),
+		};
+		return true;
+	}
+
+	void ImGuiRenderer::record(VkCommandBuffer const cmd, VkPipeline const pipeline) const
+	{
+		if (m_draws.empty() || pipeline == VK_NULL_HANDLE) { return; }
+
+		vkCmdBindPipeline(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, pipeline);
+		m_textures.bind(cmd, m_layout);
+		auto const viewport = VkViewport{0.0f, 0.0f, static_cast<float>(m_framebuffer.width), static_cast<float>(m_framebuffer.height), 0.0f, 1.0f};
+		vkCmdSetViewport(cmd, 0, 1, &viewport);
+
+		auto constants = m_constants;
+		auto pushed    = false;
+		for (auto const & draw : m_draws)
+		{
+			if (!pushed || draw.texture != constants.texture)
+			{
+				constants.texture = draw.texture;
+				vkCmdPushConstants(cmd, m_layout, VK_SHADER_STAGE_VERTEX_BIT, 0, sizeof(constants), &constants);
+				pushed = true;
+			}
+			vkCmdSetScissor(cmd, 0, 1, &draw.scissor);
+			// Indices are pulled by gl_VertexIndex, which starts at firstVertex; gl_InstanceIndex carries the vertex offset.
+			vkCmdDraw(cmd, draw.indexCount, 1, draw.firstIndex, draw.vertexOffset);
+		}
+	}
+} // namespace bk::gpu
@@ -0,0 +1,327 @@
+#include "breakout/gpu/pipeline_cache.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <span>
+#include <vector>
+
+#include "breakout/core/file_io.hpp"
+#include "breakout/core/logger.hpp"
+#include "breakout/core/thread_pool.hpp"
+#include "breakout/game/shader.hpp"
+#include "breakout/gpu/vk_device.hpp"
+
+namespace bk::gpu
+{
+	namespace
+	{
+		auto const s_log = Logger{"pipelines"};
+
+		std::filesystem::path cacheFileName(VkPhysicalDeviceProperties const & properties)
+		{
+			auto uuid = std::string{};
+			for (auto const byte : properties.pipelineCacheUUID) { std::format_to(std::back_inserter(uuid), "{:02x}", byte); }
+			return std::format("pipelines_{:04x}_{:04x}_{:08x}_{}.bin", properties.vendorID, properties.deviceID, properties.driverVersion, uuid);
+		}
+
+		/**
+		 * \brief Check a blob was produced by this exact device before handing it to the driver.
+		 */
+		bool isCompatible(std::vector<char> const & blob, VkPhysicalDeviceProperties const & properties)
+		{
+			auto header = VkPipelineCacheHeaderVersionOne{};
+			if (blob.size() < sizeof(header)) { return false; }
+			std::memcpy(&header, blob.data(), sizeof(header));
+			return header.headerSize >= sizeof(header) && header.headerVersion == VK_PIPELINE_CACHE_HEADER_VERSION_ONE &&
+				   header.vendorID == properties.vendorID && header.deviceID == properties.deviceID &&
+				   std::ranges::equal(header.pipelineCacheUUID, properties.pipelineCacheUUID);
+		}
+	} // namespace
+
+	std::uint64_t GraphicsPipelineDesc::hash() const
+	{
+		auto ret       = std::uint64_t{14695981039346656037ULL};
+		auto const mix = [&ret](std::uint64_t const value) { ret = (ret ^ value) * 1099511628211ULL; };
+		mix(vertexHash);
+		mix(fragmentHash);
+		mix(reinterpret_cast<std::uintptr_t>(layout)); // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+		mix(static_cast<std::uint64_t>(colorFormat));
+		mix(static_cast<std::uint64_t>(depthFormat));
+		mix(static_cast<std::uint64_t>(topology));
+		mix(cullMode);
+		mix(alphaBlend ? 1 : 0);
+		mix(depthTest ? 1 : 0);
+		return ret;
+	}
+
+	bool GraphicsPipelineDesc::operator==(GraphicsPipelineDesc const & other) const
+	{
+		return vertexHash == other.vertexHash && fragmentHash == other.fragmentHash && layout == other.layout && colorFormat == other.colorFormat &&
+			   depthFormat == other.depthFormat && topology == other.topology && cullMode == other.cullMode && alphaBlend == other.alphaBlend &&
+			   depthTest == other.depthTest;
+	}
+
+	PipelineCache::PipelineCache(Device const & device, ThreadPool & pool, std::filesystem::path directory, std::uint32_t const frameCount)
+	: m_device(device.device), m_path(std::move(directory) / cacheFileName(device.properties)), m_pool(pool), m_frameCount(frameCount)
+	{
+		auto blob = std::vector<char>{};
+		if (auto file = std::ifstream{m_path, std::ios::binary}) { blob.assign(std::istreambuf_iterator<char>{file}, {}); }
+		if (!blob.empty() && !isCompatible(blob, device.properties))
+		{
+			s_log.warn("ignoring incompatible pipeline cache '{}'", m_path.string());
+			blob.clear();
+		}
+
+		auto createInfo            = VkPipelineCacheCreateInfo{};
+		createInfo.sType           = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO;
+		createInfo.initialDataSize = blob.size();
+		createInfo.pInitialData    = blob.data();
+		if (vkCreatePipelineCache(m_device, &createInfo, nullptr, &m_cache) != VK_SUCCESS)
+		{
+			// A driver may still reject the data; start from scratch rather than fail.
+			createInfo.initialDataSize = 0;
+			createInfo.pInitialData    = nullptr;
+			VK_CHECK(vkCreatePipelineCache(m_device, &createInfo, nullptr, &m_cache));
+			blob.clear();
+		}
+
+		m_stats.loadedBytes = blob.size();
+		s_log.info("pipeline cache '{}': {} bytes restored", m_path.string(), blob.size());
+	}
+
+	PipelineCache::~PipelineCache()
+	{
+		{
+			auto lock = std::unique_lock{m_mutex};
+			m_cv.wait(lock, [this] { return m_pending == 0; });
+		}
+
+		save();
+		for (auto const & [key, entry] : m_pipelines) { vkDestroyPipeline(m_device, entry.pipeline, nullptr); }
+		vkDestroyPipelineCache(m_device, m_cache, nullptr);
+	}
+
+	VkPipeline PipelineCache::get(GraphicsPipelineDesc const & desc, VkPipeline const fallback)
+	{
+		auto const key               = desc.hash();
+		auto lock                    = std::unique_lock{m_mutex};
+		auto const [entry, inserted] = use(key, desc);
+		if (entry.state == State::eReady) { return entry.pipeline; }
+
+		++m_stats.fallbacks;
+		if (!inserted) { return fallback; }
+
+		++m_pending;
+		lock.unlock();
+		m_pool.enqueue(
+			[this, key, job = desc]() mutable
+			{
+				auto const pipeline = compile(job);
+				// Released before store(): after it, the cache and the device may be torn down while this job still exists.
+				job = {};
+				store(key, pipeline);
+			});
+		return fallback;
+	}
+
+	VkPipeline PipelineCache::getNow(GraphicsPipelineDesc const & desc)
+	{
+		auto const key               = desc.hash();
+		auto lock                    = std::unique_lock{m_mutex};
+		auto const [entry, inserted] = use(key, desc);
+		entry.pinned                 = true;
+		if (!inserted)
+		{
+			m_cv.wait(lock, [&] { return m_pipelines.at(key).state != State::ePending; });
+			return m_pipelines.at(key).pipeline;
+		}
+
+		++m_pending;
+		lock.unlock();
+		auto const pipeline = compile(desc);
+		store(key, pipeline);
+		return pipeline;
+	}
+
+	std::pair<PipelineCache::Entry &, bool> PipelineCache::use(std::uint64_t const key, GraphicsPipelineDesc const & desc)
+	{
+		auto const [itr, inserted] = m_pipelines.try_emplace(key);
+		auto & entry               = itr->second;
+		if (inserted)
+		{
+			entry.desc          = desc;
+			entry.desc.vertex   = nullptr;
+			entry.desc.fragment = nullptr;
+		}
+		assert(entry.desc == desc && "pipeline hash collision");
+		// Refreshed on every use: a reload with the same code maps to this entry, and its new shaders keep it alive.
+		entry.vertex   = desc.vertex;
+		entry.fragment = desc.fragment;
+		entry.lastUsed = m_frame;
+		return {entry, inserted};
+	}
+
+	void PipelineCache::beginFrame(std::uint64_t const frame)
+	{
+		auto superseded = std::vector<VkPipeline>{};
+		{
+			auto const lock = std::scoped_lock{m_mutex};
+			m_frame         = frame;
+			for (auto itr = m_pipelines.begin(); itr != m_pipelines.end();)
+			{
+				auto const & entry = itr->second;
+				auto const unused  = !entry.pinned && entry.state != State::ePending && entry.lastUsed + m_frameCount <= frame;
+				if (!unused || (!entry.vertex.expired() && !entry.fragment.expired()))
+				{
+					++itr;
+					continue;
+				}
+				if (entry.pipeline != VK_NULL_HANDLE) { superseded.push_back(entry.pipeline); }
+				itr = m_pipelines.erase(itr);
+			}
+			m_stats.destroyed += static_cast<std::uint32_t>(superseded.size());
+		}
+		for (auto const pipeline : superseded) { vkDestroyPipeline(m_device, pipeline, nullptr); }
+	}
+
+	void PipelineCache::store(std::uint64_t const key, VkPipeline const pipeline)
+	{
+		// Notify under the lock: the destructor may be waiting to tear this object down.
+		auto lock      = std::scoped_lock{m_mutex};
+		auto & entry   = m_pipelines.at(key);
+		entry.pipeline = pipeline;
+		entry.state    = pipeline != VK_NULL_HANDLE ? State::eReady : State::eFailed;
+		++(pipeline != VK_NULL_HANDLE ? m_stats.compiled : m_stats.failed);
+		--m_pending;
+		m_cv.notify_all();
+	}
+
+	bool PipelineCache::save() const
+	{
+		auto size = std::size_t{};
+		if (vkGetPipelineCacheData(m_device, m_cache, &size, nullptr) != VK_SUCCESS || size == 0) { return false; }
+		auto blob = std::vector<std::byte>(size);
+		if (vkGetPipelineCacheData(m_device, m_cache, &size, blob.data()) != VK_SUCCESS) { return false; }
+
+		// Through a temporary file, so a crash while saving never leaves a truncated cache for the next run.
+		return writeFileAtomic(m_path, std::span{blob}.first(size));
+	}
+
+	PipelineCache::Stats PipelineCache::getStats() const
+	{
+		auto lock = std::scoped_lock{m_mutex};
+		return m_stats;
+	}
+
+	VkPipeline PipelineCache::compile(GraphicsPipelineDesc const & desc) const
+	{
+		auto const start = std::chrono::steady_clock::now();
+
+		auto stages = std::array<VkPipelineShaderStageCreateInfo, 2>{};
+		for (auto & stage : stages)
+		{
+			stage.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+			stage.pName = "main";
+		}
+		stages[0].stage  = VK_SHADER_STAGE_VERTEX_BIT;
+		stages[0].module = desc.vertex->module();
+		stages[1].stage  = VK_SHADER_STAGE_FRAGMENT_BIT;
+		stages[1].module = desc.fragment->module();
+
+		auto vertexInput  = VkPipelineVertexInputStateCreateInfo{};
+		vertexInput.sType = VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO;
+
+		auto inputAssembly     = VkPipelineInputAssemblyStateCreateInfo{};
+		inputAssembly.sType    = VK_STRUCTURE_TYPE_PIPELINE_INPUT_ASSEMBLY_STATE_CREATE_INFO;
+		inputAssembly.topology = desc.topology;
+
+		auto viewport          = VkPipelineViewportStateCreateInfo{};
+		viewport.sType         = VK_STRUCTURE_TYPE_PIPELINE_VIEWPORT_STATE_CREATE_INFO;
+		viewport.viewportCount = 1;
+		viewport.scissorCount  = 1;
+
+		auto rasterization        = VkPipelineRasterizationStateCreateInfo{};
+		rasterization.sType       = VK_STRUCTURE_TYPE_PIPELINE_RASTERIZATION_STATE_CREATE_INFO;
+		rasterization.polygonMode = VK_POLYGON_MODE_FILL;
+		rasterization.cullMode    = desc.cullMode;
+		rasterization.frontFace   = VK_FRONT_FACE_CLOCKWISE;
+		rasterization.lineWidth   = 1.0f;
+
+		auto multisample                 = VkPipelineMultisampleStateCreateInfo{};
+		multisample.sType                = VK_STRUCTURE_TYPE_PIPELINE_MULTISAMPLE_STATE_CREATE_INFO;
+		multisample.rasterizationSamples = VK_SAMPLE_COUNT_1_BIT;
+		multisample.minSampleShading     = 1.0f;
+
+		auto depthStencil             = VkPipelineDepthStencilStateCreateInfo{};
+		depthStencil.sType            = VK_STRUCTURE_TYPE_PIPELINE_DEPTH_STENCIL_STATE_CREATE_INFO;
+		depthStencil.depthTestEnable  = desc.depthTest ? VK_TRUE : VK_FALSE;
+		depthStencil.depthWriteEnable = desc.depthTest ? VK_TRUE : VK_FALSE;
+		depthStencil.depthCompareOp   = VK_COMPARE_OP_GREATER_OR_EQUAL;
+		depthStencil.maxDepthBounds   = 1.0f;
+
+		auto blendAttachment           = VkPipelineColorBlendAttachmentState{};
+		blendAttachment.colorWriteMask = VK_COLOR_COMPONENT_R_BIT | VK_COLOR_COMPONENT_G_BIT | VK_COLOR_COMPONENT_B_BIT | VK_COLOR_COMPONENT_A_BIT;
+		if (desc.alphaBlend)
+		{
+			blendAttachment.blendEnable         = VK_TRUE;
+			blendAttachment.srcColorBlendFactor = VK_BLEND_FACTOR_SRC_ALPHA;
+			blendAttachment.dstColorBlendFactor = VK_BLEND_FACTOR_ONE_MINUS_SRC_ALPHA;
+			blendAttachment.colorBlendOp        = VK_BLEND_OP_ADD;
+			blendAttachment.srcAlphaBlendFactor = VK_BLEND_FACTOR_ONE;
+			blendAttachment.dstAlphaBlendFactor = VK_BLEND_FACTOR_ONE_MINUS_SRC_ALPHA;
+			blendAttachment.alphaBlendOp        = VK_BLEND_OP_ADD;
+		}
+
+		auto const hasColor        = desc.colorFormat != VK_FORMAT_UNDEFINED;
+		auto colorBlend            = VkPipelineColorBlendStateCreateInfo{};
+		colorBlend.sType           = VK_STRUCTURE_TYPE_PIPELINE_COLOR_BLEND_STATE_CREATE_INFO;
+		colorBlend.attachmentCount = hasColor ? 1 : 0;
+		colorBlend.pAttachments    = &blendAttachment;
+
+		constexpr auto dynamic_states_v = std::array{VK_DYNAMIC_STATE_VIEWPORT, VK_DYNAMIC_STATE_SCISSOR};
+		auto dynamic                    = VkPipelineDynamicStateCreateInfo{};
+		dynamic.sType                   = VK_STRUCTURE_TYPE_PIPELINE_DYNAMIC_STATE_CREATE_INFO;
+		dynamic.dynamicStateCount       = static_cast<std::uint32_t>(dynamic_states_v.size());
+		dynamic.pDynamicStates          = dynamic_states_v.data();
+
+		auto rendering                    = VkPipelineRenderingCreateInfo{};
+		rendering.sType                   = VK_STRUCTURE_TYPE_PIPELINE_RENDERING_CREATE_INFO;
+		rendering.colorAttachmentCount    = hasColor ? 1 : 0;
+		rendering.pColorAttachmentFormats = &desc.colorFormat;
+		rendering.depthAttachmentFormat   = desc.depthFormat;
+
+		auto createInfo                = VkGraphicsPipelineCreateInfo{};
+		createInfo.sType               = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO;
+		createInfo.pNext               = &rendering;
+		createInfo.stageCount          = static_cast<std::uint32_t>(stages.size());
+		createInfo.pStages             = stages.data();
+		createInfo.pVertexInputState   = &vertexInput;
+		createInfo.pInputAssemblyState = &inputAssembly;
+		createInfo.pViewportState      = &viewport;
+		createInfo.pRasterizationState = &rasterization;
+		createInfo.pMultisampleState   = &multisample;
+		createInfo.pDepthStencilState  = &depthStencil;
+		createInfo.pColorBlendState    = &colorBlend;
+		createInfo.pDynamicState       = &dynamic;
+		createInfo.layout              = desc.layout;
+
+		// VkPipelineCache is internally synchronized, so workers can compile against it concurrently.
+		auto pipeline = VkPipeline{};
+		if (vkCreateGraphicsPipelines(m_device, m_cache, 1, &createInfo, nullptr, &pipeline) != VK_SUCCESS)
+		{
+			s_log.error("failed to compile pipeline {:016x}", desc.hash());
+			return VK_NULL_HANDLE;
+		}
+
+		s_log.debug(
+			"compiled pipeline {:016x} in {:.2f}ms",
+			desc.hash(),
+			std::chrono::duration<double, std::milli>{std::chrono::steady_clock::now() - start}.count());
+		return pipeline;
+	}
+} // namespace bk::gpu
@@ -0,0 +1,632 @@
+#include "breakout/gpu/render_graph.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cstdlib>
+#include <format>
+#include <iterator>
+#include <numeric>
+#include <type_traits>
+
+#include "breakout/core/logger.hpp"
+#include "breakout/gpu/vk_device.hpp"
+#include "breakout/gpu/vk_initializers.hpp"
+
+namespace bk::gpu
+{
+	namespace
+	{
+		auto const s_log = Logger{"gpu"};
+
+		struct AccessInfo
+		{
+			VkPipelineStageFlags2 stage{};
+			VkAccessFlags2 access{};
+			VkImageLayout layout{};
+			VkImageUsageFlags imageUsage{};
+			VkBufferUsageFlags bufferUsage{};
+			bool write{}; // Whether the access writes at all, e.g. eColorAttachment declared as read still may
+		};
+
+		constexpr auto access_info_v = std::array<AccessInfo, static_cast<std::size_t>(RenderGraph::Access::eCOUNT_)>{{
+			{VK_PIPELINE_STAGE_2_COLOR_ATTACHMENT_OUTPUT_BIT, VK_ACCESS_2_COLOR_ATTACHMENT_READ_BIT | VK_ACCESS_2_COLOR_ATTACHMENT_WRITE_BIT,
+			 VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL, VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT, 0, true},
+			{VK_PIPELINE_STAGE_2_EARLY_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_2_LATE_FRAGMENT_TESTS_BIT,
+			 VK_ACCESS_2_DEPTH_STENCIL_ATTACHMENT_READ_BIT | VK_ACCESS_2_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT, VK_IMAGE_LAYOUT_DEPTH_ATTACHMENT_OPTIMAL,
+			 VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT, 0, true},
+			{VK_PIPELINE_STAGE_2_FRAGMENT_SHADER_BIT, VK_ACCESS_2_SHADER_SAMPLED_READ_BIT, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+			 VK_IMAGE_USAGE_SAMPLED_BIT, 0, false},
+			{VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT, VK_ACCESS_2_SHADER_STORAGE_READ_BIT, VK_IMAGE_LAYOUT_GENERAL, VK_IMAGE_USAGE_STORAGE_BIT,
+			 VK_BUFFER_USAGE_STORAGE_BUFFER_BIT, false},
+			{VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT, VK_ACCESS_2_SHADER_STORAGE_READ_BIT | VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT, VK_IMAGE_LAYOUT_GENERAL,
+			 VK_IMAGE_USAGE_STORAGE_BIT, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT, true},
+			{VK_PIPELINE_STAGE_2_ALL_TRANSFER_BIT, VK_ACCESS_2_TRANSFER_READ_BIT, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, VK_IMAGE_USAGE_TRANSFER_SRC_BIT,
+			 VK_BUFFER_USAGE_TRANSFER_SRC_BIT, false},
+			{VK_PIPELINE_STAGE_2_ALL_TRANSFER_BIT, VK_ACCESS_2_TRANSFER_WRITE_BIT, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_USAGE_TRANSFER_DST_BIT,
+			 VK_BUFFER_USAGE_TRANSFER_DST_BIT, true},
+			{VK_PIPELINE_STAGE_2_VERTEX_ATTRIBUTE_INPUT_BIT, VK_ACCESS_2_VERTEX_ATTRIBUTE_READ_BIT, VK_IMAGE_LAYOUT_UNDEFINED, 0,
+			 VK_BUFFER_USAGE_VERTEX_BUFFER_BIT, false},
+			{VK_PIPELINE_STAGE_2_INDEX_INPUT_BIT, VK_ACCESS_2_INDEX_READ_BIT, VK_IMAGE_LAYOUT_UNDEFINED, 0, VK_BUFFER_USAGE_INDEX_BUFFER_BIT, false},
+			{VK_PIPELINE_STAGE_2_DRAW_INDIRECT_BIT, VK_ACCESS_2_INDIRECT_COMMAND_READ_BIT, VK_IMAGE_LAYOUT_UNDEFINED, 0,
+			 VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT, false},
+			{VK_PIPELINE_STAGE_2_VERTEX_SHADER_BIT | VK_PIPELINE_STAGE_2_FRAGMENT_SHADER_BIT, VK_ACCESS_2_UNIFORM_READ_BIT, VK_IMAGE_LAYOUT_UNDEFINED, 0,
+			 VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT, false},
+		}};
+
+		AccessInfo const & infoOf(RenderGraph::Access const access) { return access_info_v[static_cast<std::size_t>(access)]; }
+
+		VkImageAspectFlags aspectOf(VkFormat const format)
+		{
+			return format == VK_FORMAT_D32_SFLOAT ? VK_IMAGE_ASPECT_DEPTH_BIT : VK_IMAGE_ASPECT_COLOR_BIT;
+		}
+
+		constexpr VkDeviceSize alignUp(VkDeviceSize const value, VkDeviceSize const alignment) { return (value + alignment - 1) / alignment * alignment; }
+
+		constexpr bool overlaps(std::uint32_t const aFirst, std::uint32_t const aLast, std::uint32_t const bFirst, std::uint32_t const bLast)
+		{
+			return aFirst <= bLast && bFirst <= aLast;
+		}
+
+		double toMiB(VkDeviceSize const bytes) { return static_cast<double>(bytes) / (1024.0 * 1024.0); }
+	} // namespace
+
+	void RenderGraph::PassBuilder::read(Image const image, Access const access)
+	{
+		m_graph.use(m_pass, static_cast<std::uint32_t>(image), access, false);
+	}
+
+	void RenderGraph::PassBuilder::write(Image const image, Access const access)
+	{
+		m_graph.use(m_pass, static_cast<std::uint32_t>(image), access, true);
+	}
+
+	void RenderGraph::PassBuilder::read(Buffer const buffer, Access const access)
+	{
+		m_graph.use(m_pass, static_cast<std::uint32_t>(buffer), access, false);
+	}
+
+	void RenderGraph::PassBuilder::write(Buffer const buffer, Access const access)
+	{
+		m_graph.use(m_pass, static_cast<std::uint32_t>(buffer), access, true);
+	}
+
+	void RenderGraph::PassBuilder::keep() { m_graph.m_passes[m_pass].keep = true; }
+
+	bool RenderGraph::Transient::matches(Transient const & other) const
+	{
+		return kind == other.kind && extent.width == other.extent.width && extent.height == other.extent.height && format == other.format &&
+			   usage == other.usage && size == other.size && firstPass == other.firstPass && lastPass == other.lastPass;
+	}
+
+	RenderGraph::RenderGraph(Device const & device, Config const & config) : m_device(device), m_config(config)
+	{
+		m_slots.resize(m_config.frameCount);
+	}
+
+	RenderGraph::~RenderGraph()
+	{
+		for (auto & slot : m_slots) { destroy(slot); }
+	}
+
+	void RenderGraph::reset()
+	{
+		m_resources.clear();
+		m_passes.clear();
+		m_imageBarriers.clear();
+		m_bufferBarriers.clear();
+		m_finalBarriers.clear();
+		m_current = nullptr;
+	}
+
+	std::uint32_t RenderGraph::add(std::string_view const name, Resource resource)
+	{
+		resource.name = name;
+		m_resources.push_back(std::move(resource));
+		return static_cast<std::uint32_t>(m_resources.size() - 1);
+	}
+
+	RenderGraph::Image RenderGraph::importImage(std::string_view const name, ImportedImage const & image)
+	{
+		return Image{add(name, {.kind = Kind::eImage, .imported = true, .image = image})};
+	}
+
+	RenderGraph::Buffer RenderGraph::importBuffer(std::string_view const name, ImportedBuffer const & buffer)
+	{
+		return Buffer{add(name, {.kind = Kind::eBuffer, .imported = true, .buffer = buffer})};
+	}
+
+	RenderGraph::Image RenderGraph::createImage(std::string_view const name, ImageDesc const & desc)
+	{
+		return Image{add(name, {.kind = Kind::eImage, .image = {.extent = desc.extent, .format = desc.format}, .usage = desc.usage})};
+	}
+
+	RenderGraph::Buffer RenderGraph::createBuffer(std::string_view const name, VkDeviceSize const size, VkBufferUsageFlags const usage)
+	{
+		return Buffer{add(name, {.kind = Kind::eBuffer, .buffer = {.size = size}, .usage = usage})};
+	}
+
+	void RenderGraph::keep(Image const image) { m_resources[static_cast<std::uint32_t>(image)].kept = true; }
+
+	void RenderGraph::addPass(std::string_view const name, Setup const & setup, Execute execute)
+	{
+		m_passes.push_back({.name = std::string{name}, .execute = std::move(execute)});
+		auto builder = PassBuilder{*this, static_cast<std::uint32_t>(m_passes.size() - 1)};
+		setup(builder);
+	}
+
+	void RenderGraph::use(std::uint32_t const pass, std::uint32_t const resource, Access const access, bool const write)
+	{
+		assert(resource < m_resources.size());
+		auto & target = m_resources[resource];
+		auto const & info = infoOf(access);
+		assert(target.kind == Kind::eBuffer || info.layout != VK_IMAGE_LAYOUT_UNDEFINED);
+		target.usage |= target.kind == Kind::eImage ? info.imageUsage : info.bufferUsage;
+		m_passes[pass].uses.push_back({.resource = resource, .access = access, .write = write});
+	}
+
+	void RenderGraph::cull()
+	{
+		// Backwards: a pass lives if it writes something that is used afterwards (by a live pass or outside the graph).
+		auto needed = std::vector<bool>(m_resources.size());
+		for (std::size_t i = 0; i < m_resources.size(); ++i) { needed[i] = m_resources[i].imported || m_resources[i].kept; }
+
+		for (auto pass = m_passes.rbegin(); pass != m_passes.rend(); ++pass)
+		{
+			pass->live = pass->keep || std::ranges::any_of(pass->uses, [&](Use const & use) { return use.write && needed[use.resource]; });
+			if (!pass->live) { continue; }
+			for (auto const & use : pass->uses)
+			{
+				if (!use.write) { needed[use.resource] = true; }
+			}
+		}
+
+		for (std::uint32_t index = 0; index < m_passes.size(); ++index)
+		{
+			if (!m_passes[index].live) { continue; }
+			for (auto const & use : m_passes[index].uses)
+			{
+				auto & resource     = m_resources[use.resource];
+				resource.firstPass  = std::min(resource.firstPass, index);
+				resource.lastPass   = std::max(resource.lastPass, index);
+			}
+		}
+	}
+
+	void RenderGraph::compile(std::uint32_t const slot)
+	{
+		m_stats = {.passes = static_cast<std::uint32_t>(m_passes.size()), .rebuilds = m_stats.rebuilds};
+		cull();
+		place(slot);
+		buildBarriers();
+		m_stats.culled = static_cast<std::uint32_t>(std::ranges::count(m_passes, false, &Pass::live));
+	}
+
+	void RenderGraph::place(std::uint32_t const slot)
+	{
+		auto & current = m_slots[slot % m_slots.size()];
+		m_current      = &current;
+
+		// What this frame needs, in declaration order; identical to last time (the common case) means nothing to do.
+		auto wanted = std::vector<Transient>{};
+		for (auto & resource : m_resources)
+		{
+			if (resource.imported || resource.firstPass > resource.lastPass) { continue; }
+			resource.physical = static_cast<std::uint32_t>(wanted.size());
+			wanted.push_back({
+				.kind      = resource.kind,
+				.extent    = resource.image.extent,
+				.format    = resource.image.format,
+				.usage     = resource.usage,
+				.size      = resource.buffer.size,
+				.firstPass = resource.firstPass,
+				.lastPass  = resource.lastPass,
+			});
+		}
+
+		auto const reusable = wanted.size() == current.transients.size() &&
+							  std::ranges::equal(wanted, current.transients, [](Transient const & a, Transient const & b) { return a.matches(b); });
+		if (!reusable)
+		{
+			destroy(current);
+			current.transients = std::move(wanted);
+			++m_stats.rebuilds;
+
+			auto requirements           = VkMemoryRequirements{};
+			requirements.memoryTypeBits = ~0u;
+			auto hasImages              = false;
+			auto hasBuffers             = false;
+			auto alignments             = std::vector<VkDeviceSize>(current.transients.size());
+			for (std::size_t i = 0; i < current.transients.size(); ++i)
+			{
+				auto & transient = current.transients[i];
+				auto memory      = VkMemoryRequirements{};
+				if (transient.kind == Kind::eImage)
+				{
+					auto const info = init::imageCreateInfo(transient.format, transient.usage, {transient.extent.width, transient.extent.height, 1});
+					VK_CHECK(vkCreateImage(m_device.device, &info, nullptr, &transient.image));
+					vkGetImageMemoryRequirements(m_device.device, transient.image, &memory);
+					hasImages = true;
+				}
+				else
+				{
+					auto info  = VkBufferCreateInfo{};
+					info.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+					info.size  = transient.size;
+					info.usage = transient.usage;
+					VK_CHECK(vkCreateBuffer(m_device.device, &info, nullptr, &transient.vkBuffer));
+					vkGetBufferMemoryRequirements(m_device.device, transient.vkBuffer, &memory);
+					hasBuffers = true;
+				}
+				transient.bytes              = memory.size;
+				alignments[i]                = memory.alignment;
+				requirements.alignment       = std::max(requirements.alignment, memory.alignment);
+				requirements.memoryTypeBits &= memory.memoryTypeBits;
+			}
+
+			// Linear buffers and optimal images sharing a page would need bufferImageGranularity between them; align all
+			// offsets to it rather than tracking which neighbour is which kind.
+			auto const granularity = hasImages && hasBuffers ? m_device.properties.limits.bufferImageGranularity : VkDeviceSize{1};
+
+			// Largest first, each at the lowest offset clear of every placed transient alive at the same time.
+			auto order = std::vector<std::size_t>(current.transients.size());
+			std::iota(order.begin(), order.end(), std::size_t{0});
+			std::ranges::stable_sort(order, std::greater{}, [&](std::size_t const i) { return current.transients[i].bytes; });
+
+			auto placed = std::vector<std::size_t>{};
+			auto busy   = std::vector<std::pair<VkDeviceSize, VkDeviceSize>>{};
+			for (auto const i : order)
+			{
+				auto & transient = current.transients[i];
+				auto const align = std::max(alignments[i], granularity);
+
+				busy.clear();
+				for (auto const other : placed)
+				{
+					auto const & occupant = current.transients[other];
+					if (overlaps(transient.firstPass, transient.lastPass, occupant.firstPass, occupant.lastPass))
+					{
+						busy.emplace_back(occupant.offset, occupant.offset + occupant.bytes);
+					}
+				}
+				std::ranges::sort(busy);
+
+				auto offset = VkDeviceSize{};
+				for (auto const & [begin, end] : busy)
+				{
+					if (offset + transient.bytes <= begin) { break; }
+					offset = std::max(offset, alignUp(end, align));
+				}
+				transient.offset = offset;
+				current.bytes    = std::max(current.bytes, offset + transient.bytes);
+				placed.push_back(i);
+			}
+
+			if (!current.transients.empty())
+			{
+				if (requirements.memoryTypeBits == 0)
+				{
+					s_log.error("render graph transients share no memory type, they cannot be aliased");
+					std::abort();
+				}
+
+				requirements.size       = current.bytes;
+				auto allocInfo          = VmaAllocationCreateInfo{};
+				allocInfo.usage         = VMA_MEMORY_USAGE_GPU_ONLY;
+				allocInfo.requiredFlags = VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT;
+				VK_CHECK(vmaAllocateMemory(m_device.allocator, &requirements, &allocInfo, &current.allocation, nullptr));
+
+				for (auto & transient : current.transients)
+				{
+					if (transient.kind == Kind::eImage)
+					{
+						VK_CHECK(vmaBindImageMemory2(m_device.allocator, current.allocation, transient.offset, transient.image, nullptr));
+						auto const view = init::imageViewCreateInfo(transient.format, transient.image, aspectOf(transient.format));
+						VK_CHECK(vkCreateImageView(m_device.device, &view, nullptr, &transient.view));
+					}
+					else { VK_CHECK(vmaBindBufferMemory2(m_device.allocator, current.allocation, transient.offset, transient.vkBuffer, nullptr)); }
+				}
+			}
+			s_log.debug("render graph slot {}: {} transients in {:.2f}MiB", slot, current.transients.size(), toMiB(current.bytes));
+		}
+
+		m_stats.transients     = static_cast<std::uint32_t>(current.transients.size());
+		m_stats.transientBytes = current.bytes;
+		for (auto const & transient : current.transients) { m_stats.unaliasedBytes += transient.bytes; }
+	}
+
+	void RenderGraph::destroy(Slot & slot)
+	{
+		for (auto const & transient : slot.transients)
+		{
+			vkDestroyImageView(m_device.device, transient.view, nullptr);
+			vkDestroyImage(m_device.device, transient.image, nullptr);
+			vkDestroyBuffer(m_device.device, transient.vkBuffer, nullptr);
+		}
+		if (slot.allocation != nullptr) { vmaFreeMemory(m_device.allocator, slot.allocation); }
+		slot = {};
+	}
+
+	void RenderGraph::buildBarriers()
+	{
+		auto states = std::vector<State>(m_resources.size());
+		for (std::size_t i = 0; i < m_resources.size(); ++i)
+		{
+			auto const & resource = m_resources[i];
+			if (!resource.imported) { continue; }
+			auto & state = states[i];
+			if (resource.kind == Kind::eImage)
+			{
+				state.layout      = resource.image.initialLayout;
+				state.writeStage  = resource.image.initialStage;
+				state.writeAccess = resource.image.initialStage == VK_PIPELINE_STAGE_2_NONE ? VK_ACCESS_2_NONE : VK_ACCESS_2_MEMORY_WRITE_BIT;
+			}
+			else
+			{
+				state.writeStage  = resource.buffer.initialStage;
+				state.writeAccess = resource.buffer.initialAccess;
+			}
+		}
+
+		auto const & transients = m_current->transients;
+		auto const transientOf  = [&](Resource const & resource) -> Transient const & { return transients[resource.physical]; };
+
+		for (std::uint32_t index = 0; index < m_passes.size(); ++index)
+		{
+			auto & pass = m_passes[index];
+			if (!pass.live) { continue; }
+			pass.firstBarrier       = static_cast<std::uint32_t>(m_imageBarriers.size());
+			pass.firstBufferBarrier = static_cast<std::uint32_t>(m_bufferBarriers.size());
+
+			// All uses of a resource within the pass become one access, so they need at most one barrier.
+			std::ranges::stable_sort(pass.uses, std::less{}, &Use::resource);
+			for (auto use = pass.uses.begin(); use != pass.uses.end();)
+			{
+				auto const resourceIndex = use->resource;
+				auto const & resource    = m_resources[resourceIndex];
+				auto stage               = VkPipelineStageFlags2{};
+				auto access              = VkAccessFlags2{};
+				auto layout              = infoOf(use->access).layout;
+				auto write               = false;
+				for (; use != pass.uses.end() && use->resource == resourceIndex; ++use)
+				{
+					auto const & info = infoOf(use->access);
+					stage            |= info.stage;
+					access           |= info.access;
+					write             = write || (use->write && info.write);
+					if (info.layout != layout)
+					{
+						s_log.error("pass '{}' uses '{}' in two layouts, falling back to GENERAL", pass.name, resource.name);
+						layout = VK_IMAGE_LAYOUT_GENERAL;
+					}
+				}
+
+				auto & state = states[resourceIndex];
+				if (!resource.imported && index == resource.firstPass)
+				{
+					// First use of a transient: wait for whatever used its memory before (this frame), then discard.
+					auto const & self = transientOf(resource);
+					for (auto const & other : m_resources)
+					{
+						if (other.imported || other.physical == ~0u || other.lastPass >= resource.firstPass) { continue; }
+						auto const & occupant = transientOf(other);
+						if (occupant.offset < self.offset + self.bytes && self.offset < occupant.offset + occupant.bytes)
+						{
+							auto const & otherState = states[static_cast<std::size_t>(&other - m_resources.data())];
+							state.writeStage |= otherState.writeStage | otherState.readStages;
+						}
+					}
+					state.layout = VK_IMAGE_LAYOUT_UNDEFINED;
+				}
+
+				auto const isImage      = resource.kind == Kind::eImage;
+				auto const changeLayout = isImage && layout != state.layout;
+				auto srcStage           = VkPipelineStageFlags2{};
+				auto srcAccess          = VkAccessFlags2{};
+				auto needed             = false;
+				if (write || changeLayout)
+				{
+					// Exclusive: after the last write (made available) and after every read since (execution only).
+					srcStage  = state.writeStage | state.readStages;
+					srcAccess = state.writeAccess;
+					needed    = changeLayout || srcStage != VK_PIPELINE_STAGE_2_NONE;
+				}
+				else if (state.writeStage != VK_PIPELINE_STAGE_2_NONE && ((stage & ~state.visibleStages) != 0 || (access & ~state.visibleAccess) != 0))
+				{
+					// Read after write not yet made visible to this stage; reads after reads need nothing.
+					srcStage  = state.writeStage;
+					srcAccess = state.writeAccess;
+					needed    = true;
+				}
+
+				if (needed)
+				{
+					if (isImage)
+					{
+						auto const view      = image(Image{resourceIndex});
+						auto barrier          = VkImageMemoryBarrier2{};
+						barrier.sType         = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER_2;
+						barrier.srcStageMask  = srcStage;
+						barrier.srcAccessMask = srcAccess;
+						barrier.dstStageMask  = stage;
+						barrier.dstAccessMask = access;
+						barrier.oldLayout     = state.layout;
+						barrier.newLayout     = layout;
+						barrier.image         = view.image;
+						barrier.subresourceRange = init::imageSubresourceRange(aspectOf(view.format));
+						m_imageBarriers.push_back(barrier);
+					}
+					else
+					{
+						auto barrier          = VkBufferMemoryBarrier2{};
+						barrier.sType         = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER_2;
+						barrier.srcStageMask  = srcStage;
+						barrier.srcAccessMask = srcAccess;
+						barrier.dstStageMask  = stage;
+						barrier.dstAccessMask = access;
+						barrier.buffer        = buffer(Buffer{resourceIndex});
+						barrier.size          = VK_WHOLE_SIZE;
+						m_bufferBarriers.push_back(barrier);
+					}
+				}
+
+				if (isImage) { state.layout = layout; }
+				if (write)
+				{
+					state = {.layout = state.layout, .writeStage = stage, .writeAccess = access};
+				}
+				else if (changeLayout)
+				{
+					// The transition is the last write; it is visible to the stages that waited for it.
+					state = {.layout = state.layout, .writeStage = stage, .readStages = stage, .visibleStages = stage, .visibleAccess = access};
+				}
+				else
+				{
+					state.readStages |= stage;
+					if (needed)
+					{
+						state.visibleStages |= stage;
+						state.visibleAccess |= access;
+					}
+				}
+			}
+
+			pass.imageBarrierCount  = static_cast<std::uint32_t>(m_imageBarriers.size()) - pass.firstBarrier;
+			pass.bufferBarrierCount = static_cast<std::uint32_t>(m_bufferBarriers.size()) - pass.firstBufferBarrier;
+			if (pass.imageBarrierCount + pass.bufferBarrierCount > 0) { ++m_stats.barrierBatches; }
+		}
+
+		// Imports the graph touched go back to where their owner expects them, in one last batch.
+		for (std::size_t i = 0; i < m_resources.size(); ++i)
+		{
+			auto const & resource = m_resources[i];
+			auto const & state    = states[i];
+			if (!resource.imported || resource.kind != Kind::eImage || resource.firstPass > resource.lastPass) { continue; }
+			if (resource.image.finalLayout == VK_IMAGE_LAYOUT_UNDEFINED || resource.image.finalLayout == state.layout) { continue; }
+
+			auto barrier             = VkImageMemoryBarrier2{};
+			barrier.sType            = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER_2;
+			barrier.srcStageMask     = state.writeStage | state.readStages;
+			barrier.srcAccessMask    = state.writeAccess;
+			barrier.dstStageMask     = VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT;
+			barrier.oldLayout        = state.layout;
+			barrier.newLayout        = resource.image.finalLayout;
+			barrier.image            = resource.image.image;
+			barrier.subresourceRange = init::imageSubresourceRange(aspectOf(resource.image.format));
+			m_finalBarriers.push_back(barrier);
+		}
+		if (!m_finalBarriers.empty()) { ++m_stats.barrierBatches; }
+
+		m_stats.imageBarriers  = static_cast<std::uint32_t>(m_imageBarriers.size() + m_finalBarriers.size());
+		m_stats.bufferBarriers = static_cast<std::uint32_t>(m_bufferBarriers.size());
+	}
+
+	void RenderGraph::execute(VkCommandBuffer const cmd) const
+	{
+		auto const barrier = [cmd](std::span<VkImageMemoryBarrier2 const> images, std::span<VkBufferMemoryBarrier2 const> buffers)
+		{
+			if (images.empty() && buffers.empty()) { return; }
+			auto info                     = VkDependencyInfo{};
+			info.sType                    = VK_STRUCTURE_TYPE_DEPENDENCY_INFO;
+			info.imageMemoryBarrierCount  = static_cast<std::uint32_t>(images.size());
+			info.pImageMemoryBarriers     = images.data();
+			info.bufferMemoryBarrierCount = static_cast<std::uint32_t>(buffers.size());
+			info.pBufferMemoryBarriers    = buffers.data();
+			vkCmdPipelineBarrier2(cmd, &info);
+		};
+
+		for (auto const & pass : m_passes)
+		{
+			if (!pass.live) { continue; }
+			barrier(std::span{m_imageBarriers}.subspan(pass.firstBarrier, pass.imageBarrierCount),
+					std::span{m_bufferBarriers}.subspan(pass.firstBufferBarrier, pass.bufferBarrierCount));
+			pass.execute(cmd, *this);
+		}
+		barrier(m_finalBarriers, {});
+	}
+
+	RenderGraph::ImageView RenderGraph::image(Image const image) const
+	{
+		auto const & resource = m_resources[static_cast<std::uint32_t>(image)];
+		assert(resource.kind == Kind::eImage);
+		if (resource.imported) { return {resource.image.image, resource.image.view, resource.image.extent, resource.image.format}; }
+
+		assert(m_current != nullptr && resource.physical != ~0u);
+		auto const & transient = m_current->transients[resource.physical];
+		return {transient.image, transient.view, transient.extent, transient.format};
+	}
+
+	VkBuffer RenderGraph::buffer(Buffer const buffer) const
+	{
+		auto const & resource = m_resources[static_cast<std::uint32_t>(buffer)];
+		assert(resource.kind == Kind::eBuffer);
+		if (resource.imported) { return resource.buffer.buffer; }
+
+		assert(m_current != nullptr && resource.physical != ~0u);
+		return m_current->transients[resource.physical].vkBuffer;
+	}
+
+	std::string RenderGraph::dump() const
+	{
+		auto out = std::string{};
+		auto itr = std::back_inserter(out);
+		std::format_to(itr, "render graph: {} passes ({} culled), {} barrier batches, {} image and {} buffer barriers\n", m_stats.passes, m_stats.culled,
+					   m_stats.barrierBatches, m_stats.imageBarriers, m_stats.bufferBarriers);
+		std::format_to(itr, "  transients: {} in {:.2f}MiB ({:.2f}MiB without aliasing)\n", m_stats.transients, toMiB(m_stats.transientBytes),
+					   toMiB(m_stats.unaliasedBytes));
+
+		for (std::size_t i = 0; i < m_resources.size(); ++i)
+		{
+			auto const & resource = m_resources[i];
+			auto const isImage    = resource.kind == Kind::eImage;
+			auto const size       = isImage ? std::format("{}x{} {}", resource.image.extent.width, resource.image.extent.height, string_VkFormat(resource.image.format))
+											: std::format("{} bytes", resource.buffer.size);
+			std::format_to(itr, "  {} {:>2} '{}' {}", isImage ? "image " : "buffer", i, resource.name, size);
+			if (resource.firstPass > resource.lastPass) { std::format_to(itr, ", unused\n"); }
+			else if (resource.imported) { std::format_to(itr, ", imported, passes {}-{}\n", resource.firstPass, resource.lastPass); }
+			else
+			{
+				auto const & transient = m_current->transients[resource.physical];
+				std::format_to(itr, ", passes {}-{}, at {:#x} +{:#x}\n", resource.firstPass, resource.lastPass, transient.offset, transient.bytes);
+			}
+		}
+
+		auto const nameOf = [&](auto const handle) -> std::string_view
+		{
+			for (std::uint32_t i = 0; i < m_resources.size(); ++i)
+			{
+				auto const & resource = m_resources[i];
+				if (resource.firstPass > resource.lastPass) { continue; }
+				if constexpr (std::is_same_v<decltype(handle), VkImage const>)
+				{
+					if (resource.kind == Kind::eImage && image(Image{i}).image == handle) { return resource.name; }
+				}
+				else if (resource.kind == Kind::eBuffer && buffer(Buffer{i}) == handle) { return resource.name; }
+			}
+			return "?";
+		};
+		auto const imageBarrier = [&](VkImageMemoryBarrier2 const & barrier)
+		{
+			std::format_to(itr, "      '{}' {} -> {}, {} -> {}\n", nameOf(barrier.image), string_VkImageLayout(barrier.oldLayout), string_VkImageLayout(barrier.newLayout),
+						   string_VkPipelineStageFlags2(barrier.srcStageMask), string_VkPipelineStageFlags2(barrier.dstStageMask));
+		};
+
+		for (std::size_t i = 0; i < m_passes.size(); ++i)
+		{
+			auto const & pass = m_passes[i];
+			std::format_to(itr, "  pass {:>2} '{}'{}\n", i, pass.name, pass.live ? "" : " (culled)");
+			if (!pass.live) { continue; }
+			for (auto const & barrier : std::span{m_imageBarriers}.subspan(pass.firstBarrier, pass.imageBarrierCount)) { imageBarrier(barrier); }
+			for (auto const & barrier : std::span{m_bufferBarriers}.subspan(pass.firstBufferBarrier, pass.bufferBarrierCount))
+			{
+				std::format_to(itr, "      '{}', {} -> {}\n", nameOf(barrier.buffer), string_VkPipelineStageFlags2(barrier.srcStageMask),
+							   string_VkPipelineStageFlags2(barrier.dstStageMask));
+			}
+		}
+		if (!m_finalBarriers.empty())
+		{
+			std::format_to(itr, "  final\n");
+			for (auto const & barrier : m_finalBarriers) { imageBarrier(barrier); }
+		}
+		return out;
+	}
+} // namespace bk::gpu
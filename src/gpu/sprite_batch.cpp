@@ -0,0 +1,138 @@
+#include "breakout/gpu/sprite_batch.hpp"
+
+#include <array>
+#include <cassert>
+#include <utility>
+
+namespace bk::gpu
+{
+	namespace
+	{
+		constexpr std::uint32_t radix_bits_v    = 8;
+		constexpr std::uint32_t radix_buckets_v = 1u << radix_bits_v;
+		constexpr std::uint32_t key_digits_v    = 32 / radix_bits_v;
+
+		constexpr std::uint32_t sortKey(Sprite const & sprite)
+		{
+			return static_cast<std::uint32_t>(sprite.layer) << 24u | static_cast<std::uint32_t>(sprite.pipeline) << 16u | sprite.texture;
+		}
+
+		constexpr std::uint32_t digit(std::uint64_t const item, std::uint32_t const pass)
+		{
+			return static_cast<std::uint32_t>(item >> (32u + pass * radix_bits_v)) & (radix_buckets_v - 1);
+		}
+	} // namespace
+
+	void SpriteBatch::reserve(std::size_t const count)
+	{
+		m_instances.reserve(count);
+		m_keys.reserve(count);
+		m_scratch.reserve(count);
+	}
+
+	void SpriteBatch::clear()
+	{
+		m_instances.clear();
+		m_keys.clear();
+		m_draws.clear();
+	}
+
+	void SpriteBatch::submit(Sprite const & sprite)
+	{
+		auto const index = static_cast<std::uint32_t>(m_instances.size());
+		m_instances.push_back({
+			.position = sprite.position,
+			.size     = sprite.size,
+			.uvRect   = sprite.uvRect,
+			.color    = sprite.color,
+			.rotation = sprite.rotation,
+			.texture  = sprite.texture,
+		});
+		m_keys.push_back(static_cast<std::uint64_t>(sortKey(sprite)) << 32u | index);
+	}
+
+	void SpriteBatch::submit(std::span<Sprite const> const sprites, std::span<std::uint32_t const> const visible)
+	{
+		for (auto const index : visible) { submit(sprites[index]); }
+	}
+
+	void SpriteBatch::sort()
+	{
+		// LSD radix sort on the key half, one byte per pass: stable, and linear in the sprite count.
+		auto histograms = std::array<std::array<std::uint32_t, radix_buckets_v>, key_digits_v>{};
+		for (auto const item : m_keys)
+		{
+			for (std::uint32_t pass = 0; pass < key_digits_v; ++pass) { ++histograms[pass][digit(item, pass)]; }
+		}
+
+		m_scratch.resize(m_keys.size());
+		auto const count = static_cast<std::uint32_t>(m_keys.size());
+		for (std::uint32_t pass = 0; pass < key_digits_v; ++pass)
+		{
+			auto & histogram = histograms[pass];
+			// Typically most sprites share a layer and pipeline: nothing to do for those digits.
+			if (histogram[digit(m_keys.front(), pass)] == count) { continue; }
+
+			auto offset = std::uint32_t{};
+			for (auto & bucket : histogram) { offset += std::exchange(bucket, offset); }
+			for (auto const item : m_keys) { m_scratch[histogram[digit(item, pass)]++] = item; }
+			m_keys.swap(m_scratch);
+			++m_stats.sortPasses;
+		}
+	}
+
+	std::span<SpriteBatch::Draw const> SpriteBatch::build(std::span<SpriteInstance> const out)
+	{
+		assert(out.size() >= m_instances.size());
+		m_draws.clear();
+		m_stats = {.sprites = static_cast<std::uint32_t>(m_instances.size())};
+		if (m_instances.empty()) { return {}; }
+
+		sort();
+
+		for (std::uint32_t i = 0; i < m_keys.size(); ++i)
+		{
+			auto const item     = m_keys[i];
+			out[i]              = m_instances[static_cast<std::uint32_t>(item)];
+			auto const key      = static_cast<std::uint32_t>(item >> 32u);
+			auto const pipeline = static_cast<std::uint8_t>(key >> 16u);
+			if (m_draws.empty() || m_draws.back().pipeline != pipeline) { m_draws.push_back({.pipeline = pipeline, .firstInstance = i}); }
+			++m_draws.back().instanceCount;
+		}
+
+		m_stats.draws = static_cast<std::uint32_t>(m_draws.size());
+		return m_draws;
+	}
+
+	void SpriteBatch::record(VkCommandBuffer const cmd, VkPipelineLayout const layout, std::span<VkPipeline const> const pipelines,
+							 glm::mat4 const & viewProj, VkDeviceAddress const instances)
+	{
+		m_stats.pipelineBinds += record(cmd, layout, pipelines, viewProj, instances, m_draws);
+	}
+
+	std::uint32_t SpriteBatch::record(VkCommandBuffer const cmd, VkPipelineLayout const layout, std::span<VkPipeline const> const pipelines,
+									  glm::mat4 const & viewProj, VkDeviceAddress const instances, std::span<Draw const> const draws)
+	{
+		constexpr auto stages_v = VkShaderStageFlags{VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT};
+
+		auto const constants = SpritePushConstants{.viewProj = viewProj, .instances = instances};
+		vkCmdPushConstants(cmd, layout, stages_v, 0, sizeof(constants), &constants);
+
+		auto boundPipeline = VkPipeline{};
+		auto binds         = std::uint32_t{};
+		for (auto const & draw : draws)
+		{
+			assert(draw.pipeline < pipelines.size());
+			if (auto const pipeline = pipelines[draw.pipeline]; pipeline != boundPipeline)
+			{
+				vkCmdBindPipeline(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, pipeline);
+				boundPipeline = pipeline;
+				++binds;
+			}
+
+			// Two triangles per instance, corners generated from gl_VertexIndex.
+			vkCmdDraw(cmd, 6, draw.instanceCount, 0, draw.firstInstance);
+		}
+		return binds;
+	}
+} // namespace bk::gpu
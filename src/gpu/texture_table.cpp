@@ -0,0 +1,207 @@
+#include "breakout/gpu/texture_table.hpp"
+
+#include <algorithm>
+#include <cassert>
+
+#include "breakout/core/logger.hpp"
+#include "breakout/gpu/vk_device.hpp"
+
+namespace bk::gpu
+{
+	namespace
+	{
+		auto const s_log = Logger{"gpu"};
+
+		std::uint32_t maxCapacity(Device const & device)
+		{
+			auto properties12  = VkPhysicalDeviceVulkan12Properties{};
+			properties12.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_PROPERTIES;
+
+			auto properties  = VkPhysicalDeviceProperties2{};
+			properties.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2;
+			properties.pNext = &properties12;
+			vkGetPhysicalDeviceProperties2(device.physicalDevice, &properties);
+
+			return std::min({properties12.maxPerStageDescriptorUpdateAfterBindSampledImages, properties12.maxPerStageDescriptorUpdateAfterBindSamplers,
+							 properties12.maxDescriptorSetUpdateAfterBindSampledImages, properties12.maxDescriptorSetUpdateAfterBindSamplers});
+		}
+
+		VkSampler createSampler(VkDevice const device, VkFilter const filter)
+		{
+			auto info         = VkSamplerCreateInfo{};
+			info.sType        = VK_STRUCTURE_TYPE_SAMPLER_CREATE_INFO;
+			info.magFilter    = filter;
+			info.minFilter    = filter;
+			info.mipmapMode   = filter == VK_FILTER_LINEAR ? VK_SAMPLER_MIPMAP_MODE_LINEAR : VK_SAMPLER_MIPMAP_MODE_NEAREST;
+			info.addressModeU = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+			info.addressModeV = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+			info.addressModeW = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+			info.maxLod       = VK_LOD_CLAMP_NONE;
+
+			auto ret = VkSampler{};
+			VK_CHECK(vkCreateSampler(device, &info, nullptr, &ret));
+			return ret;
+		}
+	} // namespace
+
+	TextureTable::TextureTable(Device const & device, Config const & config)
+	: m_device(device.device), m_frameCount(config.frameCount), m_capacity(std::min(config.capacity, maxCapacity(device)))
+	{
+		assert(m_capacity > default_slot_v + 1);
+
+		constexpr auto binding_flags_v = VkDescriptorBindingFlags{VK_DESCRIPTOR_BINDING_UPDATE_AFTER_BIND_BIT | VK_DESCRIPTOR_BINDING_PARTIALLY_BOUND_BIT |
+																  VK_DESCRIPTOR_BINDING_UPDATE_UNUSED_WHILE_PENDING_BIT};
+
+		auto binding            = VkDescriptorSetLayoutBinding{};
+		binding.binding         = 0;
+		binding.descriptorType  = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+		binding.descriptorCount = m_capacity;
+		binding.stageFlags      = VK_SHADER_STAGE_FRAGMENT_BIT;
+
+		auto bindingFlags          = VkDescriptorSetLayoutBindingFlagsCreateInfo{};
+		bindingFlags.sType         = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_BINDING_FLAGS_CREATE_INFO;
+		bindingFlags.bindingCount  = 1;
+		bindingFlags.pBindingFlags = &binding_flags_v;
+
+		auto layoutInfo         = VkDescriptorSetLayoutCreateInfo{};
+		layoutInfo.sType        = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+		layoutInfo.pNext        = &bindingFlags;
+		layoutInfo.flags        = VK_DESCRIPTOR_SET_LAYOUT_CREATE_UPDATE_AFTER_BIND_POOL_BIT;
+		layoutInfo.bindingCount = 1;
+		layoutInfo.pBindings    = &binding;
+		VK_CHECK(vkCreateDescriptorSetLayout(m_device, &layoutInfo, nullptr, &m_layout));
+
+		auto const poolSize    = VkDescriptorPoolSize{VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, m_capacity};
+		auto poolInfo          = VkDescriptorPoolCreateInfo{};
+		poolInfo.sType         = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+		poolInfo.flags         = VK_DESCRIPTOR_POOL_CREATE_UPDATE_AFTER_BIND_BIT;
+		poolInfo.maxSets       = 1;
+		poolInfo.poolSizeCount = 1;
+		poolInfo.pPoolSizes    = &poolSize;
+		VK_CHECK(vkCreateDescriptorPool(m_device, &poolInfo, nullptr, &m_pool));
+
+		auto allocInfo               = VkDescriptorSetAllocateInfo{};
+		allocInfo.sType              = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+		allocInfo.descriptorPool     = m_pool;
+		allocInfo.descriptorSetCount = 1;
+		allocInfo.pSetLayouts        = &m_layout;
+		VK_CHECK(vkAllocateDescriptorSets(m_device, &allocInfo, &m_set));
+
+		m_samplers[static_cast<std::size_t>(Sampler::eLinear)]  = createSampler(m_device, VK_FILTER_LINEAR);
+		m_samplers[static_cast<std::size_t>(Sampler::eNearest)] = createSampler(m_device, VK_FILTER_NEAREST);
+
+		// Handed out lowest first, which keeps the used range dense.
+		m_free.reserve(m_capacity - 1);
+		for (auto slot = m_capacity - 1; slot > default_slot_v; --slot) { m_free.push_back(slot); }
+
+		s_log.info("texture table: {} slots", m_capacity);
+	}
+
+	TextureTable::~TextureTable()
+	{
+		// Retired slots are expected here (their owners go with m_retired); anything else was never given back.
+		if (auto const leaked = m_used - getStats().retiring; leaked > 0) { s_log.warn("texture table destroyed with {} slots still allocated", leaked); }
+		for (auto const sampler : m_samplers) { vkDestroySampler(m_device, sampler, nullptr); }
+		vkDestroyDescriptorPool(m_device, m_pool, nullptr);
+		vkDestroyDescriptorSetLayout(m_device, m_layout, nullptr);
+	}
+
+	void TextureTable::write(std::uint32_t const slot, VkImageView const view, Sampler const sampler) const
+	{
+		auto const image = VkDescriptorImageInfo{m_samplers[static_cast<std::size_t>(sampler)], view, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL};
+
+		auto write            = VkWriteDescriptorSet{};
+		write.sType           = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+		write.dstSet          = m_set;
+		write.dstArrayElement = slot;
+		write.descriptorCount = 1;
+		write.descriptorType  = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+		write.pImageInfo      = &image;
+		vkUpdateDescriptorSets(m_device, 1, &write, 0, nullptr);
+	}
+
+	void TextureTable::setDefault(VkImageView const view)
+	{
+		auto const lock = std::scoped_lock{m_mutex};
+		m_default       = view;
+
+		// Every slot not handed out yet, in one write.
+		auto images = std::vector<VkDescriptorImageInfo>(m_capacity, {m_samplers[0], view, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL});
+
+		auto write            = VkWriteDescriptorSet{};
+		write.sType           = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+		write.dstSet          = m_set;
+		write.descriptorCount = m_capacity;
+		write.descriptorType  = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+		write.pImageInfo      = images.data();
+		assert(m_used == 0);
+		vkUpdateDescriptorSets(m_device, 1, &write, 0, nullptr);
+	}
+
+	std::optional<std::uint32_t> TextureTable::allocate(VkImageView const view, Sampler const sampler)
+	{
+		auto const lock = std::scoped_lock{m_mutex};
+		if (m_free.empty())
+		{
+			s_log.error("texture table is full ({} slots)", m_capacity);
+			return {};
+		}
+
+		auto const slot = m_free.back();
+		m_free.pop_back();
+		m_highWater = std::max(m_highWater, ++m_used);
+		write(slot, view, sampler);
+		return slot;
+	}
+
+	void TextureTable::free(std::uint32_t const slot)
+	{
+		assert(slot != default_slot_v && slot < m_capacity);
+		if (m_default != VK_NULL_HANDLE) { write(slot, m_default, Sampler::eLinear); }
+		m_free.push_back(slot);
+		--m_used;
+	}
+
+	void TextureTable::release(std::span<std::uint32_t const> const slots)
+	{
+		auto const lock = std::scoped_lock{m_mutex};
+		for (auto const slot : slots) { free(slot); }
+	}
+
+	void TextureTable::retire(std::span<std::uint32_t const> const slots, std::shared_ptr<void const> keepAlive)
+	{
+		if (slots.empty()) { return; }
+		auto const lock = std::scoped_lock{m_mutex};
+		m_retired.push_back({.frame = m_frame, .slots = {slots.begin(), slots.end()}, .keepAlive = std::move(keepAlive)});
+	}
+
+	void TextureTable::beginFrame(std::uint64_t const frame)
+	{
+		auto released = std::vector<std::shared_ptr<void const>>{};
+		{
+			auto const lock = std::scoped_lock{m_mutex};
+			m_frame         = frame;
+			auto const done = std::ranges::partition(m_retired, [&](Retired const & retired) { return retired.frame + m_frameCount > frame; });
+			for (auto & retired : done)
+			{
+				for (auto const slot : retired.slots) { free(slot); }
+				released.push_back(std::move(retired.keepAlive));
+			}
+			m_retired.erase(done.begin(), done.end());
+		}
+		// Owners (images, views) are destroyed here, outside the lock.
+	}
+
+	void TextureTable::bind(VkCommandBuffer const cmd, VkPipelineLayout const layout, std::uint32_t const set) const
+	{
+		vkCmdBindDescriptorSets(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, layout, set, 1, &m_set, 0, nullptr);
+	}
+
+	TextureTable::Stats TextureTable::getStats() const
+	{
+		auto const lock = std::scoped_lock{m_mutex};
+		auto retiring   = std::uint32_t{};
+		for (auto const & retired : m_retired) { retiring += static_cast<std::uint32_t>(retired.slots.size()); }
+		return {.capacity = m_capacity, .used = m_used, .highWater = m_highWater, .retiring = retiring};
+	}
+} // namespace bk::gpu
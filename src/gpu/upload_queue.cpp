@@ -0,0 +1,500 @@
+#include "breakout/gpu/upload_queue.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+#include <functional>
+#include <limits>
+#include <map>
+#include <utility>
+
+#include "breakout/core/logger.hpp"
+#include "breakout/gpu/vk_device.hpp"
+
+namespace bk::gpu
+{
+	namespace
+	{
+		auto const s_log = Logger{"uploads"};
+
+		constexpr VkDeviceSize alignUp(VkDeviceSize const value, VkDeviceSize const alignment)
+		{
+			return (value + alignment - 1) / alignment * alignment;
+		}
+
+		VkImageSubresourceRange mipZero(VkImageAspectFlags const aspect)
+		{
+			auto ret       = VkImageSubresourceRange{};
+			ret.aspectMask = aspect;
+			ret.levelCount = 1;
+			ret.layerCount = 1;
+			return ret;
+		}
+
+		// Start of a range written within a batch, ordered by buffer and then offset.
+		struct Written
+		{
+			VkBuffer buffer{};
+			VkDeviceSize offset{};
+
+			bool operator<(Written const & other) const
+			{
+				if (buffer != other.buffer) { return std::less<>{}(buffer, other.buffer); }
+				return offset < other.offset;
+			}
+		};
+
+		VmaAllocationCreateInfo stagingAllocationInfo()
+		{
+			auto ret  = VmaAllocationCreateInfo{};
+			ret.usage = VMA_MEMORY_USAGE_AUTO_PREFER_HOST;
+			ret.flags = VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT | VMA_ALLOCATION_CREATE_MAPPED_BIT;
+			return ret;
+		}
+
+		VkBufferCreateInfo stagingBufferInfo(VkDeviceSize const size)
+		{
+			auto ret  = VkBufferCreateInfo{};
+			ret.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+			ret.size  = size;
+			ret.usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
+			return ret;
+		}
+	} // namespace
+
+	UploadQueue::UploadQueue(Device const & device, Config const & config)
+	: m_device(device.device), m_allocator(device.allocator), m_queue(device.transferQueue), m_family(device.transferQueueFamily),
+	  m_graphicsFamily(device.graphicsQueueFamily)
+	{
+		// Satisfies the texel size and 4 byte rules for image copies of every format we use.
+		m_copyAlignment = std::max(device.properties.limits.optimalBufferCopyOffsetAlignment, VkDeviceSize{16});
+		m_capacity      = alignUp(config.stagingCapacity, m_copyAlignment);
+
+		auto const bufferInfo = stagingBufferInfo(m_capacity);
+		auto const allocInfo  = stagingAllocationInfo();
+		auto info             = VmaAllocationInfo{};
+		VK_CHECK(vmaCreateBuffer(m_allocator, &bufferInfo, &allocInfo, &m_ring, &m_ringAllocation, &info));
+		m_ringData = static_cast<std::byte *>(info.pMappedData);
+
+		auto timelineInfo          = VkSemaphoreTypeCreateInfo{};
+		timelineInfo.sType         = VK_STRUCTURE_TYPE_SEMAPHORE_TYPE_CREATE_INFO;
+		timelineInfo.semaphoreType = VK_SEMAPHORE_TYPE_TIMELINE;
+		auto semaphoreInfo         = VkSemaphoreCreateInfo{};
+		semaphoreInfo.sType        = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
+		semaphoreInfo.pNext        = &timelineInfo;
+		VK_CHECK(vkCreateSemaphore(m_device, &semaphoreInfo, nullptr, &m_semaphore));
+	}
+
+	UploadQueue::~UploadQueue()
+	{
+		auto const last = m_nextValue - 1;
+		if (last > m_completed) { wait(UploadTicket{last}); }
+		poll();
+		assert(m_inFlight.empty());
+
+		auto const stats = getStats();
+		s_log.info("uploaded {:.1f}MB in {} batches ({:.1f}MB overflowed the ring) at {:.0f}MB/s, worst frame stall {:.3f}ms",
+				   static_cast<double>(stats.bytes) / 1e6, stats.batches, static_cast<double>(stats.overflowBytes) / 1e6, stats.throughputMBps,
+				   std::chrono::duration<double, std::milli>{stats.maxStall}.count());
+
+		for (auto const & dedicated : m_pendingDedicated) { vmaDestroyBuffer(m_allocator, dedicated.buffer, dedicated.allocation); }
+		for (auto const & batch : m_free) { vkDestroyCommandPool(m_device, batch.pool, nullptr); }
+		vkDestroySemaphore(m_device, m_semaphore, nullptr);
+		vmaDestroyBuffer(m_allocator, m_ring, m_ringAllocation);
+	}
+
+	UploadQueue::Staging UploadQueue::reserve(VkDeviceSize const size, VkDeviceSize const alignment)
+	{
+		{
+			auto lock   = std::scoped_lock{m_mutex};
+			auto offset = alignUp(m_head, alignment);
+			// Never split a range across the end of the ring: skip to the start instead.
+			if (auto const physical = offset % m_capacity; physical + size > m_capacity) { offset += m_capacity - physical; }
+			if (size <= m_capacity && offset + size - m_tail <= m_capacity)
+			{
+				m_head = offset + size;
+				++m_writers;
+				auto const physical = offset % m_capacity;
+				return {.buffer = m_ring, .offset = physical, .data = m_ringData + physical};
+			}
+		}
+
+		// The ring is full of data the GPU has not consumed yet (or the upload is larger than the ring): stage it on its own
+		// rather than wait.
+		auto const bufferInfo = stagingBufferInfo(size);
+		auto const allocInfo  = stagingAllocationInfo();
+		auto ret              = Staging{};
+		auto info             = VmaAllocationInfo{};
+		VK_CHECK(vmaCreateBuffer(m_allocator, &bufferInfo, &allocInfo, &ret.dedicated.buffer, &ret.dedicated.allocation, &info));
+		ret.buffer = ret.dedicated.buffer;
+		ret.data   = static_cast<std::byte *>(info.pMappedData);
+		return ret;
+	}
+
+	UploadTicket UploadQueue::push(Copy const & copy, Dedicated const dedicated)
+	{
+		auto lock = std::scoped_lock{m_mutex};
+		m_pending.push_back(copy);
+		if (dedicated.buffer != VK_NULL_HANDLE)
+		{
+			m_pendingDedicated.push_back(dedicated);
+			m_stats.overflowBytes += copy.size;
+		}
+		else if (--m_writers == 0) { m_writersDone.notify_all(); }
+		++m_stats.uploads;
+		return UploadTicket{m_nextValue};
+	}
+
+	UploadTicket UploadQueue::upload(std::span<std::byte const> const data, VkBuffer const dst, VkDeviceSize const dstOffset)
+	{
+		if (data.empty()) { return UploadTicket{}; }
+
+		auto const staging = reserve(data.size(), 4);
+		std::memcpy(staging.data, data.data(), data.size());
+		return push({.staging = staging.buffer, .stagingOffset = staging.offset, .size = data.size(), .dstBuffer = dst, .dstOffset = dstOffset},
+					staging.dedicated);
+	}
+
+	UploadTicket UploadQueue::upload(std::span<std::byte const> const data, VkImage const dst, VkExtent3D const extent,
+									 VkImageLayout const finalLayout, VkImageAspectFlags const aspect)
+	{
+		if (data.empty()) { return UploadTicket{}; }
+
+		auto const staging = reserve(data.size(), m_copyAlignment);
+		std::memcpy(staging.data, data.data(), data.size());
+		return push({.staging       = staging.buffer,
+					 .stagingOffset = staging.offset,
+					 .size          = data.size(),
+					 .dstImage      = dst,
+					 .extent        = extent,
+					 .finalLayout   = finalLayout,
+					 .aspect        = aspect},
+					staging.dedicated);
+	}
+
+	UploadTicket UploadQueue::submit()
+	{
+		auto const start = Clock::now();
+		auto copies      = std::vector<Copy>{};
+		auto dedicated   = std::vector<Dedicated>{};
+		auto value       = std::uint64_t{};
+		auto ringEnd     = VkDeviceSize{};
+		{
+			// Every reserved range has to hold its data before the batch claims the ring up to m_head.
+			auto lock = std::unique_lock{m_mutex};
+			m_writersDone.wait(lock, [this] { return m_writers == 0; });
+			if (m_pending.empty()) { return UploadTicket{m_nextValue - 1}; }
+
+			copies.swap(m_pending);
+			dedicated.swap(m_pendingDedicated);
+			value   = m_nextValue++;
+			ringEnd = m_head;
+		}
+
+		auto batch      = acquireBatch();
+		batch.value     = value;
+		batch.ringEnd   = ringEnd;
+		batch.dedicated = std::move(dedicated);
+
+		record(batch, copies);
+
+		auto cmdInfo          = VkCommandBufferSubmitInfo{};
+		cmdInfo.sType         = VK_STRUCTURE_TYPE_COMMAND_BUFFER_SUBMIT_INFO;
+		cmdInfo.commandBuffer = batch.cmd;
+
+		auto signalInfo      = VkSemaphoreSubmitInfo{};
+		signalInfo.sType     = VK_STRUCTURE_TYPE_SEMAPHORE_SUBMIT_INFO;
+		signalInfo.semaphore = m_semaphore;
+		signalInfo.value     = batch.value;
+		signalInfo.stageMask = VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT;
+
+		auto submitInfo                     = VkSubmitInfo2{};
+		submitInfo.sType                    = VK_STRUCTURE_TYPE_SUBMIT_INFO_2;
+		submitInfo.commandBufferInfoCount   = 1;
+		submitInfo.pCommandBufferInfos      = &cmdInfo;
+		submitInfo.signalSemaphoreInfoCount = 1;
+		submitInfo.pSignalSemaphoreInfos    = &signalInfo;
+		VK_CHECK(vkQueueSubmit2(m_queue, 1, &submitInfo, VK_NULL_HANDLE));
+
+		batch.submitted   = Clock::now();
+		auto const ticket = UploadTicket{batch.value};
+		auto const bytes  = batch.bytes;
+		m_inFlight.push_back(std::move(batch));
+
+		auto const stall = Clock::now() - start;
+		auto lock        = std::scoped_lock{m_mutex};
+		m_stats.batches    += 1;
+		m_stats.bytes      += bytes;
+		m_stats.lastStall   = stall;
+		m_stats.maxStall    = std::max(m_stats.maxStall, stall);
+		m_stats.totalStall += stall;
+		return ticket;
+	}
+
+	void UploadQueue::record(Batch & batch, std::span<Copy> const copies) const
+	{
+		VK_CHECK(vkResetCommandPool(m_device, batch.pool, 0));
+		auto beginInfo  = VkCommandBufferBeginInfo{};
+		beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+		beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+		VK_CHECK(vkBeginCommandBuffer(batch.cmd, &beginInfo));
+
+		auto const release = m_family != m_graphicsFamily;
+		auto const ring    = m_ring;
+
+		// Both kinds stay in submission order: a later upload to the same destination has to land last.
+		auto const bufferEnd = std::ranges::stable_partition(copies, [](Copy const & copy) { return copy.dstBuffer != VK_NULL_HANDLE; }).begin();
+		auto const buffers   = std::span{copies.begin(), bufferEnd};
+		auto const images    = std::span{bufferEnd, copies.end()};
+
+		for (auto const & copy : copies)
+		{
+			batch.bytes += copy.size;
+			if (copy.staging == ring) { VK_CHECK(vmaFlushAllocation(m_allocator, m_ringAllocation, copy.stagingOffset, copy.size)); }
+		}
+		for (auto const & dedicated : batch.dedicated) { VK_CHECK(vmaFlushAllocation(m_allocator, dedicated.allocation, 0, VK_WHOLE_SIZE)); }
+
+		auto imageBarriers = std::vector<VkImageMemoryBarrier2>{};
+		imageBarriers.reserve(images.size());
+		for (auto const & copy : images)
+		{
+			auto & barrier              = imageBarriers.emplace_back();
+			barrier.sType               = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER_2;
+			barrier.dstStageMask        = VK_PIPELINE_STAGE_2_COPY_BIT;
+			barrier.dstAccessMask       = VK_ACCESS_2_TRANSFER_WRITE_BIT;
+			barrier.oldLayout           = VK_IMAGE_LAYOUT_UNDEFINED;
+			barrier.newLayout           = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+			barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+			barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+			barrier.image               = copy.dstImage;
+			barrier.subresourceRange    = mipZero(copy.aspect);
+		}
+		auto dependency                    = VkDependencyInfo{};
+		dependency.sType                   = VK_STRUCTURE_TYPE_DEPENDENCY_INFO;
+		dependency.imageMemoryBarrierCount = static_cast<std::uint32_t>(imageBarriers.size());
+		dependency.pImageMemoryBarriers    = imageBarriers.data();
+		if (!imageBarriers.empty()) { vkCmdPipelineBarrier2(batch.cmd, &dependency); }
+
+		// Consecutive copies between the same buffers go out as one command. Vulkan orders neither the regions of one
+		// command nor separate copies without a barrier, so a copy overlapping anything written since the last barrier
+		// starts a new command behind a transfer barrier.
+		auto regions       = std::vector<VkBufferCopy>{};
+		auto written       = std::map<Written, VkDeviceSize>{}; // Disjoint ranges since the last barrier: start to end
+		Copy const * group = nullptr;
+		auto const flush   = [&]
+		{
+			if (regions.empty()) { return; }
+			vkCmdCopyBuffer(batch.cmd, group->staging, group->dstBuffer, static_cast<std::uint32_t>(regions.size()), regions.data());
+			regions.clear();
+		};
+		for (auto const & copy : buffers)
+		{
+			// Only the range starting last before this one ends can overlap it, as the ranges are disjoint.
+			auto const end      = copy.dstOffset + copy.size;
+			auto const next     = written.lower_bound({copy.dstBuffer, end});
+			auto const overlaps = next != written.begin() && std::prev(next)->first.buffer == copy.dstBuffer && std::prev(next)->second > copy.dstOffset;
+			if (overlaps)
+			{
+				flush();
+				auto barrier          = VkMemoryBarrier2{};
+				barrier.sType         = VK_STRUCTURE_TYPE_MEMORY_BARRIER_2;
+				barrier.srcStageMask  = VK_PIPELINE_STAGE_2_COPY_BIT;
+				barrier.srcAccessMask = VK_ACCESS_2_TRANSFER_WRITE_BIT;
+				barrier.dstStageMask  = VK_PIPELINE_STAGE_2_COPY_BIT;
+				barrier.dstAccessMask = VK_ACCESS_2_TRANSFER_WRITE_BIT;
+
+				auto writes               = VkDependencyInfo{};
+				writes.sType              = VK_STRUCTURE_TYPE_DEPENDENCY_INFO;
+				writes.memoryBarrierCount = 1;
+				writes.pMemoryBarriers    = &barrier;
+				vkCmdPipelineBarrier2(batch.cmd, &writes);
+				written.clear();
+			}
+			else if (group != nullptr && (copy.staging != group->staging || copy.dstBuffer != group->dstBuffer)) { flush(); }
+
+			group = &copy;
+			regions.push_back({.srcOffset = copy.stagingOffset, .dstOffset = copy.dstOffset, .size = copy.size});
+			written.emplace(Written{copy.dstBuffer, copy.dstOffset}, end);
+		}
+		flush();
+
+		for (auto const & copy : images)
+		{
+			auto region                        = VkBufferImageCopy{};
+			region.bufferOffset                = copy.stagingOffset;
+			region.imageSubresource.aspectMask = copy.aspect;
+			region.imageSubresource.layerCount = 1;
+			region.imageExtent                 = copy.extent;
+			vkCmdCopyBufferToImage(batch.cmd, copy.staging, copy.dstImage, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &region);
+		}
+
+		// Hand the results over: a release to the graphics family (matched by recordAcquires), or a plain transition.
+		imageBarriers.clear();
+		for (auto const & copy : images)
+		{
+			auto & barrier              = imageBarriers.emplace_back();
+			barrier.sType               = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER_2;
+			barrier.srcStageMask        = VK_PIPELINE_STAGE_2_COPY_BIT;
+			barrier.srcAccessMask       = VK_ACCESS_2_TRANSFER_WRITE_BIT;
+			barrier.dstStageMask        = release ? VK_PIPELINE_STAGE_2_NONE : VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT;
+			barrier.dstAccessMask       = release ? VK_ACCESS_2_NONE : VK_ACCESS_2_MEMORY_READ_BIT;
+			barrier.oldLayout           = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+			barrier.newLayout           = copy.finalLayout;
+			barrier.srcQueueFamilyIndex = release ? m_family : VK_QUEUE_FAMILY_IGNORED;
+			barrier.dstQueueFamilyIndex = release ? m_graphicsFamily : VK_QUEUE_FAMILY_IGNORED;
+			barrier.image               = copy.dstImage;
+			barrier.subresourceRange    = mipZero(copy.aspect);
+		}
+
+		auto bufferBarriers = std::vector<VkBufferMemoryBarrier2>{};
+		if (release)
+		{
+			for (auto const & copy : buffers)
+			{
+				auto & barrier              = bufferBarriers.emplace_back();
+				barrier.sType               = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER_2;
+				barrier.srcStageMask        = VK_PIPELINE_STAGE_2_COPY_BIT;
+				barrier.srcAccessMask       = VK_ACCESS_2_TRANSFER_WRITE_BIT;
+				barrier.srcQueueFamilyIndex = m_family;
+				barrier.dstQueueFamilyIndex = m_graphicsFamily;
+				barrier.buffer              = copy.dstBuffer;
+				barrier.offset              = copy.dstOffset;
+				barrier.size                = copy.size;
+			}
+		}
+
+		dependency.bufferMemoryBarrierCount = static_cast<std::uint32_t>(bufferBarriers.size());
+		dependency.pBufferMemoryBarriers    = bufferBarriers.data();
+		dependency.imageMemoryBarrierCount  = static_cast<std::uint32_t>(imageBarriers.size());
+		dependency.pImageMemoryBarriers     = imageBarriers.data();
+		if (!bufferBarriers.empty() || !imageBarriers.empty()) { vkCmdPipelineBarrier2(batch.cmd, &dependency); }
+		VK_CHECK(vkEndCommandBuffer(batch.cmd));
+
+		if (release)
+		{
+			// The acquire repeats the release's ownership transfer and layouts, with the graphics side's scopes.
+			for (auto barrier : bufferBarriers)
+			{
+				barrier.srcStageMask  = VK_PIPELINE_STAGE_2_NONE;
+				barrier.srcAccessMask = VK_ACCESS_2_NONE;
+				barrier.dstStageMask  = VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT;
+				barrier.dstAccessMask = VK_ACCESS_2_MEMORY_READ_BIT;
+				batch.bufferAcquires.push_back(barrier);
+			}
+			for (auto barrier : imageBarriers)
+			{
+				barrier.srcStageMask  = VK_PIPELINE_STAGE_2_NONE;
+				barrier.srcAccessMask = VK_ACCESS_2_NONE;
+				barrier.dstStageMask  = VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT;
+				barrier.dstAccessMask = VK_ACCESS_2_MEMORY_READ_BIT;
+				batch.imageAcquires.push_back(barrier);
+			}
+		}
+	}
+
+	void UploadQueue::poll()
+	{
+		VK_CHECK(vkGetSemaphoreCounterValue(m_device, m_semaphore, &m_completed));
+		while (!m_inFlight.empty() && m_inFlight.front().value <= m_completed)
+		{
+			retire(m_inFlight.front());
+			m_free.push_back(std::move(m_inFlight.front()));
+			m_inFlight.pop_front();
+		}
+	}
+
+	void UploadQueue::retire(Batch & batch)
+	{
+		// Completion is only observed once per frame, so this overestimates how long the copies took.
+		m_busyTime  += Clock::now() - batch.submitted;
+		m_busyBytes += batch.bytes;
+
+		for (auto const & dedicated : batch.dedicated) { vmaDestroyBuffer(m_allocator, dedicated.buffer, dedicated.allocation); }
+		batch.dedicated.clear();
+		m_bufferAcquires.insert(m_bufferAcquires.end(), batch.bufferAcquires.begin(), batch.bufferAcquires.end());
+		m_imageAcquires.insert(m_imageAcquires.end(), batch.imageAcquires.begin(), batch.imageAcquires.end());
+		batch.bufferAcquires.clear();
+		batch.imageAcquires.clear();
+		batch.bytes = 0;
+
+		auto lock = std::scoped_lock{m_mutex};
+		m_tail    = std::max(m_tail, batch.ringEnd);
+	}
+
+	UploadQueue::Batch UploadQueue::acquireBatch()
+	{
+		if (!m_free.empty())
+		{
+			auto ret = std::move(m_free.back());
+			m_free.pop_back();
+			return ret;
+		}
+
+		auto ret                  = Batch{};
+		auto poolInfo             = VkCommandPoolCreateInfo{};
+		poolInfo.sType            = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+		poolInfo.flags            = VK_COMMAND_POOL_CREATE_TRANSIENT_BIT;
+		poolInfo.queueFamilyIndex = m_family;
+		VK_CHECK(vkCreateCommandPool(m_device, &poolInfo, nullptr, &ret.pool));
+
+		auto allocInfo               = VkCommandBufferAllocateInfo{};
+		allocInfo.sType              = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+		allocInfo.commandPool        = ret.pool;
+		allocInfo.level              = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+		allocInfo.commandBufferCount = 1;
+		VK_CHECK(vkAllocateCommandBuffers(m_device, &allocInfo, &ret.cmd));
+		return ret;
+	}
+
+	void UploadQueue::wait(UploadTicket const ticket)
+	{
+		auto const value = static_cast<std::uint64_t>(ticket);
+		if (value <= m_completed) { return; }
+
+		auto submitted = false;
+		{
+			auto lock = std::scoped_lock{m_mutex};
+			submitted = value < m_nextValue;
+		}
+		if (!submitted) { submit(); }
+
+		auto waitInfo           = VkSemaphoreWaitInfo{};
+		waitInfo.sType          = VK_STRUCTURE_TYPE_SEMAPHORE_WAIT_INFO;
+		waitInfo.semaphoreCount = 1;
+		waitInfo.pSemaphores    = &m_semaphore;
+		waitInfo.pValues        = &value;
+		VK_CHECK(vkWaitSemaphores(m_device, &waitInfo, std::numeric_limits<std::uint64_t>::max()));
+		poll();
+	}
+
+	std::uint64_t UploadQueue::recordAcquires(VkCommandBuffer const cmd)
+	{
+		if (!m_bufferAcquires.empty() || !m_imageAcquires.empty())
+		{
+			auto dependency                     = VkDependencyInfo{};
+			dependency.sType                    = VK_STRUCTURE_TYPE_DEPENDENCY_INFO;
+			dependency.bufferMemoryBarrierCount = static_cast<std::uint32_t>(m_bufferAcquires.size());
+			dependency.pBufferMemoryBarriers    = m_bufferAcquires.data();
+			dependency.imageMemoryBarrierCount  = static_cast<std::uint32_t>(m_imageAcquires.size());
+			dependency.pImageMemoryBarriers     = m_imageAcquires.data();
+			vkCmdPipelineBarrier2(cmd, &dependency);
+			m_bufferAcquires.clear();
+			m_imageAcquires.clear();
+		}
+
+		// Host observed completion does not order device work: the graphics submission still waits on the (reached) value.
+		return m_completed;
+	}
+
+	UploadQueue::Stats UploadQueue::getStats() const
+	{
+		auto ret = [this]
+		{
+			auto lock = std::scoped_lock{m_mutex};
+			return m_stats;
+		}();
+		auto const seconds = std::chrono::duration<double>{m_busyTime}.count();
+		ret.throughputMBps = seconds > 0.0 ? static_cast<double>(m_busyBytes) / 1e6 / seconds : 0.0;
+		return ret;
+	}
+} // namespace bk::gpu
@@ -0,0 +1,128 @@
+#include "breakout/gpu/vk_device.hpp"
+
+#include <SDL3/SDL_vulkan.h>
+
+#include <VkBootstrap.h>
+
+#include "breakout/core/logger.hpp"
+
+namespace bk::gpu
+{
+	namespace
+	{
+		auto const s_log = Logger{"gpu"};
+	} // namespace
+
+	std::unique_ptr<Device> Device::create(DeviceConfig const & config)
+	{
+		auto const headless = config.window == nullptr;
+
+		auto instanceResult = vkb::InstanceBuilder{}
+								  .set_app_name(config.appName.data())
+								  .request_validation_layers(config.enableValidationLayers)
+								  .use_default_debug_messenger()
+								  .require_api_version(1, 3, 0)
+								  .set_headless(headless)
+								  .build();
+		if (!instanceResult)
+		{
+			s_log.error("failed to create Vulkan instance: {}", instanceResult.error().message());
+			return {};
+		}
+
+		auto ret            = std::make_unique<Device>();
+		auto const instance = instanceResult.value();
+		ret->instance       = instance.instance;
+		ret->debugMessenger = instance.debug_messenger;
+
+		if (!headless && !SDL_Vulkan_CreateSurface(config.window, ret->instance, nullptr, &ret->surface))
+		{
+			s_log.error("failed to create window surface: {}", SDL_GetError());
+			return {};
+		}
+
+		auto features13             = VkPhysicalDeviceVulkan13Features{};
+		features13.sType            = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_3_FEATURES;
+		features13.synchronization2 = VK_TRUE;
+		features13.dynamicRendering = VK_TRUE;
+
+		auto features12                                         = VkPhysicalDeviceVulkan12Features{};
+		features12.sType                                        = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_FEATURES;
+		features12.bufferDeviceAddress                          = VK_TRUE;
+		features12.timelineSemaphore                            = VK_TRUE;
+		features12.descriptorIndexing                           = VK_TRUE; // TextureTable
+		features12.runtimeDescriptorArray                       = VK_TRUE;
+		features12.descriptorBindingPartiallyBound              = VK_TRUE;
+		features12.descriptorBindingSampledImageUpdateAfterBind = VK_TRUE;
+		features12.descriptorBindingUpdateUnusedWhilePending    = VK_TRUE;
+		features12.shaderSampledImageArrayNonUniformIndexing    = VK_TRUE;
+
+		auto selector = vkb::PhysicalDeviceSelector{instance};
+		selector.set_minimum_version(1, 3).set_required_features_13(features13).set_required_features_12(features12);
+		if (headless) { selector.require_present(false); }
+		else { selector.set_surface(ret->surface); }
+
+		auto physicalResult = selector.select();
+		if (!physicalResult)
+		{
+			s_log.error("no suitable GPU: {}", physicalResult.error().message());
+			return {};
+		}
+
+		auto physical             = physicalResult.value();
+		ret->calibratedTimestamps = physical.enable_extension_if_present(VK_EXT_CALIBRATED_TIMESTAMPS_EXTENSION_NAME);
+
+		auto deviceResult = vkb::DeviceBuilder{physical}.build();
+		if (!deviceResult)
+		{
+			s_log.error("failed to create Vulkan device: {}", deviceResult.error().message());
+			return {};
+		}
+
+		auto const device        = deviceResult.value();
+		ret->physicalDevice      = device.physical_device.physical_device;
+		ret->properties          = device.physical_device.properties;
+		ret->device              = device.device;
+		ret->graphicsQueue       = device.get_queue(vkb::QueueType::graphics).value();
+		ret->graphicsQueueFamily = device.get_queue_index(vkb::QueueType::graphics).value();
+
+		if (auto transfer = device.get_dedicated_queue(vkb::QueueType::transfer))
+		{
+			ret->transferQueue       = transfer.value();
+			ret->transferQueueFamily = device.get_dedicated_queue_index(vkb::QueueType::transfer).value();
+		}
+		else if (auto separate = device.get_queue(vkb::QueueType::transfer))
+		{
+			ret->transferQueue       = separate.value();
+			ret->transferQueueFamily = device.get_queue_index(vkb::QueueType::transfer).value();
+		}
+		else
+		{
+			ret->transferQueue       = ret->graphicsQueue;
+			ret->transferQueueFamily = ret->graphicsQueueFamily;
+		}
+
+		auto allocatorInfo             = VmaAllocatorCreateInfo{};
+		allocatorInfo.flags            = VMA_ALLOCATOR_CREATE_BUFFER_DEVICE_ADDRESS_BIT;
+		allocatorInfo.physicalDevice   = ret->physicalDevice;
+		allocatorInfo.device           = ret->device;
+		allocatorInfo.instance         = ret->instance;
+		allocatorInfo.vulkanApiVersion = VK_API_VERSION_1_3;
+		VK_CHECK(vmaCreateAllocator(&allocatorInfo, &ret->allocator));
+
+		s_log.info("using GPU '{}'{}{}", ret->properties.deviceName, headless ? " (headless)" : "", ret->hasTransferQueue() ? " with a transfer queue" : "");
+		return ret;
+	}
+
+	Device::~Device()
+	{
+		if (allocator != VK_NULL_HANDLE) { vmaDestroyAllocator(allocator); }
+		if (device != VK_NULL_HANDLE) { vkDestroyDevice(device, nullptr); }
+		if (surface != VK_NULL_HANDLE) { vkDestroySurfaceKHR(instance, surface, nullptr); }
+		if (instance != VK_NULL_HANDLE)
+		{
+			vkb::destroy_debug_utils_messenger(instance, debugMessenger);
+			vkDestroyInstance(instance, nullptr);
+		}
+	}
+} // namespace bk::gpu
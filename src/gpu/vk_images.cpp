@@ -0,0 +1,90 @@
+#include "breakout/gpu/vk_images.hpp"
+
+#include "breakout/gpu/vk_device.hpp"
+#include "breakout/gpu/vk_initializers.hpp"
+
+namespace bk::gpu
+{
+	namespace
+	{
+		VkImageAspectFlags aspectOf(VkFormat const format)
+		{
+			return format == VK_FORMAT_D32_SFLOAT ? VK_IMAGE_ASPECT_DEPTH_BIT : VK_IMAGE_ASPECT_COLOR_BIT;
+		}
+
+		VkOffset3D farCorner(VkExtent2D const size)
+		{
+			return {static_cast<std::int32_t>(size.width), static_cast<std::int32_t>(size.height), 1};
+		}
+	} // namespace
+
+	AllocatedImage createImage(Device const & device, VkExtent3D const extent, VkFormat const format, VkImageUsageFlags const usage)
+	{
+		auto ret   = AllocatedImage{};
+		ret.extent = extent;
+		ret.format = format;
+
+		auto const imageInfo    = init::imageCreateInfo(format, usage, extent);
+		auto allocInfo          = VmaAllocationCreateInfo{};
+		allocInfo.usage         = VMA_MEMORY_USAGE_GPU_ONLY;
+		allocInfo.requiredFlags = VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT;
+		VK_CHECK(vmaCreateImage(device.allocator, &imageInfo, &allocInfo, &ret.image, &ret.allocation, nullptr));
+
+		auto const viewInfo = init::imageViewCreateInfo(format, ret.image, aspectOf(format));
+		VK_CHECK(vkCreateImageView(device.device, &viewInfo, nullptr, &ret.view));
+		return ret;
+	}
+
+	void destroyImage(Device const & device, AllocatedImage & image)
+	{
+		if (image.image == VK_NULL_HANDLE) { return; }
+		vkDestroyImageView(device.device, image.view, nullptr);
+		vmaDestroyImage(device.allocator, image.image, image.allocation);
+		image = {};
+	}
+
+	void transitionImage(VkCommandBuffer const cmd, VkImage const image, VkImageLayout const currentLayout, VkImageLayout const newLayout)
+	{
+		auto const aspect = newLayout == VK_IMAGE_LAYOUT_DEPTH_ATTACHMENT_OPTIMAL ? VK_IMAGE_ASPECT_DEPTH_BIT : VK_IMAGE_ASPECT_COLOR_BIT;
+
+		auto barrier             = VkImageMemoryBarrier2{};
+		barrier.sType            = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER_2;
+		barrier.srcStageMask     = VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT;
+		barrier.srcAccessMask    = VK_ACCESS_2_MEMORY_WRITE_BIT;
+		barrier.dstStageMask     = VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT;
+		barrier.dstAccessMask    = VK_ACCESS_2_MEMORY_WRITE_BIT | VK_ACCESS_2_MEMORY_READ_BIT;
+		barrier.oldLayout        = currentLayout;
+		barrier.newLayout        = newLayout;
+		barrier.image            = image;
+		barrier.subresourceRange = init::imageSubresourceRange(aspect);
+
+		auto dependency                    = VkDependencyInfo{};
+		dependency.sType                   = VK_STRUCTURE_TYPE_DEPENDENCY_INFO;
+		dependency.imageMemoryBarrierCount = 1;
+		dependency.pImageMemoryBarriers    = &barrier;
+		vkCmdPipelineBarrier2(cmd, &dependency);
+	}
+
+	void copyImageToImage(VkCommandBuffer const cmd, VkImage const src, VkImage const dst, VkExtent2D const srcSize, VkExtent2D const dstSize)
+	{
+		auto region                      = VkImageBlit2{};
+		region.sType                     = VK_STRUCTURE_TYPE_IMAGE_BLIT_2;
+		region.srcOffsets[1]             = farCorner(srcSize);
+		region.dstOffsets[1]             = farCorner(dstSize);
+		region.srcSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+		region.srcSubresource.layerCount = 1;
+		region.dstSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+		region.dstSubresource.layerCount = 1;
+
+		auto blitInfo           = VkBlitImageInfo2{};
+		blitInfo.sType          = VK_STRUCTURE_TYPE_BLIT_IMAGE_INFO_2;
+		blitInfo.srcImage       = src;
+		blitInfo.srcImageLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+		blitInfo.dstImage       = dst;
+		blitInfo.dstImageLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+		blitInfo.regionCount    = 1;
+		blitInfo.pRegions       = &region;
+		blitInfo.filter         = VK_FILTER_LINEAR;
+		vkCmdBlitImage2(cmd, &blitInfo);
+	}
+} // namespace bk::gpu
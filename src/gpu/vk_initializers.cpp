@@ -0,0 +1,105 @@
+#include "breakout/gpu/vk_initializers.hpp"
+
+namespace bk::gpu::init
+{
+	VkCommandBufferBeginInfo commandBufferBeginInfo(VkCommandBufferUsageFlags const flags)
+	{
+		auto ret  = VkCommandBufferBeginInfo{};
+		ret.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+		ret.flags = flags;
+		return ret;
+	}
+
+	VkCommandBufferSubmitInfo commandBufferSubmitInfo(VkCommandBuffer const cmd)
+	{
+		auto ret          = VkCommandBufferSubmitInfo{};
+		ret.sType         = VK_STRUCTURE_TYPE_COMMAND_BUFFER_SUBMIT_INFO;
+		ret.commandBuffer = cmd;
+		return ret;
+	}
+
+	VkSemaphoreSubmitInfo semaphoreSubmitInfo(VkPipelineStageFlags2 const stageMask, VkSemaphore const semaphore, std::uint64_t const value)
+	{
+		auto ret      = VkSemaphoreSubmitInfo{};
+		ret.sType     = VK_STRUCTURE_TYPE_SEMAPHORE_SUBMIT_INFO;
+		ret.semaphore = semaphore;
+		ret.value     = value;
+		ret.stageMask = stageMask;
+		return ret;
+	}
+
+	VkSubmitInfo2 submitInfo(VkCommandBufferSubmitInfo const * cmd, std::span<VkSemaphoreSubmitInfo const> const wait,
+							 std::span<VkSemaphoreSubmitInfo const> const signal)
+	{
+		auto ret                     = VkSubmitInfo2{};
+		ret.sType                    = VK_STRUCTURE_TYPE_SUBMIT_INFO_2;
+		ret.waitSemaphoreInfoCount   = static_cast<std::uint32_t>(wait.size());
+		ret.pWaitSemaphoreInfos      = wait.data();
+		ret.commandBufferInfoCount   = 1;
+		ret.pCommandBufferInfos      = cmd;
+		ret.signalSemaphoreInfoCount = static_cast<std::uint32_t>(signal.size());
+		ret.pSignalSemaphoreInfos    = signal.data();
+		return ret;
+	}
+
+	VkImageSubresourceRange imageSubresourceRange(VkImageAspectFlags const aspectMask)
+	{
+		auto ret       = VkImageSubresourceRange{};
+		ret.aspectMask = aspectMask;
+		ret.levelCount = VK_REMAINING_MIP_LEVELS;
+		ret.layerCount = VK_REMAINING_ARRAY_LAYERS;
+		return ret;
+	}
+
+	VkImageCreateInfo imageCreateInfo(VkFormat const format, VkImageUsageFlags const usage, VkExtent3D const extent)
+	{
+		auto ret        = VkImageCreateInfo{};
+		ret.sType       = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
+		ret.imageType   = VK_IMAGE_TYPE_2D;
+		ret.format      = format;
+		ret.extent      = extent;
+		ret.mipLevels   = 1;
+		ret.arrayLayers = 1;
+		ret.samples     = VK_SAMPLE_COUNT_1_BIT;
+		ret.tiling      = VK_IMAGE_TILING_OPTIMAL;
+		ret.usage       = usage;
+		return ret;
+	}
+
+	VkImageViewCreateInfo imageViewCreateInfo(VkFormat const format, VkImage const image, VkImageAspectFlags const aspectMask)
+	{
+		auto ret                        = VkImageViewCreateInfo{};
+		ret.sType                       = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
+		ret.viewType                    = VK_IMAGE_VIEW_TYPE_2D;
+		ret.image                       = image;
+		ret.format                      = format;
+		ret.subresourceRange.aspectMask = aspectMask;
+		ret.subresourceRange.levelCount = 1;
+		ret.subresourceRange.layerCount = 1;
+		return ret;
+	}
+
+	VkRenderingAttachmentInfo attachmentInfo(VkImageView const view, VkClearValue const * clear, VkImageLayout const layout)
+	{
+		auto ret        = VkRenderingAttachmentInfo{};
+		ret.sType       = VK_STRUCTURE_TYPE_RENDERING_ATTACHMENT_INFO;
+		ret.imageView   = view;
+		ret.imageLayout = layout;
+		ret.loadOp      = clear != nullptr ? VK_ATTACHMENT_LOAD_OP_CLEAR : VK_ATTACHMENT_LOAD_OP_LOAD;
+		ret.storeOp     = VK_ATTACHMENT_STORE_OP_STORE;
+		if (clear != nullptr) { ret.clearValue = *clear; }
+		return ret;
+	}
+
+	VkRenderingInfo renderingInfo(VkExtent2D const extent, VkRenderingAttachmentInfo const * color, VkRenderingAttachmentInfo const * depth)
+	{
+		auto ret                 = VkRenderingInfo{};
+		ret.sType                = VK_STRUCTURE_TYPE_RENDERING_INFO;
+		ret.renderArea           = VkRect2D{VkOffset2D{0, 0}, extent};
+		ret.layerCount           = 1;
+		ret.colorAttachmentCount = color == nullptr ? 0 : 1;
+		ret.pColorAttachments    = color;
+		ret.pDepthAttachment     = depth;
+		return ret;
+	}
+} // namespace bk::gpu::init
@@ -0,0 +1,3 @@
+// Single translation unit holding the Vulkan Memory Allocator implementation.
+#define VMA_IMPLEMENTATION
+#include <vk_mem_alloc.h>
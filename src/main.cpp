@@ -1,10 +1,35 @@
 
 
 #include "breakout/game/game.hpp"
+#include "breakout/app/bench.hpp"
 #include "breakout/core/logger.hpp"
 
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
 static constexpr auto logFile{"brick_break.log"};
 
+// The optional count after a flag: only a whole number, so a following flag is never mistaken for one.
+static std::optional<std::uint32_t> parseCount(std::vector<std::string_view> const& args, std::vector<std::string_view>::const_iterator const flag)
+{
+    auto const next = std::next(flag);
+    if (next == args.end() || next->empty() || next->starts_with("--")) {
+        return std::nullopt;
+    }
+    auto const text = std::string{*next};
+    char* end = nullptr;
+    auto const value = std::strtoul(text.c_str(), &end, 10);
+    if (end != text.c_str() + text.size()) {
+        return std::nullopt;
+    }
+    return static_cast<std::uint32_t>(value);
+}
+
 
 int main(int argc, char* argv[])
 {
@@ -14,13 +39,118 @@ int main(int argc, char* argv[])
     // Required to initialize the logger for the application. This must also stay outside any try/catch blocks.
     auto logger = bk::logger::Instance{logFile, config};
 
+    auto const args = std::vector<std::string_view>(argv + 1, argv + argc);
+    if (!args.empty() && args.front() == "--bench") {
+        return bk::bench::run(std::span{args}.subspan(1));
+    }
+
     BK_LOG(bk::logger::general, "Brick break game starting up!");
 
     brk::Game game;
 
-    game.init();
+    // --headless [frames]: render offscreen without a window, e.g. against lavapipe on machines without a GPU
+    if (auto const itr = std::ranges::find(args, "--headless"); itr != args.end()) {
+        game.config.headless = true;
+        if (auto const frames = parseCount(args, itr)) {
+            game.config.headlessFrameCount = *frames;
+        }
+    }
+
+    // --software [file.png]: rasterize on the CPU without a window or GPU, writing the last frame to file.png if given
+    if (auto const itr = std::ranges::find(args, "--software"); itr != args.end()) {
+        game.config.softwareRenderer = true;
+        if (std::next(itr) != args.end() && !std::next(itr)->starts_with("--")) {
+            game.config.softwareOutput = *std::next(itr);
+        }
+    }
+
+    // --profile [interval]: log CPU and GPU zones of every interval-th frame (default 60)
+    if (auto const itr = std::ranges::find(args, "--profile"); itr != args.end()) {
+        game.config.profileReportInterval = 60;
+        if (auto const interval = parseCount(args, itr)) {
+            game.config.profileReportInterval = *interval;
+        }
+    }
+
+    // --dump-graph: log the first frame's render graph (passes, barriers, transient memory)
+    if (std::ranges::find(args, "--dump-graph") != args.end()) {
+        game.config.dumpRenderGraph = true;
+    }
+
+    // --present-mode fifo|mailbox|immediate: swapchain present mode; unsupported modes fall back to fifo
+    if (auto const itr = std::ranges::find(args, "--present-mode"); itr != args.end() && std::next(itr) != args.end()) {
+        auto const mode = *std::next(itr);
+        if (mode == "mailbox") {
+            game.config.presentMode = VK_PRESENT_MODE_MAILBOX_KHR;
+        } else if (mode == "immediate") {
+            game.config.presentMode = VK_PRESENT_MODE_IMMEDIATE_KHR;
+        } else if (mode != "fifo") {
+            bk::logger::general.warn("unknown present mode '{}', using fifo", mode);
+        }
+    }
+
+    // --frames-in-flight n: frames the CPU may run ahead of the GPU (1 to 4, default 2)
+    if (auto const itr = std::ranges::find(args, "--frames-in-flight"); itr != args.end()) {
+        if (auto const frames = parseCount(args, itr)) {
+            game.config.framesInFlight = *frames;
+        }
+    }
 
-    game.run();
+    // --jit-input: sample input right before the frame can start instead of before waiting for it
+    if (std::ranges::find(args, "--jit-input") != args.end()) {
+        game.config.justInTimeInput = true;
+    }
+
+    // --capture [interval]: write every interval-th frame (default 60) to captures/; F12 captures single frames regardless
+    if (auto const itr = std::ranges::find(args, "--capture"); itr != args.end()) {
+        game.config.captureInterval = 60;
+        if (auto const interval = parseCount(args, itr)) {
+            game.config.captureInterval = *interval;
+        }
+    }
+
+    // --capture-format png|qoi: file format of captured frames (default png)
+    if (auto const itr = std::ranges::find(args, "--capture-format"); itr != args.end() && std::next(itr) != args.end()) {
+        auto const format = *std::next(itr);
+        if (format == "qoi") {
+            game.config.captureFormat = bk::gpu::FrameCapture::Format::eQoi;
+        } else if (format != "png") {
+            bk::logger::general.warn("unknown capture format '{}', using png", format);
+        }
+    }
+
+    // --overlay: start with the performance overlay (F3) open
+    if (std::ranges::find(args, "--overlay") != args.end()) {
+        game.config.showOverlay = true;
+    }
+
+    // --metrics [file]: publish frame counters and latency histograms every second to file (Prometheus text format), or the log
+    if (auto const itr = std::ranges::find(args, "--metrics"); itr != args.end()) {
+        game.config.metricsInterval = std::chrono::seconds{1};
+        if (std::next(itr) != args.end() && !std::next(itr)->starts_with("--")) {
+            game.config.metricsFile = *std::next(itr);
+        }
+    }
+
+    // --font file.ttf: bake this font for the HUD text; without it no text is drawn
+    if (auto const itr = std::ranges::find(args, "--font"); itr != args.end() && std::next(itr) != args.end()) {
+        game.config.font = *std::next(itr);
+    }
+
+    // --startup-report: initialize, log the critical path through the startup tasks, and exit
+    if (std::ranges::find(args, "--startup-report") != args.end()) {
+        game.config.startupReport = true;
+    }
+
+    if (!game.init()) {
+        bk::logger::general.error("Failed to initialize the game");
+        game.cleanup();
+        return EXIT_FAILURE;
+    }
+
+    if (!game.config.startupReport) {
+        game.run();
+    }
 
     game.cleanup();
     //glfwCreateWindow
@@ -0,0 +1,329 @@
+#include "breakout/soft/rasterizer.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+#include <glm/vec4.hpp>
+
+#include "breakout/core/file_io.hpp"
+#include "breakout/core/image_writer.hpp"
+#include "breakout/core/thread_pool.hpp"
+
+namespace bk::soft
+{
+	namespace
+	{
+		// x * y / 255, rounded; exact for every pair of bytes.
+		std::uint32_t mul255(std::uint32_t const x, std::uint32_t const y)
+		{
+			auto const product = x * y + 128;
+			return (product + (product >> 8u)) >> 8u;
+		}
+
+		std::uint32_t channel(std::uint32_t const pixel, std::uint32_t const index) { return (pixel >> (index * 8u)) & 0xffu; }
+
+		std::uint32_t modulate(std::uint32_t const texel, std::uint32_t const color)
+		{
+			auto ret = std::uint32_t{};
+			for (auto i = 0u; i < 4; ++i) { ret |= mul255(channel(texel, i), channel(color, i)) << (i * 8u); }
+			return ret;
+		}
+
+		// VK_BLEND_FACTOR_SRC_ALPHA / ONE_MINUS_SRC_ALPHA for color, ONE / ONE_MINUS_SRC_ALPHA for alpha.
+		std::uint32_t blend(std::uint32_t const src, std::uint32_t const dst)
+		{
+			auto const alpha   = channel(src, 3);
+			auto const inverse = 255 - alpha;
+			auto ret           = (alpha + mul255(channel(dst, 3), inverse)) << 24u;
+			for (auto i = 0u; i < 3; ++i) { ret |= (mul255(channel(src, i), alpha) + mul255(channel(dst, i), inverse)) << (i * 8u); }
+			return ret;
+		}
+
+		/**
+		 * \brief Interpolants at the first pixel of a row.
+		 */
+		struct RowStart
+		{
+			float s{};
+			float t{};
+			float u{};
+			float v{};
+		};
+
+#if defined(__AVX2__)
+		// Lanes hold 16 bit channels: after unpacking against zero, 2 pixels per 128 bit half.
+		__m256i mul255(__m256i const x, __m256i const y)
+		{
+			auto const product = _mm256_add_epi16(_mm256_mullo_epi16(x, y), _mm256_set1_epi16(128));
+			return _mm256_srli_epi16(_mm256_add_epi16(product, _mm256_srli_epi16(product, 8)), 8);
+		}
+
+		__m256i modulate(__m256i const texels, __m256i const color16)
+		{
+			auto const zero = _mm256_setzero_si256();
+			auto const low  = mul255(_mm256_unpacklo_epi8(texels, zero), color16);
+			auto const high = mul255(_mm256_unpackhi_epi8(texels, zero), color16);
+			return _mm256_packus_epi16(low, high);
+		}
+
+		__m256i blend16(__m256i const src, __m256i const dst)
+		{
+			auto const alpha   = _mm256_shufflehi_epi16(_mm256_shufflelo_epi16(src, 0xff), 0xff); // Broadcast per pixel
+			auto const factor  = _mm256_blend_epi16(alpha, _mm256_set1_epi16(255), 0x88);          // 255 in the alpha channel
+			auto const inverse = _mm256_sub_epi16(_mm256_set1_epi16(255), alpha);
+			return _mm256_add_epi16(mul255(src, factor), mul255(dst, inverse));
+		}
+
+		__m256i blend(__m256i const src, __m256i const dst)
+		{
+			auto const zero = _mm256_setzero_si256();
+			auto const low  = blend16(_mm256_unpacklo_epi8(src, zero), _mm256_unpacklo_epi8(dst, zero));
+			auto const high = blend16(_mm256_unpackhi_epi8(src, zero), _mm256_unpackhi_epi8(dst, zero));
+			return _mm256_packus_epi16(low, high);
+		}
+#endif
+
+		// Both kernels evaluate every interpolant as start + step * column rather than accumulating steps, so they agree on
+		// which pixels a sprite covers.
+		template<typename Setup>
+		std::uint32_t shadeRowScalar(std::uint32_t * dst, std::uint32_t const first, std::uint32_t const count, Setup const & setup, RowStart const & row)
+		{
+			auto const solid = setup.texture.texels.empty();
+			auto const maxU  = static_cast<float>(setup.texture.width) - 1.0f;
+			auto const maxV  = static_cast<float>(setup.texture.height) - 1.0f;
+			auto covered     = std::uint32_t{};
+			for (auto i = first; i < count; ++i)
+			{
+				auto const column = static_cast<float>(i);
+				auto const s      = row.s + setup.sx * column;
+				auto const t      = row.t + setup.tx * column;
+				if (s < 0.0f || s >= 1.0f || t < 0.0f || t >= 1.0f) { continue; }
+
+				auto src = setup.color;
+				if (!solid)
+				{
+					auto const x = static_cast<std::size_t>(std::clamp(row.u + setup.ux * column, 0.0f, maxU));
+					auto const y = static_cast<std::size_t>(std::clamp(row.v + setup.vx * column, 0.0f, maxV));
+					src          = modulate(setup.texture.texels[y * setup.texture.width + x], setup.color);
+				}
+				dst[i] = blend(src, dst[i]);
+				++covered;
+			}
+			return covered;
+		}
+
+#if defined(__AVX2__)
+		/**
+		 * \brief Shades count / 8 * 8 pixels of the row; the rest is left to shadeRowScalar.
+		 */
+		template<typename Setup>
+		std::uint32_t shadeRowAvx2(std::uint32_t * dst, std::uint32_t const count, Setup const & setup, RowStart const & row)
+		{
+			auto const lane = _mm256_setr_ps(0.0f, 1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f, 7.0f);
+			auto const at   = [](__m256 const column, float const start, float const step)
+			{ return _mm256_add_ps(_mm256_set1_ps(start), _mm256_mul_ps(_mm256_set1_ps(step), column)); };
+
+			auto const zero   = _mm256_setzero_ps();
+			auto const one    = _mm256_set1_ps(1.0f);
+			auto const solid  = setup.texture.texels.empty();
+			auto const opaque = solid && (setup.color >> 24u) == 0xffu;
+			auto const color  = _mm256_set1_epi32(static_cast<int>(setup.color));
+			auto const tint   = _mm256_unpacklo_epi8(color, _mm256_setzero_si256());
+			auto const maxU   = _mm256_set1_ps(static_cast<float>(setup.texture.width) - 1.0f);
+			auto const maxV   = _mm256_set1_ps(static_cast<float>(setup.texture.height) - 1.0f);
+			auto const pitch  = _mm256_set1_epi32(static_cast<int>(setup.texture.width));
+			auto const * base = reinterpret_cast<int const *>(setup.texture.texels.data()); // NOLINT(*-reinterpret-cast)
+
+			auto covered = std::uint32_t{};
+			for (std::uint32_t i = 0; i + 8 <= count; i += 8)
+			{
+				auto const column = _mm256_add_ps(lane, _mm256_set1_ps(static_cast<float>(i)));
+				auto const s      = at(column, row.s, setup.sx);
+				auto const t      = at(column, row.t, setup.tx);
+				auto const inside = _mm256_and_ps(_mm256_and_ps(_mm256_cmp_ps(s, zero, _CMP_GE_OQ), _mm256_cmp_ps(s, one, _CMP_LT_OQ)),
+												  _mm256_and_ps(_mm256_cmp_ps(t, zero, _CMP_GE_OQ), _mm256_cmp_ps(t, one, _CMP_LT_OQ)));
+				if (auto const bits = static_cast<unsigned>(_mm256_movemask_ps(inside)); bits != 0)
+				{
+					covered         += static_cast<std::uint32_t>(std::popcount(bits));
+					auto const mask  = _mm256_castps_si256(inside);
+					auto * pixels    = reinterpret_cast<__m256i *>(dst + i); // NOLINT(*-reinterpret-cast)
+					auto const old   = _mm256_loadu_si256(pixels);
+
+					auto src = color;
+					if (!solid)
+					{
+						auto const x = _mm256_cvttps_epi32(_mm256_min_ps(_mm256_max_ps(at(column, row.u, setup.ux), zero), maxU));
+						auto const y = _mm256_cvttps_epi32(_mm256_min_ps(_mm256_max_ps(at(column, row.v, setup.vx), zero), maxV));
+						auto const texels = _mm256_mask_i32gather_epi32(_mm256_setzero_si256(), base, _mm256_add_epi32(_mm256_mullo_epi32(y, pitch), x), mask, 4);
+						src = modulate(texels, tint);
+					}
+					_mm256_storeu_si256(pixels, _mm256_blendv_epi8(old, opaque ? src : blend(src, old), mask));
+				}
+			}
+			return covered;
+		}
+#endif
+	} // namespace
+
+	bool Rasterizer::isSimd()
+	{
+#if defined(__AVX2__)
+		return true;
+#else
+		return false;
+#endif
+	}
+
+	Rasterizer::Rasterizer(ThreadPool & pool, Config const & config) : m_pool(pool) { resize(config.width, config.height); }
+
+	void Rasterizer::resize(std::uint32_t const width, std::uint32_t const height)
+	{
+		m_width  = width;
+		m_height = height;
+		m_tilesX = (width + tile_size_v - 1) / tile_size_v;
+		m_tilesY = (height + tile_size_v - 1) / tile_size_v;
+		m_pixels.assign(static_cast<std::size_t>(width) * height, 0);
+		m_bins.resize(static_cast<std::size_t>(m_tilesX) * m_tilesY);
+		m_covered.resize(m_bins.size());
+	}
+
+	void Rasterizer::setTexture(std::uint32_t const slot, Texture const & texture)
+	{
+		if (slot >= m_textures.size()) { m_textures.resize(slot + 1); }
+		m_textures[slot] = texture;
+	}
+
+	void Rasterizer::draw(std::span<gpu::SpriteInstance const> const instances, glm::mat4 const & viewProj, std::uint32_t const clearColor)
+	{
+		for (auto & bin : m_bins) { bin.clear(); }
+		m_setups.clear();
+		m_stats = {.tiles = static_cast<std::uint32_t>(m_bins.size())};
+
+		auto const viewport = glm::vec2{static_cast<float>(m_width), static_cast<float>(m_height)};
+		auto const toScreen = [&](glm::vec2 const world)
+		{
+			auto const clip = viewProj * glm::vec4{world, 0.0f, 1.0f};
+			return (glm::vec2{clip} / clip.w * 0.5f + 0.5f) * viewport;
+		};
+
+		// Sprites are parallelograms on screen as long as the projection is affine (2D cameras), so each is an origin and two
+		// edge vectors; inverting that map gives (s, t) per pixel, and everything else is linear in (s, t).
+		for (auto const & instance : instances)
+		{
+			auto const cos      = std::cos(instance.rotation);
+			auto const sin      = std::sin(instance.rotation);
+			auto const toWorld  = [&](float const x, float const y)
+			{
+				auto const local = (glm::vec2{x, y} - 0.5f) * instance.size;
+				return instance.position + glm::vec2{local.x * cos - local.y * sin, local.x * sin + local.y * cos};
+			};
+			auto const origin   = toScreen(toWorld(0.0f, 0.0f));
+			auto const edgeS    = toScreen(toWorld(1.0f, 0.0f)) - origin;
+			auto const edgeT    = toScreen(toWorld(0.0f, 1.0f)) - origin;
+			auto const area     = edgeS.x * edgeT.y - edgeS.y * edgeT.x;
+			auto const opposite = origin + edgeS + edgeT;
+
+			auto setup = Setup{
+				.min   = glm::min(glm::min(origin, opposite), glm::min(origin + edgeS, origin + edgeT)),
+				.max   = glm::max(glm::max(origin, opposite), glm::max(origin + edgeS, origin + edgeT)),
+				.color = instance.color,
+			};
+			if (std::abs(area) < 1e-6f || setup.max.x <= 0.0f || setup.max.y <= 0.0f || setup.min.x >= viewport.x || setup.min.y >= viewport.y) { continue; }
+
+			setup.sx = edgeT.y / area;
+			setup.sy = -edgeT.x / area;
+			setup.s  = -(setup.sx * origin.x + setup.sy * origin.y);
+			setup.tx = -edgeS.y / area;
+			setup.ty = edgeS.x / area;
+			setup.t  = -(setup.tx * origin.x + setup.ty * origin.y);
+
+			if (instance.texture < m_textures.size() && !m_textures[instance.texture].texels.empty())
+			{
+				setup.texture     = m_textures[instance.texture];
+				auto const scaleU = (instance.uvRect.z - instance.uvRect.x) * static_cast<float>(setup.texture.width);
+				auto const scaleV = (instance.uvRect.w - instance.uvRect.y) * static_cast<float>(setup.texture.height);
+				setup.u           = setup.s * scaleU + instance.uvRect.x * static_cast<float>(setup.texture.width);
+				setup.ux          = setup.sx * scaleU;
+				setup.uy          = setup.sy * scaleU;
+				setup.v           = setup.t * scaleV + instance.uvRect.y * static_cast<float>(setup.texture.height);
+				setup.vx          = setup.tx * scaleV;
+				setup.vy          = setup.ty * scaleV;
+			}
+
+			auto const index = static_cast<std::uint32_t>(m_setups.size());
+			auto const tile  = [](float const coordinate, std::uint32_t const size)
+			{
+				auto const pixel = std::clamp(coordinate, 0.0f, static_cast<float>(size - 1));
+				return static_cast<std::uint32_t>(pixel) / tile_size_v;
+			};
+			for (auto y = tile(setup.min.y, m_height); y <= tile(setup.max.y, m_height); ++y)
+			{
+				for (auto x = tile(setup.min.x, m_width); x <= tile(setup.max.x, m_width); ++x) { m_bins[y * m_tilesX + x].push_back(index); }
+			}
+			m_setups.push_back(setup);
+		}
+
+		m_pool.parallelFor(static_cast<std::uint32_t>(m_bins.size()), [&](std::uint32_t const tile) { shadeTile(tile, clearColor); });
+
+		m_stats.sprites = static_cast<std::uint32_t>(m_setups.size());
+		for (std::size_t tile = 0; tile < m_bins.size(); ++tile)
+		{
+			m_stats.binned  += m_bins[tile].size();
+			m_stats.covered += m_covered[tile];
+		}
+	}
+
+	void Rasterizer::shadeTile(std::uint32_t const tile, std::uint32_t const clearColor)
+	{
+		auto const left   = static_cast<std::int32_t>((tile % m_tilesX) * tile_size_v);
+		auto const top    = static_cast<std::int32_t>((tile / m_tilesX) * tile_size_v);
+		auto const right  = std::min(left + static_cast<std::int32_t>(tile_size_v), static_cast<std::int32_t>(m_width));
+		auto const bottom = std::min(top + static_cast<std::int32_t>(tile_size_v), static_cast<std::int32_t>(m_height));
+
+		auto const row = [&](std::int32_t const y) { return m_pixels.data() + static_cast<std::size_t>(y) * m_width; };
+		for (auto y = top; y < bottom; ++y) { std::fill(row(y) + left, row(y) + right, clearColor); }
+
+		auto covered = std::uint64_t{};
+		for (auto const index : m_bins[tile])
+		{
+			auto const & setup = m_setups[index];
+			auto const x0      = std::max(left, static_cast<std::int32_t>(std::floor(setup.min.x)));
+			auto const x1      = std::min(right, static_cast<std::int32_t>(std::ceil(setup.max.x)));
+			auto const y0      = std::max(top, static_cast<std::int32_t>(std::floor(setup.min.y)));
+			auto const y1      = std::min(bottom, static_cast<std::int32_t>(std::ceil(setup.max.y)));
+			if (x0 >= x1 || y0 >= y1) { continue; }
+
+			// Sampled at pixel centres.
+			auto const px = static_cast<float>(x0) + 0.5f;
+			for (auto y = y0; y < y1; ++y)
+			{
+				auto const py    = static_cast<float>(y) + 0.5f;
+				auto const start = RowStart{
+					.s = setup.s + setup.sx * px + setup.sy * py,
+					.t = setup.t + setup.tx * px + setup.ty * py,
+					.u = setup.u + setup.ux * px + setup.uy * py,
+					.v = setup.v + setup.vx * px + setup.vy * py,
+				};
+				auto const count = static_cast<std::uint32_t>(x1 - x0);
+#if defined(__AVX2__)
+				covered += shadeRowAvx2(row(y) + x0, count, setup, start);
+				covered += shadeRowScalar(row(y) + x0, count / 8 * 8, count, setup, start);
+#else
+				covered += shadeRowScalar(row(y) + x0, 0, count, setup, start);
+#endif
+			}
+		}
+		m_covered[tile] = covered;
+	}
+
+	bool Rasterizer::write(std::filesystem::path const & path) const
+	{
+		if (m_pixels.empty()) { return false; }
+		return writeFileAtomic(path, image::encodePng(m_width, m_height, m_pixels));
+	}
+} // namespace bk::soft
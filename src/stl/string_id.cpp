@@ -0,0 +1,69 @@
+#include "breakout/stl/string_id.hpp"
+
+#include <cstdio>
+#include <cstdlib>
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_map>
+
+namespace bk
+{
+    namespace
+    {
+        struct InternTable
+        {
+            std::shared_mutex mutex{};
+            // Node based: views into the names stay valid as the table grows, and nothing is ever erased.
+            std::unordered_map<std::uint64_t, FixedString<string_id_capacity_v>> names{};
+        };
+
+        // Function local, since loggers intern their categories during static initialisation.
+        InternTable & getTable()
+        {
+            static auto ret = InternTable{};
+            return ret;
+        }
+
+        void checkCollision([[maybe_unused]] std::string_view const stored, [[maybe_unused]] std::string_view const text)
+        {
+#if !defined(NDEBUG)
+            if (stored != text.substr(0, string_id_capacity_v))
+            {
+                // The logger interns its own categories, so report straight to stderr.
+                std::fprintf(stderr, "StringId collision: '%.*s' and '%.*s' hash to %016llx\n", static_cast<int>(stored.size()), stored.data(),
+                             static_cast<int>(text.size()), text.data(), static_cast<unsigned long long>(fnv1a(text)));
+                std::abort();
+            }
+#endif
+        }
+    } // namespace
+
+    StringId StringId::intern(std::string_view const text)
+    {
+        auto const ret = StringId{text};
+        auto & table   = getTable();
+        {
+            // Interning the same strings again is the common case: a shared lock keeps concurrent callers apart only
+            // when something new comes along.
+            auto const lock = std::shared_lock{table.mutex};
+            if (auto const itr = table.names.find(ret.m_value); itr != table.names.end())
+            {
+                checkCollision(itr->second.view(), text);
+                return ret;
+            }
+        }
+
+        auto const lock            = std::unique_lock{table.mutex};
+        auto const [itr, inserted] = table.names.try_emplace(ret.m_value, text);
+        if (!inserted) { checkCollision(itr->second.view(), text); }
+        return ret;
+    }
+
+    std::string_view StringId::name() const
+    {
+        auto & table    = getTable();
+        auto const lock = std::shared_lock{table.mutex};
+        auto const itr  = table.names.find(m_value);
+        return itr != table.names.end() ? itr->second.view() : std::string_view{};
+    }
+} // namespace bk
@@ -0,0 +1,304 @@
+#include "breakout/transform.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cmath>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+namespace bk
+{
+	namespace
+	{
+		constexpr float two_over_pi_v{0.636619772367581f};
+		// pi / 2 split into three parts (Cody-Waite): the first two have few enough significant bits that multiplying them
+		// by the quadrant count is exact, so most of the reduction loses nothing.
+		constexpr float half_pi_hi_v{1.5703125f};
+		constexpr float half_pi_mid_v{4.837512969970703125e-4f};
+		constexpr float half_pi_lo_v{7.54978995489188216e-8f};
+
+		std::size_t groupCount(std::size_t const count) { return (count + Transforms::group_size_v - 1) / Transforms::group_size_v; }
+
+#if defined(__AVX2__)
+		// Plain arrays: std::array would drop the alignment attribute of __m256.
+		using Rows       = __m256[8];  // NOLINT(*-avoid-c-arrays)
+		using Components = __m256[16]; // NOLINT(*-avoid-c-arrays)
+
+		// In: rows[j] holds component j of 8 matrices. Out: rows[k] holds components 0-7 of matrix k.
+		void transpose(Rows & rows)
+		{
+			auto const t0 = _mm256_unpacklo_ps(rows[0], rows[1]);
+			auto const t1 = _mm256_unpackhi_ps(rows[0], rows[1]);
+			auto const t2 = _mm256_unpacklo_ps(rows[2], rows[3]);
+			auto const t3 = _mm256_unpackhi_ps(rows[2], rows[3]);
+			auto const t4 = _mm256_unpacklo_ps(rows[4], rows[5]);
+			auto const t5 = _mm256_unpackhi_ps(rows[4], rows[5]);
+			auto const t6 = _mm256_unpacklo_ps(rows[6], rows[7]);
+			auto const t7 = _mm256_unpackhi_ps(rows[6], rows[7]);
+			auto const s0 = _mm256_shuffle_ps(t0, t2, 0x44);
+			auto const s1 = _mm256_shuffle_ps(t0, t2, 0xee);
+			auto const s2 = _mm256_shuffle_ps(t1, t3, 0x44);
+			auto const s3 = _mm256_shuffle_ps(t1, t3, 0xee);
+			auto const s4 = _mm256_shuffle_ps(t4, t6, 0x44);
+			auto const s5 = _mm256_shuffle_ps(t4, t6, 0xee);
+			auto const s6 = _mm256_shuffle_ps(t5, t7, 0x44);
+			auto const s7 = _mm256_shuffle_ps(t5, t7, 0xee);
+			rows[0]       = _mm256_permute2f128_ps(s0, s4, 0x20);
+			rows[1]       = _mm256_permute2f128_ps(s1, s5, 0x20);
+			rows[2]       = _mm256_permute2f128_ps(s2, s6, 0x20);
+			rows[3]       = _mm256_permute2f128_ps(s3, s7, 0x20);
+			rows[4]       = _mm256_permute2f128_ps(s0, s4, 0x31);
+			rows[5]       = _mm256_permute2f128_ps(s1, s5, 0x31);
+			rows[6]       = _mm256_permute2f128_ps(s2, s6, 0x31);
+			rows[7]       = _mm256_permute2f128_ps(s3, s7, 0x31);
+		}
+
+		// components[c * 4 + r] holds column c, row r of 8 matrices, written out to matrices[0..7].
+		void store(Components const & components, glm::mat4 * const matrices)
+		{
+			for (std::size_t half = 0; half < 2; ++half)
+			{
+				Rows rows;
+				for (std::size_t j = 0; j < 8; ++j) { rows[j] = components[half * 8 + j]; }
+				transpose(rows);
+				for (std::size_t k = 0; k < 8; ++k) { _mm256_storeu_ps(&matrices[k][0][0] + half * 8, rows[k]); }
+			}
+		}
+#endif
+	} // namespace
+
+	SinCos fastSinCos(float const radians)
+	{
+		// radians = quadrant * pi/2 + r, |r| <= pi/4, where both polynomials are accurate to float precision.
+		auto const quadrant = std::floor(radians * two_over_pi_v + 0.5f);
+		auto const r        = ((radians - quadrant * half_pi_hi_v) - quadrant * half_pi_mid_v) - quadrant * half_pi_lo_v;
+		auto const r2       = r * r;
+
+		// Minimax polynomials from Cephes' sinf and cosf.
+		auto const sin = ((-1.9515295891e-4f * r2 + 8.3321608736e-3f) * r2 - 1.6666654611e-1f) * r2 * r + r;
+		auto const cos = ((2.443315711809948e-5f * r2 - 1.388731625493765e-3f) * r2 + 4.166664568298827e-2f) * r2 * r2 - 0.5f * r2 + 1.0f;
+
+		switch (static_cast<std::int64_t>(quadrant) & 3)
+		{
+		case 0: return {sin, cos};
+		case 1: return {cos, -sin};
+		case 2: return {-sin, -cos};
+		default: return {-cos, sin};
+		}
+	}
+
+	void Transforms::reserve(std::size_t const count)
+	{
+		auto const padded = groupCount(count) * group_size_v;
+		for (auto * const components : componentArrays()) { components->reserve(padded); }
+		m_dirty.reserve(groupCount(count));
+		m_world.reserve(padded);
+		m_worldViewProj.reserve(padded);
+	}
+
+	void Transforms::clear()
+	{
+		for (auto * const components : componentArrays()) { components->clear(); }
+		m_count = 0;
+		m_dirty.clear();
+		m_world.clear();
+		m_worldViewProj.clear();
+	}
+
+	std::uint32_t Transforms::add(Trs const & trs)
+	{
+		if (m_count % group_size_v == 0)
+		{
+			// A new group of identity transforms; the ones past m_count are padding, computed but never read.
+			auto const padded = m_count + group_size_v;
+			for (auto * const components : componentArrays()) { components->resize(padded, 0.0f); }
+			for (auto * const components : {&m_rotationW, &m_scaleX, &m_scaleY, &m_scaleZ}) { std::fill(components->end() - group_size_v, components->end(), 1.0f); }
+			m_dirty.push_back(1);
+			m_world.resize(padded, glm::mat4{1.0f});
+			m_worldViewProj.resize(padded, glm::mat4{1.0f});
+		}
+		auto const index = static_cast<std::uint32_t>(m_count++);
+		set(index, trs);
+		return index;
+	}
+
+	void Transforms::remove(std::uint32_t const index)
+	{
+		assert(index < m_count);
+		auto const last = static_cast<std::uint32_t>(m_count - 1);
+		set(index, get(last));
+		set(last, Trs{});
+		--m_count;
+		if (m_count % group_size_v == 0)
+		{
+			for (auto * const components : componentArrays()) { components->resize(m_count); }
+			m_dirty.pop_back();
+			m_world.resize(m_count);
+			m_worldViewProj.resize(m_count);
+		}
+	}
+
+	void Transforms::set(std::uint32_t const index, Trs const & trs)
+	{
+		setPosition(index, trs.position);
+		setRotation(index, trs.rotation);
+		setScale(index, trs.scale);
+	}
+
+	void Transforms::setPosition(std::uint32_t const index, glm::vec3 const & position)
+	{
+		assert(index < m_count);
+		m_positionX[index] = position.x;
+		m_positionY[index] = position.y;
+		m_positionZ[index] = position.z;
+		markDirty(index);
+	}
+
+	void Transforms::setRotation(std::uint32_t const index, glm::quat const & rotation)
+	{
+		assert(index < m_count);
+		m_rotationX[index] = rotation.x;
+		m_rotationY[index] = rotation.y;
+		m_rotationZ[index] = rotation.z;
+		m_rotationW[index] = rotation.w;
+		markDirty(index);
+	}
+
+	void Transforms::setRotationZ(std::uint32_t const index, float const radians)
+	{
+		auto const half = fastSinCos(radians * 0.5f);
+		setRotation(index, glm::quat{half.cos, 0.0f, 0.0f, half.sin});
+	}
+
+	void Transforms::setScale(std::uint32_t const index, glm::vec3 const & scale)
+	{
+		assert(index < m_count);
+		m_scaleX[index] = scale.x;
+		m_scaleY[index] = scale.y;
+		m_scaleZ[index] = scale.z;
+		markDirty(index);
+	}
+
+	Transforms::Trs Transforms::get(std::uint32_t const index) const
+	{
+		assert(index < m_count);
+		return {
+			.position = {m_positionX[index], m_positionY[index], m_positionZ[index]},
+			.rotation = {m_rotationW[index], m_rotationX[index], m_rotationY[index], m_rotationZ[index]},
+			.scale    = {m_scaleX[index], m_scaleY[index], m_scaleZ[index]},
+		};
+	}
+
+	void Transforms::update(glm::mat4 const & viewProj)
+	{
+		auto const allViewProj = !m_hasViewProj || viewProj != m_viewProj;
+		m_viewProj             = viewProj;
+		m_hasViewProj          = true;
+		m_stats                = {};
+		for (std::size_t group = 0; group < m_dirty.size(); ++group)
+		{
+			auto const dirty = m_dirty[group] != 0;
+			if (!dirty && !allViewProj) { continue; }
+			updateGroup(group, viewProj, dirty);
+			m_dirty[group]          = 0;
+			m_stats.worldUpdates    += dirty ? static_cast<std::uint32_t>(group_size_v) : 0;
+			m_stats.viewProjUpdates += static_cast<std::uint32_t>(group_size_v);
+		}
+	}
+
+	void Transforms::updateGroup(std::size_t const group, glm::mat4 const & viewProj, bool const world)
+	{
+		auto const first = group * group_size_v;
+#if defined(__AVX2__)
+		auto const load   = [first](std::vector<float> const & components) { return _mm256_loadu_ps(components.data() + first); };
+		auto const x      = load(m_rotationX);
+		auto const y      = load(m_rotationY);
+		auto const z      = load(m_rotationZ);
+		auto const w      = load(m_rotationW);
+		auto const scaleX = load(m_scaleX);
+		auto const scaleY = load(m_scaleY);
+		auto const scaleZ = load(m_scaleZ);
+		auto const one    = _mm256_set1_ps(1.0f);
+		auto const two    = _mm256_set1_ps(2.0f);
+
+		// Rotation matrix of a unit quaternion, columns scaled: the upper 3x3 of translate * rotate * scale.
+		auto const xx = _mm256_mul_ps(x, x);
+		auto const yy = _mm256_mul_ps(y, y);
+		auto const zz = _mm256_mul_ps(z, z);
+		auto const xy = _mm256_mul_ps(x, y);
+		auto const xz = _mm256_mul_ps(x, z);
+		auto const yz = _mm256_mul_ps(y, z);
+		auto const wx = _mm256_mul_ps(w, x);
+		auto const wy = _mm256_mul_ps(w, y);
+		auto const wz = _mm256_mul_ps(w, z);
+
+		auto const diagonal   = [&](__m256 const a, __m256 const b) { return _mm256_sub_ps(one, _mm256_mul_ps(two, _mm256_add_ps(a, b))); };
+		auto const sum        = [&](__m256 const a, __m256 const b) { return _mm256_mul_ps(two, _mm256_add_ps(a, b)); };
+		auto const difference = [&](__m256 const a, __m256 const b) { return _mm256_mul_ps(two, _mm256_sub_ps(a, b)); };
+
+		Components const components{
+			_mm256_mul_ps(diagonal(yy, zz), scaleX),
+			_mm256_mul_ps(sum(xy, wz), scaleX),
+			_mm256_mul_ps(difference(xz, wy), scaleX),
+			_mm256_setzero_ps(),
+			_mm256_mul_ps(difference(xy, wz), scaleY),
+			_mm256_mul_ps(diagonal(xx, zz), scaleY),
+			_mm256_mul_ps(sum(yz, wx), scaleY),
+			_mm256_setzero_ps(),
+			_mm256_mul_ps(sum(xz, wy), scaleZ),
+			_mm256_mul_ps(difference(yz, wx), scaleZ),
+			_mm256_mul_ps(diagonal(xx, yy), scaleZ),
+			_mm256_setzero_ps(),
+			load(m_positionX),
+			load(m_positionY),
+			load(m_positionZ),
+			one,
+		};
+		if (world) { store(components, m_world.data() + first); }
+
+		// viewProj * world, column by column: the w row of the world matrix is 0, 0, 0, 1.
+		Components product;
+		for (glm::length_t column = 0; column < 4; ++column)
+		{
+			auto const * const columns = components + column * 4;
+			for (glm::length_t row = 0; row < 4; ++row)
+			{
+				auto value = _mm256_mul_ps(_mm256_set1_ps(viewProj[0][row]), columns[0]);
+				value      = _mm256_add_ps(value, _mm256_mul_ps(_mm256_set1_ps(viewProj[1][row]), columns[1]));
+				value      = _mm256_add_ps(value, _mm256_mul_ps(_mm256_set1_ps(viewProj[2][row]), columns[2]));
+				if (column == 3) { value = _mm256_add_ps(value, _mm256_set1_ps(viewProj[3][row])); }
+				product[column * 4 + row] = value;
+			}
+		}
+		store(product, m_worldViewProj.data() + first);
+#else
+		for (auto i = first; i < first + group_size_v; ++i)
+		{
+			auto const x = m_rotationX[i];
+			auto const y = m_rotationY[i];
+			auto const z = m_rotationZ[i];
+			auto const w = m_rotationW[i];
+			auto matrix  = glm::mat4{
+				glm::vec4{(1.0f - 2.0f * (y * y + z * z)) * m_scaleX[i], 2.0f * (x * y + w * z) * m_scaleX[i], 2.0f * (x * z - w * y) * m_scaleX[i], 0.0f},
+				glm::vec4{2.0f * (x * y - w * z) * m_scaleY[i], (1.0f - 2.0f * (x * x + z * z)) * m_scaleY[i], 2.0f * (y * z + w * x) * m_scaleY[i], 0.0f},
+				glm::vec4{2.0f * (x * z + w * y) * m_scaleZ[i], 2.0f * (y * z - w * x) * m_scaleZ[i], (1.0f - 2.0f * (x * x + y * y)) * m_scaleZ[i], 0.0f},
+				glm::vec4{m_positionX[i], m_positionY[i], m_positionZ[i], 1.0f},
+			};
+			if (world) { m_world[i] = matrix; }
+			m_worldViewProj[i] = viewProj * matrix;
+		}
+#endif
+	}
+
+	bool Transforms::isSimd()
+	{
+#if defined(__AVX2__)
+		return true;
+#else
+		return false;
+#endif
+	}
+} // namespace bk